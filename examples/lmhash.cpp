@@ -0,0 +1,257 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lmcore/crc32.h"
+#include "lmcore/mapped_file.h"
+#include "lmcore/md5.h"
+#include "lmcore/thread_pool.h"
+#include "lmcore/xxhash64.h"
+
+using namespace lmshao::lmcore;
+
+// Parallel file checksums: every file is split into chunks that are mapped (MappedFile ranges)
+// and hashed on a ThreadPool with ParallelFor. Prints one digest per file, in the format of
+// crc32/md5sum/xxhsum, optionally the digest of every chunk, and throughput on stderr.
+//
+// The CRC32 of a file is combined from its chunk CRCs, so it is fully parallel even for a single
+// file. MD5 and XXH64 can't be combined: each file is hashed sequentially by one thread (files in
+// parallel), and chunk digests are computed separately when asked for.
+//
+// Usage: lmhash [-a crc32|md5|xxh64] [-c chunk_MiB] [-j threads] [-v] file...
+
+namespace {
+
+enum class Algorithm { kCrc32, kMd5, kXxh64 };
+
+struct Options {
+    Algorithm algorithm = Algorithm::kXxh64;
+    size_t chunkSize = 16 * 1024 * 1024;
+    size_t threads = std::max(1U, std::thread::hardware_concurrency());
+    bool perChunk = false;
+    std::vector<std::string> files;
+};
+
+struct FileJob {
+    std::string path;
+    uint64_t size = 0;
+    size_t chunks = 0;
+    std::string digest;
+    std::vector<std::string> chunkDigests;
+    std::vector<uint32_t> chunkCrcs;
+    std::atomic<bool> failed{false};
+    /// @brief The failure was already reported
+    bool reported = false;
+};
+
+/// Work item: one chunk of a file, or the whole file when chunk == kWholeFile
+struct WorkItem {
+    static constexpr size_t kWholeFile = SIZE_MAX;
+    size_t file;
+    size_t chunk;
+};
+
+void Usage()
+{
+    fprintf(stderr, "Usage: lmhash [-a crc32|md5|xxh64] [-c chunk_MiB] [-j threads] [-v] file...\n"
+                    "  -a  digest algorithm (default xxh64)\n"
+                    "  -c  chunk size in MiB (default 16)\n"
+                    "  -j  worker threads (default: number of CPUs)\n"
+                    "  -v  also print the digest of every chunk\n");
+}
+
+bool ParseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-a" && hasValue) {
+            std::string name = argv[++i];
+            if (name == "crc32") {
+                options.algorithm = Algorithm::kCrc32;
+            } else if (name == "md5") {
+                options.algorithm = Algorithm::kMd5;
+            } else if (name == "xxh64") {
+                options.algorithm = Algorithm::kXxh64;
+            } else {
+                return false;
+            }
+        } else if (arg == "-c" && hasValue) {
+            options.chunkSize = static_cast<size_t>(std::max(1L, atol(argv[++i]))) * 1024 * 1024;
+        } else if (arg == "-j" && hasValue) {
+            options.threads = static_cast<size_t>(std::max(1L, atol(argv[++i])));
+        } else if (arg == "-v") {
+            options.perChunk = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        } else {
+            options.files.push_back(arg);
+        }
+    }
+    return !options.files.empty();
+}
+
+std::string ToHex(uint64_t value, int digits)
+{
+    char text[17];
+    snprintf(text, sizeof(text), "%0*" PRIx64, digits, value);
+    return text;
+}
+
+std::string HashBlock(Algorithm algorithm, const uint8_t *data, size_t len)
+{
+    switch (algorithm) {
+        case Algorithm::kCrc32:
+            return ToHex(CRC32::Calculate(data, len), 8);
+        case Algorithm::kMd5:
+            return MD5::Calculate(data, len);
+        case Algorithm::kXxh64:
+        default:
+            return ToHex(XXHash64::Calculate(data, len), 16);
+    }
+}
+
+void HashChunk(const Options &options, FileJob &job, size_t chunk)
+{
+    uint64_t offset = static_cast<uint64_t>(chunk) * options.chunkSize;
+    auto file = MappedFile::Open(job.path, offset, options.chunkSize);
+    if (!file) {
+        job.failed = true;
+        return;
+    }
+    if (options.algorithm == Algorithm::kCrc32) {
+        job.chunkCrcs[chunk] = CRC32::Calculate(file->Data(), file->Size());
+        if (options.perChunk) {
+            job.chunkDigests[chunk] = ToHex(job.chunkCrcs[chunk], 8);
+        }
+    } else {
+        job.chunkDigests[chunk] = HashBlock(options.algorithm, file->Data(), file->Size());
+    }
+}
+
+/// Stream the whole file through one context, mapping one chunk at a time
+void HashWholeFile(const Options &options, FileJob &job)
+{
+    MD5::Context md5;
+    XXHash64::Context xxh64;
+    for (size_t chunk = 0; chunk < job.chunks; ++chunk) {
+        auto file = MappedFile::Open(job.path, static_cast<uint64_t>(chunk) * options.chunkSize, options.chunkSize);
+        if (!file) {
+            job.failed = true;
+            return;
+        }
+        if (options.algorithm == Algorithm::kMd5) {
+            md5.Update(file->Data(), file->Size());
+        } else {
+            xxh64.Update(file->Data(), file->Size());
+        }
+    }
+    job.digest = options.algorithm == Algorithm::kMd5 ? md5.Final() : ToHex(xxh64.Final(), 16);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        Usage();
+        return 2;
+    }
+
+    std::vector<FileJob> jobs(options.files.size());
+    std::vector<WorkItem> items;
+    bool crc = options.algorithm == Algorithm::kCrc32;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        FileJob &job = jobs[i];
+        job.path = options.files[i];
+        std::error_code ec;
+        job.size = std::filesystem::file_size(job.path, ec);
+        if (ec) {
+            fprintf(stderr, "lmhash: %s: %s\n", job.path.c_str(), ec.message().c_str());
+            job.failed = true;
+            job.reported = true;
+            continue;
+        }
+        job.chunks = static_cast<size_t>((job.size + options.chunkSize - 1) / options.chunkSize);
+        job.chunkCrcs.resize(crc ? job.chunks : 0);
+        job.chunkDigests.resize(crc && !options.perChunk ? 0 : job.chunks);
+        if (!crc) {
+            items.push_back({i, WorkItem::kWholeFile});
+        }
+        if (crc || options.perChunk) {
+            for (size_t chunk = 0; chunk < job.chunks; ++chunk) {
+                items.push_back({i, chunk});
+            }
+        }
+    }
+    // Whole files are the longest items: start them first so the chunks fill in around them
+    std::stable_sort(items.begin(), items.end(), [](const WorkItem &a, const WorkItem &b) {
+        return a.chunk == WorkItem::kWholeFile && b.chunk != WorkItem::kWholeFile;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(static_cast<int>(options.threads), static_cast<int>(options.threads), "lmhash");
+        pool.ParallelFor(0, items.size(), [&](size_t i) {
+            const WorkItem &item = items[i];
+            if (item.chunk == WorkItem::kWholeFile) {
+                HashWholeFile(options, jobs[item.file]);
+            } else {
+                HashChunk(options, jobs[item.file], item.chunk);
+            }
+        });
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int status = 0;
+    uint64_t totalBytes = 0;
+    for (FileJob &job : jobs) {
+        if (job.failed) {
+            if (!job.reported) {
+                fprintf(stderr, "lmhash: %s: read failed\n", job.path.c_str());
+            }
+            status = 1;
+            continue;
+        }
+        if (crc) {
+            uint32_t value = 0; // CRC32 of no data
+            for (size_t chunk = 0; chunk < job.chunks; ++chunk) {
+                uint64_t len = std::min<uint64_t>(options.chunkSize, job.size - chunk * options.chunkSize);
+                value = CRC32::Combine(value, job.chunkCrcs[chunk], len);
+            }
+            job.digest = ToHex(value, 8);
+        } else if (job.chunks == 0) {
+            job.digest = HashBlock(options.algorithm, reinterpret_cast<const uint8_t *>(""), 0);
+        }
+        printf("%s  %s\n", job.digest.c_str(), job.path.c_str());
+        if (options.perChunk) {
+            for (size_t chunk = 0; chunk < job.chunks; ++chunk) {
+                printf("  chunk %zu @%" PRIu64 " %s\n", chunk, static_cast<uint64_t>(chunk) * options.chunkSize,
+                       job.chunkDigests[chunk].c_str());
+            }
+        }
+        totalBytes += job.size;
+    }
+
+    double mib = static_cast<double>(totalBytes) / (1024.0 * 1024.0);
+    fprintf(stderr, "lmhash: %zu files, %.1f MiB in %.3f s: %.1f MiB/s (%zu threads, %zu work items)\n", jobs.size(),
+            mib, seconds, seconds > 0 ? mib / seconds : 0.0, options.threads, items.size());
+    return status;
+}
@@ -0,0 +1,148 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lmcore/adaptive_mutex.h"
+
+using namespace lmshao::lmcore;
+
+// Compares AdaptiveMutex/AdaptiveCondVar with std::mutex/std::condition_variable.
+// Usage: mutex_benchmark [seconds_per_case]
+
+namespace {
+
+double g_seconds = 0.5;
+
+// Work done inside and between critical sections, in loop iterations
+void Spin(int iterations)
+{
+    for (volatile int i = 0; i < iterations; i = i + 1) {
+    }
+}
+
+template <typename Mutex>
+double LockThroughput(int threads, int insideWork, int outsideWork)
+{
+    Mutex mutex;
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> total{0};
+    uint64_t shared = 0;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                {
+                    std::lock_guard<Mutex> lock(mutex);
+                    ++shared;
+                    Spin(insideWork);
+                }
+                Spin(outsideWork);
+                ++ops;
+            }
+            total.fetch_add(ops);
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(g_seconds));
+    stop = true;
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    return static_cast<double>(total.load()) / g_seconds / 1e6;
+}
+
+// Two threads hand a token back and forth through a condition variable
+template <typename Mutex, typename CondVar>
+double PingPong()
+{
+    Mutex mutex;
+    CondVar cond;
+    int turn = 0;
+    bool stop = false;
+    uint64_t rounds = 0;
+
+    auto player = [&](int me) {
+        std::unique_lock<Mutex> lock(mutex);
+        while (!stop) {
+            cond.wait(lock, [&]() { return turn == me || stop; });
+            if (stop) {
+                break;
+            }
+            turn = 1 - me;
+            ++rounds;
+            cond.notify_all();
+        }
+    };
+
+    std::thread a(player, 0);
+    std::thread b(player, 1);
+    std::this_thread::sleep_for(std::chrono::duration<double>(g_seconds));
+    {
+        std::lock_guard<Mutex> lock(mutex);
+        stop = true;
+    }
+    cond.notify_all();
+    a.join();
+    b.join();
+    return static_cast<double>(rounds) / g_seconds / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        g_seconds = atof(argv[1]);
+        if (g_seconds <= 0) {
+            g_seconds = 0.5;
+        }
+    }
+
+    printf("CPUs: %u, %.2fs per case, throughput in million lock/unlock pairs per second\n\n",
+           std::thread::hardware_concurrency(), g_seconds);
+
+    struct Case {
+        const char *name;
+        int inside;
+        int outside;
+    };
+    const Case cases[] = {
+        {"empty section, back-to-back (max contention)", 0, 0},
+        {"short section, short gap", 20, 100},
+        {"short section, long gap (low contention)", 20, 2000},
+        {"long section", 500, 100},
+    };
+    const int threadCounts[] = {1, 2, 4, 8};
+
+    for (const Case &c : cases) {
+        printf("%s\n", c.name);
+        printf("  %-8s %14s %14s %8s\n", "threads", "std::mutex", "AdaptiveMutex", "speedup");
+        for (int threads : threadCounts) {
+            double plain = LockThroughput<std::mutex>(threads, c.inside, c.outside);
+            double adaptive = LockThroughput<AdaptiveMutex>(threads, c.inside, c.outside);
+            printf("  %-8d %14.2f %14.2f %7.2fx\n", threads, plain, adaptive, plain > 0 ? adaptive / plain : 0.0);
+        }
+        printf("\n");
+    }
+
+    double plain = PingPong<std::mutex, std::condition_variable>();
+    double adaptive = PingPong<AdaptiveMutex, AdaptiveCondVar>();
+    printf("condition variable ping-pong, million handoffs per second\n");
+    printf("  std::condition_variable %.3f, AdaptiveCondVar %.3f (%.2fx)\n", plain, adaptive,
+           plain > 0 ? adaptive / plain : 0.0);
+    return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_ADAPTIVE_MUTEX_H
+#define LMSHAO_LMCORE_ADAPTIVE_MUTEX_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief Mutex that spins briefly before parking on a futex.
+ *
+ * Uncontended lock/unlock is a single atomic operation each, with no syscall. A contended
+ * lock spins with a CPU pause hint for an adaptively tuned number of iterations (tracking
+ * how long recent owners held the lock), then sleeps on a futex. Unlock only issues a wake
+ * syscall when a thread is actually asleep. Spinning is skipped on single-CPU machines.
+ *
+ * Intended for short critical sections; satisfies Lockable. Pair with AdaptiveCondVar. Not derived
+ * from NonCopyable, which would add a vtable pointer to a four-byte lock word.
+ */
+class AdaptiveMutex {
+public:
+    AdaptiveMutex() = default;
+    AdaptiveMutex(const AdaptiveMutex &) = delete;
+    AdaptiveMutex &operator=(const AdaptiveMutex &) = delete;
+
+    void lock()
+    {
+        uint32_t expected = kUnlocked;
+        if (!state_.compare_exchange_strong(expected, kLocked, std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+            LockSlow();
+        }
+    }
+
+    bool try_lock()
+    {
+        uint32_t expected = kUnlocked;
+        return state_.compare_exchange_strong(expected, kLocked, std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+        if (state_.exchange(kUnlocked, std::memory_order_release) == kContended) {
+            WakeOne();
+        }
+    }
+
+private:
+    friend class AdaptiveCondVar;
+
+    static constexpr uint32_t kUnlocked = 0;
+    static constexpr uint32_t kLocked = 1;
+    static constexpr uint32_t kContended = 2; // locked, and threads may be sleeping
+
+    void LockSlow();
+    /**
+     * @brief Lock for a thread woken from AdaptiveCondVar; marks the lock contended so waiters
+     * requeued onto the mutex are woken one by one as it is released.
+     */
+    void LockContended();
+    void WakeOne();
+
+    std::atomic<uint32_t> state_{kUnlocked};
+    std::atomic<int32_t> spinEstimate_{0};
+};
+
+/**
+ * @brief Condition variable for AdaptiveMutex.
+ *
+ * notify_one/notify_all are a single atomic increment when nobody waits. notify_all moves
+ * the waiters straight onto the mutex futex (wait morphing, FUTEX_CMP_REQUEUE) instead of
+ * waking them all only to have them fight for the mutex. Spurious wakeups are possible, as
+ * with any condition variable.
+ */
+class AdaptiveCondVar {
+public:
+    AdaptiveCondVar() = default;
+    AdaptiveCondVar(const AdaptiveCondVar &) = delete;
+    AdaptiveCondVar &operator=(const AdaptiveCondVar &) = delete;
+
+    void notify_one() { Notify(false); }
+    void notify_all() { Notify(true); }
+
+    void wait(std::unique_lock<AdaptiveMutex> &lock) { WaitNs(lock, -1); }
+
+    template <typename Predicate>
+    void wait(std::unique_lock<AdaptiveMutex> &lock, Predicate pred)
+    {
+        while (!pred()) {
+            wait(lock);
+        }
+    }
+
+    template <typename Clock, typename Duration>
+    std::cv_status wait_until(std::unique_lock<AdaptiveMutex> &lock,
+                              const std::chrono::time_point<Clock, Duration> &deadline)
+    {
+        auto remaining = deadline - Clock::now();
+        if (remaining <= Duration::zero()) {
+            return std::cv_status::timeout;
+        }
+        WaitNs(lock, std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count() + 1);
+        return Clock::now() < deadline ? std::cv_status::no_timeout : std::cv_status::timeout;
+    }
+
+    template <typename Clock, typename Duration, typename Predicate>
+    bool wait_until(std::unique_lock<AdaptiveMutex> &lock, const std::chrono::time_point<Clock, Duration> &deadline,
+                    Predicate pred)
+    {
+        while (!pred()) {
+            if (wait_until(lock, deadline) == std::cv_status::timeout) {
+                return pred();
+            }
+        }
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    std::cv_status wait_for(std::unique_lock<AdaptiveMutex> &lock, const std::chrono::duration<Rep, Period> &timeout)
+    {
+        return wait_until(lock, std::chrono::steady_clock::now() + timeout);
+    }
+
+    template <typename Rep, typename Period, typename Predicate>
+    bool wait_for(std::unique_lock<AdaptiveMutex> &lock, const std::chrono::duration<Rep, Period> &timeout,
+                  Predicate pred)
+    {
+        return wait_until(lock, std::chrono::steady_clock::now() + timeout, std::move(pred));
+    }
+
+private:
+    /**
+     * @brief Release the lock, sleep until notified or timeoutNs elapses (-1: no timeout), relock.
+     */
+    void WaitNs(std::unique_lock<AdaptiveMutex> &lock, int64_t timeoutNs);
+    void Notify(bool all);
+
+    std::atomic<uint32_t> seq_{0};
+    std::atomic<uint32_t> waiters_{0};
+    /// @brief Mutex of the current waiters, the requeue target of notify_all.
+    std::atomic<AdaptiveMutex *> mutex_{nullptr};
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_ADAPTIVE_MUTEX_H
@@ -18,10 +18,22 @@
 #include <mutex>
 #include <thread>
 
+#include "flat_hash_map.h"
+#include "profiled_mutex.h"
 #include "thread_pool.h"
 
 namespace lmshao::lmcore {
+namespace coro {
+class SleepAwaiter;
+}
 
+/**
+ * @brief Timer service running callbacks on an internal ThreadPool.
+ *
+ * Registers lmcore_asynctimer_timers_{scheduled,fired,cancelled}_total and
+ * lmcore_asynctimer_lateness_ns (time between the due time and the start of the
+ * callback) in MetricsRegistry.
+ */
 class AsyncTimer {
 public:
     using TimerCallback = std::function<void()>;
@@ -60,6 +72,17 @@ public:
      */
     TimerId ScheduleOnce(const TimerCallback &callback, uint64_t delayMs);
 
+    // Declared only where coro.h defines it, so C++17 code can't reach an undefined symbol
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+    /**
+     * @brief co_await timer.SleepFor(delay) to resume a coroutine on the timer's pool after the delay.
+     * @note Requires C++20 and coro.h, which defines it.
+     */
+    coro::SleepAwaiter SleepFor(Duration delay);
+#endif
+#endif
+
     /**
      * @brief Schedule a repeating timer
      * @param callback The callback function to execute
@@ -150,16 +173,22 @@ private:
     std::atomic<bool> shouldStop_{false};
     std::atomic<TimerId> nextTimerId_{1};
 
-    mutable std::mutex mutex_;
-    std::condition_variable condition_;
+    mutable InternalMutex mutex_ LMCORE_MUTEX_INIT("AsyncTimer");
+    InternalCondVar condition_;
     std::unique_ptr<std::thread> workerThread_;
 
     // Timer storage
     std::multimap<TimePoint, std::shared_ptr<TimerTask>> timerTasks_;
-    std::map<TimerId, std::shared_ptr<TimerTask>> timerMap_; // For quick lookup by ID
+    FlatHashMap<TimerId, std::shared_ptr<TimerTask>> timerMap_; // For quick lookup by ID
 
     // Thread pool for async callback execution
     std::unique_ptr<ThreadPool> threadPool_;
+
+    // Metrics owned by MetricsRegistry
+    Counter *timersScheduled_ = nullptr;
+    Counter *timersFired_ = nullptr;
+    Counter *timersCancelled_ = nullptr;
+    LatencyHistogram *lateness_ = nullptr;
 };
 
 } // namespace lmshao::lmcore
@@ -0,0 +1,131 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_CHANNEL_NOTIFIER_H
+#define LMSHAO_LMCORE_CHANNEL_NOTIFIER_H
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+namespace detail {
+/// @brief Whether a channel receiver supports ChannelNotifier (single-consumer channels do).
+template <typename Receiver, typename = void>
+struct HasChannelNotifier : std::false_type {};
+
+template <typename Receiver>
+struct HasChannelNotifier<Receiver, std::void_t<decltype(std::declval<Receiver &>().ArmNotifier())>>
+    : std::true_type {};
+} // namespace detail
+
+namespace sync {
+
+/**
+ * @brief Pollable readiness signal for a single-consumer channel.
+ *
+ * Exposes a file descriptor (eventfd on Linux, a pipe on other POSIX systems) that becomes
+ * readable when a sender pushes to a channel whose consumer is armed. The consumer arms only
+ * after finding the channel empty, and the first notification disarms it, so a burst of
+ * messages costs one write and one read in total instead of one per message.
+ *
+ * Consumer protocol (see SpscReceiver::ArmNotifier):
+ * @code
+ * for (;;) {
+ *     while (auto msg = rx->TryRecv()) Handle(*msg);
+ *     if (rx->ArmNotifier()) {
+ *         WaitReadable(rx->GetNotifier()->GetFd());   // e.g. epoll_wait
+ *         rx->GetNotifier()->Clear();
+ *     }
+ * }
+ * @endcode
+ *
+ * A consumer that is not a thread, such as a suspended coroutine, installs a waker with
+ * SetWaker() before arming: the notification then calls it instead of touching the descriptor.
+ */
+class ChannelNotifier : public NonCopyable {
+public:
+    using Waker = void (*)(void *context);
+
+    ChannelNotifier();
+    ~ChannelNotifier() override;
+
+    /**
+     * @brief Get the descriptor to poll for readability, -1 if unsupported or creation failed.
+     */
+    int GetFd() const { return readFd_; }
+
+    /**
+     * @brief Producer side: signal the consumer if it is waiting. Call after a successful push.
+     */
+    void Notify()
+    {
+        // Orders the caller's push before reading armed_; pairs with the store in Arm() followed by the
+        // consumer's re-check of the queue, so either we see the consumer armed or it sees our item
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (armed_.load(std::memory_order_relaxed) && armed_.exchange(false, std::memory_order_acq_rel)) {
+            Wake();
+        }
+    }
+
+    /**
+     * @brief Consumer side: request a signal for the next push. Re-check the queue afterwards.
+     */
+    void Arm() { armed_.store(true, std::memory_order_seq_cst); }
+
+    /**
+     * @brief Consumer side: withdraw the request, e.g. when the re-check after Arm() found data.
+     */
+    void Disarm() { armed_.store(false, std::memory_order_relaxed); }
+
+    /**
+     * @brief Consumer side: have the next notification call waker(context), on the producer's thread,
+     * instead of making the descriptor readable. One-shot; install it before Arm().
+     */
+    void SetWaker(Waker waker, void *context)
+    {
+        context_.store(context, std::memory_order_relaxed);
+        waker_.store(waker, std::memory_order_release);
+    }
+
+    /**
+     * @brief Consumer side: withdraw the waker, e.g. when the re-check after Arm() found data.
+     * @return false if a notification took it first: the waker runs or has run
+     */
+    bool ClearWaker() { return waker_.exchange(nullptr, std::memory_order_acq_rel) != nullptr; }
+
+    /**
+     * @brief Make the descriptor readable unconditionally.
+     */
+    void Signal();
+
+    /**
+     * @brief Consume pending signals so the descriptor stops being readable.
+     */
+    void Clear();
+
+private:
+    /// @brief Call the waker if one is installed, signal the descriptor otherwise.
+    void Wake();
+
+    std::atomic<bool> armed_{false};
+    std::atomic<Waker> waker_{nullptr};
+    std::atomic<void *> context_{nullptr};
+    int readFd_ = -1;
+    /// @brief Same as readFd_ for an eventfd
+    int writeFd_ = -1;
+};
+
+} // namespace sync
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_CHANNEL_NOTIFIER_H
@@ -0,0 +1,144 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_CHUNK_READER_H
+#define LMSHAO_LMCORE_CHUNK_READER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+class DataBuffer;
+
+namespace sync {
+template <typename T>
+class SpscSender;
+template <typename T>
+class SpscReceiver;
+template <typename T>
+class MpscSender;
+template <typename T>
+class MpscReceiver;
+} // namespace sync
+
+/**
+ * @brief Reads a stream on its own thread, up to readAhead chunks ahead of the consumer.
+ *
+ * The reader thread fills fixed-size DataBuffer chunks and hands them to the consumer through an
+ * SpscChannel, so the next chunks are read while the current one is processed. Only readAhead
+ * chunks ever exist: a chunk is recycled to the reader through a return channel when its last
+ * reference is released, on whichever thread that happens, and the reader waits for a returned
+ * chunk when all of them are in use. Both sides block on the channels' notifiers rather than spin.
+ *
+ * Every chunk is full except the last one before the end of the stream. Next() is for a single
+ * consumer thread; chunks may be passed on to other threads.
+ *
+ * Usage:
+ * @code
+ * auto reader = ChunkReader::OpenFile("capture.ts", 1024 * 1024, 4);
+ * while (auto chunk = reader->Next()) {
+ *     Parse(chunk->Data(), chunk->Size());
+ * }                                        // chunk released: back to the reader
+ * if (reader->HasError()) { ... }
+ * @endcode
+ */
+class ChunkReader : public NonCopyable {
+public:
+    /// @brief Reads up to `size` bytes into `buffer`; returns the count, 0 at the end, -1 on error.
+    using Source = std::function<int64_t(uint8_t *buffer, size_t size)>;
+
+    static constexpr size_t kDefaultChunkSize = 1024 * 1024;
+    static constexpr size_t kDefaultReadAhead = 4;
+
+    struct Stats {
+        uint64_t bytes = 0;
+        uint64_t chunks = 0;
+        /// @brief Times the reader found every chunk in use: the consumer is the bottleneck
+        uint64_t readerWaits = 0;
+        /// @brief Times Next() found no chunk ready: the source is the bottleneck
+        uint64_t consumerWaits = 0;
+    };
+
+    /**
+     * @brief Constructor. Starts the reader thread.
+     * @param source Called on the reader thread only
+     * @param chunkSize Size of each chunk
+     * @param readAhead Number of chunks, i.e. how far the reader may run ahead of the consumer
+     */
+    explicit ChunkReader(Source source, size_t chunkSize = kDefaultChunkSize, size_t readAhead = kDefaultReadAhead);
+    ~ChunkReader() override;
+
+    /**
+     * @brief Open a file and start reading it.
+     * @return The reader, or nullptr if the file can't be opened
+     */
+    static std::unique_ptr<ChunkReader> OpenFile(const std::string &path, size_t chunkSize = kDefaultChunkSize,
+                                                 size_t readAhead = kDefaultReadAhead);
+
+    /**
+     * @brief Get the next chunk, waiting for the reader if needed.
+     * @return The chunk, or nullptr at the end of the stream, on a read error or after Stop()
+     */
+    std::shared_ptr<DataBuffer> Next();
+
+    /**
+     * @brief Get the next chunk if one is ready.
+     * @return The chunk, or nullptr if none is ready yet or the stream is over (see IsFinished())
+     */
+    std::shared_ptr<DataBuffer> TryNext();
+
+    /**
+     * @brief Check whether every chunk has been handed out and the reader is done.
+     */
+    bool IsFinished() const;
+
+    /**
+     * @brief Stop reading and join the reader thread. Chunks already handed out stay valid.
+     */
+    void Stop();
+
+    bool HasError() const { return error_.load(std::memory_order_acquire); }
+    size_t GetChunkSize() const { return chunkSize_; }
+    size_t GetReadAhead() const { return readAhead_; }
+    Stats GetStats() const;
+
+private:
+    void ReadLoop();
+    /// @brief Take a free chunk, allocating one while fewer than readAhead_ exist; nullptr on Stop().
+    std::unique_ptr<DataBuffer> AcquireChunk();
+
+    Source source_;
+    const size_t chunkSize_;
+    const size_t readAhead_;
+    size_t allocated_ = 0;
+
+    std::unique_ptr<sync::SpscSender<std::shared_ptr<DataBuffer>>> readyTx_;
+    std::unique_ptr<sync::SpscReceiver<std::shared_ptr<DataBuffer>>> readyRx_;
+    std::shared_ptr<sync::MpscSender<std::unique_ptr<DataBuffer>>> freeTx_;
+    std::unique_ptr<sync::MpscReceiver<std::unique_ptr<DataBuffer>>> freeRx_;
+
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> error_{false};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> chunks_{0};
+    std::atomic<uint64_t> readerWaits_{0};
+    std::atomic<uint64_t> consumerWaits_{0};
+    std::thread thread_;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_CHUNK_READER_H
@@ -14,6 +14,8 @@
 #include <optional>
 #include <vector>
 
+#include "profiled_mutex.h"
+
 namespace lmshao::lmcore {
 
 template <typename T>
@@ -26,7 +28,7 @@ public:
 
     void Push(const T &value)
     {
-        std::unique_lock<std::mutex> lock(mutex_);
+        std::unique_lock<InternalMutex> lock(mutex_);
         not_full_.wait(lock, [this] { return size_ < capacity_; });
 
         buffer_[tail_] = value;
@@ -38,7 +40,7 @@ public:
 
     void Push(T &&value)
     {
-        std::unique_lock<std::mutex> lock(mutex_);
+        std::unique_lock<InternalMutex> lock(mutex_);
         not_full_.wait(lock, [this] { return size_ < capacity_; });
 
         buffer_[tail_] = std::move(value);
@@ -50,7 +52,7 @@ public:
 
     bool TryPush(const T &value)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         if (size_ >= capacity_) {
             return false;
         }
@@ -65,7 +67,7 @@ public:
 
     bool TryPush(T &&value)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         if (size_ >= capacity_) {
             return false;
         }
@@ -80,7 +82,7 @@ public:
 
     bool ForcePush(const T &value)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         bool overwrote = (size_ >= capacity_);
 
         if (overwrote) {
@@ -98,7 +100,7 @@ public:
 
     bool ForcePush(T &&value)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         bool overwrote = (size_ >= capacity_);
 
         if (overwrote) {
@@ -116,7 +118,7 @@ public:
 
     T Pop()
     {
-        std::unique_lock<std::mutex> lock(mutex_);
+        std::unique_lock<InternalMutex> lock(mutex_);
         not_empty_.wait(lock, [this] { return size_ > 0; });
 
         T result = std::move(buffer_[head_]);
@@ -129,7 +131,7 @@ public:
 
     std::optional<T> TryPop()
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         if (size_ == 0) {
             return std::nullopt;
         }
@@ -144,31 +146,31 @@ public:
 
     size_t Capacity() const
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         return capacity_;
     }
 
     size_t Size() const
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         return size_;
     }
 
     bool Empty() const
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         return size_ == 0;
     }
 
     bool Full() const
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         return size_ == capacity_;
     }
 
     void Clear()
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         head_ = 0;
         tail_ = 0;
         size_ = 0;
@@ -176,9 +178,9 @@ public:
     }
 
 private:
-    mutable std::mutex mutex_;
-    std::condition_variable not_full_;
-    std::condition_variable not_empty_;
+    mutable InternalMutex mutex_ LMCORE_MUTEX_INIT("CircularQueue");
+    InternalCondVar not_full_;
+    InternalCondVar not_empty_;
 
     size_t capacity_;
     std::vector<T> buffer_;
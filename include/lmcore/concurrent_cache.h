@@ -0,0 +1,449 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_CONCURRENT_CACHE_H
+#define LMSHAO_LMCORE_CONCURRENT_CACHE_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "metrics.h"
+#include "noncopyable.h"
+#include "profiled_mutex.h"
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief Thread-safe, sharded cache with CLOCK eviction, weighted capacity and optional TTL.
+ *
+ * Keys are spread over a power-of-two number of shards, each with its own lock, so threads
+ * working on different keys rarely meet. A hit only sets the entry's reference bit: unlike LRU
+ * there is no list to relink, which keeps the critical section to a probe and a copy of the
+ * value. When a shard is over its share of the capacity, a clock hand sweeps its entries,
+ * giving referenced ones a second chance and evicting the rest.
+ *
+ * Each shard indexes its entries with an open-addressing table of 8-byte buckets (hash and
+ * entry index, eight per cache line), probed linearly and kept at most half full; deletion
+ * shifts followers back instead of leaving tombstones.
+ *
+ * Capacity is measured by a weigher, one unit per entry by default. Values are returned by
+ * copy, so store large or shared payloads as shared pointers; a shared_ptr<DataBuffer> from a
+ * DataBufferPool goes back to its pool when the last copy, cached or not, is released.
+ * Value destructors run under the shard lock and must not call back into the cache.
+ *
+ * Registers lmcore_cache_requests_total{result=hit|miss} and
+ * lmcore_cache_evictions_total{reason=capacity|expired}, labelled with the cache name.
+ *
+ * Usage:
+ * @code
+ * ConcurrentCache<std::string, std::shared_ptr<DataBuffer>> segments(
+ *     64 << 20, [](const std::string &, const std::shared_ptr<DataBuffer> &buf) { return buf->Capacity(); });
+ * segments.Put(url, buffer, std::chrono::seconds(30));
+ * if (auto hit = segments.Get(url)) {
+ *     Send(*hit);
+ * }
+ * @endcode
+ *
+ * @tparam K Key type
+ * @tparam V Value type, copyable
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class ConcurrentCache : public NonCopyable {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Weigher = std::function<size_t(const K &key, const V &value)>;
+
+    /// @brief Default number of shards.
+    static constexpr size_t kDefaultShards = 16;
+
+    /**
+     * @brief Constructor
+     * @param capacity Total weight the cache may hold, split evenly among shards
+     * @param weigher Weight of an entry (optional, defaults to 1 per entry)
+     * @param shardCount Number of shards, rounded up to a power of two
+     * @param defaultTtl Lifetime of entries put without their own TTL (zero: no expiry)
+     * @param name Cache name used as the "cache" label of its metrics
+     */
+    explicit ConcurrentCache(size_t capacity, Weigher weigher = nullptr, size_t shardCount = kDefaultShards,
+                             Clock::duration defaultTtl = Clock::duration::zero(), const std::string &name = "cache")
+        : weigher_(std::move(weigher)), defaultTtl_(defaultTtl)
+    {
+        size_t shards = 1;
+        while (shards < shardCount) {
+            shards <<= 1;
+        }
+        shardMask_ = shards - 1;
+        shardCapacity_ = capacity == 0 ? 0 : (capacity + shards - 1) / shards;
+        shards_ = std::make_unique<Shard[]>(shards);
+
+        auto &registry = MetricsRegistry::GetInstance();
+        const char *requests = "lmcore_cache_requests_total";
+        const char *evictions = "lmcore_cache_evictions_total";
+        hits_ = &registry.GetCounter(requests, {{"cache", name}, {"result", "hit"}}, "ConcurrentCache lookups");
+        misses_ = &registry.GetCounter(requests, {{"cache", name}, {"result", "miss"}});
+        evicted_ = &registry.GetCounter(evictions, {{"cache", name}, {"reason", "capacity"}},
+                                        "ConcurrentCache entries removed by the cache");
+        expired_ = &registry.GetCounter(evictions, {{"cache", name}, {"reason", "expired"}});
+    }
+
+    ~ConcurrentCache() override = default;
+
+    /**
+     * @brief Look up a key and mark it recently used.
+     * @return A copy of the value, or std::nullopt if absent or expired
+     */
+    std::optional<V> Get(const K &key)
+    {
+        uint64_t hash = HashOf(key);
+        Shard &shard = ShardFor(hash);
+        std::lock_guard<InternalMutex> lock(shard.mutex);
+        size_t pos = FindBucket(shard, key, static_cast<uint32_t>(hash));
+        if (pos != kNotFound) {
+            Entry &entry = shard.entries[shard.buckets[pos].entry];
+            // Entries without a TTL skip the clock read
+            if (entry.expires == TimePoint::max() || !HasExpired(entry, Clock::now())) {
+                entry.referenced = true;
+                hits_->Increment();
+                return entry.item->value;
+            }
+            RemoveAt(shard, pos);
+            expired_->Increment();
+        }
+        misses_->Increment();
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Check if a live entry exists, without marking it used.
+     */
+    bool Contains(const K &key) const
+    {
+        uint64_t hash = HashOf(key);
+        Shard &shard = ShardFor(hash);
+        std::lock_guard<InternalMutex> lock(shard.mutex);
+        size_t pos = FindBucket(shard, key, static_cast<uint32_t>(hash));
+        return pos != kNotFound && !HasExpired(shard.entries[shard.buckets[pos].entry], Clock::now());
+    }
+
+    /**
+     * @brief Insert or replace an entry, evicting others from its shard as needed.
+     * @param ttl Lifetime of the entry; zero uses the cache's default TTL
+     * @return false if the entry alone outweighs a shard's capacity (any old entry is removed)
+     */
+    bool Put(const K &key, V value, Clock::duration ttl = Clock::duration::zero())
+    {
+        size_t weight = weigher_ ? weigher_(key, value) : 1;
+        if (ttl <= Clock::duration::zero()) {
+            ttl = defaultTtl_;
+        }
+        TimePoint now = Clock::now();
+        TimePoint expires = ttl > Clock::duration::zero() ? now + ttl : TimePoint::max();
+
+        uint64_t hash = HashOf(key);
+        Shard &shard = ShardFor(hash);
+        std::lock_guard<InternalMutex> lock(shard.mutex);
+        size_t pos = FindBucket(shard, key, static_cast<uint32_t>(hash));
+        if (pos != kNotFound) {
+            RemoveAt(shard, pos);
+        }
+        if (weight > shardCapacity_) {
+            return false;
+        }
+        MakeRoom(shard, weight, now);
+
+        uint32_t index;
+        if (!shard.freeEntries.empty()) {
+            index = shard.freeEntries.back();
+            shard.freeEntries.pop_back();
+        } else {
+            index = static_cast<uint32_t>(shard.entries.size());
+            shard.entries.emplace_back();
+        }
+        Entry &entry = shard.entries[index];
+        entry.item.emplace(Item{key, std::move(value)});
+        entry.expires = expires;
+        entry.weight = weight;
+        entry.hash = static_cast<uint32_t>(hash);
+        entry.referenced = false;
+        InsertBucket(shard, entry.hash, index);
+        shard.weight += weight;
+        return true;
+    }
+
+    /**
+     * @brief Remove an entry.
+     * @return true if it was present (expired or not)
+     */
+    bool Erase(const K &key)
+    {
+        uint64_t hash = HashOf(key);
+        Shard &shard = ShardFor(hash);
+        std::lock_guard<InternalMutex> lock(shard.mutex);
+        size_t pos = FindBucket(shard, key, static_cast<uint32_t>(hash));
+        if (pos == kNotFound) {
+            return false;
+        }
+        RemoveAt(shard, pos);
+        return true;
+    }
+
+    /**
+     * @brief Remove every entry.
+     */
+    void Clear()
+    {
+        for (size_t i = 0; i <= shardMask_; ++i) {
+            Shard &shard = shards_[i];
+            std::lock_guard<InternalMutex> lock(shard.mutex);
+            shard.buckets.clear();
+            shard.entries.clear();
+            shard.freeEntries.clear();
+            shard.count = 0;
+            shard.weight = 0;
+            shard.hand = 0;
+        }
+    }
+
+    /**
+     * @brief Remove expired entries from every shard; otherwise they go when looked up or swept.
+     * @return Number of entries removed
+     */
+    size_t PurgeExpired()
+    {
+        size_t removed = 0;
+        TimePoint now = Clock::now();
+        for (size_t i = 0; i <= shardMask_; ++i) {
+            Shard &shard = shards_[i];
+            std::lock_guard<InternalMutex> lock(shard.mutex);
+            for (uint32_t index = 0; index < shard.entries.size(); ++index) {
+                if (shard.entries[index].item && HasExpired(shard.entries[index], now)) {
+                    RemoveAt(shard, FindEntryBucket(shard, index));
+                    ++removed;
+                }
+            }
+        }
+        expired_->Increment(removed);
+        return removed;
+    }
+
+    /**
+     * @brief Get the number of entries, including expired ones not yet removed.
+     */
+    size_t GetSize() const
+    {
+        size_t total = 0;
+        for (size_t i = 0; i <= shardMask_; ++i) {
+            std::lock_guard<InternalMutex> lock(shards_[i].mutex);
+            total += shards_[i].count;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Get the total weight of the entries.
+     */
+    size_t GetWeight() const
+    {
+        size_t total = 0;
+        for (size_t i = 0; i <= shardMask_; ++i) {
+            std::lock_guard<InternalMutex> lock(shards_[i].mutex);
+            total += shards_[i].weight;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Get the capacity, as rounded to whole shards.
+     */
+    size_t GetCapacity() const { return shardCapacity_ * (shardMask_ + 1); }
+
+    /**
+     * @brief Get the number of shards.
+     */
+    size_t GetShardCount() const { return shardMask_ + 1; }
+
+private:
+    using TimePoint = Clock::time_point;
+
+    static constexpr uint32_t kEmptyBucket = UINT32_MAX;
+    static constexpr size_t kNotFound = SIZE_MAX;
+    static constexpr size_t kMinBuckets = 16;
+
+    struct Bucket {
+        uint32_t hash;
+        /// @brief Index into Shard::entries, kEmptyBucket if unused
+        uint32_t entry;
+    };
+
+    struct Item {
+        K key;
+        V value;
+    };
+
+    struct Entry {
+        /// @brief Empty while the slot is on the free list
+        std::optional<Item> item;
+        TimePoint expires;
+        size_t weight = 0;
+        uint32_t hash = 0;
+        /// @brief CLOCK reference bit, set by hits and cleared by the sweeping hand
+        bool referenced = false;
+    };
+
+    struct alignas(64) Shard {
+        mutable InternalMutex mutex LMCORE_MUTEX_INIT("ConcurrentCache");
+        /// @brief Power-of-two open-addressing table, at most half full
+        std::vector<Bucket> buckets;
+        std::vector<Entry> entries;
+        std::vector<uint32_t> freeEntries;
+        size_t count = 0;
+        size_t weight = 0;
+        /// @brief CLOCK hand, an index into entries
+        size_t hand = 0;
+    };
+
+    uint64_t HashOf(const K &key) const
+    {
+        // Finalize the std::hash value: it is often the identity for integers
+        uint64_t h = static_cast<uint64_t>(hasher_(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    /// @brief The high half picks the shard, the low half the bucket.
+    Shard &ShardFor(uint64_t hash) const { return shards_[(hash >> 32) & shardMask_]; }
+
+    static bool HasExpired(const Entry &entry, TimePoint now) { return now >= entry.expires; }
+
+    size_t FindBucket(const Shard &shard, const K &key, uint32_t hash) const
+    {
+        if (shard.buckets.empty()) {
+            return kNotFound;
+        }
+        size_t mask = shard.buckets.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const Bucket &bucket = shard.buckets[i];
+            if (bucket.entry == kEmptyBucket) {
+                return kNotFound;
+            }
+            if (bucket.hash == hash && equal_(shard.entries[bucket.entry].item->key, key)) {
+                return i;
+            }
+        }
+    }
+
+    static size_t FindEntryBucket(const Shard &shard, uint32_t index)
+    {
+        size_t mask = shard.buckets.size() - 1;
+        size_t i = shard.entries[index].hash & mask;
+        while (shard.buckets[i].entry != index) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    static void InsertBucket(Shard &shard, uint32_t hash, uint32_t index)
+    {
+        if ((shard.count + 1) * 2 > shard.buckets.size()) {
+            std::vector<Bucket> old(std::max(kMinBuckets, shard.buckets.size() * 2), Bucket{0, kEmptyBucket});
+            old.swap(shard.buckets);
+            size_t mask = shard.buckets.size() - 1;
+            for (const Bucket &bucket : old) {
+                if (bucket.entry != kEmptyBucket) {
+                    size_t i = bucket.hash & mask;
+                    while (shard.buckets[i].entry != kEmptyBucket) {
+                        i = (i + 1) & mask;
+                    }
+                    shard.buckets[i] = bucket;
+                }
+            }
+        }
+        size_t mask = shard.buckets.size() - 1;
+        size_t i = hash & mask;
+        while (shard.buckets[i].entry != kEmptyBucket) {
+            i = (i + 1) & mask;
+        }
+        shard.buckets[i] = Bucket{hash, index};
+        ++shard.count;
+    }
+
+    /// @brief Remove the entry of a bucket, then shift later buckets of the probe run back.
+    static void RemoveAt(Shard &shard, size_t pos)
+    {
+        uint32_t index = shard.buckets[pos].entry;
+        Entry &entry = shard.entries[index];
+        entry.item.reset();
+        shard.weight -= entry.weight;
+        shard.freeEntries.push_back(index);
+        --shard.count;
+
+        size_t mask = shard.buckets.size() - 1;
+        size_t hole = pos;
+        for (size_t i = (hole + 1) & mask; shard.buckets[i].entry != kEmptyBucket; i = (i + 1) & mask) {
+            size_t home = shard.buckets[i].hash & mask;
+            // Move it only if the hole lies on its probe path
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                shard.buckets[hole] = shard.buckets[i];
+                hole = i;
+            }
+        }
+        shard.buckets[hole].entry = kEmptyBucket;
+    }
+
+    /// @brief Sweep the clock hand until `incoming` more weight fits in the shard.
+    void MakeRoom(Shard &shard, size_t incoming, TimePoint now)
+    {
+        while (shard.count > 0 && shard.weight + incoming > shardCapacity_) {
+            if (shard.hand >= shard.entries.size()) {
+                shard.hand = 0;
+            }
+            uint32_t index = static_cast<uint32_t>(shard.hand++);
+            Entry &entry = shard.entries[index];
+            if (!entry.item) {
+                continue;
+            }
+            bool expired = HasExpired(entry, now);
+            if (entry.referenced && !expired) {
+                entry.referenced = false;
+                continue;
+            }
+            RemoveAt(shard, FindEntryBucket(shard, index));
+            (expired ? expired_ : evicted_)->Increment();
+        }
+    }
+
+    Hash hasher_;
+    KeyEqual equal_;
+    Weigher weigher_;
+    Clock::duration defaultTtl_;
+    size_t shardMask_ = 0;
+    size_t shardCapacity_ = 0;
+    std::unique_ptr<Shard[]> shards_;
+
+    Counter *hits_;
+    Counter *misses_;
+    Counter *evicted_;
+    Counter *expired_;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_CONCURRENT_CACHE_H
@@ -0,0 +1,505 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_CORO_H
+#define LMSHAO_LMCORE_CORO_H
+
+// C++20 coroutine support. The library itself stays C++17: this header is self-contained and
+// compiles to nothing unless the including translation unit has coroutines enabled. thread_pool.h
+// and async_timer.h declare Schedule() and SleepFor() under the same condition.
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define LMCORE_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifdef LMCORE_HAS_COROUTINES
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "async_timer.h"
+#include "channel_notifier.h"
+#include "recycling_allocator.h"
+#include "thread_pool.h"
+
+namespace lmshao::lmcore::coro {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/// @brief Frames come from the per-thread recycling free lists instead of the general heap.
+struct FrameAllocation {
+    static void *operator new(size_t size) { return lmcore::detail::RecyclingAllocate(size); }
+    static void operator delete(void *ptr, size_t size) { lmcore::detail::RecyclingDeallocate(ptr, size); }
+};
+
+struct PromiseBase : FrameAllocation {
+    /// @brief Resumes whoever awaited the task by symmetric transfer. Deep chains keep a flat stack only
+    /// where the compiler emits that transfer as a tail call, which optimized builds do.
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            std::coroutine_handle<> continuation = handle.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+    void RethrowIfFailed()
+    {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    std::coroutine_handle<> continuation;
+    std::exception_ptr exception;
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U &&value)
+    {
+        result.emplace(std::forward<U>(value));
+    }
+
+    T Result()
+    {
+        RethrowIfFailed();
+        return std::move(*result);
+    }
+
+    std::optional<T> result;
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+    void Result() { RethrowIfFailed(); }
+};
+
+/// @brief Eagerly started, self-destroying coroutine used to launch tasks from non-coroutine code.
+struct Detached {
+    struct promise_type : FrameAllocation {
+        Detached get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine producing a T.
+ *
+ * The body runs when the task is awaited, and the awaiting coroutine resumes directly when it
+ * finishes (symmetric transfer). Exceptions propagate to the awaiter. Use Spawn() or SyncWait()
+ * to start a task from ordinary code.
+ *
+ * Usage:
+ * @code
+ * coro::Task<int> Fetch(ThreadPool &pool, AsyncTimer &timer)
+ * {
+ *     co_await pool.Schedule();                          // continue on a worker
+ *     co_await timer.SleepFor(std::chrono::milliseconds(10));
+ *     co_return 42;
+ * }
+ * int value = coro::SyncWait(Fetch(pool, timer));
+ * @endcode
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() noexcept = default;
+    Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task &operator=(Task &&other) noexcept
+    {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+    ~Task()
+    {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    /**
+     * @brief Check if the body has run to completion.
+     */
+    bool IsDone() const noexcept { return !handle_ || handle_.done(); }
+
+    // An empty task (default-constructed or moved from) is ready, and awaiting it throws
+    bool await_ready() const noexcept { return IsDone(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle_.promise().continuation = awaiting;
+        return handle_;
+    }
+    T await_resume()
+    {
+        if (!handle_) {
+            throw std::logic_error("co_await on an empty Task");
+        }
+        return handle_.promise().Result();
+    }
+
+private:
+    friend promise_type;
+    explicit Task(Handle handle) noexcept : handle_(handle) {}
+
+    Handle handle_;
+};
+
+namespace detail {
+template <typename T>
+Task<T> Promise<T>::get_return_object() noexcept
+{
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept
+{
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+inline Detached RunDetached(Task<void> task)
+{
+    co_await task;
+}
+
+template <typename T>
+struct SyncWaitState {
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool done = false;
+    std::conditional_t<std::is_void_v<T>, bool, std::optional<T>> result{};
+    std::exception_ptr exception;
+};
+
+template <typename T>
+Detached RunSyncWait(Task<T> &task, SyncWaitState<T> &state)
+{
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await task;
+        } else {
+            state.result.emplace(co_await task);
+        }
+    } catch (...) {
+        state.exception = std::current_exception();
+    }
+    // Notify under the lock: the waiter destroys the state as soon as it sees done
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.done = true;
+    state.cond.notify_one();
+}
+} // namespace detail
+
+/**
+ * @brief Start a task without waiting for it; it runs on the calling thread until it first suspends.
+ * @note An exception escaping the task terminates the process.
+ */
+inline void Spawn(Task<void> task)
+{
+    detail::RunDetached(std::move(task));
+}
+
+/**
+ * @brief Run a task and block the calling thread until it completes.
+ * @return The task's result; its exception is rethrown here
+ */
+template <typename T>
+T SyncWait(Task<T> task)
+{
+    detail::SyncWaitState<T> state;
+    detail::RunSyncWait(task, state);
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.cond.wait(lock, [&state]() { return state.done; });
+    if (state.exception) {
+        std::rethrow_exception(state.exception);
+    }
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*state.result);
+    }
+}
+
+/**
+ * @brief Awaitable returned by ThreadPool::Schedule(): resumes the coroutine on a pool worker.
+ *
+ * If the pool is shutting down and rejects the task, the coroutine continues on the calling thread.
+ */
+class ScheduleAwaiter {
+public:
+    explicit ScheduleAwaiter(ThreadPool &pool) : pool_(pool) {}
+
+    bool await_ready() const noexcept { return false; }
+    // The lambda holds only the handle, which fits std::function's inline storage: no allocation
+    bool await_suspend(std::coroutine_handle<> handle) { return pool_.AddTask([handle]() { handle.resume(); }); }
+    void await_resume() const noexcept {}
+
+private:
+    ThreadPool &pool_;
+};
+
+/**
+ * @brief Awaitable returned by AsyncTimer::SleepFor(): resumes the coroutine on the timer's pool.
+ *
+ * Resumes immediately if the delay is zero or the timer is not running.
+ */
+class SleepAwaiter {
+public:
+    SleepAwaiter(AsyncTimer &timer, AsyncTimer::Duration delay) : timer_(timer), delay_(delay) {}
+
+    bool await_ready() const noexcept { return delay_.count() <= 0; }
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        auto delayMs = static_cast<uint64_t>(delay_.count());
+        return timer_.ScheduleOnce([handle]() { handle.resume(); }, delayMs) != 0;
+    }
+    void await_resume() const noexcept {}
+
+private:
+    AsyncTimer &timer_;
+    AsyncTimer::Duration delay_;
+};
+
+namespace detail {
+/// @brief Pause before the next poll of a channel without a notifier: free at first, then up to 1 ms.
+inline void PollBackoff(unsigned attempt)
+{
+    constexpr unsigned kYields = 16;
+    if (attempt == 0) {
+        return;
+    }
+    if (attempt < kYields) {
+        std::this_thread::yield();
+        return;
+    }
+    unsigned shift = attempt - kYields < 10 ? attempt - kYields : 10;
+    std::this_thread::sleep_for(std::chrono::microseconds(1u << shift));
+}
+} // namespace detail
+
+/**
+ * @brief Awaitable receive from any lmcore channel receiver.
+ *
+ * While the channel is empty, the coroutine parks on the channel's ChannelNotifier and the next
+ * send or Close() schedules it back on the pool: an idle channel costs nothing. Channels created
+ * without a notifier (and multi-consumer channels, which have none) are re-polled from pool
+ * tasks instead, backing off to one poll per millisecond while they stay empty.
+ */
+template <typename Receiver>
+class RecvAwaiter {
+public:
+    using Value = decltype(std::declval<Receiver &>().TryRecv());
+
+    RecvAwaiter(Receiver &receiver, ThreadPool &pool) : receiver_(receiver), pool_(pool) {}
+
+    bool await_ready() { return TryComplete(); }
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+        return Park();
+    }
+    /// @return The value, or std::nullopt once the channel is closed and drained or the pool shuts down
+    Value await_resume() { return std::move(value_); }
+
+private:
+    bool TryComplete()
+    {
+        value_ = receiver_.TryRecv();
+        if (!value_ && receiver_.IsClosed()) {
+            // A value may have been sent just before closing
+            value_ = receiver_.TryRecv();
+            return true;
+        }
+        return value_.has_value();
+    }
+
+    sync::ChannelNotifier *GetNotifier() const
+    {
+        if constexpr (lmcore::detail::HasChannelNotifier<Receiver>::value) {
+            return receiver_.GetNotifier();
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Wait for a value without holding a thread.
+     * @return true if the coroutine stays suspended until something resumes it, false to resume it now.
+     * Once a wake-up is scheduled the awaiter may be resumed and destroyed at any time, so nothing
+     * touches it after that.
+     */
+    bool Park()
+    {
+        for (;;) {
+            if (TryComplete()) {
+                return false;
+            }
+            sync::ChannelNotifier *notifier = GetNotifier();
+            if (!notifier) {
+                detail::PollBackoff(polls_++);
+                // A pool that is shutting down gives up the wait: resume now, as if the channel were closed
+                return pool_.AddTask([this]() { Retry(); });
+            }
+            notifier->SetWaker(&RecvAwaiter::Wake, this);
+            if (receiver_.ArmNotifier()) {
+                return true;
+            }
+            // A value or the closure arrived meanwhile; unless a notification already took the waker, look again
+            if (!notifier->ClearWaker()) {
+                return true;
+            }
+        }
+    }
+
+    void Retry()
+    {
+        if (!Park()) {
+            handle_.resume();
+        }
+    }
+
+    /// @brief Called by the notifier on the sending thread.
+    static void Wake(void *context)
+    {
+        auto *self = static_cast<RecvAwaiter *>(context);
+        if (!self->pool_.AddTask([self]() { self->Retry(); })) {
+            self->handle_.resume();
+        }
+    }
+
+    Receiver &receiver_;
+    ThreadPool &pool_;
+    std::coroutine_handle<> handle_;
+    Value value_;
+    unsigned polls_ = 0;
+};
+
+/**
+ * @brief Awaitable send to any lmcore channel sender.
+ *
+ * Senders have no notifier, so while the channel is full the awaiter re-polls it from pool tasks,
+ * backing off to one attempt per millisecond. The value is moved into the channel once, by the
+ * attempt that succeeds, so T only needs to be movable.
+ */
+template <typename Sender, typename T>
+class SendAwaiter {
+public:
+    SendAwaiter(Sender &sender, T value, ThreadPool &pool) : sender_(sender), pool_(pool), value_(std::move(value)) {}
+
+    bool await_ready() { return TryComplete(); }
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+        // A pool that is shutting down gives up the wait: resume now, as if the channel were closed
+        return pool_.AddTask([this]() { Retry(); });
+    }
+    /// @return true if sent, false if the channel was closed or the pool shuts down
+    bool await_resume() const noexcept { return sent_; }
+
+private:
+    bool TryComplete()
+    {
+        // TrySend() leaves value_ alone when the channel is full
+        sent_ = sender_.TrySend(std::move(value_));
+        return sent_ || sender_.IsClosed();
+    }
+
+    void Retry()
+    {
+        if (TryComplete()) {
+            handle_.resume();
+            return;
+        }
+        detail::PollBackoff(++polls_);
+        if (!pool_.AddTask([this]() { Retry(); })) {
+            handle_.resume();
+        }
+    }
+
+    Sender &sender_;
+    ThreadPool &pool_;
+    std::coroutine_handle<> handle_;
+    T value_;
+    bool sent_ = false;
+    unsigned polls_ = 0;
+};
+
+/**
+ * @brief co_await Recv(*rx, pool): receive without blocking a thread.
+ */
+template <typename Receiver>
+RecvAwaiter<Receiver> Recv(Receiver &receiver, ThreadPool &pool)
+{
+    return RecvAwaiter<Receiver>(receiver, pool);
+}
+
+/**
+ * @brief co_await Send(*tx, value, pool): send without blocking a thread.
+ */
+template <typename Sender, typename T>
+SendAwaiter<Sender, std::decay_t<T>> Send(Sender &sender, T &&value, ThreadPool &pool)
+{
+    return SendAwaiter<Sender, std::decay_t<T>>(sender, std::forward<T>(value), pool);
+}
+
+} // namespace lmshao::lmcore::coro
+
+namespace lmshao::lmcore {
+
+inline coro::ScheduleAwaiter ThreadPool::Schedule()
+{
+    return coro::ScheduleAwaiter(*this);
+}
+
+inline coro::SleepAwaiter AsyncTimer::SleepFor(Duration delay)
+{
+    return coro::SleepAwaiter(*this, delay);
+}
+
+} // namespace lmshao::lmcore
+
+#endif // LMCORE_HAS_COROUTINES
+
+#endif // LMSHAO_LMCORE_CORO_H
@@ -0,0 +1,121 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_CPU_FEATURES_H
+#define LMSHAO_LMCORE_CPU_FEATURES_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief Instruction set extensions of the running CPU
+ *
+ * Detected once on first use: CPUID and XGETBV on x86 (AVX/AVX-512 also require the
+ * OS to save the wider registers), getauxval(AT_HWCAP) on Linux/Android AArch64.
+ *
+ * Setting the environment variable LMCORE_NO_SIMD to a non-empty value other than "0"
+ * reports no optional features, which forces every dispatched kernel onto its
+ * portable implementation.
+ *
+ * Example usage:
+ * @code
+ *   if (CpuFeatures::Get().Has(CpuFeatures::kAvx2)) {
+ *       ...
+ *   }
+ *   printf("%s\n", CpuFeatures::Get().ToString().c_str());
+ * @endcode
+ */
+class CpuFeatures {
+public:
+    /**
+     * @brief Feature bits, may be or-ed together.
+     */
+    enum Feature : uint32_t {
+        kSse2 = 1u << 0,
+        kSsse3 = 1u << 1,
+        kSse41 = 1u << 2,
+        kSse42 = 1u << 3,
+        kPclmul = 1u << 4,
+        kAvx = 1u << 5,
+        kAvx2 = 1u << 6,
+        kBmi2 = 1u << 7,
+        kAvx512F = 1u << 8,
+        kAvx512BW = 1u << 9,
+        kNeon = 1u << 16,
+        kArmCrc32 = 1u << 17,
+        kArmPmull = 1u << 18
+    };
+
+    /**
+     * @brief Get the features of the running CPU.
+     */
+    static const CpuFeatures &Get();
+
+    /**
+     * @brief Check for a set of features.
+     * @param features One or more Feature bits
+     * @return true if all of them are available
+     */
+    bool Has(uint32_t features) const { return (mask_ & features) == features; }
+
+    /**
+     * @brief Get all available features as a bit mask.
+     */
+    uint32_t Mask() const { return mask_; }
+
+    /**
+     * @brief List the available features, e.g. "sse2 ssse3 sse4.1 pclmul avx2".
+     */
+    std::string ToString() const;
+
+private:
+    CpuFeatures();
+
+    uint32_t mask_ = 0;
+};
+
+/**
+ * @brief A kernel implementation and the CPU features it needs.
+ * @tparam Fn Function pointer type
+ */
+template <typename Fn>
+struct KernelVariant {
+    /// @brief Feature bits required by the kernel.
+    uint32_t required;
+    /// @brief The kernel.
+    Fn kernel;
+};
+
+/**
+ * @brief Pick the first kernel whose required features are all available.
+ *
+ * Intended to initialize a function-local static, so the choice is made once:
+ * @code
+ *   static const auto kernel = SelectKernel<Fn>({{CpuFeatures::kAvx2, FooAvx2}}, FooGeneric);
+ * @endcode
+ * @param variants Candidates, best first
+ * @param fallback Portable kernel used when no candidate is supported
+ */
+template <typename Fn>
+Fn SelectKernel(std::initializer_list<KernelVariant<Fn>> variants, Fn fallback)
+{
+    const CpuFeatures &features = CpuFeatures::Get();
+    for (const auto &variant : variants) {
+        if (variant.kernel != nullptr && features.Has(variant.required)) {
+            return variant.kernel;
+        }
+    }
+    return fallback;
+}
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_CPU_FEATURES_H
@@ -26,7 +26,8 @@ namespace lmshao::lmcore {
  * - Network protocols
  *
  * Features:
- * - Fast computation using lookup table
+ * - Fast computation: slicing-by-8 tables, or PCLMULQDQ / ARMv8 CRC32 instructions
+ *   when the CPU supports them (see CpuFeatures)
  * - Detects common transmission errors
  * - Supports incremental calculation for large files
  *
@@ -70,6 +71,21 @@ public:
      */
     static uint32_t Calculate(const std::string &data);
 
+    /**
+     * @brief Combine the checksums of two consecutive blocks into the checksum of both
+     * @param crc1 CRC32 of the first block
+     * @param crc2 CRC32 of the second block
+     * @param len2 Length of the second block in bytes
+     * @return CRC32 of the first block followed by the second
+     *
+     * Runs in O(log len2), so blocks can be checksummed in parallel and combined afterwards:
+     * @code
+     *   uint32_t crc = CRC32::Combine(CRC32::Calculate(a, lenA), CRC32::Calculate(b, lenB), lenB);
+     *   // Same as CRC32 of a followed by b
+     * @endcode
+     */
+    static uint32_t Combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
+
     /**
      * @brief Context for incremental CRC32 calculation
      *
@@ -130,10 +146,7 @@ public:
     };
 
 private:
-    static void InitTable();
     static uint32_t UpdateInternal(uint32_t crc, const uint8_t *data, size_t len);
-    static uint32_t table_[256];
-    static bool table_initialized_;
 };
 
 } // namespace lmshao::lmcore
@@ -0,0 +1,149 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_EPOCH_H
+#define LMSHAO_LMCORE_EPOCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief Epoch-based memory reclamation (RCU-style).
+ *
+ * Readers bracket their accesses with an EpochGuard, which costs two stores to a thread-private
+ * cache line and no shared atomic read-modify-write. Writers unlink an object and Retire() it;
+ * the object is deleted once every reader that could still see it has left its critical section,
+ * i.e. after the global epoch advanced twice.
+ *
+ * Each thread gets a record in every domain it uses, with its own limbo list of retired objects;
+ * a record is recycled when its thread exits. The domain must outlive the threads using it.
+ *
+ * Usage:
+ * @code
+ * std::atomic<Node *> head;
+ * {
+ *     EpochGuard guard;                // readers
+ *     Node *node = head.load(std::memory_order_acquire);
+ *     Use(node);
+ * }
+ * Node *old = head.exchange(next);     // writer
+ * EpochDomain::Default().Retire(old);
+ * @endcode
+ */
+class EpochDomain : public NonCopyable {
+public:
+    /// @brief Retired objects a thread collects before it tries to advance the epoch.
+    static constexpr size_t kReclaimThreshold = 64;
+
+    EpochDomain();
+    /**
+     * @brief Destroy the domain and every object still waiting for reclamation.
+     * @note No thread may be inside a critical section of this domain.
+     */
+    ~EpochDomain() override;
+
+    /**
+     * @brief Get the process-wide domain.
+     */
+    static EpochDomain &Default();
+
+    /**
+     * @brief Enter a read-side critical section (nestable). Prefer EpochGuard.
+     */
+    void Enter();
+    /**
+     * @brief Leave a read-side critical section.
+     */
+    void Exit();
+
+    /**
+     * @brief Delete an unlinked object once no reader can reference it any more.
+     * @param ptr Object already unreachable for new readers
+     */
+    template <typename T>
+    void Retire(T *ptr)
+    {
+        if (ptr) {
+            Retire(ptr, [](void *p) { delete static_cast<T *>(p); });
+        }
+    }
+
+    /**
+     * @brief Retire with a custom deleter.
+     */
+    void Retire(void *ptr, void (*deleter)(void *));
+
+    /**
+     * @brief Wait until every reader active at the time of the call has left, then reclaim
+     * what the calling thread retired.
+     * @note Must not be called inside a critical section.
+     */
+    void Synchronize();
+
+    /**
+     * @brief Try to advance the epoch and reclaim the calling thread's eligible objects.
+     * @return Number of objects deleted
+     */
+    size_t Reclaim();
+
+    /**
+     * @brief Get the current global epoch.
+     */
+    uint64_t CurrentEpoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Get the number of retired objects not yet deleted, over all threads.
+     */
+    size_t PendingCount() const;
+
+private:
+    struct Record;
+    struct Retired {
+        void *ptr;
+        void (*deleter)(void *);
+        uint64_t epoch;
+    };
+
+    Record *GetRecord();
+    Record *AcquireRecord();
+    static void ReleaseRecord(void *domain, void *record);
+    bool TryAdvance();
+    size_t ReclaimList(std::vector<Retired> &list, uint64_t epoch);
+
+    const uint64_t id_;
+    std::atomic<uint64_t> epoch_{2};
+    std::atomic<Record *> records_{nullptr};
+    std::atomic<size_t> pending_{0};
+
+    /// @brief Objects left behind by exited threads.
+    std::mutex orphanMutex_;
+    std::vector<Retired> orphans_;
+};
+
+/**
+ * @brief RAII read-side critical section of an EpochDomain.
+ */
+class EpochGuard : public NonCopyable {
+public:
+    explicit EpochGuard(EpochDomain &domain = EpochDomain::Default()) : domain_(domain) { domain_.Enter(); }
+    ~EpochGuard() override { domain_.Exit(); }
+
+private:
+    EpochDomain &domain_;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_EPOCH_H
@@ -0,0 +1,272 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_EVENT_LOOP_H
+#define LMSHAO_LMCORE_EVENT_LOOP_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "channel_notifier.h"
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief Single-threaded reactor multiplexing file descriptors, timers, posted tasks and channels.
+ *
+ * Everything registered with a loop runs on the thread that calls Run(), so handlers need no
+ * locking among themselves; run one loop per core for a thread-per-core design. On Linux it is
+ * built on epoll, a timerfd for all timers and an eventfd for cross-thread wakeups; Post() pushes
+ * onto a lock-free MPSC inbox and writes the eventfd only when the loop may be asleep.
+ * Other platforms are not supported yet: Run() fails.
+ *
+ * Thread safety: Post(), Stop(), RunAt()/RunAfter()/RunEvery() and CancelTimer() may be called
+ * from any thread. Fd and receiver registration must happen on the loop thread or before Run().
+ *
+ * Usage:
+ * @code
+ * EventLoop loop;
+ * loop.AddFd(sock, EventLoop::kReadable, [&](uint32_t events) { OnReadable(sock); });
+ * loop.RunEvery(std::chrono::seconds(1), [&]() { ReportStats(); });
+ * auto [tx, rx] = sync::MpscChannel<Message>(1024, true);   // with a notifier: no polling
+ * loop.AddReceiver(std::move(rx), [&](Message msg) { Handle(msg); });
+ * std::thread thread([&]() { loop.Run(); });
+ * loop.Post([&]() { ... });       // from any thread
+ * loop.Stop();
+ * thread.join();
+ * @endcode
+ */
+class EventLoop : public NonCopyable {
+public:
+    using Task = std::function<void()>;
+    using IoCallback = std::function<void(uint32_t events)>;
+    using TimerId = uint64_t;
+    using ReceiverId = uint64_t;
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Fd event flags, for AddFd() and passed to IoCallback.
+    static constexpr uint32_t kReadable = 1u << 0;
+    static constexpr uint32_t kWritable = 1u << 1;
+    /// @brief Error or hang-up; always reported, no need to request it.
+    static constexpr uint32_t kError = 1u << 2;
+
+    /// @brief Wait cap while channel receivers without a pollable fd are registered.
+    static constexpr std::chrono::milliseconds kReceiverPollInterval{1};
+    /// @brief Messages taken from one receiver per iteration, so one busy channel can't starve the rest.
+    static constexpr size_t kReceiverBatch = 64;
+    /// @brief Posted tasks run per iteration, so tasks that keep posting can't starve I/O.
+    static constexpr size_t kInboxBatch = 1024;
+
+    EventLoop();
+    /**
+     * @brief Destructor. Tasks still in the inbox are discarded without running.
+     */
+    ~EventLoop() override;
+
+    /**
+     * @brief Run the loop on the calling thread until Stop().
+     * @return 0 on normal exit, -1 if the loop could not be set up or is already running
+     */
+    int32_t Run();
+
+    /**
+     * @brief Make Run() return after the current iteration.
+     */
+    void Stop();
+
+    /**
+     * @brief Check if Run() is executing.
+     */
+    bool IsRunning() const { return running_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Check if the caller is the thread executing Run().
+     */
+    bool IsInLoopThread() const { return std::this_thread::get_id() == loopThread_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Run a task on the loop thread, after the current handler returns.
+     */
+    void Post(Task task);
+
+    /**
+     * @brief Run a task at the given time.
+     * @return Timer ID, never 0
+     */
+    TimerId RunAt(Clock::time_point when, Task task);
+
+    /**
+     * @brief Run a task after a delay.
+     */
+    TimerId RunAfter(Clock::duration delay, Task task) { return RunAt(Clock::now() + delay, std::move(task)); }
+
+    /**
+     * @brief Run a task every interval, first after one interval. Missed periods are skipped, not queued.
+     */
+    TimerId RunEvery(Clock::duration interval, Task task);
+
+    /**
+     * @brief Cancel a timer. From another thread the cancellation takes effect asynchronously.
+     * @return false if the timer is unknown (loop thread only; always true elsewhere)
+     */
+    bool CancelTimer(TimerId id);
+
+    /**
+     * @brief Watch a file descriptor.
+     * @param events kReadable and/or kWritable; level-triggered
+     * @return 0 on success, -1 on failure
+     */
+    int32_t AddFd(int fd, uint32_t events, IoCallback callback);
+
+    /**
+     * @brief Change the events watched on a registered fd.
+     */
+    int32_t ModifyFd(int fd, uint32_t events);
+
+    /**
+     * @brief Stop watching a file descriptor. Safe from within its own callback.
+     */
+    int32_t RemoveFd(int fd);
+
+    /**
+     * @brief Drain a channel receiver on the loop thread.
+     *
+     * The loop owns the receiver and drops it once its channel is closed and empty. Receivers of
+     * channels created with a notifier (SpscChannel/MpscChannel withNotifier) are watched through its
+     * fd and cost nothing while idle; others are polled every iteration, so while any is registered
+     * the loop sleeps at most kReceiverPollInterval.
+     *
+     * @param receiver Receiver of any lmcore channel (SpscReceiver, MpscReceiver, ...)
+     * @param handler Called with each received value
+     */
+    template <typename Receiver, typename Handler>
+    ReceiverId AddReceiver(std::unique_ptr<Receiver> receiver, Handler handler)
+    {
+        auto shared = std::shared_ptr<Receiver>(std::move(receiver));
+        auto drain = [shared, handler = std::move(handler)]() mutable {
+            for (size_t i = 0; i < kReceiverBatch; ++i) {
+                auto value = shared->TryRecv();
+                if (!value) {
+                    return shared->IsClosed() && shared->IsEmpty() ? DrainResult::kClosed : DrainResult::kIdle;
+                }
+                handler(std::move(*value));
+            }
+            return DrainResult::kBusy;
+        };
+        if constexpr (detail::HasChannelNotifier<Receiver>::value) {
+            sync::ChannelNotifier *notifier = shared->GetNotifier();
+            if (notifier && notifier->GetFd() >= 0) {
+                return AddNotifiedReceiver(std::move(drain), notifier, [shared]() { return shared->ArmNotifier(); });
+            }
+        }
+        return AddReceiverSource(std::move(drain));
+    }
+
+    /**
+     * @brief Stop draining a receiver and drop it.
+     */
+    bool RemoveReceiver(ReceiverId id);
+
+    /**
+     * @brief Get the number of registered fds, timers and receivers (loop thread only).
+     */
+    size_t GetSourceCount() const;
+
+private:
+    enum class DrainResult {
+        kIdle,   ///< Receiver is empty
+        kBusy,   ///< Batch limit reached, more may be waiting
+        kClosed, ///< Channel closed and drained; drop the receiver
+    };
+    using DrainFn = std::function<DrainResult()>;
+
+    struct InboxNode {
+        Task task;
+        std::atomic<InboxNode *> next{nullptr};
+    };
+
+    struct Timer {
+        Clock::time_point when;
+        /// @brief Zero for one-shot timers
+        Clock::duration interval;
+        /// @brief Shared so that firing a periodic timer doesn't copy the callable
+        std::shared_ptr<Task> task;
+    };
+
+    struct TimerEntry {
+        Clock::time_point when;
+        TimerId id;
+        bool operator>(const TimerEntry &other) const { return when > other.when; }
+    };
+
+    struct FdHandler {
+        uint32_t events;
+        std::shared_ptr<IoCallback> callback;
+    };
+
+    struct ReceiverSource {
+        ReceiverId id;
+        /// @brief Notifier fd watched by epoll, -1 for a polled receiver
+        int fd;
+        /// @brief Shared so it survives registrations made while it runs
+        std::shared_ptr<DrainFn> drain;
+    };
+
+    ReceiverId AddReceiverSource(DrainFn drain);
+    ReceiverId AddNotifiedReceiver(DrainFn drain, sync::ChannelNotifier *notifier, std::function<bool()> arm);
+    bool HasPolledReceivers() const;
+
+    void Wakeup();
+    void DrainInbox();
+    void AddTimer(TimerId id, Timer timer);
+    void RunDueTimers();
+    void ArmTimerFd();
+    bool InboxEmpty() const { return inboxTail_->next.load(std::memory_order_acquire) == nullptr; }
+    /// @return true if a receiver may have more messages waiting
+    bool PollReceivers();
+    void Dispatch(int fd, uint32_t events);
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<std::thread::id> loopThread_{};
+
+    int epollFd_ = -1;
+    int wakeFd_ = -1;
+    int timerFd_ = -1;
+
+    /// @brief Vyukov MPSC queue: producers exchange head_, the loop pops from tail_ (a stub node).
+    alignas(64) std::atomic<InboxNode *> inboxHead_{nullptr};
+    alignas(64) InboxNode *inboxTail_ = nullptr;
+    /// @brief Set once a wakeup was written and not yet consumed, to write the eventfd once per batch.
+    std::atomic<bool> wakeupPending_{false};
+
+    std::atomic<TimerId> nextTimerId_{1};
+    std::unordered_map<TimerId, Timer> timers_;
+    std::priority_queue<TimerEntry, std::vector<TimerEntry>, std::greater<TimerEntry>> timerQueue_;
+    Clock::time_point armedAt_ = Clock::time_point::max();
+
+    std::unordered_map<int, FdHandler> fds_;
+
+    ReceiverId nextReceiverId_ = 1;
+    std::vector<ReceiverSource> receivers_;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_EVENT_LOOP_H
@@ -0,0 +1,148 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_FAST_CDC_H
+#define LMSHAO_LMCORE_FAST_CDC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace lmshao::lmcore {
+
+class DataBuffer;
+class MappedFile;
+class ThreadPool;
+
+/**
+ * @brief Content-defined chunking (FastCDC) for deduplication and delta transfer
+ *
+ * Chunk boundaries are placed where a gear rolling hash of the preceding bytes matches a mask,
+ * so they move with the content: inserting or deleting bytes only changes the chunks around the
+ * edit, and the rest of a modified file still produces the same chunks and fingerprints.
+ * Boundaries are never closer than the minimum size nor further apart than the maximum, and
+ * normalized chunking (a stricter mask before the average size, a looser one after) keeps most
+ * chunks near the average.
+ *
+ * Each chunk gets an XXH64 fingerprint of its content. Split() is one-shot over contiguous data
+ * (e.g. a MappedFile) and can use a ThreadPool for large inputs; Stream takes the data in pieces
+ * of any size, such as received DataBuffers. All of them produce the same chunks.
+ *
+ * Usage:
+ * @code
+ * FastCdc cdc(4096, 16384, 65536);
+ * auto file = MappedFile::Open("recording.mp4");
+ * for (const auto &chunk : cdc.Split(*file, &pool)) {
+ *     if (!store.Has(chunk.fingerprint)) {
+ *         Upload(file->Data() + chunk.offset, chunk.length);
+ *     }
+ * }
+ * @endcode
+ */
+class FastCdc {
+public:
+    struct Chunk {
+        uint64_t offset = 0;
+        uint32_t length = 0;
+        /// @brief XXH64 of the chunk's content
+        uint64_t fingerprint = 0;
+    };
+
+    /// @brief Receives each chunk with its data, valid during the call only
+    using Callback = std::function<void(const Chunk &chunk, const uint8_t *data)>;
+
+    static constexpr size_t kDefaultMinSize = 2 * 1024;
+    static constexpr size_t kDefaultAvgSize = 8 * 1024;
+    static constexpr size_t kDefaultMaxSize = 64 * 1024;
+    /// @brief Inputs are split into segments of this size to be chunked in parallel
+    static constexpr size_t kSegmentSize = 8 * 1024 * 1024;
+
+    /**
+     * @brief Constructor
+     * @param minSize Smallest chunk, except for the last one
+     * @param avgSize Target average chunk size, rounded to a power of two
+     * @param maxSize Largest chunk
+     */
+    explicit FastCdc(size_t minSize = kDefaultMinSize, size_t avgSize = kDefaultAvgSize,
+                     size_t maxSize = kDefaultMaxSize);
+
+    /**
+     * @brief Find the end of the chunk starting at `data`.
+     * @return Length of the chunk; `len` if the data ends before a boundary
+     */
+    size_t FindBoundary(const uint8_t *data, size_t len) const;
+
+    /**
+     * @brief Split contiguous data into chunks.
+     * @param pool Chunk and fingerprint segments of large inputs on this pool, nullptr to stay on the caller
+     * @return The chunks, covering the data in order
+     */
+    std::vector<Chunk> Split(const uint8_t *data, size_t len, ThreadPool *pool = nullptr) const;
+
+    /**
+     * @brief Split a mapped file (or mapped range); offsets are file offsets.
+     */
+    std::vector<Chunk> Split(const MappedFile &file, ThreadPool *pool = nullptr) const;
+
+    size_t GetMinSize() const { return minSize_; }
+    size_t GetAvgSize() const { return avgSize_; }
+    size_t GetMaxSize() const { return maxSize_; }
+
+    /// @brief Incremental chunker for data arriving in pieces, defined below
+    class Stream;
+
+private:
+    /// @brief Boundaries of the chunks starting at `begin`, up to the first one at or past `end`.
+    std::vector<uint64_t> FindBoundaries(const uint8_t *data, uint64_t len, uint64_t begin, uint64_t end) const;
+
+    size_t minSize_;
+    size_t avgSize_;
+    size_t maxSize_;
+    /// @brief Stricter mask used below the average size, looser one above (normalized chunking)
+    uint64_t maskSmall_;
+    uint64_t maskLarge_;
+};
+
+/**
+ * @brief Incremental chunker for data arriving in pieces.
+ *
+ * A chunk is emitted once maxSize bytes past its start have arrived, when its end is certain
+ * whatever follows, so less than maxSize bytes are kept between calls. The rest is emitted
+ * by Finish().
+ */
+class FastCdc::Stream {
+public:
+    Stream(const FastCdc &cdc, Callback callback);
+
+    void Update(const uint8_t *data, size_t len);
+    void Update(const DataBuffer &buffer);
+
+    /**
+     * @brief Emit the buffered tail as the final chunks. The stream then starts over at offset 0.
+     */
+    void Finish();
+
+    /**
+     * @brief Get the number of bytes emitted in chunks since the start of the stream.
+     */
+    uint64_t GetOffset() const { return offset_; }
+
+private:
+    /// @brief Emit the chunks of data[0, len) whose end is certain; returns the bytes consumed.
+    size_t Consume(const uint8_t *data, size_t len, bool final);
+
+    const FastCdc cdc_;
+    Callback callback_;
+    std::vector<uint8_t> pending_;
+    uint64_t offset_ = 0;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_FAST_CDC_H
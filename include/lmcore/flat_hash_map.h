@@ -0,0 +1,736 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_FLAT_HASH_MAP_H
+#define LMSHAO_LMCORE_FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LMCORE_FLAT_HASH_SSE2 1
+#endif
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief Default hasher of FlatHashMap and FlatHashSet.
+ *
+ * Strings hash transparently, so string-keyed tables can be searched with a std::string_view
+ * or a C string without building a temporary std::string.
+ */
+template <typename T>
+struct FlatHash : std::hash<T> {};
+
+template <>
+struct FlatHash<std::string> {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>()(str); }
+};
+
+/**
+ * @brief Default key comparison of FlatHashMap and FlatHashSet; transparent for strings.
+ */
+template <typename T>
+struct FlatEqual : std::equal_to<T> {};
+
+template <>
+struct FlatEqual<std::string> : std::equal_to<> {};
+
+namespace detail {
+
+/// @brief Control byte of a slot: 0..127 holds 7 bits of the hash of a full slot.
+using FlatCtrl = int8_t;
+constexpr FlatCtrl kFlatEmpty = -128;
+constexpr FlatCtrl kFlatDeleted = -2;
+/// @brief Ends the control array, so iteration stops without a bounds check.
+constexpr FlatCtrl kFlatSentinel = -1;
+
+inline uint32_t FlatTrailingZeros(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+#else
+    uint32_t count = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Sixteen control bytes matched at once: one SSE2 compare, or a byte loop elsewhere.
+ */
+class FlatGroup {
+public:
+    static constexpr size_t kWidth = 16;
+
+#if defined(LMCORE_FLAT_HASH_SSE2)
+    explicit FlatGroup(const FlatCtrl *ctrl) : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+
+    /// @return Bit i set if byte i equals h2
+    uint32_t Match(FlatCtrl h2) const
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+    }
+    uint32_t MatchEmpty() const { return Match(kFlatEmpty); }
+    uint32_t MatchEmptyOrDeleted() const
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(kFlatSentinel), ctrl_)));
+    }
+
+private:
+    __m128i ctrl_;
+#else
+    explicit FlatGroup(const FlatCtrl *ctrl) { std::memcpy(ctrl_, ctrl, kWidth); }
+
+    uint32_t Match(FlatCtrl h2) const
+    {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kWidth; ++i) {
+            mask |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+        }
+        return mask;
+    }
+    uint32_t MatchEmpty() const { return Match(kFlatEmpty); }
+    uint32_t MatchEmptyOrDeleted() const
+    {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kWidth; ++i) {
+            mask |= static_cast<uint32_t>(ctrl_[i] < kFlatSentinel) << i;
+        }
+        return mask;
+    }
+
+private:
+    FlatCtrl ctrl_[kWidth];
+#endif
+};
+
+/// @brief Control bytes of a table without storage: every lookup misses, the first insert allocates.
+alignas(16) inline constexpr FlatCtrl kFlatEmptyGroup[FlatGroup::kWidth] = {
+    kFlatSentinel, kFlatEmpty, kFlatEmpty, kFlatEmpty, kFlatEmpty, kFlatEmpty, kFlatEmpty, kFlatEmpty,
+    kFlatEmpty,    kFlatEmpty, kFlatEmpty, kFlatEmpty, kFlatEmpty, kFlatEmpty, kFlatEmpty, kFlatEmpty};
+
+/// @brief Lookup argument type: any type when hasher and comparison are transparent, else the key.
+template <bool kTransparent>
+struct FlatKeyArg {
+    template <typename Q, typename Key>
+    using Type = Key;
+};
+
+template <>
+struct FlatKeyArg<true> {
+    template <typename Q, typename Key>
+    using Type = Q;
+};
+
+template <typename T, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename T>
+struct IsTransparent<T, std::void_t<typename T::is_transparent>> : std::true_type {};
+
+struct FlatMapPolicy {
+    template <typename Pair>
+    static const auto &Key(const Pair &pair)
+    {
+        return pair.first;
+    }
+
+    /// @brief Move an element to new storage. The key is const in the pair but the source is
+    /// destroyed right after, so it is moved rather than copied.
+    template <typename Pair>
+    static void Transfer(Pair *dst, Pair *src)
+    {
+        using KeyType = std::remove_const_t<typename Pair::first_type>;
+        new (dst) Pair(std::piecewise_construct, std::forward_as_tuple(std::move(const_cast<KeyType &>(src->first))),
+                       std::forward_as_tuple(std::move(src->second)));
+        src->~Pair();
+    }
+};
+
+struct FlatSetPolicy {
+    template <typename T>
+    static const T &Key(const T &value)
+    {
+        return value;
+    }
+
+    template <typename T>
+    static void Transfer(T *dst, T *src)
+    {
+        new (dst) T(std::move(*src));
+        src->~T();
+    }
+};
+
+/**
+ * @brief Open-addressing table shared by FlatHashMap and FlatHashSet (SwissTable layout).
+ *
+ * Slots live in one array next to an array of one control byte per slot. A hash is split into
+ * H1, which picks where probing starts, and H2, its low 7 bits, stored in the control byte of a
+ * full slot. Lookups compare H2 against a whole group of control bytes at once and only touch
+ * the slots that match, probing group by group until a group with an empty slot. The capacity
+ * is 2^n - 1 and the first kWidth - 1 control bytes are mirrored after the sentinel, so a group
+ * can be loaded at any position without wrapping.
+ */
+template <typename Key, typename Value, typename Hash, typename Eq, typename Policy>
+class FlatTable {
+    static constexpr size_t kWidth = FlatGroup::kWidth;
+    static constexpr size_t kNpos = SIZE_MAX;
+    static constexpr bool kTransparent = IsTransparent<Hash>::value && IsTransparent<Eq>::value;
+
+    static_assert(alignof(Value) <= alignof(std::max_align_t), "over-aligned elements are not supported");
+
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = Eq;
+    using reference = Value &;
+    using const_reference = const Value &;
+
+    template <bool kConst>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = ptrdiff_t;
+        using reference = std::conditional_t<kConst, const Value &, Value &>;
+        using pointer = std::conditional_t<kConst, const Value *, Value *>;
+
+        Iterator() = default;
+        template <bool kOther, typename = std::enable_if_t<kConst && !kOther>>
+        Iterator(const Iterator<kOther> &other) : ctrl_(other.ctrl_), slot_(other.slot_)
+        {
+        }
+
+        reference operator*() const { return *slot_; }
+        pointer operator->() const { return slot_; }
+
+        Iterator &operator++()
+        {
+            ++ctrl_;
+            ++slot_;
+            SkipFree();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const Iterator &a, const Iterator &b) { return a.ctrl_ == b.ctrl_; }
+        friend bool operator!=(const Iterator &a, const Iterator &b) { return a.ctrl_ != b.ctrl_; }
+
+    private:
+        friend class FlatTable;
+        template <bool>
+        friend class Iterator;
+
+        Iterator(const FlatCtrl *ctrl, Value *slot) : ctrl_(ctrl), slot_(slot) {}
+
+        void SkipFree()
+        {
+            while (*ctrl_ < kFlatSentinel) {
+                ++ctrl_;
+                ++slot_;
+            }
+        }
+
+        const FlatCtrl *ctrl_ = nullptr;
+        Value *slot_ = nullptr;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    /// @brief Parameter type of lookups; see FlatHash for heterogeneous lookup.
+    template <typename Q>
+    using KeyArg = typename FlatKeyArg<kTransparent>::template Type<Q, Key>;
+
+    FlatTable() = default;
+
+    explicit FlatTable(size_t bucketCount, const Hash &hash = Hash(), const Eq &eq = Eq()) : hash_(hash), eq_(eq)
+    {
+        reserve(bucketCount);
+    }
+
+    FlatTable(const FlatTable &other) : hash_(other.hash_), eq_(other.eq_)
+    {
+        reserve(other.size_);
+        for (const Value &value : other) {
+            size_t index = PrepareInsert(HashOf(Policy::Key(value)));
+            new (slots_ + index) Value(value);
+        }
+    }
+
+    FlatTable(FlatTable &&other) noexcept
+        : ctrl_(std::exchange(other.ctrl_, EmptyCtrl())), slots_(std::exchange(other.slots_, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)), size_(std::exchange(other.size_, 0)),
+          growthLeft_(std::exchange(other.growthLeft_, 0)), hash_(std::move(other.hash_)), eq_(std::move(other.eq_))
+    {
+    }
+
+    FlatTable &operator=(FlatTable other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~FlatTable()
+    {
+        DestroySlots();
+        Deallocate();
+    }
+
+    iterator begin()
+    {
+        iterator it(ctrl_, slots_);
+        it.SkipFree();
+        return it;
+    }
+    const_iterator begin() const { return const_cast<FlatTable *>(this)->begin(); }
+    const_iterator cbegin() const { return begin(); }
+    iterator end() { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+    const_iterator end() const { return const_cast<FlatTable *>(this)->end(); }
+    const_iterator cend() const { return end(); }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    /// @brief Number of slots; the table grows when it would be more than 7/8 full.
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Destroy all elements, keeping the storage.
+     */
+    void clear()
+    {
+        DestroySlots();
+        if (capacity_) {
+            ResetCtrl();
+        }
+        size_ = 0;
+    }
+
+    /**
+     * @brief Make room for `count` elements without further rehashing.
+     */
+    void reserve(size_t count)
+    {
+        if (count <= size_ + growthLeft_) {
+            return;
+        }
+        size_t capacity = kWidth - 1;
+        while (GrowthLimit(capacity) < count) {
+            capacity = capacity * 2 + 1;
+        }
+        Resize(capacity);
+    }
+
+    template <typename Q = Key>
+    iterator find(const KeyArg<Q> &key)
+    {
+        size_t index = FindIndex(key, HashOf(key));
+        return index == kNpos ? end() : IteratorAt(index);
+    }
+
+    template <typename Q = Key>
+    const_iterator find(const KeyArg<Q> &key) const
+    {
+        return const_cast<FlatTable *>(this)->template find<Q>(key);
+    }
+
+    template <typename Q = Key>
+    bool contains(const KeyArg<Q> &key) const
+    {
+        return FindIndex(key, HashOf(key)) != kNpos;
+    }
+
+    template <typename Q = Key>
+    size_t count(const KeyArg<Q> &key) const
+    {
+        return contains<Q>(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief Insert an element built from args unless its key is present.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args &&...args)
+    {
+        alignas(Value) unsigned char storage[sizeof(Value)];
+        Value *value = new (storage) Value(std::forward<Args>(args)...);
+        uint64_t hash = HashOf(Policy::Key(*value));
+        size_t index = FindIndex(Policy::Key(*value), hash);
+        if (index != kNpos) {
+            value->~Value();
+            return {IteratorAt(index), false};
+        }
+        index = PrepareInsert(hash);
+        Policy::Transfer(slots_ + index, value);
+        return {IteratorAt(index), true};
+    }
+
+    std::pair<iterator, bool> insert(const Value &value) { return emplace(value); }
+    std::pair<iterator, bool> insert(Value &&value) { return emplace(std::move(value)); }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    template <typename Q = Key>
+    size_t erase(const KeyArg<Q> &key)
+    {
+        size_t index = FindIndex(key, HashOf(key));
+        if (index == kNpos) {
+            return 0;
+        }
+        EraseAt(index);
+        return 1;
+    }
+
+    /// @return Iterator to the element after the erased one
+    iterator erase(const_iterator pos)
+    {
+        iterator next(pos.ctrl_, pos.slot_);
+        ++next;
+        EraseAt(static_cast<size_t>(pos.ctrl_ - ctrl_));
+        return next;
+    }
+
+    iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+    void swap(FlatTable &other) noexcept
+    {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(growthLeft_, other.growthLeft_);
+        std::swap(hash_, other.hash_);
+        std::swap(eq_, other.eq_);
+    }
+
+    hasher hash_function() const { return hash_; }
+    key_equal key_eq() const { return eq_; }
+
+protected:
+    /**
+     * @brief Find a key, or claim a slot for it; the caller constructs the element in a claimed slot.
+     * @return Slot index, and whether it was claimed
+     */
+    template <typename Q>
+    std::pair<size_t, bool> FindOrPrepareInsert(const Q &key)
+    {
+        uint64_t hash = HashOf(key);
+        size_t index = FindIndex(key, hash);
+        if (index != kNpos) {
+            return {index, false};
+        }
+        return {PrepareInsert(hash), true};
+    }
+
+    Value *SlotAt(size_t index) { return slots_ + index; }
+    iterator IteratorAt(size_t index) { return iterator(ctrl_ + index, slots_ + index); }
+
+private:
+    static FlatCtrl *EmptyCtrl() { return const_cast<FlatCtrl *>(kFlatEmptyGroup); }
+    static size_t GrowthLimit(size_t capacity) { return capacity - capacity / 8; }
+    static FlatCtrl H2(uint64_t hash) { return static_cast<FlatCtrl>(hash & 0x7f); }
+    static size_t H1(uint64_t hash) { return static_cast<size_t>(hash >> 7); }
+
+    template <typename Q>
+    uint64_t HashOf(const Q &key) const
+    {
+        // Spread the bits: std::hash is the identity for integers
+        uint64_t hash = static_cast<uint64_t>(hash_(key)) * 0x9e3779b97f4a7c15ULL;
+        return hash ^ (hash >> 32);
+    }
+
+    template <typename Q>
+    size_t FindIndex(const Q &key, uint64_t hash) const
+    {
+        FlatCtrl h2 = H2(hash);
+        size_t offset = H1(hash) & capacity_;
+        for (size_t step = kWidth;; step += kWidth) {
+            FlatGroup group(ctrl_ + offset);
+            for (uint32_t mask = group.Match(h2); mask; mask &= mask - 1) {
+                size_t index = (offset + FlatTrailingZeros(mask)) & capacity_;
+                if (eq_(Policy::Key(slots_[index]), key)) {
+                    return index;
+                }
+            }
+            if (group.MatchEmpty()) {
+                return kNpos;
+            }
+            offset = (offset + step) & capacity_;
+        }
+    }
+
+    size_t FindFirstNonFull(uint64_t hash) const
+    {
+        size_t offset = H1(hash) & capacity_;
+        for (size_t step = kWidth;; step += kWidth) {
+            uint32_t mask = FlatGroup(ctrl_ + offset).MatchEmptyOrDeleted();
+            if (mask) {
+                return (offset + FlatTrailingZeros(mask)) & capacity_;
+            }
+            offset = (offset + step) & capacity_;
+        }
+    }
+
+    size_t PrepareInsert(uint64_t hash)
+    {
+        size_t index = FindFirstNonFull(hash);
+        if (growthLeft_ == 0 && ctrl_[index] != kFlatDeleted) {
+            // Mostly tombstones: rehash in place; otherwise double
+            bool compact = capacity_ > kWidth && size_ * 32 <= capacity_ * 25;
+            Resize(compact ? capacity_ : (capacity_ ? capacity_ * 2 + 1 : kWidth - 1));
+            index = FindFirstNonFull(hash);
+        }
+        if (ctrl_[index] == kFlatEmpty) {
+            --growthLeft_;
+        }
+        ++size_;
+        SetCtrl(index, H2(hash));
+        return index;
+    }
+
+    void EraseAt(size_t index)
+    {
+        slots_[index].~Value();
+        --size_;
+        // A slot whose every enclosing group still had an empty slot never stopped a probe, so it can
+        // become empty again instead of a tombstone
+        uint32_t emptyAfter = FlatGroup(ctrl_ + index).MatchEmpty();
+        uint32_t emptyBefore = FlatGroup(ctrl_ + ((index - kWidth) & capacity_)).MatchEmpty();
+        bool neverFull = false;
+        if (emptyAfter && emptyBefore) {
+            uint32_t leading = 0;
+            for (uint32_t bit = 1u << (kWidth - 1); !(emptyBefore & bit); bit >>= 1) {
+                ++leading;
+            }
+            neverFull = FlatTrailingZeros(emptyAfter) + leading < kWidth;
+        }
+        SetCtrl(index, neverFull ? kFlatEmpty : kFlatDeleted);
+        growthLeft_ += neverFull ? 1 : 0;
+    }
+
+    void SetCtrl(size_t index, FlatCtrl ctrl)
+    {
+        ctrl_[index] = ctrl;
+        ctrl_[((index - (kWidth - 1)) & capacity_) + (kWidth - 1)] = ctrl;
+    }
+
+    void ResetCtrl()
+    {
+        std::memset(ctrl_, static_cast<unsigned char>(kFlatEmpty), capacity_ + kWidth);
+        ctrl_[capacity_] = kFlatSentinel;
+        growthLeft_ = GrowthLimit(capacity_) - size_;
+    }
+
+    static size_t SlotOffset(size_t capacity)
+    {
+        return (capacity + kWidth + alignof(Value) - 1) & ~(alignof(Value) - 1);
+    }
+
+    void Resize(size_t capacity)
+    {
+        FlatCtrl *oldCtrl = ctrl_;
+        Value *oldSlots = slots_;
+        size_t oldCapacity = capacity_;
+
+        char *memory = static_cast<char *>(::operator new(SlotOffset(capacity) + capacity * sizeof(Value)));
+        ctrl_ = reinterpret_cast<FlatCtrl *>(memory);
+        slots_ = reinterpret_cast<Value *>(memory + SlotOffset(capacity));
+        capacity_ = capacity;
+        ResetCtrl();
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldCtrl[i] >= 0) {
+                uint64_t hash = HashOf(Policy::Key(oldSlots[i]));
+                size_t index = FindFirstNonFull(hash);
+                SetCtrl(index, H2(hash));
+                Policy::Transfer(slots_ + index, oldSlots + i);
+            }
+        }
+        growthLeft_ = GrowthLimit(capacity_) - size_;
+        if (oldCapacity) {
+            ::operator delete(oldCtrl);
+        }
+    }
+
+    void DestroySlots()
+    {
+        if (!std::is_trivially_destructible<Value>::value && size_) {
+            for (size_t i = 0; i < capacity_; ++i) {
+                if (ctrl_[i] >= 0) {
+                    slots_[i].~Value();
+                }
+            }
+        }
+    }
+
+    void Deallocate()
+    {
+        if (capacity_) {
+            ::operator delete(ctrl_);
+        }
+        ctrl_ = EmptyCtrl();
+        slots_ = nullptr;
+        capacity_ = 0;
+        growthLeft_ = 0;
+    }
+
+    FlatCtrl *ctrl_ = EmptyCtrl();
+    Value *slots_ = nullptr;
+    /// @brief 2^n - 1 slots, or 0 before the first insert
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    /// @brief Inserts into empty slots left before the table must grow
+    size_t growthLeft_ = 0;
+    Hash hash_;
+    Eq eq_;
+};
+
+} // namespace detail
+
+/**
+ * @brief Open-addressing hash map with SwissTable-style group probing.
+ *
+ * Elements are stored inline in one flat array, so inserting allocates only when the table
+ * grows, and a lookup usually costs one 16-byte control-group compare plus one key comparison.
+ * With the default FlatHash/FlatEqual, std::string keys can be looked up by std::string_view
+ * or const char * (heterogeneous lookup).
+ *
+ * The interface follows std::unordered_map, with these differences: inserting may move
+ * elements, invalidating iterators, pointers and references (unlike node-based containers);
+ * erasing invalidates only the erased element. Not thread-safe.
+ *
+ * Usage:
+ * @code
+ * FlatHashMap<std::string, int> counts;
+ * ++counts["GET"];
+ * std::string_view method = ParseMethod(request);
+ * auto it = counts.find(method);      // no std::string constructed
+ * @endcode
+ */
+template <typename K, typename V, typename Hash = FlatHash<K>, typename Eq = FlatEqual<K>>
+class FlatHashMap : public detail::FlatTable<K, std::pair<const K, V>, Hash, Eq, detail::FlatMapPolicy> {
+    using Base = detail::FlatTable<K, std::pair<const K, V>, Hash, Eq, detail::FlatMapPolicy>;
+
+public:
+    using mapped_type = V;
+    using typename Base::iterator;
+    using typename Base::value_type;
+
+    using Base::Base;
+
+    FlatHashMap() = default;
+    FlatHashMap(std::initializer_list<value_type> init) { Base::insert(init.begin(), init.end()); }
+
+    /**
+     * @brief Insert a value constructed from args unless the key is present; args are untouched then.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K &key, Args &&...args)
+    {
+        return TryEmplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K &&key, Args &&...args)
+    {
+        return TryEmplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const K &key, M &&value)
+    {
+        auto result = TryEmplace(key, std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    V &operator[](const K &key) { return TryEmplace(key).first->second; }
+    V &operator[](K &&key) { return TryEmplace(std::move(key)).first->second; }
+
+private:
+    template <typename KeyType, typename... Args>
+    std::pair<iterator, bool> TryEmplace(KeyType &&key, Args &&...args)
+    {
+        auto [index, claimed] = Base::FindOrPrepareInsert(key);
+        if (claimed) {
+            new (Base::SlotAt(index)) value_type(std::piecewise_construct,
+                                                 std::forward_as_tuple(std::forward<KeyType>(key)),
+                                                 std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        return {Base::IteratorAt(index), claimed};
+    }
+};
+
+/**
+ * @brief Open-addressing hash set; see FlatHashMap.
+ */
+template <typename K, typename Hash = FlatHash<K>, typename Eq = FlatEqual<K>>
+class FlatHashSet : public detail::FlatTable<K, K, Hash, Eq, detail::FlatSetPolicy> {
+    using Base = detail::FlatTable<K, K, Hash, Eq, detail::FlatSetPolicy>;
+
+public:
+    using typename Base::iterator;
+    using Base::Base;
+    using Base::insert;
+
+    FlatHashSet() = default;
+    FlatHashSet(std::initializer_list<K> init) { Base::insert(init.begin(), init.end()); }
+
+    /// @brief Unlike emplace(), copies the key only if it is inserted.
+    std::pair<iterator, bool> insert(const K &key) { return Insert(key); }
+    std::pair<iterator, bool> insert(K &&key) { return Insert(std::move(key)); }
+
+private:
+    template <typename KeyType>
+    std::pair<iterator, bool> Insert(KeyType &&key)
+    {
+        auto [index, claimed] = Base::FindOrPrepareInsert(key);
+        if (claimed) {
+            new (Base::SlotAt(index)) K(std::forward<KeyType>(key));
+        }
+        return {Base::IteratorAt(index), claimed};
+    }
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_FLAT_HASH_MAP_H
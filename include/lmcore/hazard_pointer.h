@@ -0,0 +1,155 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_HAZARD_POINTER_H
+#define LMSHAO_LMCORE_HAZARD_POINTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief Hazard pointer memory reclamation.
+ *
+ * Unlike EpochDomain, a stalled reader only pins the objects it actually protects, so the amount
+ * of unreclaimed memory stays bounded; the price is a store and a re-check per protected load.
+ * Prefer it for long-lived readers, EpochDomain for short read sections over many objects.
+ *
+ * Usage:
+ * @code
+ * HazardGuard guard;
+ * Node *node = guard.Protect(head);     // safe to dereference until guard is reset or destroyed
+ * ...
+ * Node *old = head.exchange(next);      // writer
+ * HazardDomain::Default().Retire(old);
+ * @endcode
+ */
+class HazardDomain : public NonCopyable {
+public:
+    /// @brief Hazard slots per thread record; more simultaneous guards take another record.
+    static constexpr size_t kSlotsPerRecord = 4;
+    /// @brief Minimum retired objects a thread collects before scanning the hazard slots.
+    static constexpr size_t kScanThreshold = 64;
+
+    HazardDomain();
+    /**
+     * @brief Destroy the domain and every retired object.
+     * @note No HazardGuard of this domain may be alive.
+     */
+    ~HazardDomain() override;
+
+    /**
+     * @brief Get the process-wide domain.
+     */
+    static HazardDomain &Default();
+
+    /**
+     * @brief Delete an unlinked object once no hazard slot points at it.
+     */
+    template <typename T>
+    void Retire(T *ptr)
+    {
+        if (ptr) {
+            Retire(ptr, [](void *p) { delete static_cast<T *>(p); });
+        }
+    }
+
+    /**
+     * @brief Retire with a custom deleter.
+     */
+    void Retire(void *ptr, void (*deleter)(void *));
+
+    /**
+     * @brief Scan the hazard slots and delete the calling thread's unprotected retired objects.
+     * @return Number of objects deleted
+     */
+    size_t Reclaim();
+
+    /**
+     * @brief Get the number of retired objects not yet deleted, over all threads.
+     */
+    size_t PendingCount() const;
+
+private:
+    friend class HazardGuard;
+
+    struct Record;
+    struct Retired {
+        void *ptr;
+        void (*deleter)(void *);
+    };
+
+    Record *GetRecord();
+    Record *AcquireRecord();
+    static void ReleaseRecord(void *domain, void *record);
+    std::atomic<void *> *AcquireSlot();
+    void ReleaseSlot(std::atomic<void *> *slot);
+    size_t ReclaimList(std::vector<Retired> &list);
+
+    const uint64_t id_;
+    std::atomic<Record *> records_{nullptr};
+    std::atomic<size_t> recordCount_{0};
+    std::atomic<size_t> pending_{0};
+
+    /// @brief Objects left behind by exited threads.
+    std::mutex orphanMutex_;
+    std::vector<Retired> orphans_;
+};
+
+/**
+ * @brief Owns one hazard slot; the pointer it protects is not deleted while it is published.
+ */
+class HazardGuard : public NonCopyable {
+public:
+    explicit HazardGuard(HazardDomain &domain = HazardDomain::Default())
+        : domain_(domain), slot_(domain.AcquireSlot())
+    {
+    }
+    ~HazardGuard() override
+    {
+        slot_->store(nullptr, std::memory_order_release);
+        domain_.ReleaseSlot(slot_);
+    }
+
+    /**
+     * @brief Load src and publish it, retrying until the published value is still current.
+     * @return The protected pointer, valid until Reset() or another Protect()
+     */
+    template <typename T>
+    T *Protect(const std::atomic<T *> &src)
+    {
+        T *ptr = src.load(std::memory_order_relaxed);
+        for (;;) {
+            slot_->store(ptr, std::memory_order_seq_cst);
+            T *current = src.load(std::memory_order_seq_cst);
+            if (current == ptr) {
+                return ptr;
+            }
+            ptr = current;
+        }
+    }
+
+    /**
+     * @brief Stop protecting the current pointer.
+     */
+    void Reset() { slot_->store(nullptr, std::memory_order_release); }
+
+private:
+    HazardDomain &domain_;
+    std::atomic<void *> *slot_;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_HAZARD_POINTER_H
@@ -0,0 +1,190 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_JITTER_BUFFER_H
+#define LMSHAO_LMCORE_JITTER_BUFFER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+class DataBuffer;
+
+/**
+ * @brief Reorder buffer for RTP packets, with playout deadlines and loss/NACK detection.
+ *
+ * Packets are stored in a fixed ring indexed by sequence number & mask, so inserting and
+ * popping are O(1) and never allocate; 16-bit sequence numbers and 32-bit RTP timestamps are
+ * unwrapped internally. Each packet becomes playable `delay` after the time its RTP timestamp
+ * maps to, using the earliest arrival seen so far as the reference. A missing packet holds
+ * back the packets after it until one of them is due; it is then counted as lost and skipped.
+ *
+ * Payloads are shared pointers, typically from a DataBufferPool, so buffers return to their
+ * pool once played or dropped. Not thread-safe: use it from the receiving thread or EventLoop.
+ *
+ * Usage:
+ * @code
+ * JitterBuffer jitter(512, 90000, std::chrono::milliseconds(80));
+ * jitter.Insert(seq, rtpTimestamp, payload, marker);         // per received packet
+ * while (auto packet = jitter.Pop()) {
+ *     Decode(*packet->payload);
+ * }
+ * std::vector<uint16_t> nacks;
+ * if (jitter.GetNackList(nacks) > 0) {
+ *     SendNack(nacks);
+ * }
+ * @endcode
+ */
+class JitterBuffer : public NonCopyable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Largest ring: half the sequence space, so unwrapping stays unambiguous.
+    static constexpr size_t kMaxCapacity = 32768;
+    /// @brief A missing packet is NACKed at most this many times.
+    static constexpr uint32_t kMaxNackRetries = 3;
+
+    struct Packet {
+        std::shared_ptr<DataBuffer> payload;
+        uint32_t timestamp = 0;
+        uint16_t seq = 0;
+        bool marker = false;
+    };
+
+    enum class InsertResult {
+        kInserted,
+        kDuplicate, ///< Already buffered
+        kLate,      ///< Older than the packets already played or skipped
+    };
+
+    struct Stats {
+        uint64_t received = 0;
+        uint64_t duplicates = 0;
+        uint64_t late = 0;
+        /// @brief Packets skipped at playout because they never arrived
+        uint64_t lost = 0;
+        /// @brief Buffered packets discarded because a newer packet no longer fit the ring
+        uint64_t dropped = 0;
+        uint64_t nacks = 0;
+    };
+
+    /**
+     * @brief Constructor
+     * @param capacity Ring size in packets, rounded up to a power of two (at most kMaxCapacity)
+     * @param clockRate RTP clock rate in Hz
+     * @param delay Buffering delay added to each packet's playout time
+     * @param nackInterval Minimum time between two NACKs of the same packet
+     */
+    explicit JitterBuffer(size_t capacity = 512, uint32_t clockRate = 90000,
+                          Clock::duration delay = std::chrono::milliseconds(50),
+                          Clock::duration nackInterval = std::chrono::milliseconds(20));
+    ~JitterBuffer() override;
+
+    /**
+     * @brief Buffer a received packet.
+     * @param arrival Reception time, used to map RTP time to local time
+     */
+    InsertResult Insert(uint16_t seq, uint32_t timestamp, std::shared_ptr<DataBuffer> payload, bool marker = false,
+                        Clock::time_point arrival = Clock::now());
+
+    /**
+     * @brief Take the next packet in sequence order if it is due.
+     * @return The packet, or std::nullopt if nothing is playable yet
+     */
+    std::optional<Packet> Pop(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Get the playout time of the next buffered packet, e.g. to arm a timer.
+     */
+    std::optional<Clock::time_point> GetNextPlayoutTime();
+
+    /**
+     * @brief Append the missing sequence numbers due for a (re)transmission request.
+     *
+     * A gap is reported when a later packet has arrived, then again every nackInterval up to
+     * kMaxNackRetries times while it is still missing and not yet skipped.
+     *
+     * @return Number of sequence numbers appended
+     */
+    size_t GetNackList(std::vector<uint16_t> &seqs, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Drop all packets and forget the stream's sequence and timing state. Stats are kept.
+     */
+    void Reset();
+
+    /**
+     * @brief Get the number of buffered packets.
+     */
+    size_t GetSize() const { return count_; }
+
+    /**
+     * @brief Get the ring size.
+     */
+    size_t GetCapacity() const { return slots_.size(); }
+
+    /**
+     * @brief Get the packet counters.
+     */
+    const Stats &GetStats() const { return stats_; }
+
+private:
+    struct Slot {
+        std::shared_ptr<DataBuffer> payload;
+        /// @brief Unwrapped sequence number the slot refers to, -1 if unused
+        int64_t seq = -1;
+        /// @brief Unwrapped RTP timestamp
+        int64_t timestamp = 0;
+        Clock::time_point lastNack;
+        uint32_t nackCount = 0;
+        bool present = false;
+        bool marker = false;
+    };
+
+    int64_t UnwrapSeq(uint16_t seq) const;
+    int64_t UnwrapTimestamp(uint32_t timestamp);
+    Clock::duration MediaTime(int64_t timestamp) const;
+    Clock::time_point PlayoutTime(int64_t timestamp) const;
+    /// @brief Move head_ forward to `seq`, dropping buffered packets before it and counting gaps as lost.
+    void AdvanceHead(int64_t seq);
+    /// @brief Find the first buffered packet at or after head_, -1 if none.
+    int64_t FindFirstPresent();
+
+    std::vector<Slot> slots_;
+    size_t mask_;
+    uint32_t clockRate_;
+    Clock::duration delay_;
+    Clock::duration nackInterval_;
+
+    bool started_ = false;
+    /// @brief Next sequence number to play
+    int64_t head_ = 0;
+    /// @brief Highest sequence number received
+    int64_t highest_ = 0;
+    /// @brief Slots in [head_, scan_) are known to be missing
+    int64_t scan_ = 0;
+    size_t count_ = 0;
+
+    int64_t lastTimestamp_ = 0;
+    int64_t firstTimestamp_ = 0;
+    /// @brief Smallest (arrival - media time) seen: the transit of the fastest packet
+    Clock::duration baseTransit_{};
+
+    Stats stats_;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_JITTER_BUFFER_H
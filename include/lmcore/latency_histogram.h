@@ -0,0 +1,242 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_LATENCY_HISTOGRAM_H
+#define LMSHAO_LMCORE_LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief Lock-free, fixed-memory, log-linear latency histogram (HDR style)
+ *
+ * Values are bucketed by their power of two, and every power of two is split into
+ * kSubBucketCount linear sub-buckets, so the relative error of any reported value is
+ * below 1 / kSubBucketCount (~3%). Values below kSubBucketCount are recorded exactly.
+ * The whole uint64_t range is covered by kBucketCount buckets, and all memory is
+ * allocated in the constructor.
+ *
+ * Recording is wait-free: each thread is bound to one of the recording shards and
+ * does relaxed atomic increments on it, so concurrent recorders rarely share a cache line.
+ * Snapshots merge all shards into a plain, non-atomic Snapshot that can be queried and
+ * exported (text, JSON, Prometheus) without touching the live histogram again.
+ *
+ * Values are unit-agnostic; nanoseconds are the convention used across lmcore.
+ *
+ * Example usage:
+ * @code
+ *   LatencyHistogram hist;
+ *   auto start = std::chrono::steady_clock::now();
+ *   DoWork();
+ *   hist.RecordDuration(std::chrono::steady_clock::now() - start);
+ *
+ *   auto snapshot = hist.GetSnapshot();
+ *   uint64_t p99 = snapshot.Percentile(99.0);
+ *   std::string json = snapshot.ToJson();
+ * @endcode
+ */
+class LatencyHistogram : public NonCopyable {
+public:
+    /// @brief Number of bits used for the linear sub-buckets of each power of two.
+    static constexpr uint32_t kSubBucketBits = 5;
+    /// @brief Number of linear sub-buckets per power of two.
+    static constexpr uint64_t kSubBucketCount = 1ULL << kSubBucketBits;
+    /// @brief Total number of buckets needed to cover the uint64_t range.
+    static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBucketCount;
+    /// @brief Default number of recording shards.
+    static constexpr size_t kDefaultShards = 4;
+
+    /**
+     * @brief Immutable, merged view of a histogram at one point in time.
+     */
+    class Snapshot {
+    public:
+        Snapshot();
+
+        /**
+         * @brief Get the number of recorded values.
+         */
+        uint64_t Count() const { return count_; }
+        /**
+         * @brief Get the sum of all recorded values.
+         */
+        uint64_t Sum() const { return sum_; }
+        /**
+         * @brief Get the smallest recorded value (0 if empty).
+         */
+        uint64_t Min() const { return count_ ? min_ : 0; }
+        /**
+         * @brief Get the largest recorded value.
+         */
+        uint64_t Max() const { return max_; }
+        /**
+         * @brief Get the arithmetic mean of the recorded values.
+         */
+        double Mean() const { return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+
+        /**
+         * @brief Get the value at a given percentile.
+         * @param percentile Percentile in the range [0, 100]
+         * @return The highest value equivalent to the bucket containing the percentile, clamped to [Min, Max]
+         */
+        uint64_t Percentile(double percentile) const;
+
+        /**
+         * @brief Get the per-bucket counts.
+         * @return Vector of kBucketCount counts
+         */
+        const std::vector<uint64_t> &Buckets() const { return buckets_; }
+
+        /**
+         * @brief Add the contents of another snapshot to this one.
+         * @param other The snapshot to merge
+         */
+        void Merge(const Snapshot &other);
+
+        /**
+         * @brief Format as a single human-readable line.
+         * @return e.g. "count=10 min=1 mean=5.50 p50=5 p90=9 p99=10 p999=10 max=10"
+         */
+        std::string ToText() const;
+
+        /**
+         * @brief Format as a JSON object.
+         */
+        std::string ToJson() const;
+
+        /**
+         * @brief Format as a Prometheus summary, including the TYPE line.
+         * @param name Metric name
+         * @param labels Optional label list without braces, e.g. "pool=\"io\""
+         */
+        std::string ToPrometheus(const std::string &name, const std::string &labels = "") const;
+
+        /**
+         * @brief Append the Prometheus summary samples (quantiles, _sum, _count) without a TYPE line.
+         * @param out String to append to
+         * @param name Metric name
+         * @param labels Optional label list without braces
+         */
+        void AppendPrometheusSamples(std::string &out, const std::string &name, const std::string &labels) const;
+
+    private:
+        friend class LatencyHistogram;
+
+        std::vector<uint64_t> buckets_;
+        uint64_t count_ = 0;
+        uint64_t sum_ = 0;
+        uint64_t min_ = UINT64_MAX;
+        uint64_t max_ = 0;
+    };
+
+    /**
+     * @brief Construct a histogram.
+     * @param shards Number of recording shards (rounded up to a power of two, at least 1)
+     */
+    explicit LatencyHistogram(size_t shards = kDefaultShards);
+    ~LatencyHistogram() override;
+
+    /**
+     * @brief Record a single value.
+     * @param value The value to record
+     */
+    void Record(uint64_t value) { Record(value, 1); }
+
+    /**
+     * @brief Record a value several times.
+     * @param value The value to record
+     * @param count Number of occurrences
+     */
+    void Record(uint64_t value, uint64_t count);
+
+    /**
+     * @brief Record a duration in nanoseconds. Negative durations are recorded as 0.
+     * @param duration The duration to record
+     */
+    template <typename Rep, typename Period>
+    void RecordDuration(std::chrono::duration<Rep, Period> duration)
+    {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        Record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+    }
+
+    /**
+     * @brief Add all values recorded in another histogram to this one.
+     * @param other The histogram to merge
+     */
+    void Merge(const LatencyHistogram &other);
+
+    /**
+     * @brief Add the contents of a snapshot to this histogram.
+     * @param snapshot The snapshot to merge
+     */
+    void Merge(const Snapshot &snapshot);
+
+    /**
+     * @brief Take a merged snapshot of all shards.
+     *
+     * Safe to call concurrently with Record(); values recorded during the call may or may not be included.
+     */
+    Snapshot GetSnapshot() const;
+
+    /**
+     * @brief Get the total number of recorded values.
+     */
+    uint64_t Count() const;
+
+    /**
+     * @brief Clear all recorded values.
+     */
+    void Reset();
+
+    /**
+     * @brief Get the number of recording shards.
+     */
+    size_t ShardCount() const { return shardMask_ + 1; }
+
+    /**
+     * @brief Map a value to its bucket index.
+     */
+    static size_t BucketIndex(uint64_t value);
+    /**
+     * @brief Get the smallest value mapped to a bucket.
+     */
+    static uint64_t BucketLowerBound(size_t index);
+    /**
+     * @brief Get the largest value mapped to a bucket.
+     */
+    static uint64_t BucketUpperBound(size_t index);
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> min;
+        std::atomic<uint64_t> max;
+        std::atomic<uint64_t> buckets[kBucketCount];
+    };
+
+    static void ResetShard(Shard &shard);
+    void MergeInto(Snapshot &snapshot) const;
+
+    size_t shardMask_;
+    std::unique_ptr<Shard[]> shards_;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_LATENCY_HISTOGRAM_H
@@ -9,6 +9,7 @@
 #ifndef LMSHAO_LMCORE_LOGGER_H
 #define LMSHAO_LMCORE_LOGGER_H
 
+#include <atomic>
 #include <chrono>
 #include <cstdarg>
 #include <cstdio>
@@ -21,7 +22,8 @@
 #include <sstream>
 #include <string>
 #include <typeindex>
-#include <unordered_map>
+
+#include "flat_hash_map.h"
 
 namespace lmshao::lmcore {
 
@@ -57,7 +59,7 @@ public:
     static void RegisterModule(const std::string &name)
     {
         std::lock_guard<std::mutex> lock(GetRegistryMutex());
-        GetModuleNames()[std::type_index(typeid(ModuleTag))] = name;
+        ModuleNameSlot<ModuleTag>().store(InternModuleName(name), std::memory_order_release);
     }
 
     template <typename ModuleTag>
@@ -73,16 +75,39 @@ public:
     template <typename ModuleTag>
     static std::string GetModuleName()
     {
-        std::lock_guard<std::mutex> lock(GetRegistryMutex());
-        auto it = GetModuleNames().find(std::type_index(typeid(ModuleTag)));
-        return it != GetModuleNames().end() ? it->second : "Unknown";
+        return PublishedModuleName<ModuleTag>();
     }
 
 private:
+    friend class Logger;
+
+    /**
+     * @brief Get the module name registered for a tag; a single atomic load, no lock.
+     * @return The name, or "Unknown". The string is never freed.
+     */
+    template <typename ModuleTag>
+    static const char *PublishedModuleName()
+    {
+        const char *name = ModuleNameSlot<ModuleTag>().load(std::memory_order_acquire);
+        return name ? name : "Unknown";
+    }
+
+    /// @brief Per-tag publish-once slot pointing at an interned name.
+    template <typename ModuleTag>
+    static std::atomic<const char *> &ModuleNameSlot()
+    {
+        static std::atomic<const char *> slot{nullptr};
+        return slot;
+    }
+
+    /**
+     * @brief Get a copy of name that lives until exit, so readers never race with re-registration.
+     * @note Called with the registry mutex held.
+     */
+    static const char *InternModuleName(const std::string &name);
     static class Logger &GetOrCreateLogger(std::type_index type_id, const std::string &module_name);
 
-    static std::unordered_map<std::type_index, std::unique_ptr<class Logger>> &GetLoggers();
-    static std::unordered_map<std::type_index, std::string> &GetModuleNames();
+    static FlatHashMap<std::type_index, std::unique_ptr<class Logger>> &GetLoggers();
     static std::mutex &GetRegistryMutex();
 };
 
@@ -92,11 +117,11 @@ private:
 class Logger {
 public:
     Logger(const std::string &module_name = "Unknown");
-    ~Logger() = default;
+    ~Logger();
 
     void SetOutput(LogOutput output) { output_ = output; }
-    void SetLogFile(const std::string &filename) { log_file_ = filename; }
-    void SetOutputFile(const std::string &filename) { log_file_ = filename; }
+    void SetLogFile(const std::string &filename);
+    void SetOutputFile(const std::string &filename) { SetLogFile(filename); }
     void SetLevel(LogLevel level) { level_ = level; }
     void SetModuleName(const std::string &module) { module_name_ = module; }
     LogLevel GetLevel() const { return level_; }
@@ -113,44 +138,8 @@ public:
 
         va_list args;
         va_start(args, fmt);
-
-        char buffer[4096];
-        vsnprintf(buffer, sizeof(buffer), fmt, args);
-
+        Write(level, LoggerRegistry::PublishedModuleName<ModuleTag>(), file, line, func, fmt, args);
         va_end(args);
-
-        std::string time_str = GetTimeString();
-        std::string level_str = GetLevelString(level);
-        std::string filename = GetFileName(file);
-        std::string module_name = LoggerRegistry::GetModuleName<ModuleTag>();
-
-        std::ostringstream oss;
-        oss << "[" << time_str << "] [" << level_str << "] [" << module_name << "] " << filename << ":" << line << " "
-            << func << "() - " << buffer << std::endl;
-
-        std::string log_message = oss.str();
-
-        if (output_ == LogOutput::CONSOLE || output_ == LogOutput::BOTH) {
-            std::cout << log_message;
-            std::cout.flush();
-        }
-
-        if ((output_ == LogOutput::FILE || output_ == LogOutput::BOTH) && !log_file_.empty()) {
-#ifdef _WIN32
-            FILE *fp = nullptr;
-            errno_t err = fopen_s(&fp, log_file_.c_str(), "a");
-            if (err == 0 && fp) {
-                fprintf(fp, "%s", log_message.c_str());
-                fclose(fp);
-            }
-#else
-            FILE *fp = fopen(log_file_.c_str(), "a");
-            if (fp) {
-                fprintf(fp, "%s", log_message.c_str());
-                fclose(fp);
-            }
-#endif
-        }
     }
 
     bool ShouldLog(LogLevel level) const
@@ -159,16 +148,22 @@ public:
     }
 
 private:
-    std::string GetTimeString() const;
-    std::string GetLevelString(LogLevel level) const;
+    /**
+     * @brief Format one record into a stack buffer and write it to the configured outputs.
+     * @note Does not allocate, so enabled log statements stay off the heap.
+     */
+    void Write(LogLevel level, const char *module, const char *file, int line, const char *func, const char *fmt,
+               va_list args);
+
     std::string GetColorCode(LogLevel level) const;
     std::string GetResetColor() const;
-    std::string GetFileName(const char *file) const;
 
     LogLevel level_;
     LogOutput output_;
     std::string module_name_;
     std::string log_file_;
+    /// @brief log_file_ opened on first use and kept open, guarded by mutex_.
+    FILE *file_ = nullptr;
     mutable std::mutex mutex_;
 };
 
@@ -9,6 +9,7 @@
 #ifndef LMSHAO_LMCORE_MAPPED_FILE_H
 #define LMSHAO_LMCORE_MAPPED_FILE_H
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -18,7 +19,7 @@
 namespace lmshao::lmcore {
 
 /**
- * @brief Memory-mapped file for efficient read-only file access
+ * @brief Memory-mapped file for efficient zero-copy file access
  *
  * Cross-platform implementation:
  * - Linux/macOS/Unix: mmap() with MADV_SEQUENTIAL optimization
@@ -36,6 +37,10 @@ namespace lmshao::lmcore {
  *   const uint8_t* data = file->Data();
  *   size_t size = file->Size();
  *   // Direct access: data[offset], data + offset, etc.
+ *
+ *   auto state = MappedFile::OpenWritable("state.bin", 4096);
+ *   memcpy(state->MutableData(), &record, sizeof(record));
+ *   state->Flush(0, sizeof(record));     // msync: on disk when it returns
  * @endcode
  */
 class MappedFile : public NonCopyable {
@@ -44,18 +49,57 @@ public:
 
     static std::shared_ptr<MappedFile> Open(const std::string &path);
 
+    /**
+     * @brief Map only part of a file, e.g. one chunk of a file too large to map at once.
+     * @param offset Start of the range; need not be page-aligned
+     * @param length Length of the range, clipped to the end of the file
+     * @return The mapping, whose Data() points at `offset`, or nullptr if the range is empty or on failure
+     */
+    static std::shared_ptr<MappedFile> Open(const std::string &path, uint64_t offset, size_t length);
+
+    /**
+     * @brief Map a file for reading and writing, creating it or growing it to at least `size` bytes.
+     *
+     * The mapping is shared: stores are visible to every other mapping of the file, in this
+     * process or another, and reach the disk on Flush() or whenever the OS writes them back.
+     * New space reads as zeros.
+     *
+     * @return The mapping (of the whole file, if it was larger), or nullptr on failure
+     */
+    static std::shared_ptr<MappedFile> OpenWritable(const std::string &path, size_t size);
+
     const uint8_t *Data() const { return data_; }
+    /// @brief Writable view of the mapping, nullptr unless opened with OpenWritable()
+    uint8_t *MutableData() const { return writable_ ? data_ : nullptr; }
     size_t Size() const { return size_; }
     bool IsValid() const { return data_ != nullptr && size_ > 0; }
+    bool IsWritable() const { return writable_; }
     const std::string &Path() const { return path_; }
+    /// @brief Position of Data() in the file
+    uint64_t Offset() const { return offset_; }
+    /// @brief Size of the whole file, which is larger than Size() for a ranged mapping
+    uint64_t FileSize() const { return fileSize_; }
+
+    /**
+     * @brief Write modified pages in [offset, offset + length) back to the file and wait for them.
+     * @return 0 on success, -1 on failure
+     */
+    int32_t Flush(size_t offset = 0, size_t length = SIZE_MAX) const;
 
 private:
     MappedFile() = default;
-    bool OpenImpl(const std::string &path);
+    bool OpenImpl(const std::string &path, uint64_t offset = 0, size_t length = SIZE_MAX);
+    bool OpenWritableImpl(const std::string &path, size_t size);
     void Close();
 
     uint8_t *data_ = nullptr;
     size_t size_ = 0;
+    uint64_t offset_ = 0;
+    uint64_t fileSize_ = 0;
+    /// @brief Start and length of the mapping: data_ and size_ rounded out to page boundaries
+    uint8_t *map_base_ = nullptr;
+    size_t map_size_ = 0;
+    bool writable_ = false;
     std::string path_;
 
 #ifdef _WIN32
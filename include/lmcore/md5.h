@@ -93,20 +93,58 @@ public:
      */
     static std::string CalculateFile(const std::string &path);
 
+    /**
+     * @brief Context for incremental MD5 calculation, e.g. over the chunks of a file
+     *
+     * Example:
+     * @code
+     *   MD5::Context ctx;
+     *   ctx.Update(chunk1, len1);
+     *   ctx.Update(chunk2, len2);
+     *   std::string hash = ctx.Final();
+     * @endcode
+     */
+    class Context;
+
 private:
-    struct Context {
+    struct State {
         uint32_t state[4];
         uint32_t count[2];
         uint8_t buffer[64];
     };
 
-    static void Init(Context &ctx);
-    static void Update(Context &ctx, const uint8_t *data, size_t len);
-    static void Final(Context &ctx, uint8_t digest[16]);
+    static void Init(State &ctx);
+    static void Update(State &ctx, const uint8_t *data, size_t len);
+    static void Final(State &ctx, uint8_t digest[16]);
     static void Transform(uint32_t state[4], const uint8_t block[64]);
     static std::string DigestToHex(const uint8_t digest[16]);
 };
 
+class MD5::Context {
+public:
+    Context() { MD5::Init(state_); }
+
+    /**
+     * @brief Update MD5 with binary data
+     */
+    void Update(const uint8_t *data, size_t len) { MD5::Update(state_, data, len); }
+
+    /**
+     * @brief Get the hash of the data added so far
+     * @return MD5 hash as 32-character hexadecimal string (lowercase)
+     * @note Can be called multiple times without changing state
+     */
+    std::string Final() const;
+
+    /**
+     * @brief Reset context to initial state
+     */
+    void Reset() { MD5::Init(state_); }
+
+private:
+    State state_;
+};
+
 } // namespace lmshao::lmcore
 
 #endif // LMSHAO_LMCORE_MD5_H
@@ -0,0 +1,191 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_MESSAGE_PARSER_H
+#define LMSHAO_LMCORE_MESSAGE_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+class DataBuffer;
+
+/**
+ * @brief Incremental parser for HTTP/1.x and RTSP/1.0 messages received over a stream.
+ *
+ * Received data is appended with Feed() in chunks of any size, and Next() pulls events out of
+ * it: the head of a message (start line and headers), the pieces of its body, or an RTSP
+ * interleaved binary frame ("$" channel length payload). A message split over many reads is
+ * resumed where the last scan stopped, so each byte of a head is searched once; the blank line
+ * ending a head is found with AVX2 when the CPU has it.
+ *
+ * The start line, headers and body are string_views into the parser's buffer, valid until the
+ * next Feed() (Next() never moves buffered data) and, for the head, until the next kHead or
+ * Reset(). Nothing is allocated per message once the buffer and header list have grown to the
+ * largest message seen.
+ *
+ * The body is Content-Length bytes, or chunked (Transfer-Encoding: chunked) and decoded. A
+ * message with neither has no body; HTTP/1.0 responses delimited by closing the connection are
+ * not supported. 1xx, 204 and 304 responses never have a body, nor does the response to a HEAD
+ * request, which the caller announces with ExpectHeadResponse().
+ *
+ * Usage:
+ * @code
+ * MessageParser parser;
+ * parser.Feed(*received);
+ * for (auto event = parser.Next(); event != MessageParser::Event::kNeedMore; event = parser.Next()) {
+ *     if (event == MessageParser::Event::kHead) {
+ *         auto cseq = parser.GetHeader("CSeq");
+ *     } else if (event == MessageParser::Event::kBody) {
+ *         sdp.append(parser.GetBody());
+ *     } else if (event == MessageParser::Event::kError) {
+ *         CloseConnection();
+ *         break;
+ *     }
+ * }
+ * @endcode
+ */
+class MessageParser : public NonCopyable {
+public:
+    enum class Event {
+        /// @brief The buffered data ends in the middle of something: Feed() more
+        kNeedMore,
+        /// @brief A message head: start line, headers and body length are available
+        kHead,
+        /// @brief The next piece of the current message's body, in GetBody()
+        kBody,
+        /// @brief The current message is complete (sent after its body, if any)
+        kEnd,
+        /// @brief A whole RTSP interleaved frame: GetChannel() and GetBody()
+        kInterleaved,
+        /// @brief Malformed input, see GetError(); Reset() before reusing the parser
+        kError,
+    };
+
+    struct Header {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    static constexpr size_t kDefaultMaxHeadSize = 64 * 1024;
+
+    /**
+     * @brief Constructor
+     * @param maxHeadSize Largest accepted head (start line and headers); larger ones are an error
+     */
+    explicit MessageParser(size_t maxHeadSize = kDefaultMaxHeadSize);
+    ~MessageParser() override = default;
+
+    /**
+     * @brief Append received data.
+     */
+    void Feed(const uint8_t *data, size_t size);
+    void Feed(const DataBuffer &buffer);
+
+    /**
+     * @brief Parse the next event out of the buffered data.
+     */
+    Event Next();
+
+    /**
+     * @brief Drop all buffered data and the current message, and start over with a new one.
+     */
+    void Reset();
+
+    /**
+     * @brief Announce that the next response answers a HEAD request, so it has no body even if it
+     * carries Content-Length or Transfer-Encoding. Call it before Next() reaches that response.
+     */
+    void ExpectHeadResponse() { expectHeadResponse_ = true; }
+
+    bool IsRequest() const { return isRequest_; }
+    std::string_view GetStartLine() const { return startLine_; }
+    /// @brief Request method, e.g. "GET" or "DESCRIBE"
+    std::string_view GetMethod() const { return method_; }
+    /// @brief Request target, e.g. "/index.html" or "rtsp://host/stream"
+    std::string_view GetTarget() const { return target_; }
+    /// @brief Protocol version, e.g. "HTTP/1.1" or "RTSP/1.0"
+    std::string_view GetVersion() const { return version_; }
+    /// @brief Response status code, 0 for a request
+    int32_t GetStatusCode() const { return statusCode_; }
+    std::string_view GetReason() const { return reason_; }
+    const std::vector<Header> &GetHeaders() const { return headers_; }
+
+    /**
+     * @brief Find a header by case-insensitive name.
+     * @return Value of the first header with that name, empty if there is none
+     */
+    std::string_view GetHeader(std::string_view name) const;
+
+    /**
+     * @brief Get the body length of the current message: 0 if it has none, -1 if chunked.
+     */
+    int64_t GetContentLength() const { return contentLength_; }
+    bool IsChunked() const { return contentLength_ < 0; }
+
+    /**
+     * @brief Get the body piece of a kBody event, or the payload of a kInterleaved frame.
+     */
+    std::string_view GetBody() const { return body_; }
+    uint8_t GetChannel() const { return channel_; }
+
+    const char *GetError() const { return error_; }
+
+    /**
+     * @brief Get the number of bytes fed but not yet parsed.
+     */
+    size_t GetBufferedSize() const { return buffer_.size() - pos_; }
+
+private:
+    enum class State { kHead, kBody, kEnd, kChunkSize, kChunkData, kChunkDataEnd, kTrailers, kError };
+
+    Event ParseHead();
+    Event ParseBody();
+    Event ParseChunked();
+    /// @brief Parse the head in [pos_, end) into the start line and headers; false if malformed.
+    bool ParseHeadLines(size_t end);
+    /// @brief Offset just past the blank line ending the head, or 0 if not buffered yet.
+    size_t FindHeadEnd();
+    /// @brief Offset just past the next "\n" from pos_, or 0 if not buffered yet.
+    size_t FindLineEnd() const;
+    Event Fail(const char *error);
+    std::string_view View(size_t begin, size_t end) const;
+
+    const size_t maxHeadSize_;
+    std::vector<uint8_t> buffer_;
+    /// @brief Start of the unparsed data in buffer_
+    size_t pos_ = 0;
+    /// @brief Head bytes from pos_ already searched for the terminating blank line
+    size_t scanned_ = 0;
+    State state_ = State::kHead;
+    uint64_t remaining_ = 0;
+
+    bool isRequest_ = false;
+    std::string_view startLine_;
+    std::string_view method_;
+    std::string_view target_;
+    std::string_view version_;
+    std::string_view reason_;
+    int32_t statusCode_ = 0;
+    std::vector<Header> headers_;
+    int64_t contentLength_ = 0;
+    std::string_view body_;
+    uint8_t channel_ = 0;
+    const char *error_ = "";
+    /// @brief The next response head answers a HEAD request
+    bool expectHeadResponse_ = false;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_MESSAGE_PARSER_H
@@ -0,0 +1,224 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_METRICS_H
+#define LMSHAO_LMCORE_METRICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "latency_histogram.h"
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+/// @brief Label set of a metric, e.g. {{"pool", "io"}}.
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief Get the counter shard of the calling thread.
+ *
+ * Uses the current CPU where the platform exposes it cheaply (sched_getcpu on Linux),
+ * otherwise a sticky per-thread slot.
+ * @return Shard index in [0, Counter::kShards)
+ */
+size_t CurrentMetricShard();
+
+/**
+ * @brief Monotonic counter sharded per CPU.
+ *
+ * Every shard lives on its own cache line, so concurrent increments from different
+ * CPUs never contend. Reading sums all shards.
+ */
+class Counter : public NonCopyable {
+public:
+    /// @brief Number of shards (power of two).
+    static constexpr size_t kShards = 16;
+
+    Counter() = default;
+
+    /**
+     * @brief Increase the counter.
+     * @param n Amount to add
+     */
+    void Increment(uint64_t n = 1) { cells_[CurrentMetricShard()].value.fetch_add(n, std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the current value (sum of all shards).
+     */
+    uint64_t Value() const
+    {
+        uint64_t total = 0;
+        for (const auto &cell : cells_) {
+            total += cell.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Reset the counter to zero.
+     */
+    void Reset()
+    {
+        for (auto &cell : cells_) {
+            cell.value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<uint64_t> value{0};
+    };
+
+    Cell cells_[kShards];
+};
+
+/**
+ * @brief Gauge holding a signed value that can go up and down.
+ */
+class Gauge : public NonCopyable {
+public:
+    Gauge() = default;
+
+    void Set(int64_t value) { value_.store(value, std::memory_order_relaxed); }
+    void Add(int64_t delta) { value_.fetch_add(delta, std::memory_order_relaxed); }
+    void Sub(int64_t delta) { value_.fetch_sub(delta, std::memory_order_relaxed); }
+    void Increment() { Add(1); }
+    void Decrement() { Sub(1); }
+    int64_t Value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<int64_t> value_{0};
+};
+
+/**
+ * @brief Library-wide registry of named counters, gauges and latency histograms
+ *
+ * Metrics are created on first lookup and live until process exit, so the returned
+ * references can be cached and used on hot paths without touching the registry again.
+ * Looking up the same name and labels twice returns the same metric. Export can be
+ * triggered from any thread.
+ *
+ * lmcore registers its own internals under the "lmcore_" prefix (ThreadPool, TaskQueue,
+ * AsyncTimer, DataBuffer::PoolAlloc and ObjectPool).
+ *
+ * Example usage:
+ * @code
+ *   auto &registry = MetricsRegistry::GetInstance();
+ *   auto &requests = registry.GetCounter("http_requests_total", {{"method", "GET"}}, "Handled requests");
+ *   requests.Increment();
+ *
+ *   auto &latency = registry.GetHistogram("http_latency_ns");
+ *   latency.Record(elapsedNs);
+ *
+ *   std::string body = registry.ExportPrometheus();
+ * @endcode
+ */
+class MetricsRegistry : public NonCopyable {
+public:
+    /**
+     * @brief Metric kinds.
+     */
+    enum class Type {
+        kCounter = 0,
+        kGauge = 1,
+        kHistogram = 2
+    };
+
+    /**
+     * @brief Get the process-wide registry.
+     */
+    static MetricsRegistry &GetInstance();
+
+    /**
+     * @brief Get or create a counter.
+     * @param name Metric name
+     * @param labels Metric labels
+     * @param help Help text (used when the metric family is first created)
+     * @return Reference valid until process exit
+     */
+    Counter &GetCounter(const std::string &name, const MetricLabels &labels = {}, const std::string &help = "");
+
+    /**
+     * @brief Get or create a gauge.
+     * @param name Metric name
+     * @param labels Metric labels
+     * @param help Help text (used when the metric family is first created)
+     * @return Reference valid until process exit
+     */
+    Gauge &GetGauge(const std::string &name, const MetricLabels &labels = {}, const std::string &help = "");
+
+    /**
+     * @brief Get or create a latency histogram.
+     * @param name Metric name
+     * @param labels Metric labels
+     * @param help Help text (used when the metric family is first created)
+     * @return Reference valid until process exit
+     */
+    LatencyHistogram &GetHistogram(const std::string &name, const MetricLabels &labels = {},
+                                   const std::string &help = "");
+
+    /**
+     * @brief Export all metrics, one per line ("name{labels} value").
+     */
+    std::string ExportText() const;
+
+    /**
+     * @brief Export all metrics as a JSON array of objects.
+     */
+    std::string ExportJson() const;
+
+    /**
+     * @brief Export all metrics in the Prometheus text exposition format.
+     *
+     * Histograms are exported as summaries.
+     */
+    std::string ExportPrometheus() const;
+
+    /**
+     * @brief Reset all counters and histograms to zero (metrics stay registered).
+     *
+     * Gauges mirror live state and are left untouched.
+     */
+    void ResetAll();
+
+private:
+    struct Series {
+        MetricLabels labels;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<LatencyHistogram> histogram;
+    };
+
+    struct Family {
+        Type type;
+        std::string help;
+        // Keyed by the formatted label string, so export order is stable
+        std::map<std::string, Series> series;
+    };
+
+    MetricsRegistry() = default;
+
+    Series &GetSeries(Type type, const std::string &name, const MetricLabels &labels, const std::string &help);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;
+    // Metrics handed out for a name already registered with another type; never exported
+    std::vector<std::unique_ptr<Series>> orphans_;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_METRICS_H
@@ -14,8 +14,10 @@
 #include <memory>
 #include <optional>
 #include <thread>
+#include <utility>
 #include <vector>
 
+#include "channel_notifier.h"
 #include "noncopyable.h"
 
 namespace lmshao::lmcore::sync {
@@ -31,13 +33,15 @@ class MpscReceiver;
  * @brief Create a bounded MPSC (Multi-Producer Single-Consumer) channel.
  * @tparam T Element type
  * @param capacity Channel capacity
+ * @param withNotifier Attach a ChannelNotifier so the receiver can be waited on with poll/epoll
  * @return A pair of (Sender, Receiver)
  *
  * Similar to Rust's std::sync::mpsc::sync_channel.
  * Multiple threads can send concurrently, but only one thread should receive.
  */
 template <typename T>
-std::pair<std::shared_ptr<MpscSender<T>>, std::unique_ptr<MpscReceiver<T>>> MpscChannel(size_t capacity);
+std::pair<std::shared_ptr<MpscSender<T>>, std::unique_ptr<MpscReceiver<T>>> MpscChannel(size_t capacity,
+                                                                                        bool withNotifier = false);
 
 /**
  * @brief Lock-free MPSC circular queue implementation.
@@ -94,7 +98,7 @@ public:
             }
 
             if (tail_.compare_exchange_weak(t, t + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
-                buffer_[static_cast<size_t>(t % static_cast<uint64_t>(capacity_))].emplace(value);
+                Fill(t, value);
                 return true;
             }
         }
@@ -111,7 +115,7 @@ public:
             }
 
             if (tail_.compare_exchange_weak(t, t + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
-                buffer_[static_cast<size_t>(t % static_cast<uint64_t>(capacity_))].emplace(std::move(value));
+                Fill(t, std::move(value));
                 return true;
             }
         }
@@ -119,9 +123,6 @@ public:
 
     std::optional<T> TryPop()
     {
-        constexpr int max_spin_count = 100;
-        int spin_count = 0;
-
         uint64_t h = head_.load(std::memory_order_relaxed);
         uint64_t t = tail_.load(std::memory_order_acquire);
 
@@ -129,24 +130,9 @@ public:
             return std::nullopt;
         }
 
-        auto &slot = buffer_[static_cast<size_t>(h % static_cast<uint64_t>(capacity_))];
-        while (!slot.has_value()) {
-            if (++spin_count > max_spin_count) {
-                std::this_thread::yield();
-                spin_count = 0;
-                h = head_.load(std::memory_order_relaxed);
-                t = tail_.load(std::memory_order_acquire);
-                if (t == h) {
-                    return std::nullopt;
-                }
-                slot = buffer_[static_cast<size_t>(h % static_cast<uint64_t>(capacity_))];
-            } else {
-                std::this_thread::yield();
-            }
-        }
-
-        std::optional<T> result(std::move(slot.value()));
-        slot.reset();
+        Slot &slot = WaitFilled(h);
+        std::optional<T> result(std::move(*slot.value));
+        Drain(slot);
         head_.store(h + 1, std::memory_order_release);
         return result;
     }
@@ -156,15 +142,47 @@ public:
         uint64_t h = head_.load(std::memory_order_relaxed);
         uint64_t t = tail_.load(std::memory_order_relaxed);
         while (h != t) {
-            buffer_[static_cast<size_t>(h % static_cast<uint64_t>(capacity_))].reset();
+            Drain(WaitFilled(h));
             ++h;
         }
         head_.store(t, std::memory_order_release);
     }
 
 private:
+    struct Slot {
+        std::optional<T> value;
+        /// @brief Set once the producer that claimed the slot has constructed the value
+        std::atomic<bool> filled{false};
+    };
+
+    template <typename U>
+    void Fill(uint64_t index, U &&value)
+    {
+        Slot &slot = buffer_[static_cast<size_t>(index % static_cast<uint64_t>(capacity_))];
+        slot.value.emplace(std::forward<U>(value));
+        slot.filled.store(true, std::memory_order_release);
+    }
+
+    Slot &WaitFilled(uint64_t index)
+    {
+        // The producer that claimed the slot may not have filled it yet. Only this consumer moves
+        // head_, so the slot stays ours while we wait
+        Slot &slot = buffer_[static_cast<size_t>(index % static_cast<uint64_t>(capacity_))];
+        while (!slot.filled.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        return slot;
+    }
+
+    /// @brief Empty the slot; publishing head_ afterwards hands it back to the producers
+    static void Drain(Slot &slot)
+    {
+        slot.value.reset();
+        slot.filled.store(false, std::memory_order_relaxed);
+    }
+
     size_t capacity_;
-    std::vector<std::optional<T>> buffer_;
+    std::vector<Slot> buffer_;
     std::atomic<uint64_t> head_;
     std::atomic<uint64_t> tail_;
 };
@@ -178,12 +196,17 @@ private:
 template <typename T>
 class MpscSender : public NonCopyable {
 public:
-    bool TrySend(T value) { return queue_->TryPush(std::move(value)); }
+    /// @brief `value` is only moved from on success, so a failed attempt can be retried with it
+    bool TrySend(T &&value) { return Pushed(queue_->TryPush(std::move(value))); }
+    bool TrySend(const T &value) { return Pushed(queue_->TryPush(value)); }
 
     bool Send(T value)
     {
         while (!closed_->load(std::memory_order_acquire)) {
             if (queue_->TryPush(std::move(value))) {
+                if (notifier_) {
+                    notifier_->Notify();
+                }
                 return true;
             }
             std::this_thread::yield();
@@ -193,19 +216,37 @@ public:
 
     bool IsClosed() const { return closed_->load(std::memory_order_acquire); }
 
-    void Close() { closed_->store(true, std::memory_order_release); }
+    void Close()
+    {
+        closed_->store(true, std::memory_order_release);
+        // Wake a waiting receiver so it can observe the closure
+        if (notifier_) {
+            notifier_->Notify();
+        }
+    }
 
 private:
     template <typename U>
-    friend std::pair<std::shared_ptr<MpscSender<U>>, std::unique_ptr<MpscReceiver<U>>> MpscChannel(size_t);
+    friend std::pair<std::shared_ptr<MpscSender<U>>, std::unique_ptr<MpscReceiver<U>>> MpscChannel(size_t, bool);
 
-    explicit MpscSender(std::shared_ptr<MpscCircularQueue<T>> queue, std::shared_ptr<std::atomic<bool>> closed)
-        : queue_(std::move(queue)), closed_(std::move(closed))
+    explicit MpscSender(std::shared_ptr<MpscCircularQueue<T>> queue, std::shared_ptr<std::atomic<bool>> closed,
+                        std::shared_ptr<ChannelNotifier> notifier)
+        : queue_(std::move(queue)), closed_(std::move(closed)), notifier_(std::move(notifier))
     {
     }
 
+    bool Pushed(bool pushed)
+    {
+        if (pushed && notifier_) {
+            notifier_->Notify();
+        }
+        return pushed;
+    }
+
     std::shared_ptr<MpscCircularQueue<T>> queue_;
     std::shared_ptr<std::atomic<bool>> closed_;
+    /// @brief Null unless the channel was created with a notifier.
+    std::shared_ptr<ChannelNotifier> notifier_;
 };
 
 /**
@@ -237,27 +278,55 @@ public:
 
     bool IsClosed() const { return closed_->load(std::memory_order_acquire); }
 
+    /**
+     * @brief Get the channel's notifier, nullptr if it was created without one.
+     */
+    ChannelNotifier *GetNotifier() const { return notifier_.get(); }
+
+    /**
+     * @brief Ask to be notified of the next send. Call after TryRecv() found the channel empty.
+     * @return true if armed and it is safe to wait on the notifier's fd; false if messages arrived
+     * meanwhile, the channel is closed or there is no notifier, so keep receiving instead
+     */
+    bool ArmNotifier()
+    {
+        if (!notifier_) {
+            return false;
+        }
+        notifier_->Arm();
+        if (!queue_->Empty() || closed_->load(std::memory_order_acquire)) {
+            notifier_->Disarm();
+            return false;
+        }
+        return true;
+    }
+
 private:
     template <typename U>
-    friend std::pair<std::shared_ptr<MpscSender<U>>, std::unique_ptr<MpscReceiver<U>>> MpscChannel(size_t);
+    friend std::pair<std::shared_ptr<MpscSender<U>>, std::unique_ptr<MpscReceiver<U>>> MpscChannel(size_t, bool);
 
-    explicit MpscReceiver(std::shared_ptr<MpscCircularQueue<T>> queue, std::shared_ptr<std::atomic<bool>> closed)
-        : queue_(std::move(queue)), closed_(std::move(closed))
+    explicit MpscReceiver(std::shared_ptr<MpscCircularQueue<T>> queue, std::shared_ptr<std::atomic<bool>> closed,
+                          std::shared_ptr<ChannelNotifier> notifier)
+        : queue_(std::move(queue)), closed_(std::move(closed)), notifier_(std::move(notifier))
     {
     }
 
     std::shared_ptr<MpscCircularQueue<T>> queue_;
     std::shared_ptr<std::atomic<bool>> closed_;
+    /// @brief Null unless the channel was created with a notifier.
+    std::shared_ptr<ChannelNotifier> notifier_;
 };
 
 template <typename T>
-std::pair<std::shared_ptr<MpscSender<T>>, std::unique_ptr<MpscReceiver<T>>> MpscChannel(size_t capacity)
+std::pair<std::shared_ptr<MpscSender<T>>, std::unique_ptr<MpscReceiver<T>>> MpscChannel(size_t capacity,
+                                                                                        bool withNotifier)
 {
     auto queue = std::make_shared<MpscCircularQueue<T>>(capacity);
     auto closed = std::make_shared<std::atomic<bool>>(false);
+    auto notifier = withNotifier ? std::make_shared<ChannelNotifier>() : nullptr;
 
-    auto sender = std::shared_ptr<MpscSender<T>>(new MpscSender<T>(queue, closed));
-    auto receiver = std::unique_ptr<MpscReceiver<T>>(new MpscReceiver<T>(queue, closed));
+    auto sender = std::shared_ptr<MpscSender<T>>(new MpscSender<T>(queue, closed, notifier));
+    auto receiver = std::unique_ptr<MpscReceiver<T>>(new MpscReceiver<T>(queue, closed, notifier));
 
     return std::make_pair(std::move(sender), std::move(receiver));
 }
@@ -12,8 +12,13 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
+#include "metrics.h"
+#include "profiled_mutex.h"
+#include "recycling_allocator.h"
+
 namespace lmshao::lmcore {
 
 /**
@@ -22,6 +27,9 @@ namespace lmshao::lmcore {
  *
  * This class provides a thread-safe object pool that can be used by any class
  * to manage instances of type T. Each class can have its own independent pool.
+ *
+ * Hits, misses and releases are counted in MetricsRegistry as lmcore_objectpool_acquire_total
+ * and lmcore_objectpool_release_total, labelled with the pool name.
  */
 template <typename T>
 class ObjectPool {
@@ -37,12 +45,21 @@ public:
      * @param resetter Function to reset object state before reuse (optional)
      * @param deleter Function to delete objects (optional, uses delete by default)
      * @param maxPoolSize Maximum number of objects to keep in pool (default: 100)
+     * @param name Pool name used as the "pool" label of its metrics
      */
     explicit ObjectPool(ObjectFactory factory = nullptr, ObjectResetter resetter = nullptr,
-                        ObjectDeleter deleter = nullptr, size_t maxPoolSize = 100)
+                        ObjectDeleter deleter = nullptr, size_t maxPoolSize = 100,
+                        const std::string &name = "object_pool")
         : factory_(factory ? std::move(factory) : []() { return new T(); }), resetter_(std::move(resetter)),
           deleter_(deleter ? std::move(deleter) : [](T *obj) { delete obj; }), maxPoolSize_(maxPoolSize)
     {
+        auto &registry = MetricsRegistry::GetInstance();
+        const char *acquire = "lmcore_objectpool_acquire_total";
+        const char *release = "lmcore_objectpool_release_total";
+        hits_ = &registry.GetCounter(acquire, {{"pool", name}, {"result", "hit"}}, "ObjectPool acquisitions");
+        misses_ = &registry.GetCounter(acquire, {{"pool", name}, {"result", "miss"}});
+        pooled_ = &registry.GetCounter(release, {{"pool", name}, {"result", "pooled"}}, "ObjectPool releases");
+        dropped_ = &registry.GetCounter(release, {{"pool", name}, {"result", "dropped"}});
     }
 
     /**
@@ -50,7 +67,7 @@ public:
      */
     ~ObjectPool()
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         for (T *obj : pool_) {
             deleter_(obj);
         }
@@ -66,7 +83,7 @@ public:
         T *obj = nullptr;
 
         {
-            std::lock_guard<std::mutex> lock(mutex_);
+            std::lock_guard<InternalMutex> lock(mutex_);
             if (!pool_.empty()) {
                 obj = pool_.back();
                 pool_.pop_back();
@@ -74,13 +91,17 @@ public:
         }
 
         if (!obj) {
+            misses_->Increment();
             obj = factory_();
-        } else if (resetter_) {
-            resetter_(obj);
+        } else {
+            hits_->Increment();
+            if (resetter_) {
+                resetter_(obj);
+            }
         }
 
         // Return shared_ptr with custom deleter that returns object to pool
-        return ObjectPtr(obj, [this](T *ptr) { this->Release(ptr); });
+        return ObjectPtr(obj, [this](T *ptr) { this->Release(ptr); }, RecyclingAllocator<T>());
     }
 
     /**
@@ -89,7 +110,7 @@ public:
      */
     size_t GetPoolSize() const
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         return pool_.size();
     }
 
@@ -105,7 +126,7 @@ public:
      */
     void SetMaxPoolSize(size_t maxSize)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         maxPoolSize_ = maxSize;
 
         // Remove excess objects if new max size is smaller
@@ -121,7 +142,7 @@ public:
      */
     void Clear()
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         for (T *obj : pool_) {
             deleter_(obj);
         }
@@ -139,11 +160,13 @@ private:
             return;
         }
 
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         if (pool_.size() < maxPoolSize_) {
             pool_.push_back(obj);
+            pooled_->Increment();
         } else {
             deleter_(obj);
+            dropped_->Increment();
         }
     }
 
@@ -157,9 +180,14 @@ private:
     size_t maxPoolSize_;
 
     /// @brief Mutex for thread safety.
-    mutable std::mutex mutex_;
+    mutable InternalMutex mutex_ LMCORE_MUTEX_INIT("ObjectPool");
     /// @brief Pool of available objects.
     std::vector<T *> pool_;
+
+    Counter *hits_;
+    Counter *misses_;
+    Counter *pooled_;
+    Counter *dropped_;
 };
 
 /**
@@ -0,0 +1,292 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_PARALLEL_ORDERED_STAGE_H
+#define LMSHAO_LMCORE_PARALLEL_ORDERED_STAGE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "noncopyable.h"
+#include "thread_pool.h"
+
+namespace lmshao::lmcore {
+
+struct ParallelOrderedOptions {
+    /// @brief Threads of the stage's own pool; unused when a ThreadPool is given
+    size_t workers = 2;
+    /// @brief Size of the reorder ring: at most this many items are in flight
+    size_t window = 64;
+    /// @brief Name of the stage's own pool threads, and of the stage in logs
+    std::string name = "Ordered";
+};
+
+namespace detail {
+
+/**
+ * @brief Sequence bookkeeping of a ParallelOrderedStage: how many items were released in order,
+ * who is releasing them, and waiting for the ring to drain.
+ */
+class OrderedWindow : public NonCopyable {
+public:
+    explicit OrderedWindow(size_t window);
+
+    size_t GetWindow() const { return window_; }
+    uint64_t GetReleased() const { return released_.load(std::memory_order_seq_cst); }
+
+    /**
+     * @brief Block until at least `count` items were released.
+     */
+    void WaitReleased(uint64_t count);
+
+    /**
+     * @brief Take the releaser role; only one thread releases at a time.
+     * @return false if another thread holds it
+     */
+    bool TryBeginRelease() { return !releasing_.exchange(true, std::memory_order_seq_cst); }
+
+    /**
+     * @brief Releaser side: `count` items are now released, wake anyone waiting for room.
+     */
+    void Publish(uint64_t count);
+
+    void EndRelease() { releasing_.store(false, std::memory_order_seq_cst); }
+
+private:
+    const size_t window_;
+    std::atomic<uint64_t> released_{0};
+    std::atomic<bool> releasing_{false};
+    std::atomic<uint32_t> waiting_{0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+void LogOrderedStageException(const std::string &stage, const char *what);
+void LogOrderedStageRejected(const std::string &stage);
+
+} // namespace detail
+
+/**
+ * @brief Runs an expensive, stateless function over a stream of items on several threads and
+ * hands the results on in input order.
+ *
+ * Items are numbered as they are submitted and each is processed as a separate ThreadPool task,
+ * so uneven items balance across the threads. Results are parked in a reorder ring indexed by
+ * sequence number; whichever thread completes the oldest outstanding item releases it, and every
+ * consecutive result behind it, to the output callback. The output callback is therefore never
+ * called concurrently and always sees the input order, although from varying threads.
+ *
+ * The ring has `window` slots and Submit() waits while they are all taken, so at most `window`
+ * items are in flight: one slow item holds the others back rather than growing memory, and a
+ * blocking output callback holds Submit() back the same way.
+ *
+ * A function returning std::optional filters: std::nullopt drops the item, as does an exception,
+ * which is logged. Submit(), Flush() and Close() must be called from one thread at a time, and not
+ * from a task of the pool doing the work. A shared pool that is shut down rejects further items,
+ * which are dropped; shutting it down with items still queued loses them and Flush() never returns.
+ *
+ * Usage:
+ * @code
+ * ParallelOrderedStage<Frame, Packet> compress(
+ *     [](Frame frame) { return Compress(frame); },
+ *     [&](Packet packet) { muxer.Write(packet); },   // in frame order
+ *     {4, 16});
+ * while (auto frame = capture.Read()) {
+ *     compress.Submit(std::move(*frame));
+ * }
+ * compress.Close();
+ * @endcode
+ */
+template <typename In, typename Out>
+class ParallelOrderedStage : public NonCopyable {
+public:
+    using Transform = std::function<std::optional<Out>(In)>;
+    using Output = std::function<void(Out)>;
+
+    /**
+     * @param fn Called with each item on a pool thread
+     * @param output Called with each result, in input order
+     * @param pool Pool to run on; it must outlive the stage. nullptr to create one with `options.workers` threads
+     */
+    ParallelOrderedStage(Transform fn, Output output, ParallelOrderedOptions options = {}, ThreadPool *pool = nullptr)
+        : name_(std::move(options.name)), fn_(std::move(fn)), output_(std::move(output)),
+          ring_(options.window == 0 ? 1 : options.window), slots_(new Slot[ring_.GetWindow()])
+    {
+        if (pool) {
+            pool_ = pool;
+        } else {
+            int workers = static_cast<int>(options.workers == 0 ? 1 : options.workers);
+            ownedPool_ = std::make_unique<ThreadPool>(workers, workers, name_);
+            pool_ = ownedPool_.get();
+        }
+    }
+
+    ~ParallelOrderedStage() override { Close(); }
+
+    /**
+     * @brief Queue an item, waiting while the reorder ring is full.
+     * @return false if the stage is closed, or if the pool is shut down and the item was dropped
+     */
+    bool Submit(In item)
+    {
+        if (closed_) {
+            return false;
+        }
+        uint64_t seq = submitted_;
+        if (seq - ring_.GetReleased() >= ring_.GetWindow()) {
+            windowWaits_.fetch_add(1, std::memory_order_relaxed);
+            ring_.WaitReleased(seq - ring_.GetWindow() + 1);
+        }
+        // The slot's previous item was released, so nobody else touches it
+        slots_[Index(seq)].input.emplace(std::move(item));
+        submitted_ = seq + 1;
+        tasks_.fetch_add(1, std::memory_order_relaxed);
+        if (!pool_->AddTask([this, seq]() { Process(seq); })) {
+            // Its slot still has to be released, or the ring stops at it
+            detail::LogOrderedStageRejected(name_);
+            slots_[Index(seq)].input.reset();
+            Complete(seq);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Wait until every submitted item went through the output callback, or was dropped.
+     */
+    void Flush()
+    {
+        ring_.WaitReleased(submitted_);
+        // A task may still be finishing its release attempt after its item went out
+        while (tasks_.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Flush, stop accepting items and stop the stage's own pool.
+     */
+    void Close()
+    {
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        Flush();
+        if (ownedPool_) {
+            ownedPool_->Shutdown();
+        }
+    }
+
+    bool IsClosed() const { return closed_; }
+    size_t GetWindow() const { return ring_.GetWindow(); }
+
+    /**
+     * @brief Items submitted but not yet released, at most GetWindow(). Call it from the submitting thread.
+     */
+    size_t GetInFlight() const { return static_cast<size_t>(submitted_ - ring_.GetReleased()); }
+
+    /**
+     * @brief Times Submit() found the ring full: the oldest item or the output callback holds the stage back.
+     */
+    uint64_t GetWindowWaits() const { return windowWaits_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::optional<In> input;
+        std::optional<Out> output;
+        /// @brief seq + 1 once item seq has its result in the slot
+        std::atomic<uint64_t> ready{0};
+    };
+
+    size_t Index(uint64_t seq) const { return static_cast<size_t>(seq % ring_.GetWindow()); }
+
+    void Process(uint64_t seq)
+    {
+        Slot &slot = slots_[Index(seq)];
+        In input = std::move(*slot.input);
+        slot.input.reset();
+        try {
+            slot.output = fn_(std::move(input));
+        } catch (const std::exception &e) {
+            detail::LogOrderedStageException(name_, e.what());
+        } catch (...) {
+            detail::LogOrderedStageException(name_, "unknown exception");
+        }
+        Complete(seq);
+    }
+
+    /// @brief Mark item seq done, with or without a result, and release what is ready
+    void Complete(uint64_t seq)
+    {
+        slots_[Index(seq)].ready.store(seq + 1, std::memory_order_seq_cst);
+
+        // Either this thread sees the head ready after the releaser gave up its role, or the releaser sees it
+        while (HeadReady() && ring_.TryBeginRelease()) {
+            Release();
+            ring_.EndRelease();
+        }
+        // Last access to the stage: once every task got here, Flush() returns and the stage may go away
+        tasks_.fetch_sub(1, std::memory_order_release);
+    }
+
+    bool HeadReady() const
+    {
+        uint64_t head = ring_.GetReleased();
+        return slots_[Index(head)].ready.load(std::memory_order_seq_cst) == head + 1;
+    }
+
+    void Release()
+    {
+        uint64_t head = ring_.GetReleased();
+        for (;;) {
+            Slot &slot = slots_[Index(head)];
+            if (slot.ready.load(std::memory_order_acquire) != head + 1) {
+                break;
+            }
+            if (slot.output) {
+                try {
+                    output_(std::move(*slot.output));
+                } catch (const std::exception &e) {
+                    detail::LogOrderedStageException(name_, e.what());
+                } catch (...) {
+                    detail::LogOrderedStageException(name_, "unknown exception");
+                }
+                slot.output.reset();
+            }
+            ring_.Publish(++head);
+        }
+    }
+
+    const std::string name_;
+    Transform fn_;
+    Output output_;
+    detail::OrderedWindow ring_;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<ThreadPool> ownedPool_;
+    ThreadPool *pool_ = nullptr;
+    uint64_t submitted_ = 0;
+    /// @brief Tasks queued or running
+    std::atomic<size_t> tasks_{0};
+    std::atomic<uint64_t> windowWaits_{0};
+    bool closed_ = false;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_PARALLEL_ORDERED_STAGE_H
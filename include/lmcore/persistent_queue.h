@@ -0,0 +1,146 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_PERSISTENT_QUEUE_H
+#define LMSHAO_LMCORE_PERSISTENT_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+class DataBuffer;
+class MappedFile;
+
+/**
+ * @brief Durable single-producer/single-consumer FIFO of byte records, backed by memory-mapped files.
+ *
+ * The queue is a directory holding a small header file with the producer and consumer cursors
+ * and a sequence of fixed-size segment files the records are written to. A segment is created
+ * when the producer reaches its end and deleted once the consumer has moved past it, so the
+ * directory grows and shrinks with the backlog.
+ *
+ * Push() writes the record into the mapped segment, msyncs it, and only then advances and
+ * msyncs the producer cursor; Pop() does the same for the consumer cursor. After a crash the
+ * queue therefore holds exactly the records whose Push() returned and not their Pop(): a
+ * record being processed when the consumer died is delivered again. With sync = false the
+ * msyncs are skipped, which still survives a process crash (the pages live in the page cache)
+ * but not a power loss.
+ *
+ * The producer and the consumer may be two threads or two processes, each with its own
+ * PersistentQueue on the same directory; they share nothing but the mapped header, whose
+ * cursors are lock-free atomics. Records are read in place: Front() points into the mapping.
+ * The header is in native byte order, so the files are not portable across architectures.
+ *
+ * Usage:
+ * @code
+ * // recorder process
+ * auto queue = PersistentQueue::Open("/var/spool/recorder");
+ * queue->Push(*frame);
+ *
+ * // uploader process
+ * auto queue = PersistentQueue::Open("/var/spool/recorder");
+ * while (auto record = queue->Front()) {
+ *     Upload(record->data, record->size);
+ *     queue->Pop();
+ * }
+ * @endcode
+ */
+class PersistentQueue : public NonCopyable {
+public:
+    /// @brief A record in place in the mapping; valid until the next Pop() on the same queue.
+    struct Record {
+        const uint8_t *data = nullptr;
+        size_t size = 0;
+    };
+
+    /// @brief Length prefix of each record, which also keeps records 8-byte aligned.
+    static constexpr size_t kRecordHeaderSize = 8;
+    static constexpr size_t kDefaultSegmentSize = 16 * 1024 * 1024;
+
+    ~PersistentQueue() override;
+
+    /**
+     * @brief Open or create a queue.
+     * @param dir Directory holding the queue, created if missing
+     * @param segmentSize Size of each segment file, for a new queue; an existing queue keeps its own.
+     *        Records can be up to segmentSize - kRecordHeaderSize bytes.
+     * @return The queue, or nullptr on failure
+     */
+    static std::shared_ptr<PersistentQueue> Open(const std::string &dir, size_t segmentSize = kDefaultSegmentSize);
+
+    /**
+     * @brief Append a record (producer side).
+     * @param sync Wait until the record and the cursor that publishes it are on disk
+     * @return 0 on success, -1 on failure or if the record is larger than a segment
+     */
+    int32_t Push(const uint8_t *data, size_t size, bool sync = true);
+    int32_t Push(const DataBuffer &record, bool sync = true);
+
+    /**
+     * @brief Get the oldest record without removing it (consumer side).
+     * @return The record, or std::nullopt if the queue is empty
+     */
+    std::optional<Record> Front();
+
+    /**
+     * @brief Remove the oldest record (consumer side).
+     *
+     * Consumed segments are deleted once the cursor past them is on disk: right away with sync, and
+     * otherwise when the cursor moves into a new segment, which then costs one header flush.
+     *
+     * @param sync Wait until the consumer cursor is on disk
+     * @return 0 on success, -1 if the queue is empty or on failure
+     */
+    int32_t Pop(bool sync = true);
+
+    bool Empty() const;
+
+    /**
+     * @brief Get the number of records pushed and not yet popped.
+     */
+    uint64_t GetSize() const;
+
+    size_t GetSegmentSize() const { return segmentSize_; }
+    const std::string &GetDirectory() const { return dir_; }
+
+private:
+    struct Header;
+
+    explicit PersistentQueue(std::string dir);
+    int32_t OpenImpl(size_t segmentSize);
+    std::string SegmentPath(uint64_t index) const;
+    /// @brief Map segment `index` into `slot`, creating the file if needed.
+    MappedFile *MapSegment(std::shared_ptr<MappedFile> &slot, uint64_t &slotIndex, uint64_t index, bool create);
+    /// @brief Delete the segments before the durable consumer cursor.
+    void RemoveConsumedSegments();
+
+    const std::string dir_;
+    size_t segmentSize_ = 0;
+    std::shared_ptr<MappedFile> headerFile_;
+    Header *header_ = nullptr;
+
+    // Producer state
+    std::shared_ptr<MappedFile> writeSegment_;
+    uint64_t writeIndex_ = UINT64_MAX;
+
+    // Consumer state
+    std::shared_ptr<MappedFile> readSegment_;
+    uint64_t readIndex_ = UINT64_MAX;
+    /// @brief Segments below this index are already deleted
+    uint64_t removedBelow_ = 0;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_PERSISTENT_QUEUE_H
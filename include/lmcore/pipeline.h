@@ -0,0 +1,659 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_PIPELINE_H
+#define LMSHAO_LMCORE_PIPELINE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "latency_histogram.h"
+#include "noncopyable.h"
+#include "parallel_ordered_stage.h"
+#include "spsc_channel.h"
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief How a pipeline worker waits for input, or for room in the next stage's channel.
+ */
+enum class WaitStrategy {
+    /// @brief Busy-poll: lowest latency, but burns the core; pair it with pinning
+    kSpin,
+    /// @brief Poll, yielding the CPU between attempts
+    kYield,
+    /// @brief Sleep on a channel notifier until woken
+    kBlock,
+};
+
+struct PipelineStageOptions {
+    /// @brief Number of worker threads running the stage. 0 picks the default: one thread, or one per CPU
+    /// for the own pool of an ordered stage
+    size_t workers = 0;
+    /// @brief CPUs to pin the workers to: worker i runs on cpus[i % cpus.size()]; empty to not pin
+    std::vector<int> cpus;
+    WaitStrategy wait = WaitStrategy::kBlock;
+    /// @brief Capacity of each channel into the stage; a full channel holds the previous stage back
+    size_t capacity = 64;
+};
+
+struct PipelineStageStats {
+    std::string name;
+    size_t workers = 0;
+    /// @brief Items the stage function ran on
+    uint64_t items = 0;
+    /// @brief Items the stage function filtered out (returned std::nullopt) or threw on
+    uint64_t dropped = 0;
+    /// @brief Average throughput since the pipeline started
+    double itemsPerSecond = 0.0;
+    /// @brief Times a worker found its input empty: the stage is waiting on upstream
+    uint64_t inputWaits = 0;
+    /// @brief Times a worker found the next stage's channel full: the stage is held back by downstream
+    uint64_t outputWaits = 0;
+    /// @brief Times an ordered stage found its reorder ring full: the oldest item in flight holds the
+    /// others back, or downstream holds back its release, which outputWaits then shows too. 0 for other stages
+    uint64_t windowWaits = 0;
+    /// @brief Nanoseconds spent in the stage function per item
+    LatencyHistogram::Snapshot latency;
+    /// @brief Nanoseconds items waited in the stage's input channels
+    LatencyHistogram::Snapshot queueDelay;
+};
+
+namespace detail {
+
+/// @brief Counters and histograms shared by the workers of one stage.
+class PipelineStageState : public NonCopyable {
+public:
+    PipelineStageState(std::string name, PipelineStageOptions options);
+
+    const std::string &GetName() const { return name_; }
+    const PipelineStageOptions &GetOptions() const { return options_; }
+    void MarkStarted() { start_ = std::chrono::steady_clock::now(); }
+    PipelineStageStats GetStats() const;
+
+    LatencyHistogram latency;
+    LatencyHistogram queueDelay;
+    std::atomic<uint64_t> items{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> inputWaits{0};
+    std::atomic<uint64_t> outputWaits{0};
+
+private:
+    const std::string name_;
+    const PipelineStageOptions options_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/// @brief Name the calling thread after its stage and pin it as the options say.
+void SetupPipelineWorker(const PipelineStageState &state, size_t worker);
+/// @brief Wait until `notifier` is signaled, then clear it.
+void WaitPipelineNotifier(sync::ChannelNotifier *notifier);
+/// @brief One idle round of a polling strategy.
+void PipelineIdle(WaitStrategy wait);
+void LogPipelineException(const std::string &stage, const char *what);
+
+template <typename T>
+struct PipelineMessage {
+    /// @brief Empty for an item dropped upstream, passed on to keep the workers in step
+    std::optional<T> value;
+    std::chrono::steady_clock::time_point sent;
+};
+
+/**
+ * @brief SPSC channels from every worker of a stage to every worker of the next: link m * consumers + n.
+ *
+ * Item j (in input order) is handled by worker j % N of each N-worker stage. Worker n therefore
+ * knows that its next item comes from producer j % M, and sends its result to consumer j % N':
+ * each channel has one producer and one consumer, and order is kept without any reordering.
+ */
+template <typename T>
+struct PipelineLinks {
+    using Message = PipelineMessage<T>;
+
+    PipelineLinks(size_t producers, size_t consumers, size_t capacity, WaitStrategy producerWait,
+                  WaitStrategy consumerWait)
+        : producers(producers), consumers(consumers), producerWait(producerWait), consumerWait(consumerWait)
+    {
+        for (size_t i = 0; i < producers * consumers; ++i) {
+            auto channel = sync::SpscChannel<Message>(capacity, consumerWait == WaitStrategy::kBlock);
+            senders.push_back(std::move(channel.first));
+            receivers.push_back(std::move(channel.second));
+            space.push_back(producerWait == WaitStrategy::kBlock ? std::make_unique<sync::ChannelNotifier>()
+                                                                  : nullptr);
+        }
+    }
+
+    /// @brief Send over link (m, n), waiting while it is full. Returns whether it had to wait.
+    bool Send(size_t m, size_t n, Message message)
+    {
+        size_t link = m * consumers + n;
+        auto &sender = senders[link];
+        bool waited = false;
+        while (sender->IsFull()) {
+            waited = true;
+            if (space[link]) {
+                space[link]->Arm();
+                if (!sender->IsFull()) {
+                    space[link]->Disarm();
+                    break;
+                }
+                WaitPipelineNotifier(space[link].get());
+            } else {
+                PipelineIdle(producerWait);
+            }
+        }
+        sender->TrySend(std::move(message));
+        return waited;
+    }
+
+    /// @brief Receive from link (m, n), waiting while it is empty; std::nullopt once closed and drained.
+    std::optional<Message> Receive(size_t m, size_t n, bool &waited)
+    {
+        size_t link = m * consumers + n;
+        auto &receiver = receivers[link];
+        waited = false;
+        for (;;) {
+            auto message = receiver->TryRecv();
+            if (message) {
+                if (space[link]) {
+                    space[link]->Notify();
+                }
+                return message;
+            }
+            if (receiver->IsClosed()) {
+                // Closing happens after the last send, so one more look finds anything sent before it
+                message = receiver->TryRecv();
+                return message;
+            }
+            waited = true;
+            if (consumerWait == WaitStrategy::kBlock) {
+                if (receiver->ArmNotifier()) {
+                    WaitPipelineNotifier(receiver->GetNotifier());
+                }
+            } else {
+                PipelineIdle(consumerWait);
+            }
+        }
+    }
+
+    void CloseProducer(size_t m)
+    {
+        for (size_t n = 0; n < consumers; ++n) {
+            senders[m * consumers + n]->Close();
+        }
+    }
+
+    const size_t producers;
+    const size_t consumers;
+    const WaitStrategy producerWait;
+    const WaitStrategy consumerWait;
+    std::vector<std::unique_ptr<sync::SpscSender<Message>>> senders;
+    std::vector<std::unique_ptr<sync::SpscReceiver<Message>>> receivers;
+    /// @brief Signaled by the consumer after each receive, for a producer waiting for room
+    std::vector<std::unique_ptr<sync::ChannelNotifier>> space;
+};
+
+/// @brief A stage function returning std::optional<T> filters: std::nullopt drops the item.
+template <typename R>
+struct PipelineResult {
+    using Type = R;
+    static constexpr bool kFilter = false;
+};
+
+template <typename R>
+struct PipelineResult<std::optional<R>> {
+    using Type = R;
+    static constexpr bool kFilter = true;
+};
+
+template <typename Fn, typename In>
+using PipelineStageOutput = typename PipelineResult<std::invoke_result_t<Fn &, In &&>>::Type;
+
+/// @brief Type-erased stage, connected and started when the pipeline is built.
+class PipelineStageBase : public NonCopyable {
+public:
+    explicit PipelineStageBase(std::string name, PipelineStageOptions options)
+        : state_(std::move(name), std::move(options))
+    {
+    }
+
+    size_t GetWorkers() const { return state_.GetOptions().workers; }
+    WaitStrategy GetWait() const { return state_.GetOptions().wait; }
+    /// @brief Number of workers sending to the next stage
+    virtual size_t GetProducers() const { return GetWorkers(); }
+    const PipelineStageState &GetState() const { return state_; }
+    virtual PipelineStageStats GetStats() const { return state_.GetStats(); }
+
+    /// @brief Create the channels into the stage from `producers` upstream workers.
+    virtual void Connect(size_t producers, WaitStrategy producerWait) = 0;
+    /// @brief Start the workers, sending to the input of `next`, or nowhere for the sink.
+    virtual void Start(PipelineStageBase *next, std::vector<std::thread> &threads) = 0;
+    virtual std::shared_ptr<void> GetInput() const = 0;
+
+protected:
+    PipelineStageState state_;
+};
+
+template <typename In, typename Out, typename Fn>
+class PipelineStage : public PipelineStageBase {
+public:
+    PipelineStage(std::string name, Fn fn, PipelineStageOptions options)
+        : PipelineStageBase(std::move(name), std::move(options)), fn_(std::move(fn))
+    {
+    }
+
+    void Connect(size_t producers, WaitStrategy producerWait) override
+    {
+        const auto &options = state_.GetOptions();
+        input_ = std::make_shared<PipelineLinks<In>>(producers, options.workers, options.capacity, producerWait,
+                                                     options.wait);
+    }
+
+    void Start(PipelineStageBase *next, std::vector<std::thread> &threads) override
+    {
+        if constexpr (!std::is_void_v<Out>) {
+            output_ = std::static_pointer_cast<PipelineLinks<Out>>(next->GetInput());
+        }
+        state_.MarkStarted();
+        for (size_t n = 0; n < state_.GetOptions().workers; ++n) {
+            threads.emplace_back([this, n]() {
+                SetupPipelineWorker(state_, n);
+                Run(n);
+            });
+        }
+    }
+
+    std::shared_ptr<void> GetInput() const override { return input_; }
+
+private:
+    void Run(size_t n)
+    {
+        const size_t workers = input_->consumers;
+        for (uint64_t j = n;; j += workers) {
+            bool waited = false;
+            auto message = input_->Receive(static_cast<size_t>(j % input_->producers), n, waited);
+            if (!message) {
+                break;
+            }
+            if (waited) {
+                state_.inputWaits.fetch_add(1, std::memory_order_relaxed);
+            }
+            auto received = std::chrono::steady_clock::now();
+            state_.queueDelay.RecordDuration(received - message->sent);
+
+            if constexpr (std::is_void_v<Out>) {
+                if (message->value) {
+                    Invoke(std::move(*message->value), received);
+                }
+            } else {
+                PipelineMessage<Out> result;
+                if (message->value) {
+                    result.value = Invoke(std::move(*message->value), received);
+                }
+                result.sent = std::chrono::steady_clock::now();
+                if (output_->Send(n, static_cast<size_t>(j % output_->consumers), std::move(result))) {
+                    state_.outputWaits.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+        if constexpr (!std::is_void_v<Out>) {
+            output_->CloseProducer(n);
+        }
+    }
+
+    /// @brief Run the stage function on one item; returns its result, std::nullopt if dropped.
+    auto Invoke(In &&value, std::chrono::steady_clock::time_point start)
+    {
+        using Result = std::conditional_t<std::is_void_v<Out>, bool, std::optional<Out>>;
+        Result result{};
+        try {
+            if constexpr (std::is_void_v<Out>) {
+                fn_(std::move(value));
+                result = true;
+            } else if constexpr (PipelineResult<std::invoke_result_t<Fn &, In &&>>::kFilter) {
+                result = fn_(std::move(value));
+            } else {
+                result.emplace(fn_(std::move(value)));
+            }
+        } catch (const std::exception &e) {
+            LogPipelineException(state_.GetName(), e.what());
+        } catch (...) {
+            LogPipelineException(state_.GetName(), "unknown exception");
+        }
+        state_.latency.RecordDuration(std::chrono::steady_clock::now() - start);
+        state_.items.fetch_add(1, std::memory_order_relaxed);
+        if (!result) {
+            state_.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    Fn fn_;
+    std::shared_ptr<PipelineLinks<In>> input_;
+    std::shared_ptr<PipelineLinks<std::conditional_t<std::is_void_v<Out>, In, Out>>> output_;
+};
+
+/**
+ * @brief Stage running its function on a ThreadPool through a ParallelOrderedStage.
+ *
+ * One worker receives the items and submits them; results leave in order from whichever pool
+ * thread releases them, so the next stage sees a single producer.
+ */
+template <typename In, typename Out, typename Fn>
+class PipelineOrderedStage : public PipelineStageBase {
+public:
+    PipelineOrderedStage(std::string name, Fn fn, PipelineStageOptions options, ThreadPool *pool)
+        : PipelineStageBase(std::move(name), std::move(options)), fn_(std::move(fn)), pool_(pool)
+    {
+    }
+
+    size_t GetProducers() const override { return 1; }
+
+    void Connect(size_t producers, WaitStrategy producerWait) override
+    {
+        const auto &options = state_.GetOptions();
+        input_ = std::make_shared<PipelineLinks<In>>(producers, 1, options.capacity, producerWait, options.wait);
+    }
+
+    void Start(PipelineStageBase *next, std::vector<std::thread> &threads) override
+    {
+        output_ = std::static_pointer_cast<PipelineLinks<Out>>(next->GetInput());
+        const auto &options = state_.GetOptions();
+        ParallelOrderedOptions ordered;
+        ordered.workers = options.workers;
+        ordered.window = std::max(options.capacity, options.workers);
+        ordered.name = state_.GetName();
+        stage_ = std::make_unique<ParallelOrderedStage<In, Out>>([this](In value) { return Invoke(std::move(value)); },
+                                                                 [this](Out value) { Send(std::move(value)); },
+                                                                 std::move(ordered), pool_);
+        state_.MarkStarted();
+        threads.emplace_back([this]() {
+            SetupPipelineWorker(state_, 0);
+            Run();
+        });
+    }
+
+    std::shared_ptr<void> GetInput() const override { return input_; }
+
+    PipelineStageStats GetStats() const override
+    {
+        PipelineStageStats stats = state_.GetStats();
+        stats.windowWaits = stage_ ? stage_->GetWindowWaits() : 0;
+        return stats;
+    }
+
+private:
+    void Run()
+    {
+        for (uint64_t j = 0;; ++j) {
+            bool waited = false;
+            auto message = input_->Receive(static_cast<size_t>(j % input_->producers), 0, waited);
+            if (!message) {
+                break;
+            }
+            if (waited) {
+                state_.inputWaits.fetch_add(1, std::memory_order_relaxed);
+            }
+            state_.queueDelay.RecordDuration(std::chrono::steady_clock::now() - message->sent);
+            if (!message->value) {
+                continue; // dropped upstream; with a single producer downstream there is nobody to keep in step
+            }
+            stage_->Submit(std::move(*message->value));
+        }
+        stage_->Flush();
+        output_->CloseProducer(0);
+    }
+
+    /// @brief Runs on the pool threads, concurrently.
+    std::optional<Out> Invoke(In &&value)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::optional<Out> result;
+        try {
+            if constexpr (PipelineResult<std::invoke_result_t<Fn &, In &&>>::kFilter) {
+                result = fn_(std::move(value));
+            } else {
+                result.emplace(fn_(std::move(value)));
+            }
+        } catch (const std::exception &e) {
+            LogPipelineException(state_.GetName(), e.what());
+        } catch (...) {
+            LogPipelineException(state_.GetName(), "unknown exception");
+        }
+        state_.latency.RecordDuration(std::chrono::steady_clock::now() - start);
+        state_.items.fetch_add(1, std::memory_order_relaxed);
+        if (!result) {
+            state_.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    /// @brief Called in order, by one pool thread at a time.
+    void Send(Out &&value)
+    {
+        size_t n = static_cast<size_t>(sent_++ % output_->consumers);
+        if (output_->Send(0, n, {std::move(value), std::chrono::steady_clock::now()})) {
+            state_.outputWaits.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    Fn fn_;
+    ThreadPool *pool_;
+    std::shared_ptr<PipelineLinks<In>> input_;
+    std::shared_ptr<PipelineLinks<Out>> output_;
+    std::unique_ptr<ParallelOrderedStage<In, Out>> stage_;
+    uint64_t sent_ = 0;
+};
+
+} // namespace detail
+
+template <typename In, typename Out>
+class PipelineBuilder;
+
+/**
+ * @brief A chain of stages, each on its own worker threads, connected by bounded SPSC channels.
+ *
+ * Built with PipelineBuilder. Items pushed in go through every stage in order and end in the
+ * sink. A stage can run on several workers: item j goes to worker j % N, which makes every
+ * channel single-producer single-consumer and keeps the items in order without a reorder step.
+ * A stage function returning std::optional drops the item on std::nullopt. Round-robin ties each
+ * item to one worker, so an expensive stage with uneven items is better added with
+ * PipelineBuilder::OrderedStage(), which balances them over a ThreadPool and reorders.
+ *
+ * Channels are bounded, so a slow stage fills its input channels and holds everything before it
+ * back, down to Push(): memory stays bounded and the pipeline runs at the pace of its slowest
+ * stage. GetStats() shows which one that is.
+ *
+ * Usage:
+ * @code
+ * auto pipeline = PipelineBuilder<Packet>("video")
+ *                     .Stage("decode", [](Packet p) { return Decode(p); }, {2})
+ *                     .Stage("scale", [](Frame f) { return Scale(f); })
+ *                     .Sink("encode", [&](Frame f) { encoder.Encode(f); });
+ * while (auto packet = capture.Read()) {
+ *     pipeline->Push(std::move(*packet));     // waits while the pipeline is full
+ * }
+ * pipeline->Close();                          // everything pushed reaches the sink
+ * @endcode
+ */
+template <typename In>
+class Pipeline : public NonCopyable {
+public:
+    ~Pipeline() override { Close(); }
+
+    /**
+     * @brief Feed an item into the first stage, waiting while its channel is full.
+     * Push() and Close() must be called from one thread at a time.
+     * @return false if the pipeline is closed
+     */
+    bool Push(In item)
+    {
+        if (closed_) {
+            return false;
+        }
+        size_t n = static_cast<size_t>(pushed_++ % source_->consumers);
+        source_->Send(0, n, {std::move(item), std::chrono::steady_clock::now()});
+        return true;
+    }
+
+    /**
+     * @brief Stop accepting items, let every stage drain, and join the workers.
+     */
+    void Close()
+    {
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        source_->CloseProducer(0);
+        for (auto &thread : threads_) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+    bool IsClosed() const { return closed_; }
+    const std::string &GetName() const { return name_; }
+
+    /**
+     * @brief Get the statistics of every stage, in pipeline order.
+     */
+    std::vector<PipelineStageStats> GetStats() const
+    {
+        std::vector<PipelineStageStats> stats;
+        for (const auto &stage : stages_) {
+            stats.push_back(stage->GetStats());
+        }
+        return stats;
+    }
+
+private:
+    template <typename, typename>
+    friend class PipelineBuilder;
+
+    Pipeline(std::string name, std::vector<std::unique_ptr<detail::PipelineStageBase>> stages)
+        : name_(std::move(name)), stages_(std::move(stages))
+    {
+        for (size_t i = 0; i < stages_.size(); ++i) {
+            if (i == 0) {
+                stages_[i]->Connect(1, stages_[i]->GetWait());
+            } else {
+                stages_[i]->Connect(stages_[i - 1]->GetProducers(), stages_[i - 1]->GetWait());
+            }
+        }
+        source_ = std::static_pointer_cast<detail::PipelineLinks<In>>(stages_[0]->GetInput());
+        for (size_t i = 0; i < stages_.size(); ++i) {
+            stages_[i]->Start(i + 1 < stages_.size() ? stages_[i + 1].get() : nullptr, threads_);
+        }
+    }
+
+    const std::string name_;
+    std::vector<std::unique_ptr<detail::PipelineStageBase>> stages_;
+    std::shared_ptr<detail::PipelineLinks<In>> source_;
+    std::vector<std::thread> threads_;
+    uint64_t pushed_ = 0;
+    bool closed_ = false;
+};
+
+/**
+ * @brief Declares the stages of a Pipeline.
+ * @tparam In Type of the items pushed into the pipeline
+ * @tparam Out Type of the items produced by the last stage declared so far
+ */
+template <typename In, typename Out = In>
+class PipelineBuilder {
+public:
+    explicit PipelineBuilder(std::string name = "Pipeline") : name_(std::move(name)) {}
+
+    /**
+     * @brief Add a stage.
+     * @param name Stage name, used for its threads and statistics
+     * @param fn Called with each Out item; returns the item for the next stage, or std::optional of it
+     * @param options Workers, pinning, wait strategy and channel capacity
+     */
+    template <typename Fn>
+    PipelineBuilder<In, detail::PipelineStageOutput<Fn, Out>> Stage(std::string name, Fn fn,
+                                                                    PipelineStageOptions options = {})
+    {
+        using Next = detail::PipelineStageOutput<Fn, Out>;
+        Add(std::make_unique<detail::PipelineStage<Out, Next, Fn>>(std::move(name), std::move(fn),
+                                                                    std::move(options)));
+        return Chain<Next>();
+    }
+
+    /**
+     * @brief Add a stage whose function runs on a thread pool, with its results put back in input order.
+     *
+     * Items are balanced over the pool as they come, instead of round-robin over fixed workers, and
+     * a reorder ring of options.capacity slots bounds how far they may get ahead of the oldest one.
+     * fn runs concurrently with itself, so it must not keep state between items.
+     *
+     * @param options workers sizes the stage's own pool when `pool` is nullptr, and the default of 0
+     *        means one thread per CPU; capacity sizes the input channel and the reorder ring; cpus
+     *        applies to the worker receiving the items only
+     * @param pool Pool to run on, outliving the pipeline; nullptr to create one
+     */
+    template <typename Fn>
+    PipelineBuilder<In, detail::PipelineStageOutput<Fn, Out>> OrderedStage(std::string name, Fn fn,
+                                                                           PipelineStageOptions options = {},
+                                                                           ThreadPool *pool = nullptr)
+    {
+        using Next = detail::PipelineStageOutput<Fn, Out>;
+        if (!pool && options.workers == 0) {
+            options.workers = std::max(1U, std::thread::hardware_concurrency());
+        }
+        Add(std::make_unique<detail::PipelineOrderedStage<Out, Next, Fn>>(std::move(name), std::move(fn),
+                                                                           std::move(options), pool));
+        return Chain<Next>();
+    }
+
+    /**
+     * @brief Add the last stage and start the pipeline.
+     * @param fn Called with each Out item
+     */
+    template <typename Fn>
+    std::unique_ptr<Pipeline<In>> Sink(std::string name, Fn fn, PipelineStageOptions options = {})
+    {
+        Add(std::make_unique<detail::PipelineStage<Out, void, Fn>>(std::move(name), std::move(fn),
+                                                                    std::move(options)));
+        return std::unique_ptr<Pipeline<In>>(new Pipeline<In>(std::move(name_), std::move(stages_)));
+    }
+
+private:
+    template <typename, typename>
+    friend class PipelineBuilder;
+
+    void Add(std::unique_ptr<detail::PipelineStageBase> stage) { stages_.push_back(std::move(stage)); }
+
+    template <typename Next>
+    PipelineBuilder<In, Next> Chain()
+    {
+        PipelineBuilder<In, Next> next(std::move(name_));
+        next.stages_ = std::move(stages_);
+        return next;
+    }
+
+    std::string name_;
+    std::vector<std::unique_ptr<detail::PipelineStageBase>> stages_;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_PIPELINE_H
@@ -0,0 +1,89 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_PROFILED_MUTEX_H
+#define LMSHAO_LMCORE_PROFILED_MUTEX_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "adaptive_mutex.h"
+#include "latency_histogram.h"
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief Per-name lock statistics shared by every ProfiledMutex with that name.
+ */
+struct ProfiledMutexStats;
+
+/**
+ * @brief std::mutex drop-in that measures contention.
+ *
+ * Every acquisition records its hold time; acquisitions that find the lock taken also record
+ * how long they waited and the call site that waited. Statistics are aggregated by name, so
+ * all ThreadPool instances, for example, report as one lock. Wait and hold times are exported
+ * through MetricsRegistry as lmcore_mutex_wait_ns / lmcore_mutex_hold_ns, labelled with the name.
+ *
+ * Call sites are symbolized with dladdr; executables need -rdynamic for their own symbols,
+ * otherwise they are shown as module+offset for addr2line.
+ *
+ * Satisfies Lockable; pair it with std::condition_variable_any.
+ */
+class ProfiledMutex : public NonCopyable {
+public:
+    /**
+     * @brief Construct a profiled mutex.
+     * @param name Name the statistics are aggregated under
+     */
+    explicit ProfiledMutex(const char *name = "unnamed");
+
+    void lock();
+    bool try_lock();
+    void unlock();
+
+    /**
+     * @brief Format the most contended locks, ordered by total wait time.
+     * @param top Maximum number of locks to list
+     * @return One block per lock with counts, wait/hold percentiles and the top waiting call sites
+     */
+    static std::string Report(size_t top = 10);
+
+    /**
+     * @brief Reset the statistics of all profiled mutexes.
+     */
+    static void ResetAll();
+
+private:
+    void RecordContended(uint64_t waitNs, void *caller);
+
+    std::mutex mutex_;
+    ProfiledMutexStats *stats_;
+    std::chrono::steady_clock::time_point acquiredAt_;
+};
+
+// Mutex types used by lmcore internals, whose critical sections are short: AdaptiveMutex by
+// default, ProfiledMutex when configured with -DLMCORE_MUTEX_PROFILING=ON. Members are declared
+// as `InternalMutex mutex_ LMCORE_MUTEX_INIT("Name");`.
+#if defined(LMCORE_MUTEX_PROFILING)
+using InternalMutex = ProfiledMutex;
+using InternalCondVar = std::condition_variable_any;
+#define LMCORE_MUTEX_INIT(name) {name}
+#else
+using InternalMutex = AdaptiveMutex;
+using InternalCondVar = AdaptiveCondVar;
+#define LMCORE_MUTEX_INIT(name) {}
+#endif
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_PROFILED_MUTEX_H
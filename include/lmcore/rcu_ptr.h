@@ -0,0 +1,125 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_RCU_PTR_H
+#define LMSHAO_LMCORE_RCU_PTR_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "epoch.h"
+#include "noncopyable.h"
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief Pointer to read-mostly shared state (configuration, routing tables, ...).
+ *
+ * Readers get an immutable snapshot without touching any shared counter, unlike copying a
+ * std::shared_ptr. Writers publish a new object and the old one is reclaimed through an
+ * EpochDomain once the last reader of it is gone.
+ *
+ * Usage:
+ * @code
+ * RcuPtr<Routes> routes(std::make_unique<Routes>());
+ * {
+ *     auto snapshot = routes.Read();            // valid until snapshot goes out of scope
+ *     Forward(snapshot->Lookup(key));
+ * }
+ * routes.Update([](Routes &copy) { copy.Add(key, target); });
+ * @endcode
+ */
+template <typename T>
+class RcuPtr : public NonCopyable {
+public:
+    /**
+     * @brief Read-side critical section holding one snapshot.
+     */
+    class ReadGuard : public NonCopyable {
+    public:
+        const T *get() const { return ptr_; }
+        const T *operator->() const { return ptr_; }
+        const T &operator*() const { return *ptr_; }
+        explicit operator bool() const { return ptr_ != nullptr; }
+
+    private:
+        friend class RcuPtr;
+        ReadGuard(EpochDomain &domain, const std::atomic<T *> &ptr)
+            : guard_(domain), ptr_(ptr.load(std::memory_order_acquire))
+        {
+        }
+
+        EpochGuard guard_;
+        const T *ptr_;
+    };
+
+    explicit RcuPtr(std::unique_ptr<T> value = nullptr, EpochDomain &domain = EpochDomain::Default())
+        : domain_(domain), ptr_(value.release())
+    {
+    }
+
+    /**
+     * @note No reader may still hold a snapshot.
+     */
+    ~RcuPtr() override { delete ptr_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Pin the current value for reading.
+     */
+    ReadGuard Read() const { return ReadGuard(domain_, ptr_); }
+
+    /**
+     * @brief Copy the current value out.
+     * @return The value, or a default-constructed T if empty
+     */
+    T Load() const
+    {
+        ReadGuard guard = Read();
+        return guard ? *guard : T();
+    }
+
+    /**
+     * @brief Replace the value; the previous one is retired.
+     */
+    void Store(std::unique_ptr<T> value)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        Publish(value.release());
+    }
+
+    /**
+     * @brief Read-copy-update: apply fn to a copy of the current value and publish the copy.
+     * Writers are serialized, so concurrent updates are never lost.
+     */
+    template <typename Fn>
+    void Update(Fn &&fn)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        const T *current = ptr_.load(std::memory_order_acquire);
+        auto next = current ? std::make_unique<T>(*current) : std::make_unique<T>();
+        std::forward<Fn>(fn)(*next);
+        Publish(next.release());
+    }
+
+private:
+    void Publish(T *next)
+    {
+        T *old = ptr_.exchange(next, std::memory_order_acq_rel);
+        domain_.Retire(old);
+    }
+
+    EpochDomain &domain_;
+    std::atomic<T *> ptr_;
+    std::mutex writeMutex_;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_RCU_PTR_H
@@ -0,0 +1,133 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_RECORD_LOG_H
+#define LMSHAO_LMCORE_RECORD_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "noncopyable.h"
+#include "profiled_mutex.h"
+
+namespace lmshao::lmcore {
+
+class DataBuffer;
+
+/**
+ * @brief Durable append-only log of CRC-checked records, stored as a directory of segment files.
+ *
+ * Each record is framed as a 4-byte big-endian length, a CRC32 of the length and payload, and
+ * the payload. Records are numbered from 0; a segment file is named after the number of its
+ * first record and preallocated to the segment size, so appends don't extend the file and the
+ * unused tail reads as zeros, which never passes the CRC.
+ *
+ * Appends are durable when they return (unless sync is false). Concurrent appenders share
+ * fdatasync calls (group commit): one thread syncs everything written so far while the others
+ * wait for it, so N threads appending at once cost about one sync rather than N. A segment is
+ * synced before the next one is created, so a crash can only tear the last segment; on Open()
+ * it is truncated at the first record with a bad CRC.
+ *
+ * Replay() maps segments with MappedFile and walks them sequentially. POSIX only: Open() fails
+ * on Windows.
+ *
+ * Usage:
+ * @code
+ * auto log = RecordLog::Open("/var/lib/app/events");
+ * log->Append(*buffer);                     // returns once on disk
+ * log->Replay([](uint64_t seq, const uint8_t *data, size_t size) {
+ *     Apply(data, size);
+ *     return true;                          // false stops the replay
+ * });
+ * @endcode
+ */
+class RecordLog : public NonCopyable {
+public:
+    using Visitor = std::function<bool(uint64_t seq, const uint8_t *data, size_t size)>;
+
+    /// @brief Length and CRC prefix of each record.
+    static constexpr size_t kHeaderSize = 8;
+    static constexpr size_t kDefaultSegmentSize = 64 * 1024 * 1024;
+
+    ~RecordLog() override;
+
+    /**
+     * @brief Open or create a log, recovering the end of its last segment.
+     * @param dir Directory holding the segments, created if missing
+     * @param segmentSize Preallocated size of each segment; also the largest record plus header
+     * @return The log, or nullptr on failure
+     */
+    static std::shared_ptr<RecordLog> Open(const std::string &dir, size_t segmentSize = kDefaultSegmentSize);
+
+    /**
+     * @brief Append a record.
+     * @param sync Wait until the record is on stable storage
+     * @return Record number, or -1 on failure
+     */
+    int64_t Append(const uint8_t *data, size_t size, bool sync = true);
+    int64_t Append(const DataBuffer &record, bool sync = true);
+
+    /**
+     * @brief Make every record appended so far durable.
+     * @return 0 on success, -1 on failure
+     */
+    int32_t Sync();
+
+    /**
+     * @brief Visit records in order, from fromSeq to the end of the log.
+     * @return 0 on success (including when the visitor stopped early), -1 if a segment can't be read
+     * @note Records appended while replaying may or may not be visited.
+     */
+    int32_t Replay(const Visitor &visitor, uint64_t fromSeq = 0) const;
+
+    /**
+     * @brief Get the number the next appended record will get.
+     */
+    uint64_t GetNextSeq() const;
+
+    /**
+     * @brief Get the number of segment files.
+     */
+    size_t GetSegmentCount() const;
+
+    const std::string &GetDirectory() const { return dir_; }
+
+private:
+    struct Segment;
+
+    RecordLog(std::string dir, size_t segmentSize);
+    int32_t OpenImpl();
+    std::shared_ptr<Segment> CreateSegment(uint64_t baseSeq);
+    int32_t Rotate();
+    /// @brief Wait until appendedBytes_ reaches `end` on disk, syncing as leader if nobody is.
+    int32_t WaitDurable(std::unique_lock<InternalMutex> &lock, uint64_t end);
+
+    const std::string dir_;
+    const size_t segmentSize_;
+
+    mutable InternalMutex mutex_ LMCORE_MUTEX_INIT("RecordLog");
+    InternalCondVar syncCond_;
+    std::shared_ptr<Segment> active_;
+    std::vector<uint64_t> segmentBases_;
+    uint64_t writeOffset_ = 0;
+    uint64_t nextSeq_ = 0;
+
+    /// @brief Bytes written and bytes known durable since Open(), over all segments
+    uint64_t appendedBytes_ = 0;
+    uint64_t syncedBytes_ = 0;
+    bool syncing_ = false;
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_RECORD_LOG_H
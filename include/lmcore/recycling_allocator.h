@@ -0,0 +1,83 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_RECYCLING_ALLOCATOR_H
+#define LMSHAO_LMCORE_RECYCLING_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+namespace lmshao::lmcore {
+
+namespace detail {
+/**
+ * @brief Take a block of at least `bytes` from the calling thread's free lists, or the heap.
+ */
+void *RecyclingAllocate(size_t bytes);
+/**
+ * @brief Keep a block from RecyclingAllocate on the calling thread's free lists for reuse.
+ */
+void RecyclingDeallocate(void *p, size_t bytes);
+} // namespace detail
+
+/**
+ * @brief Allocator that recycles small blocks through per-thread free lists.
+ *
+ * Meant for short-lived bookkeeping allocations on hot paths, such as the control block of a
+ * shared_ptr with a custom deleter or a coroutine frame. Blocks up to 256 bytes are kept in
+ * 16-byte size classes and blocks up to 2 KiB in 128-byte classes, a bounded number per class
+ * and thread; a block freed on another thread simply joins that thread's lists. Larger or
+ * over-aligned requests go straight to operator new.
+ *
+ * @tparam T Value type
+ */
+template <typename T>
+class RecyclingAllocator {
+public:
+    using value_type = T;
+
+    RecyclingAllocator() noexcept = default;
+
+    template <typename U>
+    RecyclingAllocator(const RecyclingAllocator<U> &) noexcept
+    {
+    }
+
+    T *allocate(size_t n)
+    {
+        if (alignof(T) > alignof(std::max_align_t)) {
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+        return static_cast<T *>(detail::RecyclingAllocate(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, size_t n) noexcept
+    {
+        if (alignof(T) > alignof(std::max_align_t)) {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+            return;
+        }
+        detail::RecyclingDeallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const RecyclingAllocator<U> &) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const RecyclingAllocator<U> &) const noexcept
+    {
+        return false;
+    }
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_RECYCLING_ALLOCATOR_H
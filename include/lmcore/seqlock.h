@@ -0,0 +1,118 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_SEQLOCK_H
+#define LMSHAO_LMCORE_SEQLOCK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include "noncopyable.h"
+
+namespace lmshao::lmcore::sync {
+
+/**
+ * @brief Sequence lock publishing the latest value of a small trivially copyable T.
+ *
+ * The writer never waits: it bumps the sequence to odd, copies the value and bumps it back to
+ * even. Readers copy optimistically and retry if the sequence changed meanwhile, so they never
+ * slow the writer down, however many there are. Best for values of a few cache lines that are
+ * overwritten often (statistics, estimates, pointers plus metadata).
+ *
+ * There is one writer at a time; concurrent writers must be serialized by the caller.
+ *
+ * Example:
+ * @code
+ * SeqLock<BitrateEstimate> estimate;
+ * estimate.Store({bps, timestamp});        // writer thread
+ * BitrateEstimate latest = estimate.Load(); // any thread
+ * @endcode
+ */
+template <typename T>
+class SeqLock : public NonCopyable {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type");
+
+public:
+    explicit SeqLock(const T &value = T()) { Store(value); }
+
+    /**
+     * @brief Publish a new value (wait-free).
+     */
+    void Store(const T &value)
+    {
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        // Keeps the data stores below from moving above the odd sequence
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) {
+            data_[i].store(words[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Read a consistent copy of the latest value.
+     */
+    T Load() const
+    {
+        T value;
+        for (int attempt = 1; !TryLoad(value); ++attempt) {
+            // The writer may have been preempted in the middle of a store
+            if (attempt % 64 == 0) {
+                std::this_thread::yield();
+            }
+        }
+        return value;
+    }
+
+    /**
+     * @brief Read once without retrying.
+     * @return false if a write overlapped the read; value is left unchanged then
+     */
+    bool TryLoad(T &value) const
+    {
+        uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        uint64_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = data_[i].load(std::memory_order_relaxed);
+        }
+        // Keeps the data loads above from moving below the second sequence load
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(&value, words, sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief Get the number of completed stores, to tell cheaply whether the value changed.
+     */
+    uint64_t Version() const { return seq_.load(std::memory_order_acquire) >> 1; }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    // The payload is kept in atomic words so that a torn read is merely discarded, not a data race
+    alignas(64) std::atomic<uint64_t> seq_{0};
+    std::atomic<uint64_t> data_[kWords] = {};
+};
+
+} // namespace lmshao::lmcore::sync
+
+#endif // LMSHAO_LMCORE_SEQLOCK_H
@@ -9,6 +9,7 @@
 #ifndef LMSHAO_LMCORE_SINGLETON_H
 #define LMSHAO_LMCORE_SINGLETON_H
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -52,22 +53,44 @@ protected:
 template <typename T>
 using MeyersSingleton = Singleton<T>;
 
+/**
+ * @brief Lazily created singleton that can be destroyed and recreated.
+ *
+ * GetInstance() hands out shared ownership; Borrow() returns the raw pointer for hot paths and
+ * costs a single atomic load once the instance exists.
+ *
+ * Usage:
+ * class MyService : public ManagedSingleton<MyService> {
+ *     friend class ManagedSingleton<MyService>;
+ * private:
+ *     MyService() = default;
+ * };
+ *
+ * MyService::Borrow()->Handle(request);
+ */
 template <typename T>
 class ManagedSingleton : public NonCopyable {
 public:
     /**
-     * @brief Get the singleton instance.
+     * @brief Get the singleton instance, creating it if needed.
      * @return A shared pointer to the singleton instance.
      */
     static std::shared_ptr<T> GetInstance();
     /**
-     * @brief Destroy the singleton instance.
+     * @brief Get the singleton instance without taking ownership, creating it if needed.
+     * @return The instance, valid until DestroyInstance(); use GetInstance() if that may race.
+     */
+    static T *Borrow();
+    /**
+     * @brief Destroy the singleton instance. Holders of GetInstance() keep it alive until they let go.
      */
     static void DestroyInstance();
 
 protected:
-    /// @brief The singleton instance.
+    /// @brief The singleton instance; written under mutex_, read atomically.
     static std::shared_ptr<T> instance_;
+    /// @brief instance_.get(), published for lock-free readers.
+    static std::atomic<T *> published_;
     /// @brief Mutex for thread-safe initialization.
     static std::mutex mutex_;
 };
@@ -75,29 +98,51 @@ protected:
 template <typename T>
 std::shared_ptr<T> ManagedSingleton<T>::instance_ = nullptr;
 
+template <typename T>
+std::atomic<T *> ManagedSingleton<T>::published_{nullptr};
+
 template <typename T>
 std::mutex ManagedSingleton<T>::mutex_;
 
 template <typename T>
 std::shared_ptr<T> ManagedSingleton<T>::GetInstance()
 {
-    if (instance_ == nullptr) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (instance_ == nullptr) {
-            instance_ = std::shared_ptr<T>(new T());
-        }
+    // instance_ is only accessed through the atomic shared_ptr functions, so this check is race-free
+    std::shared_ptr<T> instance = std::atomic_load_explicit(&instance_, std::memory_order_acquire);
+    if (instance) {
+        return instance;
     }
 
-    return instance_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    instance = std::atomic_load_explicit(&instance_, std::memory_order_relaxed);
+    if (!instance) {
+        instance = std::shared_ptr<T>(new T());
+        std::atomic_store_explicit(&instance_, instance, std::memory_order_release);
+        published_.store(instance.get(), std::memory_order_release);
+    }
+    return instance;
+}
+
+template <typename T>
+T *ManagedSingleton<T>::Borrow()
+{
+    T *instance = published_.load(std::memory_order_acquire);
+    if (instance) {
+        return instance;
+    }
+    return GetInstance().get();
 }
 
 template <typename T>
 void ManagedSingleton<T>::DestroyInstance()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (instance_ != nullptr) {
-        instance_.reset();
+    std::shared_ptr<T> instance;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        published_.store(nullptr, std::memory_order_release);
+        instance = std::atomic_exchange_explicit(&instance_, std::shared_ptr<T>(), std::memory_order_acq_rel);
     }
+    // Released outside the lock, so a destructor that touches the singleton cannot deadlock
 }
 } // namespace lmshao::lmcore
 
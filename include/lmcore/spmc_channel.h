@@ -178,7 +178,9 @@ private:
 template <typename T>
 class SpmcSender : public NonCopyable {
 public:
-    bool TrySend(T value) { return queue_->TryPush(std::move(value)); }
+    /// @brief `value` is only moved from on success, so a failed attempt can be retried with it
+    bool TrySend(T &&value) { return queue_->TryPush(std::move(value)); }
+    bool TrySend(const T &value) { return queue_->TryPush(value); }
 
     bool Send(T value)
     {
@@ -18,6 +18,7 @@
 #include <utility>
 #include <vector>
 
+#include "channel_notifier.h"
 #include "noncopyable.h"
 
 namespace lmshao::lmcore::sync {
@@ -141,13 +142,15 @@ class SpscReceiver;
  * @brief Create a bounded SPSC (Single-Producer Single-Consumer) channel.
  * @tparam T Element type
  * @param capacity Channel capacity
+ * @param withNotifier Attach a ChannelNotifier so the receiver can be waited on with poll/epoll
  * @return A pair of (Sender, Receiver)
  *
  * Similar to Rust's std::sync::mpsc::sync_channel for SPSC scenario.
  * The sender can only be used by one producer thread, and the receiver by one consumer thread.
  */
 template <typename T>
-std::pair<std::unique_ptr<SpscSender<T>>, std::unique_ptr<SpscReceiver<T>>> SpscChannel(size_t capacity);
+std::pair<std::unique_ptr<SpscSender<T>>, std::unique_ptr<SpscReceiver<T>>> SpscChannel(size_t capacity,
+                                                                                        bool withNotifier = false);
 
 /**
  * @brief Sender half of a SPSC channel.
@@ -161,10 +164,11 @@ class SpscSender : public NonCopyable {
 public:
     /**
      * @brief Try to send a value (non-blocking).
-     * @param value Value to send
+     * @param value Value to send; only moved from on success, so a failed attempt can be retried with it
      * @return true if sent successfully, false if channel is full
      */
-    bool TrySend(T value) { return queue_->TryPush(std::move(value)); }
+    bool TrySend(T &&value) { return Pushed(queue_->TryPush(std::move(value))); }
+    bool TrySend(const T &value) { return Pushed(queue_->TryPush(value)); }
 
     /**
      * @brief Send a value (blocking with spinning).
@@ -177,6 +181,9 @@ public:
     {
         while (!closed_->load(std::memory_order_acquire)) {
             if (queue_->TryPush(std::move(value))) {
+                if (notifier_) {
+                    notifier_->Notify();
+                }
                 return true;
             }
             std::this_thread::yield();
@@ -184,6 +191,11 @@ public:
         return false;
     }
 
+    /**
+     * @brief Check if channel is full. The sender being the only producer, TrySend() succeeds after false.
+     */
+    bool IsFull() const { return queue_->Full(); }
+
     /**
      * @brief Check if channel is closed.
      */
@@ -192,19 +204,37 @@ public:
     /**
      * @brief Close the channel (prevents further sends).
      */
-    void Close() { closed_->store(true, std::memory_order_release); }
+    void Close()
+    {
+        closed_->store(true, std::memory_order_release);
+        // Wake a waiting receiver so it can observe the closure
+        if (notifier_) {
+            notifier_->Notify();
+        }
+    }
 
 private:
     template <typename U>
-    friend std::pair<std::unique_ptr<SpscSender<U>>, std::unique_ptr<SpscReceiver<U>>> SpscChannel(size_t);
+    friend std::pair<std::unique_ptr<SpscSender<U>>, std::unique_ptr<SpscReceiver<U>>> SpscChannel(size_t, bool);
+
+    explicit SpscSender(std::shared_ptr<SpscCircularQueue<T>> queue, std::shared_ptr<std::atomic<bool>> closed,
+                        std::shared_ptr<ChannelNotifier> notifier)
+        : queue_(std::move(queue)), closed_(std::move(closed)), notifier_(std::move(notifier))
+    {
+    }
 
-    explicit SpscSender(std::shared_ptr<SpscCircularQueue<T>> queue, std::shared_ptr<std::atomic<bool>> closed)
-        : queue_(std::move(queue)), closed_(std::move(closed))
+    bool Pushed(bool pushed)
     {
+        if (pushed && notifier_) {
+            notifier_->Notify();
+        }
+        return pushed;
     }
 
     std::shared_ptr<SpscCircularQueue<T>> queue_;
     std::shared_ptr<std::atomic<bool>> closed_;
+    /// @brief Null unless the channel was created with a notifier.
+    std::shared_ptr<ChannelNotifier> notifier_;
 };
 
 /**
@@ -255,33 +285,62 @@ public:
      */
     bool IsClosed() const { return closed_->load(std::memory_order_acquire); }
 
+    /**
+     * @brief Get the channel's notifier, nullptr if it was created without one.
+     */
+    ChannelNotifier *GetNotifier() const { return notifier_.get(); }
+
+    /**
+     * @brief Ask to be notified of the next send. Call after TryRecv() found the channel empty.
+     * @return true if armed and it is safe to wait on the notifier's fd; false if messages arrived
+     * meanwhile, the channel is closed or there is no notifier, so keep receiving instead
+     */
+    bool ArmNotifier()
+    {
+        if (!notifier_) {
+            return false;
+        }
+        notifier_->Arm();
+        if (!queue_->Empty() || closed_->load(std::memory_order_acquire)) {
+            notifier_->Disarm();
+            return false;
+        }
+        return true;
+    }
+
 private:
     template <typename U>
-    friend std::pair<std::unique_ptr<SpscSender<U>>, std::unique_ptr<SpscReceiver<U>>> SpscChannel(size_t);
+    friend std::pair<std::unique_ptr<SpscSender<U>>, std::unique_ptr<SpscReceiver<U>>> SpscChannel(size_t, bool);
 
-    explicit SpscReceiver(std::shared_ptr<SpscCircularQueue<T>> queue, std::shared_ptr<std::atomic<bool>> closed)
-        : queue_(std::move(queue)), closed_(std::move(closed))
+    explicit SpscReceiver(std::shared_ptr<SpscCircularQueue<T>> queue, std::shared_ptr<std::atomic<bool>> closed,
+                          std::shared_ptr<ChannelNotifier> notifier)
+        : queue_(std::move(queue)), closed_(std::move(closed)), notifier_(std::move(notifier))
     {
     }
 
     std::shared_ptr<SpscCircularQueue<T>> queue_;
     std::shared_ptr<std::atomic<bool>> closed_;
+    /// @brief Null unless the channel was created with a notifier.
+    std::shared_ptr<ChannelNotifier> notifier_;
 };
 
 /**
  * @brief Create a bounded SPSC channel.
  * @tparam T Element type
  * @param capacity Maximum number of elements the channel can hold
+ * @param withNotifier Attach a ChannelNotifier to the channel
  * @return A pair of (Sender, Receiver)
  */
 template <typename T>
-std::pair<std::unique_ptr<SpscSender<T>>, std::unique_ptr<SpscReceiver<T>>> SpscChannel(size_t capacity)
+std::pair<std::unique_ptr<SpscSender<T>>, std::unique_ptr<SpscReceiver<T>>> SpscChannel(size_t capacity,
+                                                                                        bool withNotifier)
 {
     auto queue = std::make_shared<SpscCircularQueue<T>>(capacity);
     auto closed = std::make_shared<std::atomic<bool>>(false);
+    auto notifier = withNotifier ? std::make_shared<ChannelNotifier>() : nullptr;
 
-    auto sender = std::unique_ptr<SpscSender<T>>(new SpscSender<T>(queue, closed));
-    auto receiver = std::unique_ptr<SpscReceiver<T>>(new SpscReceiver<T>(queue, closed));
+    auto sender = std::unique_ptr<SpscSender<T>>(new SpscSender<T>(queue, closed, notifier));
+    auto receiver = std::unique_ptr<SpscReceiver<T>>(new SpscReceiver<T>(queue, closed, notifier));
 
     return std::make_pair(std::move(sender), std::move(receiver));
 }
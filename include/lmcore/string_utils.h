@@ -97,14 +97,14 @@ public:
     static std::string TrimRight(const std::string &str);
 
     /**
-     * @brief Convert string to lowercase
+     * @brief Convert ASCII letters to lowercase (other bytes are left unchanged)
      * @param str String to convert
      * @return Lowercase string
      */
     static std::string ToLower(const std::string &str);
 
     /**
-     * @brief Convert string to uppercase
+     * @brief Convert ASCII letters to uppercase (other bytes are left unchanged)
      * @param str String to convert
      * @return Uppercase string
      */
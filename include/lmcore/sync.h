@@ -10,7 +10,7 @@
 #define LMSHAO_LMCORE_SYNC_H
 
 /**
- * @brief Synchronization primitives - Rust-style channels
+ * @brief Synchronization primitives - Rust-style channels and latest-value cells
  *
  * This module provides lock-free bounded channels for inter-thread communication,
  * similar to Rust's std::sync::mpsc and crossbeam-channel.
@@ -21,6 +21,13 @@
  * - SPMC: Single-Producer Multi-Consumer
  * - MPMC: Multi-Producer Multi-Consumer (like Rust crossbeam-channel)
  *
+ * SPSC and MPSC channels can be created with a ChannelNotifier, whose fd lets the consumer wait
+ * in poll/epoll (or EventLoop) instead of spinning in Recv().
+ *
+ * When only the most recent value matters (statistics, estimates, the last frame), use:
+ * - SeqLock: small trivially copyable values, one wait-free writer, any number of readers
+ * - TripleBuffer: any type, one writer and one reader, no copies on read
+ *
  * Example:
  * @code
  * using namespace lmshao::lmcore::sync;
@@ -40,12 +47,20 @@
  * auto [tx, rx] = MpmcChannel<int>(100);
  * auto tx2 = tx;
  * auto rx2 = rx; // Clone both sender and receiver
+ *
+ * // Latest value only
+ * SeqLock<Stats> stats;
+ * stats.Store(current);          // writer
+ * Stats snapshot = stats.Load(); // readers
  * @endcode
  */
 
+#include "channel_notifier.h"
 #include "mpmc_channel.h"
 #include "mpsc_channel.h"
+#include "seqlock.h"
 #include "spmc_channel.h"
 #include "spsc_channel.h"
+#include "triple_buffer.h"
 
 #endif // LMSHAO_LMCORE_SYNC_H
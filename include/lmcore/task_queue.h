@@ -25,7 +25,12 @@
 #include <unistd.h>
 #endif
 
+#include "profiled_mutex.h"
+
 namespace lmshao::lmcore {
+class Counter;
+class Gauge;
+class LatencyHistogram;
 class TaskQueue;
 template <typename T>
 class TaskHandler;
@@ -263,6 +268,11 @@ private:
 
 /**
  * @brief A queue that executes tasks in a separate thread.
+ *
+ * Registers the following metrics in MetricsRegistry, labelled with the queue name:
+ * lmcore_taskqueue_tasks_{enqueued,executed,cancelled,failed}_total,
+ * lmcore_taskqueue_queue_depth and lmcore_taskqueue_lateness_ns (time between the
+ * requested execution time and the actual start of the task).
  */
 class TaskQueue {
 public:
@@ -270,7 +280,7 @@ public:
      * @brief Construct a new TaskQueue object.
      * @param name The name of the task queue.
      */
-    explicit TaskQueue(const std::string &name) : name_(name) {}
+    explicit TaskQueue(const std::string &name) : name_(name) { RegisterMetrics(); }
     /**
      * @brief Destroy the TaskQueue object.
      */
@@ -312,6 +322,8 @@ private:
         std::shared_ptr<ITaskHandler> task_{nullptr};
         /// @brief The time at which the task should be executed, in nanoseconds.
         uint64_t executeTimeNs_{0ULL};
+        /// @brief Trace flow linking EnqueueTask to the task run (0 when not traced).
+        uint64_t flowId_{0ULL};
     };
     /**
      * @brief The main loop for the task processor thread.
@@ -321,6 +333,15 @@ private:
      * @brief Cancel all tasks that have not been executed.
      */
     void CancelNotExecutedTaskLocked();
+    /**
+     * @brief Remove the front task and keep its node for reuse, mutex_ must be held.
+     * @return The removed task item.
+     */
+    TaskHandlerItem PopFrontLocked();
+    /**
+     * @brief Look up the metrics of this queue in the registry.
+     */
+    void RegisterMetrics();
 
     /// @brief Flag to indicate if the task queue is exiting.
     bool isExit_ = true;
@@ -328,10 +349,12 @@ private:
     std::unique_ptr<std::thread> thread_;
     /// @brief The list of tasks to be executed.
     std::list<TaskHandlerItem> taskList_;
+    /// @brief Spare list nodes, spliced in and out of taskList_ so steady-state enqueues don't allocate.
+    std::list<TaskHandlerItem> freeList_;
     /// @brief Mutex for thread safety.
-    std::mutex mutex_;
+    InternalMutex mutex_ LMCORE_MUTEX_INIT("TaskQueue");
     /// @brief Condition variable for waiting on tasks.
-    std::condition_variable cond_;
+    InternalCondVar cond_;
     /// @brief The name of the task queue.
     std::string name_;
     /// @brief The thread ID of the task processor thread.
@@ -342,6 +365,14 @@ private:
 #endif
     /// @brief Flag to indicate if a task is currently executing.
     bool isTaskExecuting_ = false;
+
+    /// @brief Metrics owned by MetricsRegistry.
+    Counter *tasksEnqueued_ = nullptr;
+    Counter *tasksExecuted_ = nullptr;
+    Counter *tasksCancelled_ = nullptr;
+    Counter *tasksFailed_ = nullptr;
+    Gauge *queueDepth_ = nullptr;
+    LatencyHistogram *lateness_ = nullptr;
 };
 
 } // namespace lmshao::lmcore
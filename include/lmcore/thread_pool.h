@@ -10,18 +10,26 @@
 #define LMSHAO_LMCORE_THREAD_POOL_H
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <queue>
-#include <stack>
 #include <string>
 #include <thread>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
+#include "flat_hash_map.h"
+#include "profiled_mutex.h"
+
 namespace lmshao::lmcore {
+class Counter;
+class Gauge;
+class LatencyHistogram;
+namespace coro {
+class ScheduleAwaiter;
+}
+
 /// @brief Maximum number of threads allowed.
 constexpr int THREAD_NUM_MAX = 2;
 /// @brief Number of threads to pre-allocate.
@@ -29,6 +37,11 @@ constexpr int THREAD_NUM_PRE_ALLOC = 1;
 
 /**
  * @brief A thread pool for executing tasks concurrently.
+ *
+ * Registers the following metrics in MetricsRegistry, labelled with the pool name:
+ * lmcore_threadpool_tasks_{submitted,completed,rejected,failed}_total,
+ * lmcore_threadpool_queue_depth, lmcore_threadpool_threads and
+ * lmcore_threadpool_queue_delay_ns (time from AddTask until a worker starts the task).
  */
 class ThreadPool {
 public:
@@ -51,8 +64,31 @@ public:
      * @brief Add a task to the thread pool.
      * @param task The task to be executed.
      * @param serialTag Optional tag for serial execution of tasks with the same tag.
+     * @return false if the task was rejected: it is null or the pool is shutting down
      */
-    void AddTask(const Task &task, const std::string &serialTag = "");
+    bool AddTask(const Task &task, const std::string &serialTag = "");
+
+    /**
+     * @brief Run fn(i) for every i in [begin, end) on the pool and the calling thread, and wait for all of them.
+     *
+     * Indices are claimed in blocks of `grain` from a shared counter, so uneven items balance
+     * across threads. The caller works too, so this also completes when the pool is busy or
+     * shut down, and may be called from a task. Exceptions thrown by fn are logged and dropped.
+     *
+     * @param grain Number of consecutive indices claimed at once
+     */
+    void ParallelFor(size_t begin, size_t end, const std::function<void(size_t)> &fn, size_t grain = 1);
+
+    // Declared only where coro.h defines it, so C++17 code can't reach an undefined symbol
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+    /**
+     * @brief co_await pool.Schedule() to continue a coroutine on a worker thread.
+     * @note Requires C++20 and coro.h, which defines it.
+     */
+    coro::ScheduleAwaiter Schedule();
+#endif
+#endif
 
     /**
      * @brief Shutdown the thread pool.
@@ -103,6 +139,8 @@ private:
         {
             fn = std::move(task);
             tag = std::move(serialTag);
+            enqueueTime = std::chrono::steady_clock::now();
+            flowId = 0;
         }
 
         /**
@@ -118,6 +156,49 @@ private:
         Task fn;
         /// @brief The serial tag.
         std::string tag;
+        /// @brief Time the task was handed to the pool.
+        std::chrono::steady_clock::time_point enqueueTime;
+        /// @brief Trace flow linking AddTask to the task run (0 when not traced).
+        uint64_t flowId = 0;
+        /// @brief Next item in the TaskList holding this item.
+        TaskItem *next = nullptr;
+    };
+
+    /**
+     * @brief Intrusive FIFO of task items, so queueing never allocates.
+     */
+    struct TaskList {
+        void Push(TaskItem *item)
+        {
+            item->next = nullptr;
+            if (tail) {
+                tail->next = item;
+            } else {
+                head = item;
+            }
+            tail = item;
+            ++size;
+        }
+
+        TaskItem *Pop()
+        {
+            TaskItem *item = head;
+            if (item) {
+                head = item->next;
+                if (!head) {
+                    tail = nullptr;
+                }
+                item->next = nullptr;
+                --size;
+            }
+            return item;
+        }
+
+        bool Empty() const { return head == nullptr; }
+
+        TaskItem *head = nullptr;
+        TaskItem *tail = nullptr;
+        size_t size = 0;
     };
 
     /**
@@ -127,20 +208,29 @@ private:
     bool HasSerialTask() const;
     /**
      * @brief Get the next serial task.
-     * @return Shared pointer to the next serial task.
+     * @return The next serial task, or nullptr.
      */
-    std::shared_ptr<TaskItem> GetNextSerialTask();
+    TaskItem *GetNextSerialTask();
 
     /**
      * @brief Acquire a task item from the pool.
-     * @return Shared pointer to a task item.
+     * @return A task item owned by the pool.
      */
-    std::shared_ptr<TaskItem> AcquireTaskItem();
+    TaskItem *AcquireTaskItem();
     /**
      * @brief Release a task item back to the pool.
      * @param item The task item to release.
      */
-    void ReleaseTaskItem(std::shared_ptr<TaskItem> item);
+    void ReleaseTaskItem(TaskItem *item);
+    /**
+     * @brief Return a task item to the free list, mutex_ must be held.
+     * @param item The task item to release.
+     */
+    void ReleaseTaskItemLocked(TaskItem *item);
+    /**
+     * @brief Look up the metrics of this pool in the registry.
+     */
+    void RegisterMetrics();
 
 private:
     /// @brief Flag indicating if the thread pool is running.
@@ -156,24 +246,35 @@ private:
     std::string threadName_ = "threadpool";
 
     /// @brief Mutex for thread safety.
-    mutable std::mutex mutex_;
+    mutable InternalMutex mutex_ LMCORE_MUTEX_INIT("ThreadPool");
     /// @brief Condition variable for signaling.
-    std::condition_variable signal_;
+    InternalCondVar signal_;
 
     /// @brief Queue of tasks to be executed.
-    std::queue<std::shared_ptr<TaskItem>> tasks_;
+    TaskList tasks_;
     /// @brief Vector of worker threads.
     std::vector<std::unique_ptr<std::thread>> threads_;
 
     /// @brief Map of serial tasks grouped by tag.
-    std::unordered_map<std::string, std::queue<std::shared_ptr<TaskItem>>> serialTasks_;
+    FlatHashMap<std::string, TaskList> serialTasks_;
     /// @brief Set of currently running serial tags.
-    std::unordered_set<std::string> runningSerialTags_;
+    FlatHashSet<std::string> runningSerialTags_;
 
     /// @brief Queue of available serial tags for O(1) lookup.
     std::queue<std::string> availableSerialTags_;
     /// @brief Pool of task items for reuse.
-    std::stack<std::shared_ptr<TaskItem>> taskItemPool_;
+    TaskList taskItemPool_;
+
+    /// @brief Set once Shutdown() has settled the gauges of this pool.
+    bool metricsReleased_ = false;
+    /// @brief Metrics owned by MetricsRegistry.
+    Counter *tasksSubmitted_ = nullptr;
+    Counter *tasksCompleted_ = nullptr;
+    Counter *tasksRejected_ = nullptr;
+    Counter *tasksFailed_ = nullptr;
+    Gauge *queueDepth_ = nullptr;
+    Gauge *threadCount_ = nullptr;
+    LatencyHistogram *queueDelay_ = nullptr;
 };
 
 } // namespace lmshao::lmcore
@@ -0,0 +1,130 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_TRIPLE_BUFFER_H
+#define LMSHAO_LMCORE_TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#include "noncopyable.h"
+
+namespace lmshao::lmcore::sync {
+
+/**
+ * @brief Single-writer single-reader latest-value hand-off.
+ *
+ * Three slots: the writer fills its back buffer and swaps it with the shared middle one, the
+ * reader swaps its front buffer with the middle one when something new was published. Neither
+ * side ever blocks or copies the other's data, and intermediate values the reader did not pick
+ * up are simply overwritten. Unlike SeqLock, T may be any default-constructible type and large
+ * values (frames, tables) are not copied on read.
+ *
+ * Example:
+ * @code
+ * TripleBuffer<Frame> latest;
+ * // writer thread
+ * Render(latest.WriteBuffer());
+ * latest.Publish();
+ * // reader thread
+ * if (latest.Update()) {
+ *     Display(latest.ReadBuffer());
+ * }
+ * @endcode
+ */
+template <typename T>
+class TripleBuffer : public NonCopyable {
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T &initial)
+    {
+        for (auto &slot : slots_) {
+            slot.value = initial;
+        }
+    }
+
+    // Writer side
+
+    /**
+     * @brief Get the writer's private slot; its content is stale, not necessarily the last value written.
+     */
+    T &WriteBuffer() { return slots_[writeIndex_].value; }
+
+    /**
+     * @brief Make the write buffer the latest value and take a fresh one.
+     */
+    void Publish()
+    {
+        uint8_t previous = middle_.exchange(static_cast<uint8_t>(writeIndex_ | kDirty), std::memory_order_acq_rel);
+        writeIndex_ = previous & kIndexMask;
+    }
+
+    /**
+     * @brief Copy or move a value into the write buffer and publish it.
+     */
+    template <typename U>
+    void Write(U &&value)
+    {
+        WriteBuffer() = std::forward<U>(value);
+        Publish();
+    }
+
+    // Reader side
+
+    /**
+     * @brief Check whether a value was published since the last Update().
+     */
+    bool HasNew() const { return (middle_.load(std::memory_order_relaxed) & kDirty) != 0; }
+
+    /**
+     * @brief Take the latest published value into the read buffer, if there is a new one.
+     * @return true if the read buffer changed
+     */
+    bool Update()
+    {
+        if (!HasNew()) {
+            return false;
+        }
+        uint8_t previous = middle_.exchange(readIndex_, std::memory_order_acq_rel);
+        readIndex_ = previous & kIndexMask;
+        return true;
+    }
+
+    /**
+     * @brief Get the reader's current value, stable until the next Update().
+     */
+    const T &ReadBuffer() const { return slots_[readIndex_].value; }
+
+    /**
+     * @brief Update() and return the newest value.
+     */
+    const T &Read()
+    {
+        Update();
+        return ReadBuffer();
+    }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kDirty = 0x4;
+
+    struct alignas(64) Slot {
+        T value{};
+    };
+
+    Slot slots_[3];
+    /// @brief Index of the middle slot, with kDirty set while it holds an unread value
+    alignas(64) std::atomic<uint8_t> middle_{1};
+    alignas(64) uint8_t writeIndex_ = 0;
+    alignas(64) uint8_t readIndex_ = 2;
+};
+
+} // namespace lmshao::lmcore::sync
+
+#endif // LMSHAO_LMCORE_TRIPLE_BUFFER_H
@@ -0,0 +1,86 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_XXHASH64_H
+#define LMSHAO_LMCORE_XXHASH64_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace lmshao::lmcore {
+
+/**
+ * @brief XXH64, a fast non-cryptographic 64-bit hash
+ *
+ * Compatible with the reference xxHash implementation (XXH64), so digests can be compared with
+ * `xxhsum -H1`. It runs at several GB/s per core, an order of magnitude faster than MD5, which
+ * makes it the better choice for detecting corruption when no adversary is involved.
+ *
+ * Example usage:
+ * @code
+ *   uint64_t hash = XXHash64::Calculate("abc");   // 0x44BC2CF5AD770999
+ *
+ *   XXHash64::Context ctx;
+ *   ctx.Update(chunk1, len1);
+ *   ctx.Update(chunk2, len2);
+ *   uint64_t file_hash = ctx.Final();
+ * @endcode
+ */
+class XXHash64 {
+public:
+    /**
+     * @brief Calculate the hash of binary data
+     * @param data Pointer to binary data
+     * @param len Length of data in bytes
+     * @param seed Seed value, 0 for the standard digest
+     * @return 64-bit hash value
+     */
+    static uint64_t Calculate(const uint8_t *data, size_t len, uint64_t seed = 0);
+
+    /**
+     * @brief Calculate the hash of a string
+     */
+    static uint64_t Calculate(const std::string &data, uint64_t seed = 0);
+
+    /**
+     * @brief Context for incremental hashing; gives the same result as one Calculate() call
+     */
+    class Context {
+    public:
+        explicit Context(uint64_t seed = 0) { Reset(seed); }
+
+        /**
+         * @brief Add data to the hash
+         */
+        void Update(const uint8_t *data, size_t len);
+
+        /**
+         * @brief Get the hash of the data added so far
+         * @note Can be called multiple times without changing state
+         */
+        uint64_t Final() const;
+
+        /**
+         * @brief Reset context to initial state
+         */
+        void Reset(uint64_t seed = 0);
+
+    private:
+        uint64_t acc_[4];
+        uint64_t seed_;
+        uint64_t totalLen_;
+        /// @brief Input not yet consumed by a full 32-byte stripe
+        uint8_t buffer_[32];
+        size_t bufferSize_;
+    };
+};
+
+} // namespace lmshao::lmcore
+
+#endif // LMSHAO_LMCORE_XXHASH64_H
@@ -0,0 +1,110 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/adaptive_mutex.h"
+
+#include <algorithm>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+#include "futex.h"
+
+namespace lmshao::lmcore {
+
+namespace {
+constexpr int32_t kSpinMax = 200;
+
+inline void CpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+bool SpinningUseful()
+{
+    // With one CPU the owner cannot make progress while we spin
+    static const bool useful = std::thread::hardware_concurrency() > 1;
+    return useful;
+}
+} // namespace
+
+void AdaptiveMutex::LockSlow()
+{
+    if (SpinningUseful()) {
+        // Same heuristic as glibc's adaptive mutexes: spin up to twice the recent average
+        int32_t estimate = spinEstimate_.load(std::memory_order_relaxed);
+        int32_t limit = std::min(kSpinMax, estimate * 2 + 10);
+        for (int32_t spins = 0; spins < limit; ++spins) {
+            CpuRelax();
+            if (state_.load(std::memory_order_relaxed) == kUnlocked) {
+                uint32_t expected = kUnlocked;
+                if (state_.compare_exchange_weak(expected, kLocked, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                    spinEstimate_.store(estimate + (spins - estimate) / 8, std::memory_order_relaxed);
+                    return;
+                }
+            }
+        }
+        spinEstimate_.store(estimate + (limit - estimate) / 8, std::memory_order_relaxed);
+    }
+    LockContended();
+}
+
+void AdaptiveMutex::LockContended()
+{
+    while (state_.exchange(kContended, std::memory_order_acquire) != kUnlocked) {
+        detail::FutexWait(&state_, kContended);
+    }
+}
+
+void AdaptiveMutex::WakeOne()
+{
+    detail::FutexWake(&state_, 1);
+}
+
+void AdaptiveCondVar::WaitNs(std::unique_lock<AdaptiveMutex> &lock, int64_t timeoutNs)
+{
+    AdaptiveMutex *mutex = lock.mutex();
+    mutex_.store(mutex, std::memory_order_relaxed);
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    uint32_t seq = seq_.load(std::memory_order_seq_cst);
+
+    // The unique_lock keeps believing it owns the mutex; it is released and retaken underneath
+    mutex->unlock();
+    detail::FutexWait(&seq_, seq, timeoutNs);
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+
+    // We may have been requeued onto the mutex, so always lock in the contended state: our
+    // unlock then wakes the next requeued waiter
+    mutex->LockContended();
+}
+
+void AdaptiveCondVar::Notify(bool all)
+{
+    uint32_t seq = seq_.fetch_add(1, std::memory_order_seq_cst) + 1;
+    if (waiters_.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+    if (!all) {
+        detail::FutexWake(&seq_, 1);
+        return;
+    }
+
+    AdaptiveMutex *mutex = mutex_.load(std::memory_order_relaxed);
+    if (!mutex || !detail::FutexRequeue(&seq_, seq, &mutex->state_)) {
+        detail::FutexWake(&seq_, INT32_MAX);
+    }
+}
+
+} // namespace lmshao::lmcore
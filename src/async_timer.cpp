@@ -11,12 +11,21 @@
 #include <chrono>
 
 #include "internal_logger.h"
+#include "lmcore/metrics.h"
+#include "lmcore/trace.h"
 
 namespace lmshao::lmcore {
 
 AsyncTimer::AsyncTimer(int threadPoolSize)
 {
     threadPool_ = std::make_unique<ThreadPool>(threadPoolSize, threadPoolSize, "AsyncTimer");
+
+    auto &registry = MetricsRegistry::GetInstance();
+    timersScheduled_ = &registry.GetCounter("lmcore_asynctimer_timers_scheduled_total", {}, "Timers scheduled");
+    timersFired_ = &registry.GetCounter("lmcore_asynctimer_timers_fired_total", {}, "Timer callbacks run");
+    timersCancelled_ = &registry.GetCounter("lmcore_asynctimer_timers_cancelled_total", {}, "Timers cancelled");
+    lateness_ = &registry.GetHistogram("lmcore_asynctimer_lateness_ns", {},
+                                       "Delay between the due time and the start of a timer callback");
 }
 
 AsyncTimer::~AsyncTimer()
@@ -26,7 +35,7 @@ AsyncTimer::~AsyncTimer()
 
 int32_t AsyncTimer::Start()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<InternalMutex> lock(mutex_);
     if (running_.load()) {
         return 0; // Already running
     }
@@ -42,7 +51,7 @@ int32_t AsyncTimer::Start()
 int32_t AsyncTimer::Stop()
 {
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         if (!running_.load()) {
             return 0;
         }
@@ -86,11 +95,12 @@ AsyncTimer::TimerId AsyncTimer::ScheduleOnce(const TimerCallback &callback, uint
     auto task = std::make_shared<TimerTask>(timerId, callback, execTime, Duration(0), false);
 
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         timerTasks_.emplace(execTime, task);
         timerMap_[timerId] = task;
     }
 
+    timersScheduled_->Increment();
     condition_.notify_one();
     return timerId;
 }
@@ -120,20 +130,24 @@ AsyncTimer::TimerId AsyncTimer::ScheduleRepeating(const TimerCallback &callback,
     auto task = std::make_shared<TimerTask>(timerId, callback, execTime, Duration(intervalMs), true);
 
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         timerTasks_.emplace(execTime, task);
         timerMap_[timerId] = task;
     }
 
+    timersScheduled_->Increment();
     condition_.notify_one();
     return timerId;
 }
 
 bool AsyncTimer::Cancel(TimerId timerId)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<InternalMutex> lock(mutex_);
     auto it = timerMap_.find(timerId);
     if (it != timerMap_.end()) {
+        if (!it->second->isCancelled) {
+            timersCancelled_->Increment();
+        }
         it->second->isCancelled = true;
         return true;
     }
@@ -142,8 +156,11 @@ bool AsyncTimer::Cancel(TimerId timerId)
 
 void AsyncTimer::CancelAll()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<InternalMutex> lock(mutex_);
     for (auto &pair : timerMap_) {
+        if (!pair.second->isCancelled) {
+            timersCancelled_->Increment();
+        }
         pair.second->isCancelled = true;
     }
     printf("Cancelled all timers\n");
@@ -156,7 +173,7 @@ bool AsyncTimer::IsRunning() const
 
 size_t AsyncTimer::GetActiveTimerCount() const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<InternalMutex> lock(mutex_);
     return timerMap_.size();
 }
 
@@ -170,7 +187,7 @@ void AsyncTimer::TimerWorker()
     printf("AsyncTimer worker thread started\n");
 
     while (!shouldStop_.load()) {
-        std::unique_lock<std::mutex> lock(mutex_);
+        std::unique_lock<InternalMutex> lock(mutex_);
         if (timerTasks_.empty()) {
             // Wait for new timers or stop signal
             condition_.wait(lock, [this] { return !timerTasks_.empty() || shouldStop_.load(); });
@@ -219,8 +236,12 @@ void AsyncTimer::ExecuteExpiredTimers()
     for (auto &task : expiredTasks) {
         if (!task->isCancelled && threadPool_) {
             // Create a wrapper task that handles the callback execution
-            auto wrappedCallback = [task]() {
+            auto due = task->nextExecutionTime;
+            auto wrappedCallback = [this, task, due]() {
                 if (!task->isCancelled) {
+                    LMCORE_TRACE_SCOPE("AsyncTimer::Fire");
+                    lateness_->RecordDuration(std::chrono::steady_clock::now() - due);
+                    timersFired_->Increment();
                     task->callback();
                     LMCORE_LOGD("Executed timer %lu asynchronously", task->id);
                 }
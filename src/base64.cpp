@@ -8,6 +8,9 @@
 
 #include "lmcore/base64.h"
 
+#include "lmcore/cpu_features.h"
+#include "simd_kernels.h"
+
 namespace lmshao::lmcore {
 
 static const char kBase64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
@@ -17,45 +20,56 @@ static inline bool IsBase64Char(unsigned char c)
     return (isalnum(c) || (c == '+') || (c == '/'));
 }
 
-std::string Base64::Encode(const uint8_t *data, size_t len)
-{
-    std::string result;
-    result.reserve((len + 2) / 3 * 4);
+// Encodes a prefix of whole 3-byte groups, returns the number of bytes consumed
+using Base64EncodeKernel = size_t (*)(const uint8_t *src, size_t len, char *dst);
 
-    size_t i = 0;
-    uint8_t char_array_3[3];
-    uint8_t char_array_4[4];
+static size_t Base64EncodeNone(const uint8_t *, size_t, char *)
+{
+    return 0;
+}
 
-    while (len--) {
-        char_array_3[i++] = *(data++);
-        if (i == 3) {
-            char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-            char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-            char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-            char_array_4[3] = char_array_3[2] & 0x3f;
+static Base64EncodeKernel GetBase64EncodeKernel()
+{
+    static const Base64EncodeKernel kernel = SelectKernel<Base64EncodeKernel>(
+        {
+#if defined(LMCORE_X86_KERNELS)
+            {CpuFeatures::kSsse3, simd::Base64EncodeSsse3},
+#endif
+        },
+        Base64EncodeNone);
+    return kernel;
+}
 
-            for (i = 0; i < 4; i++) {
-                result += kBase64Chars[char_array_4[i]];
-            }
-            i = 0;
-        }
+std::string Base64::Encode(const uint8_t *data, size_t len)
+{
+    std::string result((len + 2) / 3 * 4, '=');
+    if (len == 0) {
+        return result;
     }
 
-    if (i) {
-        for (size_t j = i; j < 3; j++) {
-            char_array_3[j] = '\0';
-        }
-
-        char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-        char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-        char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
+    char *out = &result[0];
+    size_t i = GetBase64EncodeKernel()(data, len, out);
+    size_t o = i / 3 * 4;
+
+    for (; i + 3 <= len; i += 3, o += 4) {
+        uint32_t group =
+            (static_cast<uint32_t>(data[i]) << 16) | (static_cast<uint32_t>(data[i + 1]) << 8) | data[i + 2];
+        out[o] = kBase64Chars[(group >> 18) & 0x3f];
+        out[o + 1] = kBase64Chars[(group >> 12) & 0x3f];
+        out[o + 2] = kBase64Chars[(group >> 6) & 0x3f];
+        out[o + 3] = kBase64Chars[group & 0x3f];
+    }
 
-        for (size_t j = 0; j < i + 1; j++) {
-            result += kBase64Chars[char_array_4[j]];
+    // One or two trailing bytes; the padding '=' is already in place
+    if (i < len) {
+        uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < len) {
+            group |= static_cast<uint32_t>(data[i + 1]) << 8;
         }
-
-        while (i++ < 3) {
-            result += '=';
+        out[o] = kBase64Chars[(group >> 18) & 0x3f];
+        out[o + 1] = kBase64Chars[(group >> 12) & 0x3f];
+        if (i + 1 < len) {
+            out[o + 2] = kBase64Chars[(group >> 6) & 0x3f];
         }
     }
 
@@ -0,0 +1,50 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "simd_kernels.h"
+
+#if defined(LMCORE_X86_KERNELS)
+
+#include <tmmintrin.h>
+
+namespace lmshao::lmcore::simd {
+
+// Wojciech Muła's SSSE3 encoder: split 12 bytes into 16 sextets, then map every sextet
+// to its ASCII code by adding a per-range offset selected with pshufb.
+size_t Base64EncodeSsse3(const uint8_t *src, size_t len, char *dst)
+{
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    size_t i = 0;
+    size_t out = 0;
+    // Each step loads 16 bytes but consumes 12
+    for (; i + 16 <= len; i += 12, out += 16) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        in = _mm_shuffle_epi8(in, shuffle);
+
+        __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+        __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+        __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(t1, t3);
+
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        __m128i lower = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        range = _mm_or_si128(range, _mm_and_si128(lower, _mm_set1_epi8(13)));
+        __m128i result = _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + out), result);
+    }
+    return i;
+}
+
+} // namespace lmshao::lmcore::simd
+
+#endif // LMCORE_X86_KERNELS
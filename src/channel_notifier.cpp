@@ -0,0 +1,97 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/channel_notifier.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "internal_logger.h"
+
+namespace lmshao::lmcore::sync {
+
+ChannelNotifier::ChannelNotifier()
+{
+#if defined(__linux__)
+    readFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    writeFd_ = readFd_;
+#elif !defined(_WIN32)
+    int fds[2];
+    if (pipe(fds) == 0) {
+        for (int fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        readFd_ = fds[0];
+        writeFd_ = fds[1];
+    }
+#endif
+    if (readFd_ < 0) {
+        LMCORE_LOGE("ChannelNotifier: cannot create descriptor: %s", strerror(errno));
+    }
+}
+
+ChannelNotifier::~ChannelNotifier()
+{
+#if !defined(_WIN32)
+    if (readFd_ >= 0) {
+        close(readFd_);
+    }
+    if (writeFd_ >= 0 && writeFd_ != readFd_) {
+        close(writeFd_);
+    }
+#endif
+}
+
+void ChannelNotifier::Wake()
+{
+    Waker waker = waker_.exchange(nullptr, std::memory_order_acq_rel);
+    if (waker) {
+        waker(context_.load(std::memory_order_relaxed));
+    } else {
+        Signal();
+    }
+}
+
+void ChannelNotifier::Signal()
+{
+#if defined(__linux__)
+    uint64_t one = 1;
+    ssize_t ret = write(writeFd_, &one, sizeof(one));
+    (void)ret;
+#elif !defined(_WIN32)
+    // A full pipe is already readable, so a failed write loses nothing
+    char byte = 1;
+    ssize_t ret = write(writeFd_, &byte, 1);
+    (void)ret;
+#endif
+}
+
+void ChannelNotifier::Clear()
+{
+#if defined(__linux__)
+    uint64_t value;
+    ssize_t ret = read(readFd_, &value, sizeof(value));
+    (void)ret;
+#elif !defined(_WIN32)
+    char buffer[64];
+    while (read(readFd_, buffer, sizeof(buffer)) > 0) {
+    }
+#endif
+}
+
+} // namespace lmshao::lmcore::sync
@@ -0,0 +1,213 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/chunk_reader.h"
+
+#include <cstdio>
+#include <tuple>
+#include <utility>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <pthread.h>
+#endif
+
+#include "internal_logger.h"
+#include "lmcore/data_buffer.h"
+#include "lmcore/mpsc_channel.h"
+#include "lmcore/recycling_allocator.h"
+#include "lmcore/spsc_channel.h"
+
+namespace lmshao::lmcore {
+
+namespace {
+
+/// Block until the notifier's descriptor is readable, then consume the signal
+void WaitNotified(sync::ChannelNotifier *notifier)
+{
+#ifndef _WIN32
+    if (notifier->GetFd() >= 0) {
+        pollfd pfd{notifier->GetFd(), POLLIN, 0};
+        poll(&pfd, 1, -1);
+        notifier->Clear();
+        return;
+    }
+#endif
+    // No descriptor on this platform: fall back to polling the channel
+    notifier->Disarm();
+    std::this_thread::yield();
+}
+
+} // namespace
+
+ChunkReader::ChunkReader(Source source, size_t chunkSize, size_t readAhead)
+    : source_(std::move(source)), chunkSize_(chunkSize ? chunkSize : kDefaultChunkSize),
+      readAhead_(readAhead ? readAhead : 1)
+{
+    std::tie(readyTx_, readyRx_) = sync::SpscChannel<std::shared_ptr<DataBuffer>>(readAhead_, true);
+    std::tie(freeTx_, freeRx_) = sync::MpscChannel<std::unique_ptr<DataBuffer>>(readAhead_, true);
+    thread_ = std::thread([this]() {
+#if !defined(_WIN32)
+#if defined(__APPLE__)
+        pthread_setname_np("ChunkReader");
+#else
+        pthread_setname_np(pthread_self(), "ChunkReader");
+#endif
+#endif
+        ReadLoop();
+    });
+}
+
+ChunkReader::~ChunkReader()
+{
+    Stop();
+}
+
+std::unique_ptr<ChunkReader> ChunkReader::OpenFile(const std::string &path, size_t chunkSize, size_t readAhead)
+{
+    std::shared_ptr<FILE> file(fopen(path.c_str(), "rb"), [](FILE *f) {
+        if (f) {
+            fclose(f);
+        }
+    });
+    if (!file) {
+        LMCORE_LOGE("Failed to open %s", path.c_str());
+        return nullptr;
+    }
+    // Chunks are large: read straight into them rather than through stdio's buffer
+    setvbuf(file.get(), nullptr, _IONBF, 0);
+    auto source = [file](uint8_t *buffer, size_t size) -> int64_t {
+        size_t n = fread(buffer, 1, size, file.get());
+        if (n == 0 && ferror(file.get())) {
+            return -1;
+        }
+        return static_cast<int64_t>(n);
+    };
+    return std::make_unique<ChunkReader>(std::move(source), chunkSize, readAhead);
+}
+
+std::shared_ptr<DataBuffer> ChunkReader::Next()
+{
+    for (;;) {
+        if (auto chunk = TryNext()) {
+            return chunk;
+        }
+        if (stopping_.load(std::memory_order_acquire) || readyRx_->IsClosed()) {
+            // Closing happens after the last send, so one more look finds any chunk sent before it
+            return TryNext();
+        }
+        if (readyRx_->ArmNotifier()) {
+            consumerWaits_.fetch_add(1, std::memory_order_relaxed);
+            WaitNotified(readyRx_->GetNotifier());
+        }
+    }
+}
+
+std::shared_ptr<DataBuffer> ChunkReader::TryNext()
+{
+    if (stopping_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    auto chunk = readyRx_->TryRecv();
+    return chunk ? std::move(*chunk) : nullptr;
+}
+
+bool ChunkReader::IsFinished() const
+{
+    return stopping_.load(std::memory_order_acquire) || (readyRx_->IsClosed() && readyRx_->IsEmpty());
+}
+
+void ChunkReader::Stop()
+{
+    if (stopping_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    // Wake the reader if it is waiting for a free chunk
+    freeRx_->GetNotifier()->Signal();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    // Chunks released from now on are simply freed
+    freeTx_->Close();
+}
+
+ChunkReader::Stats ChunkReader::GetStats() const
+{
+    Stats stats;
+    stats.bytes = bytes_.load(std::memory_order_relaxed);
+    stats.chunks = chunks_.load(std::memory_order_relaxed);
+    stats.readerWaits = readerWaits_.load(std::memory_order_relaxed);
+    stats.consumerWaits = consumerWaits_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::unique_ptr<DataBuffer> ChunkReader::AcquireChunk()
+{
+    while (!stopping_.load(std::memory_order_acquire)) {
+        if (auto chunk = freeRx_->TryRecv()) {
+            return std::move(*chunk);
+        }
+        if (allocated_ < readAhead_) {
+            ++allocated_;
+            return std::make_unique<DataBuffer>(chunkSize_);
+        }
+        if (freeRx_->ArmNotifier()) {
+            readerWaits_.fetch_add(1, std::memory_order_relaxed);
+            WaitNotified(freeRx_->GetNotifier());
+        }
+    }
+    return nullptr;
+}
+
+void ChunkReader::ReadLoop()
+{
+    auto freeTx = freeTx_;
+    bool done = false;
+    while (!done) {
+        std::unique_ptr<DataBuffer> chunk = AcquireChunk();
+        if (!chunk) {
+            break;
+        }
+        size_t filled = 0;
+        while (filled < chunkSize_) {
+            int64_t n = source_(chunk->Data() + filled, chunkSize_ - filled);
+            if (n <= 0) {
+                if (n < 0) {
+                    LMCORE_LOGE("ChunkReader source failed after %llu bytes",
+                                static_cast<unsigned long long>(bytes_.load(std::memory_order_relaxed) + filled));
+                    error_.store(true, std::memory_order_release);
+                }
+                done = true;
+                break;
+            }
+            filled += static_cast<size_t>(n);
+        }
+        if (filled == 0) {
+            break;
+        }
+        chunk->SetSize(filled);
+        bytes_.fetch_add(filled, std::memory_order_relaxed);
+        chunks_.fetch_add(1, std::memory_order_relaxed);
+
+        // The last reference, wherever it is dropped, hands the chunk back to this thread
+        std::shared_ptr<DataBuffer> shared(
+            chunk.release(),
+            [freeTx](DataBuffer *buffer) {
+                std::unique_ptr<DataBuffer> owned(buffer);
+                if (!freeTx->IsClosed()) {
+                    freeTx->TrySend(std::move(owned));
+                }
+            },
+            RecyclingAllocator<DataBuffer>());
+        // Never full: no more than readAhead_ chunks exist
+        readyTx_->TrySend(std::move(shared));
+    }
+    readyTx_->Close();
+}
+
+} // namespace lmshao::lmcore
@@ -0,0 +1,203 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/cpu_features.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define LMCORE_CPU_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define LMCORE_CPU_ARM64 1
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace lmshao::lmcore {
+
+namespace {
+
+#if defined(LMCORE_CPU_X86)
+void Cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<uint32_t>(info[i]);
+    }
+#else
+    if (!__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3])) {
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    }
+#endif
+}
+
+uint64_t ReadXcr0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax;
+    uint32_t edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+uint32_t DetectX86()
+{
+    uint32_t regs[4];
+    Cpuid(0, 0, regs);
+    uint32_t maxLeaf = regs[0];
+    if (maxLeaf < 1) {
+        return 0;
+    }
+
+    uint32_t mask = 0;
+    Cpuid(1, 0, regs);
+    uint32_t ecx = regs[2];
+    uint32_t edx = regs[3];
+    if (edx & (1u << 26)) {
+        mask |= CpuFeatures::kSse2;
+    }
+    if (ecx & (1u << 9)) {
+        mask |= CpuFeatures::kSsse3;
+    }
+    if (ecx & (1u << 19)) {
+        mask |= CpuFeatures::kSse41;
+    }
+    if (ecx & (1u << 20)) {
+        mask |= CpuFeatures::kSse42;
+    }
+    if (ecx & (1u << 1)) {
+        mask |= CpuFeatures::kPclmul;
+    }
+
+    // AVX state must be enabled by the OS (OSXSAVE + XCR0 SSE/AVX bits)
+    bool osAvx = false;
+    bool osAvx512 = false;
+    if ((ecx & (1u << 27)) && (ecx & (1u << 28))) {
+        uint64_t xcr0 = ReadXcr0();
+        osAvx = (xcr0 & 0x6) == 0x6;
+        osAvx512 = osAvx && (xcr0 & 0xE0) == 0xE0;
+        if (osAvx) {
+            mask |= CpuFeatures::kAvx;
+        }
+    }
+
+    if (maxLeaf >= 7) {
+        Cpuid(7, 0, regs);
+        uint32_t ebx = regs[1];
+        if (osAvx && (ebx & (1u << 5))) {
+            mask |= CpuFeatures::kAvx2;
+        }
+        if (ebx & (1u << 8)) {
+            mask |= CpuFeatures::kBmi2;
+        }
+        if (osAvx512 && (ebx & (1u << 16))) {
+            mask |= CpuFeatures::kAvx512F;
+        }
+        if (osAvx512 && (ebx & (1u << 30))) {
+            mask |= CpuFeatures::kAvx512BW;
+        }
+    }
+    return mask;
+}
+#endif
+
+#if defined(LMCORE_CPU_ARM64)
+uint32_t DetectArm64()
+{
+    // Advanced SIMD is mandatory on AArch64
+    uint32_t mask = CpuFeatures::kNeon;
+#if defined(__linux__)
+    constexpr unsigned long kHwcapPmull = 1ul << 4;
+    constexpr unsigned long kHwcapCrc32 = 1ul << 7;
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    if (hwcap & kHwcapPmull) {
+        mask |= CpuFeatures::kArmPmull;
+    }
+    if (hwcap & kHwcapCrc32) {
+        mask |= CpuFeatures::kArmCrc32;
+    }
+#elif defined(__APPLE__)
+    // Every Apple arm64 core implements ARMv8.4 including CRC32 and PMULL
+    mask |= CpuFeatures::kArmCrc32 | CpuFeatures::kArmPmull;
+#endif
+    return mask;
+}
+#endif
+
+bool SimdDisabledByEnv()
+{
+    const char *value = std::getenv("LMCORE_NO_SIMD");
+    return value != nullptr && value[0] != '\0' && std::strcmp(value, "0") != 0;
+}
+
+} // namespace
+
+CpuFeatures::CpuFeatures()
+{
+    if (SimdDisabledByEnv()) {
+        return;
+    }
+#if defined(LMCORE_CPU_X86)
+    mask_ = DetectX86();
+#elif defined(LMCORE_CPU_ARM64)
+    mask_ = DetectArm64();
+#endif
+}
+
+const CpuFeatures &CpuFeatures::Get()
+{
+    static const CpuFeatures features;
+    return features;
+}
+
+std::string CpuFeatures::ToString() const
+{
+    static const struct {
+        Feature feature;
+        const char *name;
+    } kNames[] = {
+        {kSse2, "sse2"},
+        {kSsse3, "ssse3"},
+        {kSse41, "sse4.1"},
+        {kSse42, "sse4.2"},
+        {kPclmul, "pclmul"},
+        {kAvx, "avx"},
+        {kAvx2, "avx2"},
+        {kBmi2, "bmi2"},
+        {kAvx512F, "avx512f"},
+        {kAvx512BW, "avx512bw"},
+        {kNeon, "neon"},
+        {kArmCrc32, "crc32"},
+        {kArmPmull, "pmull"},
+    };
+
+    std::string result;
+    for (const auto &entry : kNames) {
+        if (Has(entry.feature)) {
+            if (!result.empty()) {
+                result += ' ';
+            }
+            result += entry.name;
+        }
+    }
+    return result;
+}
+
+} // namespace lmshao::lmcore
@@ -8,34 +8,141 @@
 
 #include "lmcore/crc32.h"
 
+#include <array>
+
+#include "lmcore/cpu_features.h"
+#include "simd_kernels.h"
+
 namespace lmshao::lmcore {
 
-uint32_t CRC32::table_[256];
-bool CRC32::table_initialized_ = false;
+namespace {
+
+using Crc32Kernel = uint32_t (*)(uint32_t crc, const uint8_t *data, size_t len);
+
+struct SliceTables {
+    uint32_t table[8][256];
+
+    SliceTables()
+    {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int j = 0; j < 8; j++) {
+                if (crc & 1) {
+                    crc = (crc >> 1) ^ 0xEDB88320;
+                } else {
+                    crc >>= 1;
+                }
+            }
+            table[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; i++) {
+            for (int k = 1; k < 8; k++) {
+                table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+const SliceTables &GetSliceTables()
+{
+    static const SliceTables tables;
+    return tables;
+}
+
+// Portable slicing-by-8: eight table lookups per 8 input bytes
+uint32_t Crc32Slice8(uint32_t crc, const uint8_t *data, size_t len)
+{
+    const auto &t = GetSliceTables().table;
+    while (len >= 8) {
+        uint32_t one = crc ^ (static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+                              static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24);
+        uint32_t two = static_cast<uint32_t>(data[4]) | static_cast<uint32_t>(data[5]) << 8 |
+                       static_cast<uint32_t>(data[6]) << 16 | static_cast<uint32_t>(data[7]) << 24;
+        crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+              t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+        data += 8;
+        len -= 8;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        crc = t[0][(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
 
-void CRC32::InitTable()
+#if defined(LMCORE_X86_KERNELS)
+uint32_t Crc32Pclmul(uint32_t crc, const uint8_t *data, size_t len)
 {
-    if (table_initialized_) {
-        return;
+    if (len >= 64) {
+        size_t blocks = len & ~static_cast<size_t>(15);
+        crc = simd::Crc32FoldPclmul(crc, data, blocks);
+        data += blocks;
+        len -= blocks;
     }
+    return Crc32Slice8(crc, data, len);
+}
+#endif
+
+Crc32Kernel GetCrc32Kernel()
+{
+    static const Crc32Kernel kernel = SelectKernel<Crc32Kernel>(
+        {
+#if defined(LMCORE_X86_KERNELS)
+            {CpuFeatures::kSse41 | CpuFeatures::kPclmul, Crc32Pclmul},
+#endif
+#if defined(LMCORE_ARM_KERNELS)
+            {CpuFeatures::kArmCrc32, simd::Crc32Armv8},
+#endif
+        },
+        Crc32Slice8);
+    return kernel;
+}
 
-    for (uint32_t i = 0; i < 256; i++) {
-        uint32_t crc = i;
-        for (int j = 0; j < 8; j++) {
-            if (crc & 1) {
-                crc = (crc >> 1) ^ 0xEDB88320;
-            } else {
-                crc >>= 1;
+/// Multiply two polynomials modulo the CRC polynomial, in the reflected bit order of the checksum
+uint32_t MultiplyModP(uint32_t a, uint32_t b)
+{
+    uint32_t m = 1U << 31;
+    uint32_t p = 0;
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) {
+                break;
             }
         }
-        table_[i] = crc;
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ 0xEDB88320 : b >> 1;
     }
-    table_initialized_ = true;
+    return p;
 }
 
+/// x^(n * 2^k) modulo the CRC polynomial
+uint32_t PowerModP(uint64_t n, unsigned k)
+{
+    // kSquares[i] = x^(2^i), by repeated squaring of x (1 << 30 in reflected order)
+    static const auto kSquares = []() {
+        std::array<uint32_t, 32> squares{};
+        uint32_t p = 1U << 30;
+        for (auto &square : squares) {
+            square = p;
+            p = MultiplyModP(p, p);
+        }
+        return squares;
+    }();
+
+    uint32_t p = 1U << 31; // x^0
+    for (; n != 0; n >>= 1, ++k) {
+        if (n & 1) {
+            p = MultiplyModP(kSquares[k & 31], p);
+        }
+    }
+    return p;
+}
+
+} // namespace
+
 uint32_t CRC32::Calculate(const uint8_t *data, size_t len)
 {
-    InitTable();
     return UpdateInternal(0xFFFFFFFF, data, len) ^ 0xFFFFFFFF;
 }
 
@@ -49,15 +156,16 @@ uint32_t CRC32::Calculate(const std::string &data)
     return Calculate(reinterpret_cast<const uint8_t *>(data.c_str()), data.length());
 }
 
-uint32_t CRC32::UpdateInternal(uint32_t crc, const uint8_t *data, size_t len)
+uint32_t CRC32::Combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
 {
-    InitTable();
-
-    for (size_t i = 0; i < len; i++) {
-        crc = table_[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
-    }
+    // Appending len2 bytes multiplies the first CRC by x^(8 * len2); the pre/post conditioning
+    // of both checksums cancels out
+    return MultiplyModP(PowerModP(len2, 3), crc1) ^ crc2;
+}
 
-    return crc;
+uint32_t CRC32::UpdateInternal(uint32_t crc, const uint8_t *data, size_t len)
+{
+    return GetCrc32Kernel()(crc, data, len);
 }
 
 void CRC32::Context::Update(const uint8_t *data, size_t len)
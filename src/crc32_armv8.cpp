@@ -0,0 +1,54 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "simd_kernels.h"
+
+#if defined(LMCORE_ARM_KERNELS)
+
+#include <arm_acle.h>
+
+#include <cstring>
+
+namespace lmshao::lmcore::simd {
+
+uint32_t Crc32Armv8(uint32_t crc, const uint8_t *data, size_t len)
+{
+    while (len > 0 && (reinterpret_cast<uintptr_t>(data) & 7) != 0) {
+        crc = __crc32b(crc, *data++);
+        --len;
+    }
+
+    while (len >= 32) {
+        uint64_t words[4];
+        memcpy(words, data, sizeof(words));
+        crc = __crc32d(crc, words[0]);
+        crc = __crc32d(crc, words[1]);
+        crc = __crc32d(crc, words[2]);
+        crc = __crc32d(crc, words[3]);
+        data += 32;
+        len -= 32;
+    }
+
+    while (len >= 8) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = __crc32d(crc, word);
+        data += 8;
+        len -= 8;
+    }
+
+    while (len > 0) {
+        crc = __crc32b(crc, *data++);
+        --len;
+    }
+    return crc;
+}
+
+} // namespace lmshao::lmcore::simd
+
+#endif // LMCORE_ARM_KERNELS
@@ -0,0 +1,96 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "simd_kernels.h"
+
+#if defined(LMCORE_X86_KERNELS)
+
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <wmmintrin.h>
+
+namespace lmshao::lmcore::simd {
+
+namespace {
+
+// Bit-reflected folding constants for the IEEE polynomial 0x04C11DB7, from Intel's
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+alignas(16) const uint64_t kFold4[2] = {0x0154442bd4ULL, 0x01c6e41596ULL}; // x^(512+32), x^(512-32)
+alignas(16) const uint64_t kFold1[2] = {0x01751997d0ULL, 0x00ccaa009eULL}; // x^(128+32), x^(128-32)
+alignas(16) const uint64_t kFold64[2] = {0x0163cd6124ULL, 0x0000000000ULL};
+alignas(16) const uint64_t kBarrett[2] = {0x01db710641ULL, 0x01f7011641ULL}; // P'(x), u = floor(x^64 / P(x))
+
+inline __m128i Fold(__m128i acc, __m128i k, __m128i next)
+{
+    __m128i lo = _mm_clmulepi64_si128(acc, k, 0x00);
+    __m128i hi = _mm_clmulepi64_si128(acc, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+}
+
+inline __m128i Load(const uint8_t *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+} // namespace
+
+uint32_t Crc32FoldPclmul(uint32_t crc, const uint8_t *data, size_t len)
+{
+    __m128i x1 = _mm_xor_si128(Load(data), _mm_cvtsi32_si128(static_cast<int>(crc)));
+    __m128i x2 = Load(data + 16);
+    __m128i x3 = Load(data + 32);
+    __m128i x4 = Load(data + 48);
+    data += 64;
+    len -= 64;
+
+    // Fold four 128-bit lanes in parallel
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i *>(kFold4));
+    while (len >= 64) {
+        x1 = Fold(x1, k, Load(data));
+        x2 = Fold(x2, k, Load(data + 16));
+        x3 = Fold(x3, k, Load(data + 32));
+        x4 = Fold(x4, k, Load(data + 48));
+        data += 64;
+        len -= 64;
+    }
+
+    // Reduce to a single lane, then fold the remaining 16-byte blocks into it
+    k = _mm_load_si128(reinterpret_cast<const __m128i *>(kFold1));
+    x1 = Fold(x1, k, x2);
+    x1 = Fold(x1, k, x3);
+    x1 = Fold(x1, k, x4);
+    while (len >= 16) {
+        x1 = Fold(x1, k, Load(data));
+        data += 16;
+        len -= 16;
+    }
+
+    // 128 -> 64 bits
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x2Fold = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2Fold);
+
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(kFold64));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x00), x2);
+
+    // Barrett reduction to 32 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i *>(kBarrett));
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+} // namespace lmshao::lmcore::simd
+
+#endif // LMCORE_X86_KERNELS
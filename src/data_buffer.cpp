@@ -21,6 +21,10 @@
 #include <mutex>
 #include <vector>
 
+#include "lmcore/metrics.h"
+#include "lmcore/profiled_mutex.h"
+#include "lmcore/recycling_allocator.h"
+
 namespace lmshao::lmcore {
 constexpr size_t DATA_ALIGN = 8;
 inline static size_t align(size_t len)
@@ -31,10 +35,41 @@ inline static size_t align(size_t len)
 constexpr size_t POOL_BLOCK_SIZE = 4096;
 constexpr size_t POOL_GLOBAL_MAX = 1024;
 constexpr size_t POOL_LOCAL_MAX = 32;
-static std::mutex g_poolMutex;
+static InternalMutex g_poolMutex LMCORE_MUTEX_INIT("DataBuffer::PoolAlloc");
 static std::vector<DataBuffer *> g_bufferPool;
 thread_local std::vector<DataBuffer *> t_localPool;
 
+namespace {
+
+struct PoolMetrics {
+    Counter &allocLocal;
+    Counter &allocGlobal;
+    Counter &allocNew;
+    Counter &allocOversize;
+    Counter &freeLocal;
+    Counter &freeGlobal;
+    Counter &freeDropped;
+};
+
+PoolMetrics &GetPoolMetrics()
+{
+    static const char *kAlloc = "lmcore_databuffer_pool_alloc_total";
+    static const char *kFree = "lmcore_databuffer_pool_free_total";
+    static auto &registry = MetricsRegistry::GetInstance();
+    static PoolMetrics metrics{
+        registry.GetCounter(kAlloc, {{"source", "local"}}, "DataBuffer::PoolAlloc calls by buffer source"),
+        registry.GetCounter(kAlloc, {{"source", "global"}}),
+        registry.GetCounter(kAlloc, {{"source", "new"}}),
+        registry.GetCounter(kAlloc, {{"source", "oversize"}}),
+        registry.GetCounter(kFree, {{"dest", "local"}}, "DataBuffer::PoolFree calls by buffer destination"),
+        registry.GetCounter(kFree, {{"dest", "global"}}),
+        registry.GetCounter(kFree, {{"dest", "dropped"}}),
+    };
+    return metrics;
+}
+
+} // namespace
+
 DataBuffer::DataBuffer(size_t len)
 {
     if (len) {
@@ -119,8 +154,10 @@ std::shared_ptr<DataBuffer> DataBuffer::Create(size_t len)
 
 std::shared_ptr<DataBuffer> DataBuffer::PoolAlloc(size_t len)
 {
+    auto &metrics = GetPoolMetrics();
     DataBuffer *buf = nullptr;
     if (len > POOL_BLOCK_SIZE) {
+        metrics.allocOversize.Increment();
         buf = new DataBuffer(len);
         return std::shared_ptr<DataBuffer>(buf, [](DataBuffer *p) { delete p; });
     }
@@ -129,19 +166,24 @@ std::shared_ptr<DataBuffer> DataBuffer::PoolAlloc(size_t len)
         buf = t_localPool.back();
         t_localPool.pop_back();
         buf->SetSize(0);
+        metrics.allocLocal.Increment();
     } else {
-        std::lock_guard<std::mutex> lock(g_poolMutex);
+        std::lock_guard<InternalMutex> lock(g_poolMutex);
         if (!g_bufferPool.empty()) {
             buf = g_bufferPool.back();
             g_bufferPool.pop_back();
             buf->SetSize(0);
+            metrics.allocGlobal.Increment();
         }
     }
 
     if (!buf) {
         buf = new DataBuffer(POOL_BLOCK_SIZE);
+        metrics.allocNew.Increment();
     }
-    return std::shared_ptr<DataBuffer>(buf, [](DataBuffer *p) { DataBuffer::PoolFree(p); });
+    // The control block is recycled too, so a warm pool hands out buffers without touching the heap
+    return std::shared_ptr<DataBuffer>(buf, [](DataBuffer *p) { DataBuffer::PoolFree(p); },
+                                       RecyclingAllocator<DataBuffer>());
 }
 
 void DataBuffer::PoolFree(DataBuffer *buf)
@@ -149,7 +191,9 @@ void DataBuffer::PoolFree(DataBuffer *buf)
     if (!buf) {
         return;
     }
+    auto &metrics = GetPoolMetrics();
     if (buf->capacity_ != POOL_BLOCK_SIZE) {
+        metrics.freeDropped.Increment();
         delete buf;
         return;
     }
@@ -157,14 +201,17 @@ void DataBuffer::PoolFree(DataBuffer *buf)
     if (t_localPool.size() < POOL_LOCAL_MAX) {
         buf->Clear();
         t_localPool.push_back(buf);
+        metrics.freeLocal.Increment();
         return;
     }
 
-    std::lock_guard<std::mutex> lock(g_poolMutex);
+    std::lock_guard<InternalMutex> lock(g_poolMutex);
     if (g_bufferPool.size() < POOL_GLOBAL_MAX) {
         buf->Clear();
         g_bufferPool.push_back(buf);
+        metrics.freeGlobal.Increment();
     } else {
+        metrics.freeDropped.Increment();
         delete buf;
     }
 }
@@ -0,0 +1,206 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/epoch.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "thread_records.h"
+
+namespace lmshao::lmcore {
+
+struct alignas(64) EpochDomain::Record {
+    /// @brief (epoch << 1) | 1 while inside a critical section, 0 outside
+    std::atomic<uint64_t> state{0};
+    std::atomic<bool> inUse{true};
+    Record *next = nullptr;
+
+    // Owner thread only
+    uint32_t nesting = 0;
+    size_t reclaimAt = kReclaimThreshold;
+    std::vector<Retired> limbo;
+};
+
+EpochDomain::EpochDomain() : id_(detail::RegisterDomain()) {}
+
+EpochDomain::~EpochDomain()
+{
+    detail::UnregisterDomain(id_);
+
+    Record *record = records_.load(std::memory_order_acquire);
+    while (record) {
+        for (const Retired &retired : record->limbo) {
+            retired.deleter(retired.ptr);
+        }
+        Record *next = record->next;
+        delete record;
+        record = next;
+    }
+    for (const Retired &retired : orphans_) {
+        retired.deleter(retired.ptr);
+    }
+}
+
+EpochDomain &EpochDomain::Default()
+{
+    // Leaked: threads may still retire objects during static destruction
+    static EpochDomain *domain = new EpochDomain();
+    return *domain;
+}
+
+EpochDomain::Record *EpochDomain::GetRecord()
+{
+    auto *record = static_cast<Record *>(detail::FindThreadRecord(id_));
+    if (!record) {
+        record = AcquireRecord();
+        detail::AddThreadRecord(id_, this, record, &EpochDomain::ReleaseRecord);
+    }
+    return record;
+}
+
+EpochDomain::Record *EpochDomain::AcquireRecord()
+{
+    for (Record *record = records_.load(std::memory_order_acquire); record; record = record->next) {
+        bool expected = false;
+        if (!record->inUse.load(std::memory_order_relaxed) &&
+            record->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return record;
+        }
+    }
+
+    // Records are never unlinked, so pushing at the head is the only concurrent modification
+    auto *record = new Record();
+    Record *head = records_.load(std::memory_order_relaxed);
+    do {
+        record->next = head;
+    } while (!records_.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+    return record;
+}
+
+void EpochDomain::ReleaseRecord(void *domain, void *record)
+{
+    auto *self = static_cast<EpochDomain *>(domain);
+    auto *rec = static_cast<Record *>(record);
+
+    rec->nesting = 0;
+    rec->state.store(0, std::memory_order_release);
+    if (!rec->limbo.empty()) {
+        std::lock_guard<std::mutex> lock(self->orphanMutex_);
+        self->orphans_.insert(self->orphans_.end(), rec->limbo.begin(), rec->limbo.end());
+        rec->limbo.clear();
+    }
+    rec->reclaimAt = kReclaimThreshold;
+    rec->inUse.store(false, std::memory_order_release);
+}
+
+void EpochDomain::Enter()
+{
+    Record *record = GetRecord();
+    if (record->nesting++ == 0) {
+        uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+        record->state.store((epoch << 1) | 1, std::memory_order_relaxed);
+        // Announce before any protected load; pairs with the fence in TryAdvance
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+void EpochDomain::Exit()
+{
+    Record *record = GetRecord();
+    if (--record->nesting == 0) {
+        record->state.store(0, std::memory_order_release);
+    }
+}
+
+void EpochDomain::Retire(void *ptr, void (*deleter)(void *))
+{
+    Record *record = GetRecord();
+    record->limbo.push_back({ptr, deleter, epoch_.load(std::memory_order_seq_cst)});
+    pending_.fetch_add(1, std::memory_order_relaxed);
+
+    // Rescanning on every call would be wasted while a reader is stalled, so back off by a batch
+    if (record->limbo.size() >= record->reclaimAt) {
+        Reclaim();
+        record->reclaimAt = record->limbo.size() + kReclaimThreshold;
+    }
+}
+
+bool EpochDomain::TryAdvance()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+    for (Record *record = records_.load(std::memory_order_acquire); record; record = record->next) {
+        uint64_t state = record->state.load(std::memory_order_seq_cst);
+        if ((state & 1) && (state >> 1) != epoch) {
+            return false;
+        }
+    }
+    // Failure means another thread advanced it, which is just as good
+    epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+    return true;
+}
+
+size_t EpochDomain::ReclaimList(std::vector<Retired> &list, uint64_t epoch)
+{
+    // The epoch only reaches r + 2 once every active reader entered at r + 1 or later, i.e. after
+    // an object retired at r had been unlinked
+    auto ready = std::partition(list.begin(), list.end(),
+                                [epoch](const Retired &retired) { return retired.epoch + 2 > epoch; });
+    if (ready == list.end()) {
+        return 0;
+    }
+    // Deleters may retire more objects, so take them out of the list first
+    std::vector<Retired> doomed(ready, list.end());
+    list.erase(ready, list.end());
+    for (const Retired &retired : doomed) {
+        retired.deleter(retired.ptr);
+    }
+    pending_.fetch_sub(doomed.size(), std::memory_order_relaxed);
+    return doomed.size();
+}
+
+size_t EpochDomain::Reclaim()
+{
+    Record *record = GetRecord();
+    TryAdvance();
+    uint64_t epoch = epoch_.load(std::memory_order_acquire);
+    size_t reclaimed = ReclaimList(record->limbo, epoch);
+
+    std::vector<Retired> orphans;
+    {
+        std::unique_lock<std::mutex> lock(orphanMutex_, std::try_to_lock);
+        if (lock.owns_lock() && !orphans_.empty()) {
+            orphans.swap(orphans_);
+        }
+    }
+    if (!orphans.empty()) {
+        reclaimed += ReclaimList(orphans, epoch);
+        std::lock_guard<std::mutex> lock(orphanMutex_);
+        orphans_.insert(orphans_.end(), orphans.begin(), orphans.end());
+    }
+    return reclaimed;
+}
+
+void EpochDomain::Synchronize()
+{
+    uint64_t target = epoch_.load(std::memory_order_acquire) + 2;
+    while (epoch_.load(std::memory_order_acquire) < target) {
+        if (!TryAdvance()) {
+            std::this_thread::yield();
+        }
+    }
+    Reclaim();
+}
+
+size_t EpochDomain::PendingCount() const
+{
+    return pending_.load(std::memory_order_relaxed);
+}
+
+} // namespace lmshao::lmcore
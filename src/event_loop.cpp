@@ -0,0 +1,497 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/event_loop.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+#include "internal_logger.h"
+
+namespace lmshao::lmcore {
+
+namespace {
+constexpr int kMaxEvents = 64;
+
+#if defined(__linux__)
+uint32_t ToEpollEvents(uint32_t events)
+{
+    uint32_t result = 0;
+    if (events & EventLoop::kReadable) {
+        result |= EPOLLIN | EPOLLPRI;
+    }
+    if (events & EventLoop::kWritable) {
+        result |= EPOLLOUT;
+    }
+    return result;
+}
+
+uint32_t FromEpollEvents(uint32_t events)
+{
+    uint32_t result = 0;
+    if (events & (EPOLLIN | EPOLLPRI)) {
+        result |= EventLoop::kReadable;
+    }
+    if (events & EPOLLOUT) {
+        result |= EventLoop::kWritable;
+    }
+    if (events & (EPOLLERR | EPOLLHUP)) {
+        result |= EventLoop::kError;
+    }
+    return result;
+}
+
+int AddInternalFd(int epollFd, int fd)
+{
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    return epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+}
+#endif
+} // namespace
+
+EventLoop::EventLoop()
+{
+    inboxTail_ = new InboxNode();
+    inboxHead_.store(inboxTail_, std::memory_order_relaxed);
+
+#if defined(__linux__)
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    timerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (epollFd_ < 0 || wakeFd_ < 0 || timerFd_ < 0 || AddInternalFd(epollFd_, wakeFd_) < 0 ||
+        AddInternalFd(epollFd_, timerFd_) < 0) {
+        LMCORE_LOGE("EventLoop setup failed: %s", strerror(errno));
+        if (epollFd_ >= 0) {
+            close(epollFd_);
+            epollFd_ = -1;
+        }
+    }
+#endif
+}
+
+EventLoop::~EventLoop()
+{
+#if defined(__linux__)
+    for (int fd : {epollFd_, wakeFd_, timerFd_}) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+
+    InboxNode *node = inboxTail_;
+    while (node) {
+        InboxNode *next = node->next.load(std::memory_order_acquire);
+        delete node;
+        node = next;
+    }
+}
+
+int32_t EventLoop::Run()
+{
+#if defined(__linux__)
+    if (epollFd_ < 0) {
+        LMCORE_LOGE("EventLoop is not initialized");
+        return -1;
+    }
+    bool expected = false;
+    if (!running_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        LMCORE_LOGE("EventLoop is already running");
+        return -1;
+    }
+    loopThread_.store(std::this_thread::get_id(), std::memory_order_release);
+
+    epoll_event events[kMaxEvents];
+    bool busy = false;
+    int32_t result = 0;
+    while (!stopRequested_.load(std::memory_order_acquire)) {
+        int timeout = -1;
+        if (busy || !InboxEmpty()) {
+            timeout = 0;
+        } else if (HasPolledReceivers()) {
+            timeout = static_cast<int>(kReceiverPollInterval.count());
+        }
+
+        int count = epoll_wait(epollFd_, events, kMaxEvents, timeout);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LMCORE_LOGE("epoll_wait failed: %s", strerror(errno));
+            result = -1;
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd_) {
+                uint64_t value;
+                while (read(wakeFd_, &value, sizeof(value)) > 0) {
+                }
+                // An RMW, so the producers that saw the flag set are synchronized with before draining
+                wakeupPending_.exchange(false, std::memory_order_acq_rel);
+            } else if (fd == timerFd_) {
+                uint64_t expirations;
+                while (read(timerFd_, &expirations, sizeof(expirations)) > 0) {
+                }
+                RunDueTimers();
+            } else {
+                Dispatch(fd, FromEpollEvents(events[i].events));
+            }
+        }
+
+        DrainInbox();
+        busy = PollReceivers();
+    }
+
+    stopRequested_.store(false, std::memory_order_relaxed);
+    loopThread_.store(std::thread::id(), std::memory_order_release);
+    running_.store(false, std::memory_order_release);
+    return result;
+#else
+    LMCORE_LOGE("EventLoop is not supported on this platform");
+    return -1;
+#endif
+}
+
+void EventLoop::Stop()
+{
+    stopRequested_.store(true, std::memory_order_release);
+    if (!IsInLoopThread()) {
+        Wakeup();
+    }
+}
+
+void EventLoop::Wakeup()
+{
+#if defined(__linux__)
+    if (!wakeupPending_.exchange(true, std::memory_order_acq_rel)) {
+        uint64_t one = 1;
+        ssize_t ret = write(wakeFd_, &one, sizeof(one));
+        (void)ret;
+    }
+#endif
+}
+
+void EventLoop::Post(Task task)
+{
+    auto *node = new InboxNode();
+    node->task = std::move(task);
+    InboxNode *prev = inboxHead_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+
+    // The loop checks its inbox before sleeping, so posting from a handler needs no wakeup
+    if (!IsInLoopThread()) {
+        Wakeup();
+    }
+}
+
+void EventLoop::DrainInbox()
+{
+    for (size_t i = 0; i < kInboxBatch; ++i) {
+        InboxNode *next = inboxTail_->next.load(std::memory_order_acquire);
+        if (!next) {
+            // Empty, or a producer is between its exchange and linking the node; it wakes us after
+            return;
+        }
+        Task task = std::move(next->task);
+        delete inboxTail_;
+        inboxTail_ = next;
+        if (task) {
+            task();
+        }
+    }
+}
+
+EventLoop::TimerId EventLoop::RunAt(Clock::time_point when, Task task)
+{
+    TimerId id = nextTimerId_.fetch_add(1, std::memory_order_relaxed);
+    Timer timer{when, Clock::duration::zero(), std::make_shared<Task>(std::move(task))};
+    if (IsInLoopThread()) {
+        AddTimer(id, std::move(timer));
+    } else {
+        Post([this, id, timer]() { AddTimer(id, timer); });
+    }
+    return id;
+}
+
+EventLoop::TimerId EventLoop::RunEvery(Clock::duration interval, Task task)
+{
+    if (interval <= Clock::duration::zero()) {
+        LMCORE_LOGE("Invalid timer interval");
+        return 0;
+    }
+    TimerId id = nextTimerId_.fetch_add(1, std::memory_order_relaxed);
+    Timer timer{Clock::now() + interval, interval, std::make_shared<Task>(std::move(task))};
+    if (IsInLoopThread()) {
+        AddTimer(id, std::move(timer));
+    } else {
+        Post([this, id, timer]() { AddTimer(id, timer); });
+    }
+    return id;
+}
+
+bool EventLoop::CancelTimer(TimerId id)
+{
+    if (!IsInLoopThread()) {
+        Post([this, id]() { CancelTimer(id); });
+        return true;
+    }
+    // The queue entry goes stale and is skipped when it comes up
+    return timers_.erase(id) > 0;
+}
+
+void EventLoop::AddTimer(TimerId id, Timer timer)
+{
+    timerQueue_.push({timer.when, id});
+    timers_[id] = std::move(timer);
+    ArmTimerFd();
+}
+
+void EventLoop::RunDueTimers()
+{
+    // The timerfd is one-shot and has just fired
+    armedAt_ = Clock::time_point::max();
+    Clock::time_point now = Clock::now();
+    while (!timerQueue_.empty() && timerQueue_.top().when <= now) {
+        TimerEntry entry = timerQueue_.top();
+        timerQueue_.pop();
+        auto it = timers_.find(entry.id);
+        if (it == timers_.end() || it->second.when != entry.when) {
+            continue;
+        }
+
+        std::shared_ptr<Task> task = it->second.task;
+        if (it->second.interval > Clock::duration::zero()) {
+            Timer &timer = it->second;
+            auto missed = (now - timer.when) / timer.interval;
+            timer.when += timer.interval * (missed + 1);
+            timerQueue_.push({timer.when, entry.id});
+        } else {
+            timers_.erase(it);
+        }
+        // May add or cancel timers, including this one
+        (*task)();
+    }
+    ArmTimerFd();
+}
+
+void EventLoop::ArmTimerFd()
+{
+    while (!timerQueue_.empty()) {
+        const TimerEntry &top = timerQueue_.top();
+        auto it = timers_.find(top.id);
+        if (it != timers_.end() && it->second.when == top.when) {
+            break;
+        }
+        timerQueue_.pop();
+    }
+
+    Clock::time_point next = timerQueue_.empty() ? Clock::time_point::max() : timerQueue_.top().when;
+    if (next == armedAt_) {
+        return;
+    }
+#if defined(__linux__)
+    itimerspec spec{};
+    if (next != Clock::time_point::max()) {
+        // steady_clock is CLOCK_MONOTONIC, so its epoch is the timerfd's
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(next.time_since_epoch()).count();
+        ns = std::max<int64_t>(ns, 1);
+        spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000);
+        spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+    }
+    if (timerfd_settime(timerFd_, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+        LMCORE_LOGE("timerfd_settime failed: %s", strerror(errno));
+        return;
+    }
+#endif
+    armedAt_ = next;
+}
+
+int32_t EventLoop::AddFd(int fd, uint32_t events, IoCallback callback)
+{
+#if defined(__linux__)
+    if (fd < 0 || !callback || fds_.count(fd)) {
+        LMCORE_LOGE("Invalid or duplicate fd %d", fd);
+        return -1;
+    }
+    epoll_event event{};
+    event.events = ToEpollEvents(events);
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+        LMCORE_LOGE("epoll_ctl add fd %d failed: %s", fd, strerror(errno));
+        return -1;
+    }
+    fds_[fd] = {events, std::make_shared<IoCallback>(std::move(callback))};
+    return 0;
+#else
+    (void)fd;
+    (void)events;
+    (void)callback;
+    return -1;
+#endif
+}
+
+int32_t EventLoop::ModifyFd(int fd, uint32_t events)
+{
+#if defined(__linux__)
+    auto it = fds_.find(fd);
+    if (it == fds_.end()) {
+        return -1;
+    }
+    epoll_event event{};
+    event.events = ToEpollEvents(events);
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &event) < 0) {
+        LMCORE_LOGE("epoll_ctl mod fd %d failed: %s", fd, strerror(errno));
+        return -1;
+    }
+    it->second.events = events;
+    return 0;
+#else
+    (void)fd;
+    (void)events;
+    return -1;
+#endif
+}
+
+int32_t EventLoop::RemoveFd(int fd)
+{
+#if defined(__linux__)
+    auto it = fds_.find(fd);
+    if (it == fds_.end()) {
+        return -1;
+    }
+    fds_.erase(it);
+    if (epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr) < 0) {
+        LMCORE_LOGE("epoll_ctl del fd %d failed: %s", fd, strerror(errno));
+        return -1;
+    }
+    return 0;
+#else
+    (void)fd;
+    return -1;
+#endif
+}
+
+void EventLoop::Dispatch(int fd, uint32_t events)
+{
+    auto it = fds_.find(fd);
+    if (it == fds_.end()) {
+        // Removed by an earlier callback of this batch
+        return;
+    }
+    std::shared_ptr<IoCallback> callback = it->second.callback;
+    (*callback)(events);
+}
+
+EventLoop::ReceiverId EventLoop::AddReceiverSource(DrainFn drain)
+{
+    ReceiverId id = nextReceiverId_++;
+    receivers_.push_back({id, -1, std::make_shared<DrainFn>(std::move(drain))});
+    return id;
+}
+
+EventLoop::ReceiverId EventLoop::AddNotifiedReceiver(DrainFn drain, sync::ChannelNotifier *notifier,
+                                                     std::function<bool()> arm)
+{
+    ReceiverId id = nextReceiverId_++;
+    auto shared = std::make_shared<DrainFn>(std::move(drain));
+    int fd = notifier->GetFd();
+    auto onReadable = [this, id, shared, notifier, arm = std::move(arm)](uint32_t) {
+        for (;;) {
+            DrainResult result = (*shared)();
+            if (result == DrainResult::kClosed) {
+                RemoveReceiver(id);
+                return;
+            }
+            if (result == DrainResult::kBusy) {
+                // The fd stays readable, so we are called again next iteration
+                return;
+            }
+            notifier->Clear();
+            if (arm()) {
+                return;
+            }
+        }
+    };
+    if (AddFd(fd, kReadable, std::move(onReadable)) < 0) {
+        receivers_.push_back({id, -1, shared});
+        return id;
+    }
+    receivers_.push_back({id, fd, shared});
+    // First pass drains what is already queued and arms the notifier
+    notifier->Signal();
+    return id;
+}
+
+bool EventLoop::RemoveReceiver(ReceiverId id)
+{
+    auto it = std::find_if(receivers_.begin(), receivers_.end(),
+                           [id](const ReceiverSource &receiver) { return receiver.id == id; });
+    if (it == receivers_.end()) {
+        return false;
+    }
+    if (it->fd >= 0) {
+        RemoveFd(it->fd);
+    }
+    receivers_.erase(it);
+    return true;
+}
+
+size_t EventLoop::GetSourceCount() const
+{
+    // Notified receivers are counted through their fd
+    auto polled = std::count_if(receivers_.begin(), receivers_.end(),
+                                [](const ReceiverSource &receiver) { return receiver.fd < 0; });
+    return fds_.size() + timers_.size() + static_cast<size_t>(polled);
+}
+
+bool EventLoop::HasPolledReceivers() const
+{
+    return std::any_of(receivers_.begin(), receivers_.end(),
+                       [](const ReceiverSource &receiver) { return receiver.fd < 0; });
+}
+
+bool EventLoop::PollReceivers()
+{
+    bool busy = false;
+    // Index-based: handlers may add or remove receivers
+    for (size_t i = 0; i < receivers_.size();) {
+        if (receivers_[i].fd >= 0) {
+            ++i;
+            continue;
+        }
+        ReceiverId id = receivers_[i].id;
+        std::shared_ptr<DrainFn> drain = receivers_[i].drain;
+        DrainResult result = (*drain)();
+        if (result == DrainResult::kBusy) {
+            busy = true;
+        }
+        if (i < receivers_.size() && receivers_[i].id == id) {
+            if (result == DrainResult::kClosed) {
+                receivers_.erase(receivers_.begin() + static_cast<std::ptrdiff_t>(i));
+                continue;
+            }
+            ++i;
+        }
+    }
+    return busy;
+}
+
+} // namespace lmshao::lmcore
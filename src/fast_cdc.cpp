@@ -0,0 +1,215 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/fast_cdc.h"
+
+#include <algorithm>
+#include <array>
+
+#include "lmcore/data_buffer.h"
+#include "lmcore/mapped_file.h"
+#include "lmcore/thread_pool.h"
+#include "lmcore/xxhash64.h"
+
+namespace lmshao::lmcore {
+
+namespace {
+
+constexpr size_t kMinAvgSize = 256;
+constexpr size_t kMaxChunkSize = UINT32_MAX;
+/// Chunks fingerprinted per ParallelFor work item
+constexpr size_t kHashGrain = 64;
+
+constexpr uint64_t SplitMix64(uint64_t &state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr std::array<uint64_t, 256> MakeGearTable()
+{
+    std::array<uint64_t, 256> table{};
+    uint64_t state = 0x4C4D434F52454344ULL; // fixed: boundaries must not change between builds
+    for (auto &entry : table) {
+        entry = SplitMix64(state);
+    }
+    return table;
+}
+
+constexpr std::array<uint64_t, 256> kGear = MakeGearTable();
+
+/// The gear hash shifts left once per byte, so its top bits depend on the widest window (64 bytes)
+inline uint64_t TopBitsMask(int bits)
+{
+    return ~0ULL << (64 - bits);
+}
+
+} // namespace
+
+FastCdc::FastCdc(size_t minSize, size_t avgSize, size_t maxSize)
+{
+    size_t avg = kMinAvgSize;
+    while (avg < avgSize && avg < kMaxChunkSize / 2) {
+        avg <<= 1;
+    }
+    avgSize_ = avg;
+    minSize_ = std::min(minSize, avgSize_);
+    maxSize_ = std::min(std::max(maxSize, avgSize_), kMaxChunkSize);
+
+    int bits = 0;
+    while ((size_t(1) << bits) < avgSize_) {
+        ++bits;
+    }
+    maskSmall_ = TopBitsMask(bits + 2);
+    maskLarge_ = TopBitsMask(bits - 2);
+}
+
+size_t FastCdc::FindBoundary(const uint8_t *data, size_t len) const
+{
+    if (len <= minSize_) {
+        return len;
+    }
+    size_t end = std::min(len, maxSize_);
+    size_t normal = std::min(end, avgSize_);
+    uint64_t hash = 0;
+    size_t i = minSize_;
+    for (; i < normal; ++i) {
+        hash = (hash << 1) + kGear[data[i]];
+        if ((hash & maskSmall_) == 0) {
+            return i + 1;
+        }
+    }
+    for (; i < end; ++i) {
+        hash = (hash << 1) + kGear[data[i]];
+        if ((hash & maskLarge_) == 0) {
+            return i + 1;
+        }
+    }
+    return end;
+}
+
+std::vector<uint64_t> FastCdc::FindBoundaries(const uint8_t *data, uint64_t len, uint64_t begin, uint64_t end) const
+{
+    std::vector<uint64_t> ends;
+    uint64_t pos = begin;
+    while (pos < end && pos < len) {
+        pos += FindBoundary(data + pos, static_cast<size_t>(len - pos));
+        ends.push_back(pos);
+    }
+    return ends;
+}
+
+std::vector<FastCdc::Chunk> FastCdc::Split(const uint8_t *data, size_t len, ThreadPool *pool) const
+{
+    size_t segments = (len + kSegmentSize - 1) / kSegmentSize;
+    std::vector<uint64_t> ends;
+    if (!pool || segments < 2) {
+        ends = FindBoundaries(data, len, 0, len);
+    } else {
+        // Chunk each segment as if a chunk started at its first byte. The real chain coming from
+        // the previous segment usually lands on one of those boundaries within a few chunks, and
+        // from there on the two agree; until then it is followed sequentially.
+        std::vector<std::vector<uint64_t>> chains(segments);
+        pool->ParallelFor(0, segments, [&](size_t k) {
+            uint64_t begin = static_cast<uint64_t>(k) * kSegmentSize;
+            chains[k] = FindBoundaries(data, len, begin, std::min<uint64_t>(begin + kSegmentSize, len));
+        });
+
+        ends = std::move(chains[0]);
+        for (size_t k = 1; k < segments && ends.back() < len; ++k) {
+            uint64_t begin = static_cast<uint64_t>(k) * kSegmentSize;
+            uint64_t end = std::min<uint64_t>(begin + kSegmentSize, len);
+            const auto &chain = chains[k];
+            uint64_t pos = ends.back();
+            while (pos < end) {
+                auto it = pos == begin ? chain.begin() : std::lower_bound(chain.begin(), chain.end(), pos);
+                if (pos == begin || (it != chain.end() && *it == pos)) {
+                    ends.insert(ends.end(), pos == begin ? it : it + 1, chain.end());
+                    break;
+                }
+                pos += FindBoundary(data + pos, static_cast<size_t>(len - pos));
+                ends.push_back(pos);
+            }
+        }
+    }
+
+    std::vector<Chunk> chunks(ends.size());
+    auto fill = [&](size_t i) {
+        uint64_t offset = i == 0 ? 0 : ends[i - 1];
+        chunks[i].offset = offset;
+        chunks[i].length = static_cast<uint32_t>(ends[i] - offset);
+        chunks[i].fingerprint = XXHash64::Calculate(data + offset, chunks[i].length);
+    };
+    if (pool && segments >= 2) {
+        pool->ParallelFor(0, chunks.size(), fill, kHashGrain);
+    } else {
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            fill(i);
+        }
+    }
+    return chunks;
+}
+
+std::vector<FastCdc::Chunk> FastCdc::Split(const MappedFile &file, ThreadPool *pool) const
+{
+    auto chunks = Split(file.Data(), file.Size(), pool);
+    for (auto &chunk : chunks) {
+        chunk.offset += file.Offset();
+    }
+    return chunks;
+}
+
+FastCdc::Stream::Stream(const FastCdc &cdc, Callback callback) : cdc_(cdc), callback_(std::move(callback)) {}
+
+void FastCdc::Stream::Update(const uint8_t *data, size_t len)
+{
+    if (pending_.empty()) {
+        // Chunk straight from the caller's data and keep only the undecided tail
+        size_t consumed = Consume(data, len, false);
+        pending_.assign(data + consumed, data + len);
+        return;
+    }
+    pending_.insert(pending_.end(), data, data + len);
+    size_t consumed = Consume(pending_.data(), pending_.size(), false);
+    pending_.erase(pending_.begin(), pending_.begin() + static_cast<ptrdiff_t>(consumed));
+}
+
+void FastCdc::Stream::Update(const DataBuffer &buffer)
+{
+    Update(buffer.Data(), buffer.Size());
+}
+
+void FastCdc::Stream::Finish()
+{
+    Consume(pending_.data(), pending_.size(), true);
+    pending_.clear();
+    offset_ = 0;
+}
+
+size_t FastCdc::Stream::Consume(const uint8_t *data, size_t len, bool final)
+{
+    size_t pos = 0;
+    // With maxSize bytes available the boundary can't depend on data still to come
+    while (pos < len && (final || len - pos >= cdc_.maxSize_)) {
+        size_t length = cdc_.FindBoundary(data + pos, len - pos);
+        Chunk chunk;
+        chunk.offset = offset_;
+        chunk.length = static_cast<uint32_t>(length);
+        chunk.fingerprint = XXHash64::Calculate(data + pos, length);
+        if (callback_) {
+            callback_(chunk, data + pos);
+        }
+        offset_ += length;
+        pos += length;
+    }
+    return pos;
+}
+
+} // namespace lmshao::lmcore
@@ -0,0 +1,115 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "futex.h"
+
+#include <climits>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <ctime>
+#else
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace lmshao::lmcore::detail {
+
+#if defined(__linux__)
+
+namespace {
+long Futex(std::atomic<uint32_t> *addr, int op, uint32_t val, const timespec *timeout, std::atomic<uint32_t> *addr2,
+           uint32_t val3)
+{
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit integer");
+    return syscall(SYS_futex, reinterpret_cast<uint32_t *>(addr), op, val, timeout, reinterpret_cast<uint32_t *>(addr2),
+                   val3);
+}
+} // namespace
+
+bool FutexWait(std::atomic<uint32_t> *addr, uint32_t expected, int64_t timeoutNs)
+{
+    timespec ts;
+    timespec *timeout = nullptr;
+    if (timeoutNs >= 0) {
+        ts.tv_sec = static_cast<time_t>(timeoutNs / 1000000000);
+        ts.tv_nsec = static_cast<long>(timeoutNs % 1000000000);
+        timeout = &ts;
+    }
+    if (Futex(addr, FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0) == -1 && errno == ETIMEDOUT) {
+        return false;
+    }
+    return true;
+}
+
+void FutexWake(std::atomic<uint32_t> *addr, int count)
+{
+    Futex(addr, FUTEX_WAKE_PRIVATE, static_cast<uint32_t>(count), nullptr, nullptr, 0);
+}
+
+bool FutexRequeue(std::atomic<uint32_t> *addr, uint32_t expected, std::atomic<uint32_t> *target)
+{
+    // For FUTEX_CMP_REQUEUE the timeout argument carries the maximum number of threads to requeue
+    auto requeueMax = reinterpret_cast<const timespec *>(static_cast<uintptr_t>(INT_MAX));
+    return Futex(addr, FUTEX_CMP_REQUEUE_PRIVATE, 1, requeueMax, target, expected) != -1;
+}
+
+#else
+
+namespace {
+struct Bucket {
+    std::mutex mutex;
+    std::condition_variable cond;
+};
+
+constexpr size_t kBucketCount = 64;
+
+Bucket &GetBucket(const void *addr)
+{
+    static Bucket buckets[kBucketCount];
+    auto key = reinterpret_cast<uintptr_t>(addr);
+    return buckets[(key >> 4) % kBucketCount];
+}
+} // namespace
+
+bool FutexWait(std::atomic<uint32_t> *addr, uint32_t expected, int64_t timeoutNs)
+{
+    Bucket &bucket = GetBucket(addr);
+    std::unique_lock<std::mutex> lock(bucket.mutex);
+    // Wakers take the bucket lock after changing the value, so this check cannot miss a wake
+    if (addr->load(std::memory_order_acquire) != expected) {
+        return true;
+    }
+    if (timeoutNs < 0) {
+        bucket.cond.wait(lock);
+        return true;
+    }
+    return bucket.cond.wait_for(lock, std::chrono::nanoseconds(timeoutNs)) == std::cv_status::no_timeout;
+}
+
+void FutexWake(std::atomic<uint32_t> *addr, int)
+{
+    // Buckets are shared between addresses, so every sleeper is woken and rechecks its own value
+    Bucket &bucket = GetBucket(addr);
+    std::lock_guard<std::mutex> lock(bucket.mutex);
+    bucket.cond.notify_all();
+}
+
+bool FutexRequeue(std::atomic<uint32_t> *, uint32_t, std::atomic<uint32_t> *)
+{
+    return false;
+}
+
+#endif
+
+} // namespace lmshao::lmcore::detail
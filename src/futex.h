@@ -0,0 +1,40 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_FUTEX_H
+#define LMSHAO_LMCORE_FUTEX_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace lmshao::lmcore::detail {
+
+// Address-based wait/wake. Linux uses the futex syscall directly; other platforms fall back
+// to a small table of mutex/condition_variable buckets keyed by address.
+
+/**
+ * @brief Sleep while *addr == expected, until woken or timeoutNs elapses.
+ * @param timeoutNs Relative timeout in nanoseconds, -1 for none
+ * @return false if the timeout expired, true otherwise (woken, value changed or spurious)
+ */
+bool FutexWait(std::atomic<uint32_t> *addr, uint32_t expected, int64_t timeoutNs = -1);
+
+/**
+ * @brief Wake up to count threads sleeping on addr.
+ */
+void FutexWake(std::atomic<uint32_t> *addr, int count);
+
+/**
+ * @brief Wake one thread sleeping on addr and move the others to target, if *addr == expected.
+ * @return false if the value changed or requeueing isn't supported; the caller should wake all instead
+ */
+bool FutexRequeue(std::atomic<uint32_t> *addr, uint32_t expected, std::atomic<uint32_t> *target);
+
+} // namespace lmshao::lmcore::detail
+
+#endif // LMSHAO_LMCORE_FUTEX_H
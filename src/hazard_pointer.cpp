@@ -0,0 +1,204 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/hazard_pointer.h"
+
+#include <algorithm>
+
+#include "thread_records.h"
+
+namespace lmshao::lmcore {
+
+struct alignas(64) HazardDomain::Record {
+    std::atomic<void *> slots[kSlotsPerRecord] = {};
+    std::atomic<bool> inUse{true};
+    Record *next = nullptr;
+
+    // Owner thread only
+    uint32_t usedMask = 0;
+    /// @brief Extra record taken when the thread holds more guards than one record has slots
+    Record *overflow = nullptr;
+    std::vector<Retired> retired;
+};
+
+HazardDomain::HazardDomain() : id_(detail::RegisterDomain()) {}
+
+HazardDomain::~HazardDomain()
+{
+    detail::UnregisterDomain(id_);
+
+    Record *record = records_.load(std::memory_order_acquire);
+    while (record) {
+        for (const Retired &retired : record->retired) {
+            retired.deleter(retired.ptr);
+        }
+        Record *next = record->next;
+        delete record;
+        record = next;
+    }
+    for (const Retired &retired : orphans_) {
+        retired.deleter(retired.ptr);
+    }
+}
+
+HazardDomain &HazardDomain::Default()
+{
+    // Leaked: threads may still retire objects during static destruction
+    static HazardDomain *domain = new HazardDomain();
+    return *domain;
+}
+
+HazardDomain::Record *HazardDomain::GetRecord()
+{
+    auto *record = static_cast<Record *>(detail::FindThreadRecord(id_));
+    if (!record) {
+        record = AcquireRecord();
+        detail::AddThreadRecord(id_, this, record, &HazardDomain::ReleaseRecord);
+    }
+    return record;
+}
+
+HazardDomain::Record *HazardDomain::AcquireRecord()
+{
+    for (Record *record = records_.load(std::memory_order_acquire); record; record = record->next) {
+        bool expected = false;
+        if (!record->inUse.load(std::memory_order_relaxed) &&
+            record->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return record;
+        }
+    }
+
+    // Records are never unlinked, so pushing at the head is the only concurrent modification
+    auto *record = new Record();
+    Record *head = records_.load(std::memory_order_relaxed);
+    do {
+        record->next = head;
+    } while (!records_.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+    recordCount_.fetch_add(1, std::memory_order_relaxed);
+    return record;
+}
+
+void HazardDomain::ReleaseRecord(void *domain, void *record)
+{
+    auto *self = static_cast<HazardDomain *>(domain);
+    auto *rec = static_cast<Record *>(record);
+
+    if (rec->overflow) {
+        ReleaseRecord(domain, rec->overflow);
+        rec->overflow = nullptr;
+    }
+    for (auto &slot : rec->slots) {
+        slot.store(nullptr, std::memory_order_release);
+    }
+    rec->usedMask = 0;
+    if (!rec->retired.empty()) {
+        std::lock_guard<std::mutex> lock(self->orphanMutex_);
+        self->orphans_.insert(self->orphans_.end(), rec->retired.begin(), rec->retired.end());
+        rec->retired.clear();
+    }
+    rec->inUse.store(false, std::memory_order_release);
+}
+
+std::atomic<void *> *HazardDomain::AcquireSlot()
+{
+    Record *record = GetRecord();
+    for (;;) {
+        for (size_t i = 0; i < kSlotsPerRecord; ++i) {
+            if (!(record->usedMask & (1u << i))) {
+                record->usedMask |= 1u << i;
+                return &record->slots[i];
+            }
+        }
+        if (!record->overflow) {
+            record->overflow = AcquireRecord();
+        }
+        record = record->overflow;
+    }
+}
+
+void HazardDomain::ReleaseSlot(std::atomic<void *> *slot)
+{
+    for (Record *record = GetRecord(); record; record = record->overflow) {
+        if (slot >= record->slots && slot < record->slots + kSlotsPerRecord) {
+            record->usedMask &= ~(1u << (slot - record->slots));
+            return;
+        }
+    }
+}
+
+void HazardDomain::Retire(void *ptr, void (*deleter)(void *))
+{
+    Record *record = GetRecord();
+    record->retired.push_back({ptr, deleter});
+    pending_.fetch_add(1, std::memory_order_relaxed);
+
+    // Scanning costs O(slots), so wait for a batch proportional to it
+    size_t threshold = std::max(kScanThreshold, 2 * kSlotsPerRecord * recordCount_.load(std::memory_order_relaxed));
+    if (record->retired.size() >= threshold) {
+        Reclaim();
+    }
+}
+
+size_t HazardDomain::ReclaimList(std::vector<Retired> &list)
+{
+    // Pairs with the seq_cst store/load in HazardGuard::Protect: either the reader sees the object
+    // unlinked and retries, or we see its hazard
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::vector<void *> hazards;
+    for (Record *record = records_.load(std::memory_order_acquire); record; record = record->next) {
+        for (const auto &slot : record->slots) {
+            void *ptr = slot.load(std::memory_order_seq_cst);
+            if (ptr) {
+                hazards.push_back(ptr);
+            }
+        }
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    auto ready = std::partition(list.begin(), list.end(), [&hazards](const Retired &retired) {
+        return std::binary_search(hazards.begin(), hazards.end(), retired.ptr);
+    });
+    if (ready == list.end()) {
+        return 0;
+    }
+    // Deleters may retire more objects, so take them out of the list first
+    std::vector<Retired> doomed(ready, list.end());
+    list.erase(ready, list.end());
+    for (const Retired &retired : doomed) {
+        retired.deleter(retired.ptr);
+    }
+    pending_.fetch_sub(doomed.size(), std::memory_order_relaxed);
+    return doomed.size();
+}
+
+size_t HazardDomain::Reclaim()
+{
+    Record *record = GetRecord();
+    size_t reclaimed = ReclaimList(record->retired);
+
+    std::vector<Retired> orphans;
+    {
+        std::unique_lock<std::mutex> lock(orphanMutex_, std::try_to_lock);
+        if (lock.owns_lock() && !orphans_.empty()) {
+            orphans.swap(orphans_);
+        }
+    }
+    if (!orphans.empty()) {
+        reclaimed += ReclaimList(orphans);
+        std::lock_guard<std::mutex> lock(orphanMutex_);
+        orphans_.insert(orphans_.end(), orphans.begin(), orphans.end());
+    }
+    return reclaimed;
+}
+
+size_t HazardDomain::PendingCount() const
+{
+    return pending_.load(std::memory_order_relaxed);
+}
+
+} // namespace lmshao::lmcore
@@ -11,11 +11,34 @@
 #include <cctype>
 #include <sstream>
 
+#include "lmcore/cpu_features.h"
+#include "simd_kernels.h"
+
 namespace lmshao::lmcore {
 
 static const char HEX_CHARS_UPPER[] = "0123456789ABCDEF";
 static const char HEX_CHARS_LOWER[] = "0123456789abcdef";
 
+// Encodes a prefix of the input without separators, returns the number of bytes consumed
+using HexEncodeKernel = size_t (*)(const uint8_t *src, size_t len, char *dst, const char *digits);
+
+static size_t HexEncodeNone(const uint8_t *, size_t, char *, const char *)
+{
+    return 0;
+}
+
+static HexEncodeKernel GetHexEncodeKernel()
+{
+    static const HexEncodeKernel kernel = SelectKernel<HexEncodeKernel>(
+        {
+#if defined(LMCORE_X86_KERNELS)
+            {CpuFeatures::kSsse3, simd::HexEncodeSsse3},
+#endif
+        },
+        HexEncodeNone);
+    return kernel;
+}
+
 std::string Hex::Encode(const uint8_t *data, size_t len, bool uppercase, char separator)
 {
     if (!data || len == 0) {
@@ -25,6 +48,17 @@ std::string Hex::Encode(const uint8_t *data, size_t len, bool uppercase, char se
     const char *hex_chars = uppercase ? HEX_CHARS_UPPER : HEX_CHARS_LOWER;
     std::string result;
 
+    if (separator == '\0') {
+        result.resize(len * 2);
+        char *out = &result[0];
+        size_t done = GetHexEncodeKernel()(data, len, out, hex_chars);
+        for (size_t i = done; i < len; ++i) {
+            out[2 * i] = hex_chars[(data[i] >> 4) & 0x0F];
+            out[2 * i + 1] = hex_chars[data[i] & 0x0F];
+        }
+        return result;
+    }
+
     // Reserve space: 2 chars per byte + separators
     size_t reserve_size = len * 2;
     if (separator != '\0' && len > 1) {
@@ -0,0 +1,35 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "simd_kernels.h"
+
+#if defined(LMCORE_X86_KERNELS)
+
+#include <tmmintrin.h>
+
+namespace lmshao::lmcore::simd {
+
+size_t HexEncodeSsse3(const uint8_t *src, size_t len, char *dst, const char *digits)
+{
+    const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i *>(digits));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(in, 4), nibble));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(in, nibble));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return i;
+}
+
+} // namespace lmshao::lmcore::simd
+
+#endif // LMCORE_X86_KERNELS
@@ -0,0 +1,212 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/jitter_buffer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "lmcore/data_buffer.h"
+
+namespace lmshao::lmcore {
+
+JitterBuffer::JitterBuffer(size_t capacity, uint32_t clockRate, Clock::duration delay, Clock::duration nackInterval)
+    : clockRate_(clockRate ? clockRate : 90000), delay_(delay), nackInterval_(nackInterval)
+{
+    size_t size = 1;
+    while (size < capacity && size < kMaxCapacity) {
+        size <<= 1;
+    }
+    slots_.resize(size);
+    mask_ = size - 1;
+}
+
+JitterBuffer::~JitterBuffer() = default;
+
+JitterBuffer::InsertResult JitterBuffer::Insert(uint16_t seq, uint32_t timestamp, std::shared_ptr<DataBuffer> payload,
+                                                bool marker, Clock::time_point arrival)
+{
+    int64_t ext = started_ ? UnwrapSeq(seq) : 0;
+    int64_t span = static_cast<int64_t>(slots_.size());
+    if (started_ && (ext - highest_ >= span || head_ - ext >= span)) {
+        // Jumped further than the ring spans, either way (e.g. a sender restart): treat it as a new stream
+        stats_.dropped += count_;
+        Reset();
+    }
+    if (!started_) {
+        started_ = true;
+        // Offset by one wrap so that unwrapped sequence numbers stay positive
+        ext = seq + 65536;
+        head_ = ext;
+        highest_ = ext - 1;
+        scan_ = ext;
+        firstTimestamp_ = timestamp;
+        lastTimestamp_ = timestamp;
+        baseTransit_ = arrival.time_since_epoch();
+    }
+
+    if (ext < head_) {
+        ++stats_.late;
+        return InsertResult::kLate;
+    }
+    Slot &slot = slots_[ext & mask_];
+    if (slot.present && slot.seq == ext) {
+        ++stats_.duplicates;
+        return InsertResult::kDuplicate;
+    }
+
+    if (ext - head_ >= span) {
+        AdvanceHead(ext - span + 1);
+    }
+    if (ext > highest_) {
+        // Slots of the gap were released when head_ passed them a ring ago
+        for (int64_t s = highest_ + 1; s < ext; ++s) {
+            Slot &gap = slots_[s & mask_];
+            gap.seq = s;
+            gap.nackCount = 0;
+        }
+        highest_ = ext;
+        slot.nackCount = 0;
+    }
+
+    int64_t ts = UnwrapTimestamp(timestamp);
+    slot.payload = std::move(payload);
+    slot.seq = ext;
+    slot.timestamp = ts;
+    slot.marker = marker;
+    slot.present = true;
+    ++count_;
+    ++stats_.received;
+    scan_ = std::min(scan_, ext);
+
+    Clock::duration transit = arrival.time_since_epoch() - MediaTime(ts);
+    if (transit < baseTransit_) {
+        baseTransit_ = transit;
+    }
+    return InsertResult::kInserted;
+}
+
+std::optional<JitterBuffer::Packet> JitterBuffer::Pop(Clock::time_point now)
+{
+    if (count_ == 0) {
+        return std::nullopt;
+    }
+    int64_t first = FindFirstPresent();
+    Slot &slot = slots_[first & mask_];
+    if (now < PlayoutTime(slot.timestamp)) {
+        return std::nullopt;
+    }
+    // Whatever is still missing before a due packet is given up
+    AdvanceHead(first);
+
+    Packet packet;
+    packet.payload = std::move(slot.payload);
+    packet.timestamp = static_cast<uint32_t>(slot.timestamp);
+    packet.seq = static_cast<uint16_t>(first);
+    packet.marker = slot.marker;
+    slot.present = false;
+    --count_;
+    head_ = first + 1;
+    scan_ = std::max(scan_, head_);
+    return packet;
+}
+
+std::optional<JitterBuffer::Clock::time_point> JitterBuffer::GetNextPlayoutTime()
+{
+    if (count_ == 0) {
+        return std::nullopt;
+    }
+    return PlayoutTime(slots_[FindFirstPresent() & mask_].timestamp);
+}
+
+size_t JitterBuffer::GetNackList(std::vector<uint16_t> &seqs, Clock::time_point now)
+{
+    size_t added = 0;
+    for (int64_t s = head_; started_ && s < highest_; ++s) {
+        Slot &slot = slots_[s & mask_];
+        if (slot.present || slot.nackCount >= kMaxNackRetries) {
+            continue;
+        }
+        if (slot.nackCount > 0 && now - slot.lastNack < nackInterval_) {
+            continue;
+        }
+        slot.lastNack = now;
+        ++slot.nackCount;
+        seqs.push_back(static_cast<uint16_t>(s));
+        ++added;
+    }
+    stats_.nacks += added;
+    return added;
+}
+
+void JitterBuffer::Reset()
+{
+    for (Slot &slot : slots_) {
+        slot = Slot();
+    }
+    started_ = false;
+    count_ = 0;
+}
+
+int64_t JitterBuffer::UnwrapSeq(uint16_t seq) const
+{
+    auto delta = static_cast<int16_t>(static_cast<uint16_t>(seq - static_cast<uint16_t>(highest_)));
+    return highest_ + delta;
+}
+
+int64_t JitterBuffer::UnwrapTimestamp(uint32_t timestamp)
+{
+    auto delta = static_cast<int32_t>(timestamp - static_cast<uint32_t>(lastTimestamp_));
+    int64_t ext = lastTimestamp_ + delta;
+    lastTimestamp_ = std::max(lastTimestamp_, ext);
+    return ext;
+}
+
+JitterBuffer::Clock::duration JitterBuffer::MediaTime(int64_t timestamp) const
+{
+    return std::chrono::microseconds((timestamp - firstTimestamp_) * 1000000 / clockRate_);
+}
+
+JitterBuffer::Clock::time_point JitterBuffer::PlayoutTime(int64_t timestamp) const
+{
+    return Clock::time_point(MediaTime(timestamp) + baseTransit_) + delay_;
+}
+
+void JitterBuffer::AdvanceHead(int64_t seq)
+{
+    int64_t end = std::min(seq, highest_ + 1);
+    for (; head_ < end; ++head_) {
+        Slot &slot = slots_[head_ & mask_];
+        if (slot.present && slot.seq == head_) {
+            slot.present = false;
+            slot.payload.reset();
+            --count_;
+            ++stats_.dropped;
+        } else {
+            ++stats_.lost;
+        }
+    }
+    head_ = std::max(head_, seq);
+    scan_ = std::max(scan_, head_);
+}
+
+int64_t JitterBuffer::FindFirstPresent()
+{
+    // Amortized O(1): scan_ only moves back when a packet is inserted before it
+    for (int64_t s = std::max(scan_, head_); s <= highest_; ++s) {
+        const Slot &slot = slots_[s & mask_];
+        if (slot.present && slot.seq == s) {
+            scan_ = s;
+            return s;
+        }
+    }
+    scan_ = highest_ + 1;
+    return -1;
+}
+
+} // namespace lmshao::lmcore
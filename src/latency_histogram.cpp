@@ -0,0 +1,319 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/latency_histogram.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace lmshao::lmcore {
+
+namespace {
+
+constexpr double kExportPercentiles[] = {50.0, 90.0, 99.0, 99.9};
+constexpr const char *kExportNames[] = {"p50", "p90", "p99", "p999"};
+constexpr const char *kExportQuantiles[] = {"0.5", "0.9", "0.99", "0.999"};
+
+inline uint32_t HighestBit(uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return 63 - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+}
+
+// Every thread gets a sticky slot, spreading recorders over the shards round-robin
+size_t ThreadSlot()
+{
+    static std::atomic<size_t> nextSlot{0};
+    thread_local size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+size_t RoundUpPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+void AppendFormat(std::string &out, const char *fmt, ...)
+{
+    char buffer[256];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+    if (len > 0) {
+        out.append(buffer, static_cast<size_t>(len) < sizeof(buffer) ? static_cast<size_t>(len) : sizeof(buffer) - 1);
+    }
+}
+
+} // namespace
+
+size_t LatencyHistogram::BucketIndex(uint64_t value)
+{
+    if (value < kSubBucketCount) {
+        return static_cast<size_t>(value);
+    }
+    uint32_t shift = HighestBit(value) - kSubBucketBits;
+    uint64_t mantissa = value >> shift;
+    return static_cast<size_t>((shift + 1) * kSubBucketCount + (mantissa - kSubBucketCount));
+}
+
+uint64_t LatencyHistogram::BucketLowerBound(size_t index)
+{
+    if (index < kSubBucketCount) {
+        return index;
+    }
+    uint64_t shift = index / kSubBucketCount - 1;
+    uint64_t mantissa = kSubBucketCount + index % kSubBucketCount;
+    return mantissa << shift;
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index)
+{
+    if (index + 1 >= kBucketCount) {
+        return UINT64_MAX;
+    }
+    return BucketLowerBound(index + 1) - 1;
+}
+
+LatencyHistogram::Snapshot::Snapshot() : buckets_(kBucketCount, 0) {}
+
+uint64_t LatencyHistogram::Snapshot::Percentile(double percentile) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+    if (percentile <= 0.0) {
+        return min_;
+    }
+    if (percentile >= 100.0) {
+        return max_;
+    }
+
+    auto target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count_)));
+    if (target == 0) {
+        target = 1;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[i];
+        if (seen >= target) {
+            uint64_t value = BucketUpperBound(i);
+            if (value > max_) {
+                value = max_;
+            }
+            if (value < min_) {
+                value = min_;
+            }
+            return value;
+        }
+    }
+    return max_;
+}
+
+void LatencyHistogram::Snapshot::Merge(const Snapshot &other)
+{
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    if (other.min_ < min_) {
+        min_ = other.min_;
+    }
+    if (other.max_ > max_) {
+        max_ = other.max_;
+    }
+}
+
+std::string LatencyHistogram::Snapshot::ToText() const
+{
+    std::string out;
+    AppendFormat(out, "count=%" PRIu64 " min=%" PRIu64 " mean=%.2f", count_, Min(), Mean());
+    for (size_t i = 0; i < sizeof(kExportPercentiles) / sizeof(kExportPercentiles[0]); ++i) {
+        AppendFormat(out, " %s=%" PRIu64, kExportNames[i], Percentile(kExportPercentiles[i]));
+    }
+    AppendFormat(out, " max=%" PRIu64, max_);
+    return out;
+}
+
+std::string LatencyHistogram::Snapshot::ToJson() const
+{
+    std::string out;
+    AppendFormat(out, "{\"count\":%" PRIu64 ",\"sum\":%" PRIu64 ",\"min\":%" PRIu64 ",\"max\":%" PRIu64, count_,
+                 sum_, Min(), max_);
+    AppendFormat(out, ",\"mean\":%.2f", Mean());
+    for (size_t i = 0; i < sizeof(kExportPercentiles) / sizeof(kExportPercentiles[0]); ++i) {
+        AppendFormat(out, ",\"%s\":%" PRIu64, kExportNames[i], Percentile(kExportPercentiles[i]));
+    }
+    out += "}";
+    return out;
+}
+
+std::string LatencyHistogram::Snapshot::ToPrometheus(const std::string &name, const std::string &labels) const
+{
+    std::string out = "# TYPE " + name + " summary\n";
+    AppendPrometheusSamples(out, name, labels);
+    return out;
+}
+
+void LatencyHistogram::Snapshot::AppendPrometheusSamples(std::string &out, const std::string &name,
+                                                         const std::string &labels) const
+{
+    const char *sep = labels.empty() ? "" : ",";
+    for (size_t i = 0; i < sizeof(kExportPercentiles) / sizeof(kExportPercentiles[0]); ++i) {
+        AppendFormat(out, "%s{%s%squantile=\"%s\"} %" PRIu64 "\n", name.c_str(), labels.c_str(), sep,
+                     kExportQuantiles[i], Percentile(kExportPercentiles[i]));
+    }
+
+    std::string suffix = labels.empty() ? "" : "{" + labels + "}";
+    AppendFormat(out, "%s_sum%s %" PRIu64 "\n", name.c_str(), suffix.c_str(), sum_);
+    AppendFormat(out, "%s_count%s %" PRIu64 "\n", name.c_str(), suffix.c_str(), count_);
+}
+
+LatencyHistogram::LatencyHistogram(size_t shards)
+{
+    size_t shardCount = RoundUpPowerOfTwo(shards == 0 ? 1 : shards);
+    shardMask_ = shardCount - 1;
+    shards_ = std::make_unique<Shard[]>(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        ResetShard(shards_[i]);
+    }
+}
+
+LatencyHistogram::~LatencyHistogram() = default;
+
+void LatencyHistogram::ResetShard(Shard &shard)
+{
+    shard.count.store(0, std::memory_order_relaxed);
+    shard.sum.store(0, std::memory_order_relaxed);
+    shard.min.store(UINT64_MAX, std::memory_order_relaxed);
+    shard.max.store(0, std::memory_order_relaxed);
+    for (auto &bucket : shard.buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::Record(uint64_t value, uint64_t count)
+{
+    if (count == 0) {
+        return;
+    }
+
+    Shard &shard = shards_[ThreadSlot() & shardMask_];
+    shard.buckets[BucketIndex(value)].fetch_add(count, std::memory_order_relaxed);
+    shard.sum.fetch_add(value * count, std::memory_order_relaxed);
+
+    uint64_t current = shard.min.load(std::memory_order_relaxed);
+    while (value < current && !shard.min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+    current = shard.max.load(std::memory_order_relaxed);
+    while (value > current && !shard.max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+
+    // Count is published last so that a snapshot never sees more values than bucket entries
+    shard.count.fetch_add(count, std::memory_order_release);
+}
+
+void LatencyHistogram::MergeInto(Snapshot &snapshot) const
+{
+    for (size_t s = 0; s <= shardMask_; ++s) {
+        const Shard &shard = shards_[s];
+        uint64_t count = shard.count.load(std::memory_order_acquire);
+        if (count == 0) {
+            continue;
+        }
+        snapshot.count_ += count;
+        snapshot.sum_ += shard.sum.load(std::memory_order_relaxed);
+        uint64_t min = shard.min.load(std::memory_order_relaxed);
+        uint64_t max = shard.max.load(std::memory_order_relaxed);
+        if (min < snapshot.min_) {
+            snapshot.min_ = min;
+        }
+        if (max > snapshot.max_) {
+            snapshot.max_ = max;
+        }
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            snapshot.buckets_[i] += shard.buckets[i].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::GetSnapshot() const
+{
+    Snapshot snapshot;
+    MergeInto(snapshot);
+    return snapshot;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &other)
+{
+    if (&other == this) {
+        return;
+    }
+    Merge(other.GetSnapshot());
+}
+
+void LatencyHistogram::Merge(const Snapshot &snapshot)
+{
+    if (snapshot.count_ == 0) {
+        return;
+    }
+
+    Shard &shard = shards_[ThreadSlot() & shardMask_];
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        if (snapshot.buckets_[i] != 0) {
+            shard.buckets[i].fetch_add(snapshot.buckets_[i], std::memory_order_relaxed);
+        }
+    }
+    shard.sum.fetch_add(snapshot.sum_, std::memory_order_relaxed);
+
+    uint64_t current = shard.min.load(std::memory_order_relaxed);
+    while (snapshot.min_ < current &&
+           !shard.min.compare_exchange_weak(current, snapshot.min_, std::memory_order_relaxed)) {
+    }
+    current = shard.max.load(std::memory_order_relaxed);
+    while (snapshot.max_ > current &&
+           !shard.max.compare_exchange_weak(current, snapshot.max_, std::memory_order_relaxed)) {
+    }
+
+    shard.count.fetch_add(snapshot.count_, std::memory_order_release);
+}
+
+uint64_t LatencyHistogram::Count() const
+{
+    uint64_t total = 0;
+    for (size_t s = 0; s <= shardMask_; ++s) {
+        total += shards_[s].count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void LatencyHistogram::Reset()
+{
+    for (size_t s = 0; s <= shardMask_; ++s) {
+        ResetShard(shards_[s]);
+    }
+}
+
+} // namespace lmshao::lmcore
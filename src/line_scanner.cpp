@@ -0,0 +1,283 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/line_scanner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "lmcore/cpu_features.h"
+#include "lmcore/mapped_file.h"
+#include "lmcore/thread_pool.h"
+#include "simd_kernels.h"
+
+namespace lmshao::lmcore {
+
+namespace {
+
+/// Bytes whose bitmaps are built at once
+constexpr size_t kWindow = 4096;
+constexpr size_t kWindowWords = kWindow / 64;
+
+// Builds the bitmaps of a prefix, returns the number of bytes covered
+using MatchMaskKernel = size_t (*)(const uint8_t *data, size_t len, uint8_t value, uint64_t *masks);
+
+size_t MatchMaskNone(const uint8_t *, size_t, uint8_t, uint64_t *)
+{
+    return 0;
+}
+
+/// Bitmap of the bytes of data[0, len) equal to `value`, len <= kWindow; the last word may be partial
+void BuildMasks(const uint8_t *data, size_t len, uint8_t value, uint64_t *masks)
+{
+    static const MatchMaskKernel kernel = SelectKernel<MatchMaskKernel>(
+        {
+#if defined(LMCORE_X86_KERNELS)
+            {CpuFeatures::kAvx2, simd::MatchMaskAvx2},
+#endif
+        },
+        MatchMaskNone);
+
+    for (size_t i = kernel(data, len, value, masks); i < len; i += 64) {
+        size_t n = std::min<size_t>(64, len - i);
+        uint64_t mask = 0;
+        for (size_t j = 0; j < n; ++j) {
+            mask |= static_cast<uint64_t>(data[i + j] == value) << j;
+        }
+        masks[i / 64] = mask;
+    }
+}
+
+inline uint32_t TrailingZeros64(uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctzll(mask));
+#else
+    uint32_t count = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+inline uint32_t PopCount64(uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_popcountll(mask));
+#else
+    uint32_t count = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+inline const uint8_t *Bytes(std::string_view text)
+{
+    return reinterpret_cast<const uint8_t *>(text.data());
+}
+
+size_t CountQuotes(std::string_view text)
+{
+    uint64_t masks[kWindowWords];
+    size_t count = 0;
+    for (size_t base = 0; base < text.size(); base += kWindow) {
+        size_t len = std::min(kWindow, text.size() - base);
+        BuildMasks(Bytes(text) + base, len, '"', masks);
+        for (size_t w = 0; w < (len + 63) / 64; ++w) {
+            count += PopCount64(masks[w]);
+        }
+    }
+    return count;
+}
+
+/// Offset just past the first newline at or after `pos` that ends a line, or text.size()
+size_t FindLineEnd(std::string_view text, size_t pos, bool csv, bool inQuotes)
+{
+    if (!csv) {
+        const void *newline = memchr(text.data() + pos, '\n', text.size() - pos);
+        return newline ? static_cast<size_t>(static_cast<const char *>(newline) - text.data()) + 1 : text.size();
+    }
+    for (; pos < text.size(); ++pos) {
+        if (text[pos] == '"') {
+            inQuotes = !inQuotes;
+        } else if (text[pos] == '\n' && !inQuotes) {
+            return pos + 1;
+        }
+    }
+    return text.size();
+}
+
+} // namespace
+
+void LineScanner::ForEachLine(std::string_view text, const LineVisitor &visitor, bool csv)
+{
+    uint64_t newlines[kWindowWords];
+    uint64_t quotes[kWindowWords];
+    size_t lineStart = 0;
+    bool inQuotes = false;
+
+    auto emit = [&](size_t newline) {
+        size_t end = newline;
+        if (end > lineStart && text[end - 1] == '\r') {
+            --end;
+        }
+        visitor(text.substr(lineStart, end - lineStart));
+        lineStart = newline + 1;
+    };
+
+    for (size_t base = 0; base < text.size(); base += kWindow) {
+        size_t len = std::min(kWindow, text.size() - base);
+        BuildMasks(Bytes(text) + base, len, '\n', newlines);
+        if (csv) {
+            BuildMasks(Bytes(text) + base, len, '"', quotes);
+        }
+        for (size_t w = 0; w < (len + 63) / 64; ++w) {
+            size_t wordBase = base + w * 64;
+            uint64_t newlineBits = newlines[w];
+            uint64_t quoteBits = csv ? quotes[w] : 0;
+            if (quoteBits == 0) {
+                if (inQuotes) {
+                    continue; // every newline here is inside a quoted field
+                }
+                for (; newlineBits != 0; newlineBits &= newlineBits - 1) {
+                    emit(wordBase + TrailingZeros64(newlineBits));
+                }
+                continue;
+            }
+            // Walk quotes and newlines in order to know which newlines are quoted
+            for (uint64_t bits = newlineBits | quoteBits; bits != 0; bits &= bits - 1) {
+                uint32_t index = TrailingZeros64(bits);
+                if (quoteBits & (uint64_t(1) << index)) {
+                    inQuotes = !inQuotes;
+                } else if (!inQuotes) {
+                    emit(wordBase + index);
+                }
+            }
+        }
+    }
+    if (lineStart < text.size()) {
+        size_t end = text.size();
+        if (text[end - 1] == '\r') {
+            --end;
+        }
+        visitor(text.substr(lineStart, end - lineStart));
+    }
+}
+
+std::vector<std::string_view> LineScanner::Partition(std::string_view text, const Options &options, ThreadPool *pool)
+{
+    std::vector<std::string_view> parts;
+    if (text.empty()) {
+        return parts;
+    }
+    size_t partSize = std::max<size_t>(options.partSize, 1);
+    size_t nominal = (text.size() + partSize - 1) / partSize;
+
+    // Whether each nominal boundary is inside quotes: the parity of the quotes before it
+    std::vector<uint8_t> quoted(nominal, 0);
+    if (options.csv && nominal > 1) {
+        std::vector<size_t> counts(nominal);
+        auto count = [&](size_t k) { counts[k] = CountQuotes(text.substr(k * partSize, partSize)); };
+        if (pool) {
+            pool->ParallelFor(0, nominal, count);
+        } else {
+            for (size_t k = 0; k < nominal; ++k) {
+                count(k);
+            }
+        }
+        for (size_t k = 1; k < nominal; ++k) {
+            quoted[k] = static_cast<uint8_t>((quoted[k - 1] + counts[k - 1]) & 1);
+        }
+    }
+
+    size_t start = 0;
+    for (size_t k = 1; k < nominal; ++k) {
+        // Lines are the same whichever boundary the search starts from, so a line longer than a
+        // part just yields the same end twice
+        size_t end = FindLineEnd(text, k * partSize, options.csv, quoted[k] != 0);
+        if (end > start && end < text.size()) {
+            parts.push_back(text.substr(start, end - start));
+            start = end;
+        }
+    }
+    parts.push_back(text.substr(start));
+    return parts;
+}
+
+size_t LineScanner::ParallelForEachLine(std::string_view text, ThreadPool &pool, const PartLineVisitor &visitor,
+                                        const Options &options)
+{
+    auto parts = Partition(text, options, &pool);
+    pool.ParallelFor(0, parts.size(), [&](size_t part) {
+        ForEachLine(parts[part], [&](std::string_view line) { visitor(part, line); }, options.csv);
+    });
+    return parts.size();
+}
+
+size_t LineScanner::ParallelForEachLine(const MappedFile &file, ThreadPool &pool, const PartLineVisitor &visitor,
+                                        const Options &options)
+{
+    std::string_view text(reinterpret_cast<const char *>(file.Data()), file.Size());
+    return ParallelForEachLine(text, pool, visitor, options);
+}
+
+void LineScanner::SplitFields(std::string_view record, std::vector<std::string_view> &fields, char separator)
+{
+    fields.clear();
+    size_t pos = 0;
+    while (true) {
+        if (pos < record.size() && record[pos] == '"') {
+            size_t close = pos + 1;
+            while (close < record.size()) {
+                if (record[close] == '"') {
+                    if (close + 1 < record.size() && record[close + 1] == '"') {
+                        close += 2;
+                        continue;
+                    }
+                    break;
+                }
+                ++close;
+            }
+            fields.push_back(record.substr(pos + 1, close - pos - 1));
+            // Anything between the closing quote and the separator is malformed and dropped
+            size_t next = close < record.size() ? record.find(separator, close + 1) : std::string_view::npos;
+            if (next == std::string_view::npos) {
+                return;
+            }
+            pos = next + 1;
+            continue;
+        }
+        size_t next = record.find(separator, pos);
+        if (next == std::string_view::npos) {
+            fields.push_back(record.substr(pos));
+            return;
+        }
+        fields.push_back(record.substr(pos, next - pos));
+        pos = next + 1;
+    }
+}
+
+std::string LineScanner::UnescapeField(std::string_view field)
+{
+    std::string result;
+    result.reserve(field.size());
+    for (size_t i = 0; i < field.size(); ++i) {
+        result.push_back(field[i]);
+        if (field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"') {
+            ++i;
+        }
+    }
+    return result;
+}
+
+} // namespace lmshao::lmcore
@@ -0,0 +1,34 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "simd_kernels.h"
+
+#if defined(LMCORE_X86_KERNELS)
+
+#include <immintrin.h>
+
+namespace lmshao::lmcore::simd {
+
+size_t MatchMaskAvx2(const uint8_t *data, size_t len, uint8_t value, uint64_t *masks)
+{
+    const __m256i needle = _mm256_set1_epi8(static_cast<char>(value));
+
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 32));
+        uint32_t loBits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+        uint32_t hiBits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+        masks[i / 64] = (static_cast<uint64_t>(hiBits) << 32) | loBits;
+    }
+    return i;
+}
+
+} // namespace lmshao::lmcore::simd
+
+#endif // LMCORE_X86_KERNELS
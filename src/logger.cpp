@@ -14,12 +14,12 @@
 #undef WIN32_LEAN_AND_MEAN
 #endif
 
+#include <algorithm>
 #include <chrono>
 #include <cstdarg>
 #include <cstdio>
-#include <iomanip>
-#include <iostream>
-#include <sstream>
+#include <ctime>
+#include <unordered_set>
 
 namespace lmshao::lmcore {
 
@@ -32,6 +32,23 @@ Logger::Logger(const std::string &module_name)
 {
 }
 
+Logger::~Logger()
+{
+    if (file_) {
+        fclose(file_);
+    }
+}
+
+void Logger::SetLogFile(const std::string &filename)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+    log_file_ = filename;
+}
+
 void Logger::Log(LogLevel level, const char *file, int line, const char *function, const char *format, ...)
 {
     if (!ShouldLog(level)) {
@@ -40,83 +57,90 @@ void Logger::Log(LogLevel level, const char *file, int line, const char *functio
 
     va_list args;
     va_start(args, format);
-
-    char buffer[4096];
-    vsnprintf(buffer, sizeof(buffer), format, args);
-
+    Write(level, module_name_.c_str(), file, line, function, format, args);
     va_end(args);
+}
 
-    std::string time_str = GetTimeString();
-    std::string level_str = GetLevelString(level);
-    std::string filename = GetFileName(file);
-
-    std::ostringstream oss;
-    oss << "[" << time_str << "] [" << level_str << "] [" << module_name_ << "] " << filename << ":" << line << " "
-        << function << "() - " << buffer << std::endl;
-
-    std::string log_message = oss.str();
+namespace {
 
-    if (output_ == LogOutput::CONSOLE || output_ == LogOutput::BOTH) {
-        std::cout << log_message;
-        std::cout.flush();
+const char *LevelString(LogLevel level)
+{
+    static const char *level_strings[] = {"DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+    int index = static_cast<int>(level);
+    if (index >= 0 && index < 5) {
+        return level_strings[index];
     }
+    return "UNKNOWN";
+}
 
-    if ((output_ == LogOutput::FILE || output_ == LogOutput::BOTH) && !log_file_.empty()) {
-#ifdef _WIN32
-        FILE *fp = nullptr;
-        errno_t err = fopen_s(&fp, log_file_.c_str(), "a");
-        if (err == 0 && fp) {
-            fprintf(fp, "%s", log_message.c_str());
-            fclose(fp);
-        }
-#else
-        FILE *fp = fopen(log_file_.c_str(), "a");
-        if (fp) {
-            fprintf(fp, "%s", log_message.c_str());
-            fclose(fp);
+const char *BaseName(const char *filepath)
+{
+    const char *name = filepath;
+    for (const char *p = filepath; *p; ++p) {
+        if (*p == '/' || *p == '\\') {
+            name = p + 1;
         }
-#endif
     }
+    return name;
 }
 
-std::string Logger::GetTimeString() const
+size_t FormatTime(char *buffer, size_t size)
 {
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
 
-    std::ostringstream oss;
+    struct tm tm_buf {};
 #ifdef _WIN32
-    struct tm tm_buf;
-    errno_t err = localtime_s(&tm_buf, &time_t);
-    if (err == 0) {
-        oss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S");
-    }
+    localtime_s(&tm_buf, &time_t);
 #else
-    oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
+    localtime_r(&time_t, &tm_buf);
 #endif
-    oss << "." << std::setfill('0') << std::setw(3) << ms.count();
-    return oss.str();
+    size_t len = strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &tm_buf);
+    int n = snprintf(buffer + len, size - len, ".%03d", static_cast<int>(ms.count()));
+    return n > 0 ? len + static_cast<size_t>(n) : len;
 }
 
-std::string Logger::GetLevelString(LogLevel level) const
+} // namespace
+
+void Logger::Write(LogLevel level, const char *module, const char *file, int line, const char *function,
+                   const char *format, va_list args)
 {
-    static const char *level_strings[] = {"DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
-    int index = static_cast<int>(level);
-    if (index >= 0 && index < 5) {
-        return std::string(level_strings[index]);
+    // Header and message share one buffer; an over-long message is truncated
+    char buffer[4096 + 512];
+    char time_str[32];
+    FormatTime(time_str, sizeof(time_str));
+
+    int header = snprintf(buffer, sizeof(buffer), "[%s] [%s] [%s] %s:%d %s() - ", time_str, LevelString(level),
+                          module, BaseName(file), line, function);
+    size_t len = header > 0 ? std::min(static_cast<size_t>(header), sizeof(buffer) - 1) : 0;
+    int body = vsnprintf(buffer + len, sizeof(buffer) - len, format, args);
+    if (body > 0) {
+        len = std::min(len + static_cast<size_t>(body), sizeof(buffer) - 2);
     }
-    return std::string("UNKNOWN");
-}
+    buffer[len++] = '\n';
 
-std::string Logger::GetFileName(const char *filepath) const
-{
-    std::string path(filepath);
-    size_t pos = path.find_last_of("/\\");
-    if (pos != std::string::npos) {
-        return path.substr(pos + 1);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (output_ == LogOutput::CONSOLE || output_ == LogOutput::BOTH) {
+        fwrite(buffer, 1, len, stdout);
+        fflush(stdout);
+    }
+
+    if ((output_ == LogOutput::FILE || output_ == LogOutput::BOTH) && !log_file_.empty()) {
+        if (!file_) {
+#ifdef _WIN32
+            if (fopen_s(&file_, log_file_.c_str(), "a") != 0) {
+                file_ = nullptr;
+            }
+#else
+            file_ = fopen(log_file_.c_str(), "a");
+#endif
+        }
+        if (file_) {
+            fwrite(buffer, 1, len, file_);
+            fflush(file_);
+        }
     }
-    return path;
 }
 
 std::string Logger::GetColorCode(LogLevel level) const
@@ -151,16 +175,17 @@ std::string Logger::GetResetColor() const
 }
 
 // LoggerRegistry implementation - using Meyers Singleton pattern for safe initialization
-std::unordered_map<std::type_index, std::unique_ptr<Logger>> &LoggerRegistry::GetLoggers()
+FlatHashMap<std::type_index, std::unique_ptr<Logger>> &LoggerRegistry::GetLoggers()
 {
-    static std::unordered_map<std::type_index, std::unique_ptr<Logger>> loggers;
+    static FlatHashMap<std::type_index, std::unique_ptr<Logger>> loggers;
     return loggers;
 }
 
-std::unordered_map<std::type_index, std::string> &LoggerRegistry::GetModuleNames()
+const char *LoggerRegistry::InternModuleName(const std::string &name)
 {
-    static std::unordered_map<std::type_index, std::string> module_names;
-    return module_names;
+    // Leaked, and node-based so the returned pointers stay valid while more names are added
+    static auto *names = new std::unordered_set<std::string>();
+    return names->insert(name).first->c_str();
 }
 
 std::mutex &LoggerRegistry::GetRegistryMutex()
@@ -172,12 +197,9 @@ std::mutex &LoggerRegistry::GetRegistryMutex()
 Logger &LoggerRegistry::GetOrCreateLogger(std::type_index type_id, const std::string &module_name)
 {
     std::lock_guard<std::mutex> lock(GetRegistryMutex());
-    auto it = GetLoggers().find(type_id);
-    if (it == GetLoggers().end()) {
-        auto logger = std::make_unique<Logger>(module_name);
-        Logger *logger_ptr = logger.get();
-        GetLoggers()[type_id] = std::move(logger);
-        return *logger_ptr;
+    auto [it, inserted] = GetLoggers().try_emplace(type_id);
+    if (inserted) {
+        it->second = std::make_unique<Logger>(module_name);
     }
     return *it->second;
 }
@@ -17,6 +17,8 @@
 #include <unistd.h>
 #endif
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 
 namespace lmshao::lmcore {
@@ -30,7 +32,25 @@ std::shared_ptr<MappedFile> MappedFile::Open(const std::string &path)
     return file;
 }
 
-bool MappedFile::OpenImpl(const std::string &path)
+std::shared_ptr<MappedFile> MappedFile::OpenWritable(const std::string &path, size_t size)
+{
+    auto file = std::shared_ptr<MappedFile>(new MappedFile());
+    if (!file->OpenWritableImpl(path, size)) {
+        return nullptr;
+    }
+    return file;
+}
+
+std::shared_ptr<MappedFile> MappedFile::Open(const std::string &path, uint64_t offset, size_t length)
+{
+    auto file = std::shared_ptr<MappedFile>(new MappedFile());
+    if (!file->OpenImpl(path, offset, length)) {
+        return nullptr;
+    }
+    return file;
+}
+
+bool MappedFile::OpenImpl(const std::string &path, uint64_t offset, size_t length)
 {
 #ifdef _WIN32
     HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
@@ -48,11 +68,13 @@ bool MappedFile::OpenImpl(const std::string &path)
         return false;
     }
 
-    if (file_size.QuadPart == 0) {
-        std::cerr << "File is empty: " << path << std::endl;
+    auto total = static_cast<uint64_t>(file_size.QuadPart);
+    if (offset >= total) {
+        std::cerr << (total == 0 ? "File is empty: " : "Offset beyond end of file: ") << path << std::endl;
         CloseHandle(hFile);
         return false;
     }
+    size_t map_length = static_cast<size_t>((std::min)(static_cast<uint64_t>(length), total - offset));
 
     HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
 
@@ -62,7 +84,13 @@ bool MappedFile::OpenImpl(const std::string &path)
         return false;
     }
 
-    void *addr = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    // Views must start on an allocation-granularity boundary
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    uint64_t map_offset = offset - offset % info.dwAllocationGranularity;
+    size_t lead = static_cast<size_t>(offset - map_offset);
+    void *addr = MapViewOfFile(hMapping, FILE_MAP_READ, static_cast<DWORD>(map_offset >> 32),
+                               static_cast<DWORD>(map_offset), lead + map_length);
 
     if (!addr) {
         std::cerr << "Failed to map view of file: " << path << std::endl;
@@ -73,8 +101,12 @@ bool MappedFile::OpenImpl(const std::string &path)
 
     file_handle_ = hFile;
     mapping_handle_ = hMapping;
-    data_ = static_cast<uint8_t *>(addr);
-    size_ = static_cast<size_t>(file_size.QuadPart);
+    map_base_ = static_cast<uint8_t *>(addr);
+    map_size_ = lead + map_length;
+    data_ = map_base_ + lead;
+    size_ = map_length;
+    offset_ = offset;
+    fileSize_ = total;
     path_ = path;
 
 #else
@@ -91,30 +123,171 @@ bool MappedFile::OpenImpl(const std::string &path)
         return false;
     }
 
-    if (sb.st_size == 0) {
-        std::cerr << "File is empty: " << path << std::endl;
+    auto total = static_cast<uint64_t>(sb.st_size);
+    if (offset >= total) {
+        std::cerr << (total == 0 ? "File is empty: " : "Offset beyond end of file: ") << path << std::endl;
         close(fd);
         return false;
     }
+    size_t map_length = static_cast<size_t>((std::min)(static_cast<uint64_t>(length), total - offset));
 
-    void *addr = mmap(nullptr, sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // mmap() wants a page-aligned file offset
+    static const uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    uint64_t map_offset = offset - offset % page_size;
+    size_t lead = static_cast<size_t>(offset - map_offset);
+    void *addr = mmap(nullptr, lead + map_length, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(map_offset));
     if (addr == MAP_FAILED) {
         std::cerr << "Failed to mmap file: " << path << std::endl;
         close(fd);
         return false;
     }
 
-    madvise(addr, sb.st_size, MADV_SEQUENTIAL);
+    madvise(addr, lead + map_length, MADV_SEQUENTIAL);
+
+    fd_ = fd;
+    map_base_ = static_cast<uint8_t *>(addr);
+    map_size_ = lead + map_length;
+    data_ = map_base_ + lead;
+    size_ = map_length;
+    offset_ = offset;
+    fileSize_ = total;
+    path_ = path;
+#endif
+
+    return true;
+}
+
+bool MappedFile::OpenWritableImpl(const std::string &path, size_t size)
+{
+#ifdef _WIN32
+    HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                               FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (hFile == INVALID_HANDLE_VALUE) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(hFile, &file_size)) {
+        std::cerr << "Failed to get file size: " << path << std::endl;
+        CloseHandle(hFile);
+        return false;
+    }
+
+    size_t map_size = (std::max)(static_cast<size_t>(file_size.QuadPart), size);
+    if (map_size == 0) {
+        std::cerr << "File is empty: " << path << std::endl;
+        CloseHandle(hFile);
+        return false;
+    }
+
+    // The mapping grows the file to map_size, zero-filled
+    auto mapping_size = static_cast<unsigned long long>(map_size);
+    HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READWRITE, static_cast<DWORD>(mapping_size >> 32),
+                                         static_cast<DWORD>(mapping_size), nullptr);
+
+    if (!hMapping) {
+        std::cerr << "Failed to create file mapping: " << path << std::endl;
+        CloseHandle(hFile);
+        return false;
+    }
+
+    void *addr = MapViewOfFile(hMapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, 0);
+
+    if (!addr) {
+        std::cerr << "Failed to map view of file: " << path << std::endl;
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
+        return false;
+    }
+
+    file_handle_ = hFile;
+    mapping_handle_ = hMapping;
+    map_base_ = static_cast<uint8_t *>(addr);
+    map_size_ = map_size;
+    data_ = map_base_;
+    size_ = map_size;
+    fileSize_ = map_size;
+    writable_ = true;
+    path_ = path;
+
+#else
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+
+    struct stat sb;
+    if (fstat(fd, &sb) < 0) {
+        std::cerr << "Failed to get file size: " << path << std::endl;
+        close(fd);
+        return false;
+    }
+
+    size_t map_size = (std::max)(static_cast<size_t>(sb.st_size), size);
+    if (map_size == 0) {
+        std::cerr << "File is empty: " << path << std::endl;
+        close(fd);
+        return false;
+    }
+
+    if (static_cast<size_t>(sb.st_size) < map_size && ftruncate(fd, static_cast<off_t>(map_size)) < 0) {
+        std::cerr << "Failed to resize file: " << path << std::endl;
+        close(fd);
+        return false;
+    }
+
+    void *addr = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        std::cerr << "Failed to mmap file: " << path << std::endl;
+        close(fd);
+        return false;
+    }
 
     fd_ = fd;
-    data_ = static_cast<uint8_t *>(addr);
-    size_ = static_cast<size_t>(sb.st_size);
+    map_base_ = static_cast<uint8_t *>(addr);
+    map_size_ = map_size;
+    data_ = map_base_;
+    size_ = map_size;
+    fileSize_ = map_size;
+    writable_ = true;
     path_ = path;
 #endif
 
     return true;
 }
 
+int32_t MappedFile::Flush(size_t offset, size_t length) const
+{
+    if (!data_ || !writable_) {
+        return -1;
+    }
+    if (offset >= size_ || length == 0) {
+        return 0;
+    }
+    length = (std::min)(length, size_ - offset);
+
+#ifdef _WIN32
+    if (!FlushViewOfFile(data_ + offset, length) || !FlushFileBuffers(static_cast<HANDLE>(file_handle_))) {
+        std::cerr << "Failed to flush file: " << path_ << std::endl;
+        return -1;
+    }
+#else
+    // msync() wants a page-aligned start
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t start = offset - offset % page_size;
+    if (msync(data_ + start, offset + length - start, MS_SYNC) < 0) {
+        std::cerr << "Failed to msync file: " << path_ << std::endl;
+        return -1;
+    }
+#endif
+
+    return 0;
+}
+
 void MappedFile::Close()
 {
     if (!data_) {
@@ -122,7 +295,7 @@ void MappedFile::Close()
     }
 
 #ifdef _WIN32
-    UnmapViewOfFile(data_);
+    UnmapViewOfFile(map_base_);
     if (mapping_handle_) {
         CloseHandle(static_cast<HANDLE>(mapping_handle_));
         mapping_handle_ = nullptr;
@@ -132,9 +305,7 @@ void MappedFile::Close()
         file_handle_ = nullptr;
     }
 #else
-    if (data_ != nullptr) {
-        munmap(data_, size_);
-    }
+    munmap(map_base_, map_size_);
     if (fd_ >= 0) {
         close(fd_);
         fd_ = -1;
@@ -143,6 +314,11 @@ void MappedFile::Close()
 
     data_ = nullptr;
     size_ = 0;
+    map_base_ = nullptr;
+    map_size_ = 0;
+    offset_ = 0;
+    fileSize_ = 0;
+    writable_ = false;
     path_.clear();
 }
 
@@ -103,7 +103,7 @@ static void Decode(uint32_t *output, const uint8_t *input, size_t len)
     }
 }
 
-void MD5::Init(Context &ctx)
+void MD5::Init(State &ctx)
 {
     ctx.count[0] = ctx.count[1] = 0;
     ctx.state[0] = 0x67452301;
@@ -192,7 +192,7 @@ void MD5::Transform(uint32_t state[4], const uint8_t block[64])
     state[3] += d;
 }
 
-void MD5::Update(Context &ctx, const uint8_t *data, size_t len)
+void MD5::Update(State &ctx, const uint8_t *data, size_t len)
 {
     // Use size_t for loop index to match input length type
     size_t i;
@@ -227,7 +227,7 @@ void MD5::Update(Context &ctx, const uint8_t *data, size_t len)
     std::memcpy(&ctx.buffer[index], &data[i], len - i);
 }
 
-void MD5::Final(Context &ctx, uint8_t digest[16])
+void MD5::Final(State &ctx, uint8_t digest[16])
 {
     uint8_t bits[8];
     uint32_t index, padLen;
@@ -253,9 +253,17 @@ std::string MD5::DigestToHex(const uint8_t digest[16])
     return oss.str();
 }
 
+std::string MD5::Context::Final() const
+{
+    State ctx = state_;
+    uint8_t digest[16];
+    MD5::Final(ctx, digest);
+    return DigestToHex(digest);
+}
+
 std::string MD5::Calculate(const uint8_t *data, size_t len)
 {
-    Context ctx;
+    State ctx;
     uint8_t digest[16];
 
     Init(ctx);
@@ -282,7 +290,7 @@ std::string MD5::CalculateFile(const std::string &path)
         return "";
     }
 
-    Context ctx;
+    State ctx;
     uint8_t digest[16];
     Init(ctx);
 
@@ -0,0 +1,415 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/message_parser.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "lmcore/cpu_features.h"
+#include "lmcore/data_buffer.h"
+#include "simd_kernels.h"
+
+namespace lmshao::lmcore {
+
+namespace {
+
+/// Longest chunk-size line accepted in a chunked body, extensions included
+constexpr size_t kMaxChunkLine = 1024;
+constexpr size_t kInitialHeaders = 32;
+constexpr uint64_t kMaxContentLength = uint64_t(1) << 62;
+
+// Returns the offset of the first match or the number of leading positions without one
+using FindBlankLineKernel = size_t (*)(const uint8_t *data, size_t len);
+
+size_t FindBlankLineNone(const uint8_t *, size_t)
+{
+    return 0;
+}
+
+bool IEquals(std::string_view a, std::string_view b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i] >= 'A' && a[i] <= 'Z' ? static_cast<char>(a[i] | 0x20) : a[i];
+        char y = b[i] >= 'A' && b[i] <= 'Z' ? static_cast<char>(b[i] | 0x20) : b[i];
+        if (x != y) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string_view Trim(std::string_view text)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+bool IsVersion(std::string_view text)
+{
+    return text.size() > 5 && (text.substr(0, 5) == "HTTP/" || text.substr(0, 5) == "RTSP/");
+}
+
+/// 1xx, 204 and 304 responses never have a body, whatever their headers say (RFC 7230, section 3.3.3)
+bool StatusHasNoBody(int32_t code)
+{
+    return (code >= 100 && code < 200) || code == 204 || code == 304;
+}
+
+bool ParseDecimal(std::string_view text, uint64_t &value)
+{
+    if (text.empty()) {
+        return false;
+    }
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9' || value > kMaxContentLength / 10) {
+            return false;
+        }
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return value <= kMaxContentLength;
+}
+
+} // namespace
+
+MessageParser::MessageParser(size_t maxHeadSize) : maxHeadSize_(maxHeadSize)
+{
+    headers_.reserve(kInitialHeaders);
+}
+
+void MessageParser::Feed(const uint8_t *data, size_t size)
+{
+    // Drop what was parsed; this is also what invalidates the views handed out so far
+    if (pos_ == buffer_.size()) {
+        buffer_.clear();
+    } else if (pos_ > 0) {
+        buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<ptrdiff_t>(pos_));
+    }
+    pos_ = 0;
+    buffer_.insert(buffer_.end(), data, data + size);
+}
+
+void MessageParser::Feed(const DataBuffer &buffer)
+{
+    Feed(buffer.Data(), buffer.Size());
+}
+
+void MessageParser::Reset()
+{
+    buffer_.clear();
+    pos_ = 0;
+    scanned_ = 0;
+    state_ = State::kHead;
+    remaining_ = 0;
+    // The head views point into the buffer just dropped
+    isRequest_ = false;
+    startLine_ = method_ = target_ = version_ = reason_ = {};
+    statusCode_ = 0;
+    headers_.clear();
+    contentLength_ = 0;
+    body_ = {};
+    channel_ = 0;
+    error_ = "";
+    expectHeadResponse_ = false;
+}
+
+MessageParser::Event MessageParser::Next()
+{
+    body_ = {};
+    switch (state_) {
+        case State::kHead:
+            return ParseHead();
+        case State::kBody:
+            return ParseBody();
+        case State::kEnd:
+            state_ = State::kHead;
+            return Event::kEnd;
+        case State::kError:
+            return Event::kError;
+        default:
+            return ParseChunked();
+    }
+}
+
+MessageParser::Event MessageParser::ParseHead()
+{
+    // Empty lines between messages are allowed (RFC 7230, section 3.5)
+    while (pos_ < buffer_.size() && (buffer_[pos_] == '\r' || buffer_[pos_] == '\n')) {
+        ++pos_;
+        scanned_ = 0;
+    }
+    if (pos_ == buffer_.size()) {
+        return Event::kNeedMore;
+    }
+
+    if (buffer_[pos_] == '$') {
+        if (GetBufferedSize() < 4) {
+            return Event::kNeedMore;
+        }
+        size_t length = (static_cast<size_t>(buffer_[pos_ + 2]) << 8) | buffer_[pos_ + 3];
+        if (GetBufferedSize() < 4 + length) {
+            return Event::kNeedMore;
+        }
+        channel_ = buffer_[pos_ + 1];
+        body_ = View(pos_ + 4, pos_ + 4 + length);
+        pos_ += 4 + length;
+        return Event::kInterleaved;
+    }
+
+    size_t end = FindHeadEnd();
+    if (end == 0) {
+        return GetBufferedSize() > maxHeadSize_ ? Fail("message head too large") : Event::kNeedMore;
+    }
+    if (end - pos_ > maxHeadSize_) {
+        return Fail("message head too large");
+    }
+    if (!ParseHeadLines(end)) {
+        return Fail(error_);
+    }
+    pos_ = end;
+    scanned_ = 0;
+
+    contentLength_ = 0;
+    bool hasLength = false;
+    for (const auto &header : headers_) {
+        if (IEquals(header.name, "Content-Length")) {
+            uint64_t length = 0;
+            if (!ParseDecimal(header.value, length) || (hasLength && static_cast<uint64_t>(contentLength_) != length)) {
+                return Fail("invalid Content-Length");
+            }
+            contentLength_ = static_cast<int64_t>(length);
+            hasLength = true;
+        }
+    }
+    bool headResponse = expectHeadResponse_ && !isRequest_;
+    expectHeadResponse_ = expectHeadResponse_ && isRequest_;
+    std::string_view coding = GetHeader("Transfer-Encoding");
+    if (!isRequest_ && (headResponse || StatusHasNoBody(statusCode_))) {
+        // Content-Length describes the body the request would have had, if anything
+        contentLength_ = 0;
+        state_ = State::kEnd;
+    } else if (!coding.empty()) {
+        // Chunked must be the final coding; anything else would be delimited by closing the connection
+        if (coding.size() < 7 || !IEquals(coding.substr(coding.size() - 7), "chunked")) {
+            return Fail("unsupported Transfer-Encoding");
+        }
+        contentLength_ = -1;
+        state_ = State::kChunkSize;
+    } else {
+        remaining_ = static_cast<uint64_t>(contentLength_);
+        state_ = remaining_ > 0 ? State::kBody : State::kEnd;
+    }
+    return Event::kHead;
+}
+
+MessageParser::Event MessageParser::ParseBody()
+{
+    size_t size = static_cast<size_t>(std::min<uint64_t>(GetBufferedSize(), remaining_));
+    if (size == 0) {
+        return Event::kNeedMore;
+    }
+    body_ = View(pos_, pos_ + size);
+    pos_ += size;
+    remaining_ -= size;
+    if (remaining_ == 0) {
+        state_ = state_ == State::kChunkData ? State::kChunkDataEnd : State::kEnd;
+    }
+    return Event::kBody;
+}
+
+MessageParser::Event MessageParser::ParseChunked()
+{
+    while (true) {
+        if (state_ == State::kChunkData) {
+            return ParseBody();
+        }
+        size_t end = FindLineEnd();
+        if (end == 0) {
+            size_t limit = state_ == State::kTrailers ? maxHeadSize_ : kMaxChunkLine;
+            return GetBufferedSize() > limit ? Fail("chunk line too long") : Event::kNeedMore;
+        }
+        std::string_view line = View(pos_, end - 1);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        pos_ = end;
+
+        if (state_ == State::kChunkDataEnd) {
+            if (!line.empty()) {
+                return Fail("missing CRLF after chunk data");
+            }
+            state_ = State::kChunkSize;
+        } else if (state_ == State::kChunkSize) {
+            // Chunk extensions after ';' are ignored
+            line = Trim(line.substr(0, line.find(';')));
+            if (line.empty() || line.size() > 15) {
+                return Fail("invalid chunk size");
+            }
+            uint64_t size = 0;
+            for (char c : line) {
+                int lower = c | 0x20;
+                int digit = c >= '0' && c <= '9' ? c - '0' : lower >= 'a' && lower <= 'f' ? lower - 'a' + 10 : -1;
+                if (digit < 0) {
+                    return Fail("invalid chunk size");
+                }
+                size = size * 16 + static_cast<uint64_t>(digit);
+            }
+            remaining_ = size;
+            state_ = size > 0 ? State::kChunkData : State::kTrailers;
+        } else if (line.empty()) {
+            // End of the (ignored) trailer section
+            state_ = State::kHead;
+            return Event::kEnd;
+        }
+    }
+}
+
+bool MessageParser::ParseHeadLines(size_t end)
+{
+    headers_.clear();
+    isRequest_ = false;
+    method_ = target_ = version_ = reason_ = {};
+    statusCode_ = 0;
+
+    size_t lineStart = pos_;
+    bool first = true;
+    while (lineStart < end) {
+        auto newline = static_cast<const uint8_t *>(memchr(buffer_.data() + lineStart, '\n', end - lineStart));
+        size_t next = static_cast<size_t>(newline - buffer_.data()) + 1;
+        std::string_view line = View(lineStart, next - 1);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        lineStart = next;
+        if (line.empty()) {
+            break;
+        }
+
+        if (first) {
+            first = false;
+            startLine_ = line;
+            size_t space = line.find(' ');
+            if (space == std::string_view::npos) {
+                error_ = "malformed start line";
+                return false;
+            }
+            if (IsVersion(line.substr(0, space))) {
+                // Status line: version code reason
+                version_ = line.substr(0, space);
+                std::string_view rest = line.substr(space + 1);
+                uint64_t code = 0;
+                if (rest.size() < 3 || (rest.size() > 3 && rest[3] != ' ') || !ParseDecimal(rest.substr(0, 3), code)) {
+                    error_ = "invalid status code";
+                    return false;
+                }
+                statusCode_ = static_cast<int32_t>(code);
+                reason_ = rest.size() > 4 ? rest.substr(4) : std::string_view();
+            } else {
+                // Request line: method target version
+                size_t second = line.find(' ', space + 1);
+                if (space == 0 || second == std::string_view::npos || second == space + 1 ||
+                    !IsVersion(line.substr(second + 1))) {
+                    error_ = "malformed request line";
+                    return false;
+                }
+                isRequest_ = true;
+                method_ = line.substr(0, space);
+                target_ = line.substr(space + 1, second - space - 1);
+                version_ = line.substr(second + 1);
+            }
+            continue;
+        }
+
+        if (line.front() == ' ' || line.front() == '\t') {
+            error_ = "obsolete header line folding";
+            return false;
+        }
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos || colon == 0 || line[colon - 1] == ' ' || line[colon - 1] == '\t') {
+            error_ = "malformed header";
+            return false;
+        }
+        headers_.push_back({line.substr(0, colon), Trim(line.substr(colon + 1))});
+    }
+    return true;
+}
+
+size_t MessageParser::FindHeadEnd()
+{
+    static const FindBlankLineKernel kernel = SelectKernel<FindBlankLineKernel>(
+        {
+#if defined(LMCORE_X86_KERNELS)
+            {CpuFeatures::kAvx2, simd::FindBlankLineAvx2},
+#endif
+        },
+        FindBlankLineNone);
+
+    const uint8_t *data = buffer_.data() + pos_;
+    size_t len = GetBufferedSize();
+    size_t p = scanned_ + kernel(data + scanned_, len - scanned_);
+    while (p < len) {
+        auto newline = static_cast<const uint8_t *>(memchr(data + p, '\n', len - p));
+        if (!newline) {
+            p = len;
+            break;
+        }
+        size_t q = static_cast<size_t>(newline - data);
+        if (q + 1 >= len || (data[q + 1] == '\r' && q + 2 >= len)) {
+            p = q; // can't tell yet
+            break;
+        }
+        if (data[q + 1] == '\n') {
+            return pos_ + q + 2;
+        }
+        if (data[q + 1] == '\r' && data[q + 2] == '\n') {
+            return pos_ + q + 3;
+        }
+        p = q + 1;
+    }
+    scanned_ = p;
+    return 0;
+}
+
+size_t MessageParser::FindLineEnd() const
+{
+    const void *newline = memchr(buffer_.data() + pos_, '\n', GetBufferedSize());
+    return newline ? static_cast<size_t>(static_cast<const uint8_t *>(newline) - buffer_.data()) + 1 : 0;
+}
+
+MessageParser::Event MessageParser::Fail(const char *error)
+{
+    error_ = error;
+    state_ = State::kError;
+    return Event::kError;
+}
+
+std::string_view MessageParser::View(size_t begin, size_t end) const
+{
+    return std::string_view(reinterpret_cast<const char *>(buffer_.data()) + begin, end - begin);
+}
+
+std::string_view MessageParser::GetHeader(std::string_view name) const
+{
+    for (const auto &header : headers_) {
+        if (IEquals(header.name, name)) {
+            return header.value;
+        }
+    }
+    return {};
+}
+
+} // namespace lmshao::lmcore
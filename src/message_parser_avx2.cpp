@@ -0,0 +1,43 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "simd_kernels.h"
+
+#if defined(LMCORE_X86_KERNELS)
+
+#include <immintrin.h>
+
+namespace lmshao::lmcore::simd {
+
+size_t FindBlankLineAvx2(const uint8_t *data, size_t len)
+{
+    const __m256i lf = _mm256_set1_epi8('\n');
+    const __m256i cr = _mm256_set1_epi8('\r');
+
+    // Compare each position with the two bytes after it, using loads shifted by one and two
+    size_t i = 0;
+    for (; i + 34 <= len; i += 32) {
+        __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 1));
+        __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 2));
+        __m256i crlf = _mm256_and_si256(_mm256_cmpeq_epi8(v1, cr), _mm256_cmpeq_epi8(v2, lf));
+        __m256i blank = _mm256_and_si256(_mm256_cmpeq_epi8(v0, lf), _mm256_or_si256(_mm256_cmpeq_epi8(v1, lf), crlf));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(blank));
+        if (mask != 0) {
+            for (; !(mask & 1u); mask >>= 1) {
+                ++i;
+            }
+            return i;
+        }
+    }
+    return i;
+}
+
+} // namespace lmshao::lmcore::simd
+
+#endif // LMCORE_X86_KERNELS
@@ -0,0 +1,302 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/metrics.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "internal_logger.h"
+
+namespace lmshao::lmcore {
+
+namespace {
+
+const char *TypeName(MetricsRegistry::Type type)
+{
+    switch (type) {
+        case MetricsRegistry::Type::kCounter:
+            return "counter";
+        case MetricsRegistry::Type::kGauge:
+            return "gauge";
+        case MetricsRegistry::Type::kHistogram:
+            return "summary";
+        default:
+            return "untyped";
+    }
+}
+
+void AppendEscaped(std::string &out, const std::string &value, bool json)
+{
+    for (char c : value) {
+        switch (c) {
+            case '\\':
+                out += "\\\\";
+                break;
+            case '"':
+                out += "\\\"";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            default:
+                if (json && static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    out += buffer;
+                } else {
+                    out += c;
+                }
+                break;
+        }
+    }
+}
+
+// Prometheus label list without braces: key1="v1",key2="v2"
+std::string FormatLabels(const MetricLabels &labels)
+{
+    std::string out;
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (i > 0) {
+            out += ',';
+        }
+        out += labels[i].first;
+        out += "=\"";
+        AppendEscaped(out, labels[i].second, false);
+        out += '"';
+    }
+    return out;
+}
+
+std::string SeriesName(const std::string &name, const std::string &labels)
+{
+    return labels.empty() ? name : name + "{" + labels + "}";
+}
+
+} // namespace
+
+size_t CurrentMetricShard()
+{
+#if defined(__linux__)
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<size_t>(cpu) & (Counter::kShards - 1);
+    }
+#endif
+    static std::atomic<size_t> nextSlot{0};
+    thread_local size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed);
+    return slot & (Counter::kShards - 1);
+}
+
+MetricsRegistry &MetricsRegistry::GetInstance()
+{
+    // Intentionally leaked: metrics may still be updated by static objects during process exit
+    static MetricsRegistry *instance = new MetricsRegistry();
+    return *instance;
+}
+
+MetricsRegistry::Series &MetricsRegistry::GetSeries(Type type, const std::string &name, const MetricLabels &labels,
+                                                    const std::string &help)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto familyIt = families_.find(name);
+    if (familyIt == families_.end()) {
+        familyIt = families_.emplace(name, Family{type, help, {}}).first;
+    } else if (familyIt->second.type != type) {
+        LMCORE_LOGE("Metric %s already registered as %s, requested %s", name.c_str(),
+                    TypeName(familyIt->second.type), TypeName(type));
+        orphans_.push_back(std::make_unique<Series>());
+        Series &orphan = *orphans_.back();
+        orphan.counter = std::make_unique<Counter>();
+        orphan.gauge = std::make_unique<Gauge>();
+        orphan.histogram = std::make_unique<LatencyHistogram>(1);
+        return orphan;
+    }
+
+    Family &family = familyIt->second;
+    if (family.help.empty() && !help.empty()) {
+        family.help = help;
+    }
+
+    std::string key = FormatLabels(labels);
+    auto seriesIt = family.series.find(key);
+    if (seriesIt != family.series.end()) {
+        return seriesIt->second;
+    }
+
+    Series &series = family.series[key];
+    series.labels = labels;
+    switch (type) {
+        case Type::kCounter:
+            series.counter = std::make_unique<Counter>();
+            break;
+        case Type::kGauge:
+            series.gauge = std::make_unique<Gauge>();
+            break;
+        case Type::kHistogram:
+            series.histogram = std::make_unique<LatencyHistogram>();
+            break;
+    }
+    return series;
+}
+
+Counter &MetricsRegistry::GetCounter(const std::string &name, const MetricLabels &labels, const std::string &help)
+{
+    return *GetSeries(Type::kCounter, name, labels, help).counter;
+}
+
+Gauge &MetricsRegistry::GetGauge(const std::string &name, const MetricLabels &labels, const std::string &help)
+{
+    return *GetSeries(Type::kGauge, name, labels, help).gauge;
+}
+
+LatencyHistogram &MetricsRegistry::GetHistogram(const std::string &name, const MetricLabels &labels,
+                                                const std::string &help)
+{
+    return *GetSeries(Type::kHistogram, name, labels, help).histogram;
+}
+
+std::string MetricsRegistry::ExportText() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string out;
+    char buffer[32];
+    for (const auto &[name, family] : families_) {
+        for (const auto &[labels, series] : family.series) {
+            out += SeriesName(name, labels);
+            out += ' ';
+            switch (family.type) {
+                case Type::kCounter:
+                    snprintf(buffer, sizeof(buffer), "%" PRIu64, series.counter->Value());
+                    out += buffer;
+                    break;
+                case Type::kGauge:
+                    snprintf(buffer, sizeof(buffer), "%" PRId64, series.gauge->Value());
+                    out += buffer;
+                    break;
+                case Type::kHistogram:
+                    out += series.histogram->GetSnapshot().ToText();
+                    break;
+            }
+            out += '\n';
+        }
+    }
+    return out;
+}
+
+std::string MetricsRegistry::ExportJson() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string out = "[";
+    char buffer[32];
+    bool first = true;
+    for (const auto &[name, family] : families_) {
+        for (const auto &entry : family.series) {
+            const Series &series = entry.second;
+            if (!first) {
+                out += ',';
+            }
+            first = false;
+
+            out += "{\"name\":\"";
+            AppendEscaped(out, name, true);
+            out += "\",\"type\":\"";
+            out += family.type == Type::kHistogram ? "histogram" : TypeName(family.type);
+            out += "\",\"labels\":{";
+            for (size_t i = 0; i < series.labels.size(); ++i) {
+                if (i > 0) {
+                    out += ',';
+                }
+                out += '"';
+                AppendEscaped(out, series.labels[i].first, true);
+                out += "\":\"";
+                AppendEscaped(out, series.labels[i].second, true);
+                out += '"';
+            }
+            out += "},\"value\":";
+            switch (family.type) {
+                case Type::kCounter:
+                    snprintf(buffer, sizeof(buffer), "%" PRIu64, series.counter->Value());
+                    out += buffer;
+                    break;
+                case Type::kGauge:
+                    snprintf(buffer, sizeof(buffer), "%" PRId64, series.gauge->Value());
+                    out += buffer;
+                    break;
+                case Type::kHistogram:
+                    out += series.histogram->GetSnapshot().ToJson();
+                    break;
+            }
+            out += '}';
+        }
+    }
+    out += ']';
+    return out;
+}
+
+std::string MetricsRegistry::ExportPrometheus() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string out;
+    char buffer[32];
+    for (const auto &[name, family] : families_) {
+        if (!family.help.empty()) {
+            out += "# HELP " + name + " ";
+            for (char c : family.help) {
+                if (c == '\\') {
+                    out += "\\\\";
+                } else if (c == '\n') {
+                    out += "\\n";
+                } else {
+                    out += c;
+                }
+            }
+            out += '\n';
+        }
+        out += "# TYPE " + name + " " + TypeName(family.type) + "\n";
+
+        for (const auto &[labels, series] : family.series) {
+            switch (family.type) {
+                case Type::kCounter:
+                    snprintf(buffer, sizeof(buffer), " %" PRIu64 "\n", series.counter->Value());
+                    out += SeriesName(name, labels) + buffer;
+                    break;
+                case Type::kGauge:
+                    snprintf(buffer, sizeof(buffer), " %" PRId64 "\n", series.gauge->Value());
+                    out += SeriesName(name, labels) + buffer;
+                    break;
+                case Type::kHistogram:
+                    series.histogram->GetSnapshot().AppendPrometheusSamples(out, name, labels);
+                    break;
+            }
+        }
+    }
+    return out;
+}
+
+void MetricsRegistry::ResetAll()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &familyEntry : families_) {
+        for (auto &seriesEntry : familyEntry.second.series) {
+            Series &series = seriesEntry.second;
+            if (series.counter) {
+                series.counter->Reset();
+            }
+            if (series.histogram) {
+                series.histogram->Reset();
+            }
+        }
+    }
+}
+
+} // namespace lmshao::lmcore
@@ -25,7 +25,7 @@ DataBufferPool::DataBufferPool(size_t defaultSize, size_t maxPoolSize) : default
     };
 
     // Create the underlying ObjectPool
-    pool_ = std::make_unique<ObjectPool<DataBuffer>>(factory, resetter, nullptr, maxPoolSize);
+    pool_ = std::make_unique<ObjectPool<DataBuffer>>(factory, resetter, nullptr, maxPoolSize, "databuffer_pool");
 }
 
 std::shared_ptr<DataBuffer> DataBufferPool::Acquire(size_t size)
@@ -0,0 +1,49 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/parallel_ordered_stage.h"
+
+#include "internal_logger.h"
+
+namespace lmshao::lmcore::detail {
+
+OrderedWindow::OrderedWindow(size_t window) : window_(window) {}
+
+void OrderedWindow::WaitReleased(uint64_t count)
+{
+    if (GetReleased() >= count) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Announced before the check, so Publish() either sees a waiter or stored before the check
+    waiting_.fetch_add(1, std::memory_order_seq_cst);
+    cv_.wait(lock, [this, count]() { return GetReleased() >= count; });
+    waiting_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void OrderedWindow::Publish(uint64_t count)
+{
+    released_.store(count, std::memory_order_seq_cst);
+    if (waiting_.load(std::memory_order_seq_cst) > 0) {
+        // Taking the lock closes the gap between a waiter's check and its sleep
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_all();
+    }
+}
+
+void LogOrderedStageException(const std::string &stage, const char *what)
+{
+    LMCORE_LOGE("Ordered stage %s threw: %s, item dropped", stage.c_str(), what);
+}
+
+void LogOrderedStageRejected(const std::string &stage)
+{
+    LMCORE_LOGW("Ordered stage %s: its pool is shut down, item dropped", stage.c_str());
+}
+
+} // namespace lmshao::lmcore::detail
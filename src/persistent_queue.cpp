@@ -0,0 +1,337 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/persistent_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "internal_logger.h"
+#include "lmcore/data_buffer.h"
+#include "lmcore/mapped_file.h"
+
+namespace lmshao::lmcore {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x4C4D5051; // "LMPQ"
+constexpr uint32_t kVersion = 1;
+constexpr size_t kHeaderFileSize = 4096;
+constexpr size_t kMinSegmentSize = 64;
+/// Length value telling the consumer that the rest of the segment is unused
+constexpr uint32_t kRolloverMarker = UINT32_MAX;
+
+constexpr uint64_t AlignRecord(uint64_t size)
+{
+    return (size + 7) & ~uint64_t(7);
+}
+
+int MakeDirectory(const std::string &dir)
+{
+#ifdef _WIN32
+    return _mkdir(dir.c_str());
+#else
+    return mkdir(dir.c_str(), 0755);
+#endif
+}
+
+void SyncDirectory(const std::string &dir)
+{
+#ifndef _WIN32
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+#else
+    (void)dir;
+#endif
+}
+
+} // namespace
+
+/**
+ * Layout of the header file. Each side's cursor has its own cache line, written only by that side.
+ *
+ * A count cannot change together with its cursor, so each side first stores the cursor it is about to
+ * publish with the count that goes with it. The pending count is the live one while the cursor equals
+ * the pending cursor: a crash between storing the cursor and the count leaves neither count wrong.
+ * Headers from before the pending fields have them zeroed and fall back to the plain counts.
+ */
+struct PersistentQueue::Header {
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    std::atomic<uint64_t> segmentSize;
+
+    /// Logical byte offset (segment index * segment size + offset) of the end of the last record
+    alignas(64) std::atomic<uint64_t> writeCursor;
+    std::atomic<uint64_t> pushed;
+    std::atomic<uint64_t> pendingWriteCursor;
+    std::atomic<uint64_t> pendingPushed;
+
+    /// Logical byte offset of the oldest record
+    alignas(64) std::atomic<uint64_t> readCursor;
+    std::atomic<uint64_t> popped;
+    std::atomic<uint64_t> pendingReadCursor;
+    std::atomic<uint64_t> pendingPopped;
+
+    uint64_t Pushed() const
+    {
+        uint64_t cursor = writeCursor.load(std::memory_order_acquire);
+        if (pendingWriteCursor.load(std::memory_order_acquire) == cursor) {
+            return pendingPushed.load(std::memory_order_acquire);
+        }
+        return pushed.load(std::memory_order_acquire);
+    }
+
+    uint64_t Popped() const
+    {
+        uint64_t cursor = readCursor.load(std::memory_order_acquire);
+        if (pendingReadCursor.load(std::memory_order_acquire) == cursor) {
+            return pendingPopped.load(std::memory_order_acquire);
+        }
+        return popped.load(std::memory_order_acquire);
+    }
+};
+
+PersistentQueue::PersistentQueue(std::string dir) : dir_(std::move(dir)) {}
+
+PersistentQueue::~PersistentQueue()
+{
+    if (headerFile_) {
+        headerFile_->Flush(0, sizeof(Header));
+    }
+}
+
+std::shared_ptr<PersistentQueue> PersistentQueue::Open(const std::string &dir, size_t segmentSize)
+{
+    auto queue = std::shared_ptr<PersistentQueue>(new PersistentQueue(dir));
+    if (queue->OpenImpl(segmentSize) != 0) {
+        return nullptr;
+    }
+    return queue;
+}
+
+int32_t PersistentQueue::OpenImpl(size_t segmentSize)
+{
+    static_assert(sizeof(Header) <= kHeaderFileSize, "Header must fit the header file");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared cursors must be lock-free");
+
+    if (MakeDirectory(dir_) != 0 && errno != EEXIST) {
+        LMCORE_LOGE("Failed to create queue directory %s: %s", dir_.c_str(), strerror(errno));
+        return -1;
+    }
+    headerFile_ = MappedFile::OpenWritable(dir_ + "/header", kHeaderFileSize);
+    if (!headerFile_) {
+        LMCORE_LOGE("Failed to map queue header in %s", dir_.c_str());
+        return -1;
+    }
+    header_ = reinterpret_cast<Header *>(headerFile_->MutableData());
+
+    // Whoever sets the segment size first creates the queue; a concurrent opener adopts it
+    uint64_t size = AlignRecord(std::max(segmentSize, kMinSegmentSize));
+    uint64_t existing = 0;
+    if (header_->segmentSize.compare_exchange_strong(existing, size)) {
+        header_->version = kVersion;
+    } else {
+        size = existing;
+    }
+    uint32_t magic = 0;
+    if (!header_->magic.compare_exchange_strong(magic, kMagic) && (magic != kMagic || header_->version != kVersion)) {
+        LMCORE_LOGE("Not a queue header (magic %08x, version %u) in %s", magic, header_->version, dir_.c_str());
+        return -1;
+    }
+    segmentSize_ = static_cast<size_t>(size);
+    if (headerFile_->Flush(0, sizeof(Header)) != 0) {
+        return -1;
+    }
+
+    // Segments before the consumer's are left over from a crash between its commit and their removal
+    removedBelow_ = header_->readCursor.load(std::memory_order_acquire) / segmentSize_;
+    for (uint64_t index = removedBelow_; index > 0 && std::remove(SegmentPath(index - 1).c_str()) == 0; --index) {
+    }
+    return 0;
+}
+
+int32_t PersistentQueue::Push(const DataBuffer &record, bool sync)
+{
+    return Push(record.Data(), record.Size(), sync);
+}
+
+int32_t PersistentQueue::Push(const uint8_t *data, size_t size, bool sync)
+{
+    if (size > segmentSize_ - kRecordHeaderSize) {
+        LMCORE_LOGE("Record of %zu bytes does not fit a %zu-byte queue segment", size, segmentSize_);
+        return -1;
+    }
+    uint64_t need = AlignRecord(kRecordHeaderSize + size);
+    uint64_t cursor = header_->writeCursor.load(std::memory_order_relaxed);
+    uint64_t index = cursor / segmentSize_;
+    size_t offset = static_cast<size_t>(cursor % segmentSize_);
+
+    if (offset + need > segmentSize_) {
+        // Records never straddle segments: mark the rest of this one unused and start the next
+        MappedFile *segment = MapSegment(writeSegment_, writeIndex_, index, true);
+        if (!segment) {
+            return -1;
+        }
+        memcpy(segment->MutableData() + offset, &kRolloverMarker, sizeof(kRolloverMarker));
+        if (sync && segment->Flush(offset, sizeof(kRolloverMarker)) != 0) {
+            return -1;
+        }
+        ++index;
+        offset = 0;
+    }
+    MappedFile *segment = MapSegment(writeSegment_, writeIndex_, index, true);
+    if (!segment) {
+        return -1;
+    }
+    uint8_t *dst = segment->MutableData() + offset;
+    auto length = static_cast<uint32_t>(size);
+    memcpy(dst, &length, sizeof(length));
+    memset(dst + sizeof(length), 0, kRecordHeaderSize - sizeof(length));
+    if (size > 0) {
+        memcpy(dst + kRecordHeaderSize, data, size);
+    }
+    // The record must be on disk before the cursor that publishes it
+    if (sync && segment->Flush(offset, kRecordHeaderSize + size) != 0) {
+        return -1;
+    }
+
+    uint64_t pushed = header_->Pushed() + 1;
+    cursor = index * segmentSize_ + offset + need;
+    header_->pendingWriteCursor.store(cursor, std::memory_order_release);
+    header_->pendingPushed.store(pushed, std::memory_order_release);
+    header_->writeCursor.store(cursor, std::memory_order_release);
+    header_->pushed.store(pushed, std::memory_order_release);
+    if (sync && headerFile_->Flush(0, sizeof(Header)) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+std::optional<PersistentQueue::Record> PersistentQueue::Front()
+{
+    uint64_t cursor = header_->readCursor.load(std::memory_order_relaxed);
+    if (cursor == header_->writeCursor.load(std::memory_order_acquire)) {
+        return std::nullopt;
+    }
+    for (;;) {
+        MappedFile *segment = MapSegment(readSegment_, readIndex_, cursor / segmentSize_, false);
+        if (!segment) {
+            return std::nullopt;
+        }
+        size_t offset = static_cast<size_t>(cursor % segmentSize_);
+        const uint8_t *src = segment->Data() + offset;
+        uint32_t length = 0;
+        memcpy(&length, src, sizeof(length));
+        if (length == kRolloverMarker) {
+            // The producer has moved on to the next segment, so the record is there
+            cursor = (cursor / segmentSize_ + 1) * segmentSize_;
+            header_->readCursor.store(cursor, std::memory_order_release);
+            continue;
+        }
+        if (length > segmentSize_ - offset - kRecordHeaderSize) {
+            LMCORE_LOGE("Corrupt record length %u at offset %zu of %s", length, offset, readSegment_->Path().c_str());
+            return std::nullopt;
+        }
+        return Record{src + kRecordHeaderSize, length};
+    }
+}
+
+int32_t PersistentQueue::Pop(bool sync)
+{
+    auto record = Front();
+    if (!record) {
+        return -1;
+    }
+    // Front() has skipped any roll-over marker
+    uint64_t cursor = header_->readCursor.load(std::memory_order_relaxed);
+    cursor += AlignRecord(kRecordHeaderSize + record->size);
+    uint64_t popped = header_->Popped() + 1;
+    header_->pendingReadCursor.store(cursor, std::memory_order_release);
+    header_->pendingPopped.store(popped, std::memory_order_release);
+    header_->readCursor.store(cursor, std::memory_order_release);
+    header_->popped.store(popped, std::memory_order_release);
+    // Only a durable cursor may drop the segments behind it
+    if (sync) {
+        if (headerFile_->Flush(0, sizeof(Header)) != 0) {
+            return -1;
+        }
+        RemoveConsumedSegments();
+    } else if (cursor / segmentSize_ > removedBelow_ && headerFile_->Flush(0, sizeof(Header)) == 0) {
+        // The cursor left a segment behind: one flush per segment keeps unsynced consumers from filling the disk
+        RemoveConsumedSegments();
+    }
+    return 0;
+}
+
+bool PersistentQueue::Empty() const
+{
+    return header_->readCursor.load(std::memory_order_acquire) == header_->writeCursor.load(std::memory_order_acquire);
+}
+
+uint64_t PersistentQueue::GetSize() const
+{
+    uint64_t popped = header_->Popped();
+    uint64_t pushed = header_->Pushed();
+    return pushed > popped ? pushed - popped : 0;
+}
+
+std::string PersistentQueue::SegmentPath(uint64_t index) const
+{
+    char name[32];
+    snprintf(name, sizeof(name), "/%020llu.seg", static_cast<unsigned long long>(index));
+    return dir_ + name;
+}
+
+MappedFile *PersistentQueue::MapSegment(std::shared_ptr<MappedFile> &slot, uint64_t &slotIndex, uint64_t index,
+                                        bool create)
+{
+    if (slot && slotIndex == index) {
+        return slot.get();
+    }
+    slot.reset();
+    std::string path = SegmentPath(index);
+    auto segment = MappedFile::OpenWritable(path, create ? segmentSize_ : 0);
+    if (!segment || segment->Size() != segmentSize_) {
+        LMCORE_LOGE("Failed to map queue segment %s", path.c_str());
+        return nullptr;
+    }
+    if (create) {
+        SyncDirectory(dir_);
+    }
+    slot = std::move(segment);
+    slotIndex = index;
+    return slot.get();
+}
+
+void PersistentQueue::RemoveConsumedSegments()
+{
+    uint64_t index = header_->readCursor.load(std::memory_order_relaxed) / segmentSize_;
+    if (readSegment_ && readIndex_ < index) {
+        readSegment_.reset();
+    }
+    for (; removedBelow_ < index; ++removedBelow_) {
+        std::remove(SegmentPath(removedBelow_).c_str());
+    }
+}
+
+} // namespace lmshao::lmcore
@@ -0,0 +1,134 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/pipeline.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <poll.h>
+#include <pthread.h>
+#endif
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#define LMCORE_PIPELINE_PAUSE() _mm_pause()
+#else
+#define LMCORE_PIPELINE_PAUSE() ((void)0)
+#endif
+
+#include "internal_logger.h"
+
+namespace lmshao::lmcore::detail {
+
+namespace {
+
+PipelineStageOptions Normalize(PipelineStageOptions options)
+{
+    options.workers = std::max<size_t>(options.workers, 1);
+    options.capacity = std::max<size_t>(options.capacity, 1);
+    return options;
+}
+
+/// Pthread names are limited to 15 characters
+std::string ThreadName(const std::string &stage, size_t worker)
+{
+    std::string suffix = "-" + std::to_string(worker);
+    return stage.substr(0, 15 - std::min<size_t>(suffix.size(), 15)) + suffix;
+}
+
+} // namespace
+
+PipelineStageState::PipelineStageState(std::string name, PipelineStageOptions options)
+    : name_(std::move(name)), options_(Normalize(std::move(options))), start_(std::chrono::steady_clock::now())
+{
+}
+
+PipelineStageStats PipelineStageState::GetStats() const
+{
+    PipelineStageStats stats;
+    stats.name = name_;
+    stats.workers = options_.workers;
+    stats.items = items.load(std::memory_order_relaxed);
+    stats.dropped = dropped.load(std::memory_order_relaxed);
+    stats.inputWaits = inputWaits.load(std::memory_order_relaxed);
+    stats.outputWaits = outputWaits.load(std::memory_order_relaxed);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    stats.itemsPerSecond = seconds > 0 ? static_cast<double>(stats.items) / seconds : 0.0;
+    stats.latency = latency.GetSnapshot();
+    stats.queueDelay = queueDelay.GetSnapshot();
+    return stats;
+}
+
+void SetupPipelineWorker(const PipelineStageState &state, size_t worker)
+{
+    std::string name = ThreadName(state.GetName(), worker);
+#if !defined(_WIN32)
+#if defined(__APPLE__)
+    pthread_setname_np(name.c_str());
+#else
+    pthread_setname_np(pthread_self(), name.c_str());
+#endif
+#endif
+
+    const auto &cpus = state.GetOptions().cpus;
+    if (cpus.empty()) {
+        return;
+    }
+    int cpu = cpus[worker % cpus.size()];
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (ret != 0) {
+        LMCORE_LOGW("Failed to pin %s to CPU %d: %d", name.c_str(), cpu, ret);
+    }
+#elif defined(_WIN32)
+    if (SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) == 0) {
+        LMCORE_LOGW("Failed to pin %s to CPU %d: %lu", name.c_str(), cpu, GetLastError());
+    }
+#else
+    LMCORE_LOGW("Thread pinning is not supported on this platform, %s runs unpinned", name.c_str());
+#endif
+}
+
+void WaitPipelineNotifier(sync::ChannelNotifier *notifier)
+{
+#ifndef _WIN32
+    if (notifier->GetFd() >= 0) {
+        pollfd pfd{notifier->GetFd(), POLLIN, 0};
+        poll(&pfd, 1, -1);
+        notifier->Clear();
+        return;
+    }
+#endif
+    // No descriptor on this platform: fall back to polling
+    notifier->Disarm();
+    std::this_thread::yield();
+}
+
+void PipelineIdle(WaitStrategy wait)
+{
+    if (wait == WaitStrategy::kSpin) {
+        LMCORE_PIPELINE_PAUSE();
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+void LogPipelineException(const std::string &stage, const char *what)
+{
+    LMCORE_LOGE("Pipeline stage %s threw: %s, item dropped", stage.c_str(), what);
+}
+
+} // namespace lmshao::lmcore::detail
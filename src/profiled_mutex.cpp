@@ -0,0 +1,334 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/profiled_mutex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#define LMCORE_HAVE_BACKTRACE 1
+#endif
+
+#include "lmcore/metrics.h"
+
+#if defined(__GNUC__)
+#define LMCORE_RETURN_ADDRESS() __builtin_return_address(0)
+#else
+#define LMCORE_RETURN_ADDRESS() nullptr
+#endif
+
+namespace lmshao::lmcore {
+
+namespace {
+constexpr size_t kMaxCallSites = 16;
+constexpr int kCallSiteFrames = 4;
+
+struct CallSite {
+    std::atomic<uint64_t> key{0};
+    std::atomic<bool> ready{false};
+    void *frames[kCallSiteFrames] = {};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> waitNs{0};
+};
+
+uint64_t NowNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+} // namespace
+
+struct ProfiledMutexStats {
+    explicit ProfiledMutexStats(const std::string &mutexName) : name(mutexName)
+    {
+        auto &registry = MetricsRegistry::GetInstance();
+        MetricLabels labels{{"mutex", name}};
+        wait = &registry.GetHistogram("lmcore_mutex_wait_ns", labels, "Time spent waiting for a contended mutex");
+        hold = &registry.GetHistogram("lmcore_mutex_hold_ns", labels, "Time a mutex was held");
+        contendedCounter = &registry.GetCounter("lmcore_mutex_contended_total", labels, "Contended acquisitions");
+    }
+
+    std::string name;
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> contended{0};
+    std::atomic<uint64_t> waitNs{0};
+    std::atomic<uint64_t> maxWaitNs{0};
+    std::atomic<uint64_t> untrackedSites{0};
+    LatencyHistogram *wait;
+    LatencyHistogram *hold;
+    Counter *contendedCounter;
+    CallSite sites[kMaxCallSites];
+};
+
+namespace {
+struct StatsTable {
+    std::mutex mutex;
+    std::map<std::string, ProfiledMutexStats *> byName;
+};
+
+StatsTable &GetStatsTable()
+{
+    // Leaked like MetricsRegistry: mutexes with static storage may still be used during exit
+    static auto *table = new StatsTable();
+    return *table;
+}
+
+ProfiledMutexStats *GetStats(const char *name)
+{
+    auto &table = GetStatsTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto &stats = table.byName[name];
+    if (!stats) {
+        stats = new ProfiledMutexStats(name);
+    }
+    return stats;
+}
+
+std::string Symbolize(void *address)
+{
+    char buffer[512];
+#if defined(LMCORE_HAVE_BACKTRACE)
+    Dl_info info;
+    if (dladdr(address, &info) && info.dli_sname) {
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        const char *symbol = (status == 0 && demangled) ? demangled : info.dli_sname;
+        snprintf(buffer, sizeof(buffer), "%s+0x%zx", symbol,
+                 static_cast<size_t>(static_cast<char *>(address) - static_cast<char *>(info.dli_saddr)));
+        free(demangled);
+        return buffer;
+    }
+    if (dladdr(address, &info) && info.dli_fname) {
+        snprintf(buffer, sizeof(buffer), "%s+0x%zx", info.dli_fname,
+                 static_cast<size_t>(static_cast<char *>(address) - static_cast<char *>(info.dli_fbase)));
+        return buffer;
+    }
+#endif
+    snprintf(buffer, sizeof(buffer), "%p", address);
+    return buffer;
+}
+
+// The waiting frame is the first one outside the std lock wrappers
+std::string DescribeCallSite(const CallSite &site)
+{
+    std::string fallback;
+    for (void *frame : site.frames) {
+        if (!frame) {
+            break;
+        }
+        std::string symbol = Symbolize(frame);
+        if (symbol.rfind("std::", 0) == 0) {
+            if (fallback.empty()) {
+                fallback = symbol;
+            }
+            continue;
+        }
+        return symbol;
+    }
+    return fallback.empty() ? "<unknown>" : fallback;
+}
+
+void AppendDuration(std::string &out, uint64_t ns)
+{
+    char buffer[32];
+    if (ns >= 1000000000ULL) {
+        snprintf(buffer, sizeof(buffer), "%.2fs", static_cast<double>(ns) / 1e9);
+    } else if (ns >= 1000000ULL) {
+        snprintf(buffer, sizeof(buffer), "%.2fms", static_cast<double>(ns) / 1e6);
+    } else if (ns >= 1000ULL) {
+        snprintf(buffer, sizeof(buffer), "%.2fus", static_cast<double>(ns) / 1e3);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%" PRIu64 "ns", ns);
+    }
+    out += buffer;
+}
+} // namespace
+
+ProfiledMutex::ProfiledMutex(const char *name) : stats_(GetStats(name)) {}
+
+void ProfiledMutex::lock()
+{
+    if (!mutex_.try_lock()) {
+        uint64_t start = NowNs();
+        mutex_.lock();
+        RecordContended(NowNs() - start, LMCORE_RETURN_ADDRESS());
+    }
+    stats_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    acquiredAt_ = std::chrono::steady_clock::now();
+}
+
+bool ProfiledMutex::try_lock()
+{
+    if (!mutex_.try_lock()) {
+        return false;
+    }
+    stats_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    acquiredAt_ = std::chrono::steady_clock::now();
+    return true;
+}
+
+void ProfiledMutex::unlock()
+{
+    stats_->hold->RecordDuration(std::chrono::steady_clock::now() - acquiredAt_);
+    mutex_.unlock();
+}
+
+void ProfiledMutex::RecordContended(uint64_t waitNs, void *caller)
+{
+    ProfiledMutexStats &stats = *stats_;
+    stats.contended.fetch_add(1, std::memory_order_relaxed);
+    stats.contendedCounter->Increment();
+    stats.waitNs.fetch_add(waitNs, std::memory_order_relaxed);
+    stats.wait->Record(waitNs);
+    uint64_t max = stats.maxWaitNs.load(std::memory_order_relaxed);
+    while (waitNs > max && !stats.maxWaitNs.compare_exchange_weak(max, waitNs, std::memory_order_relaxed)) {
+    }
+
+    // Contended path only: a short backtrace starting at the caller of lock() identifies the call
+    // site even when std::lock_guard isn't inlined (the report skips std:: frames)
+    void *frames[kCallSiteFrames + 2] = {};
+    void **callerFrames = frames;
+    int callerDepth = 0;
+#if defined(LMCORE_HAVE_BACKTRACE)
+    int depth = backtrace(frames, kCallSiteFrames + 2);
+    for (int i = 0; i < depth; ++i) {
+        if (frames[i] == caller) {
+            callerFrames = frames + i;
+            callerDepth = std::min(depth - i, kCallSiteFrames);
+            break;
+        }
+    }
+#endif
+    if (callerDepth == 0) {
+        frames[0] = caller;
+        frames[1] = nullptr;
+        callerFrames = frames;
+        callerDepth = caller ? 1 : 0;
+    }
+
+    uint64_t key = 1469598103934665603ULL;
+    for (int i = 0; i < callerDepth; ++i) {
+        key = (key ^ reinterpret_cast<uintptr_t>(callerFrames[i])) * 1099511628211ULL;
+    }
+    key |= 1; // 0 marks a free slot
+
+    for (auto &site : stats.sites) {
+        uint64_t current = site.key.load(std::memory_order_acquire);
+        if (current == 0) {
+            if (site.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                for (int i = 0; i < callerDepth; ++i) {
+                    site.frames[i] = callerFrames[i];
+                }
+                site.ready.store(true, std::memory_order_release);
+                current = key;
+            }
+        }
+        if (current == key) {
+            site.count.fetch_add(1, std::memory_order_relaxed);
+            site.waitNs.fetch_add(waitNs, std::memory_order_relaxed);
+            return;
+        }
+    }
+    stats.untrackedSites.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string ProfiledMutex::Report(size_t top)
+{
+    std::vector<ProfiledMutexStats *> all;
+    {
+        auto &table = GetStatsTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        for (const auto &pair : table.byName) {
+            all.push_back(pair.second);
+        }
+    }
+    std::sort(all.begin(), all.end(), [](const ProfiledMutexStats *a, const ProfiledMutexStats *b) {
+        uint64_t waitA = a->waitNs.load(std::memory_order_relaxed);
+        uint64_t waitB = b->waitNs.load(std::memory_order_relaxed);
+        if (waitA != waitB) {
+            return waitA > waitB;
+        }
+        return a->contended.load(std::memory_order_relaxed) > b->contended.load(std::memory_order_relaxed);
+    });
+    if (all.size() > top) {
+        all.resize(top);
+    }
+
+    std::string out = "Top contended mutexes by total wait time\n";
+    char line[256];
+    size_t rank = 0;
+    for (const ProfiledMutexStats *stats : all) {
+        uint64_t acquisitions = stats->acquisitions.load(std::memory_order_relaxed);
+        uint64_t contended = stats->contended.load(std::memory_order_relaxed);
+        double ratio = acquisitions ? 100.0 * static_cast<double>(contended) / static_cast<double>(acquisitions) : 0;
+        snprintf(line, sizeof(line), "%zu. %s: acquisitions=%" PRIu64 " contended=%" PRIu64 " (%.2f%%) wait_total=",
+                 ++rank, stats->name.c_str(), acquisitions, contended, ratio);
+        out += line;
+        AppendDuration(out, stats->waitNs.load(std::memory_order_relaxed));
+        out += " wait_max=";
+        AppendDuration(out, stats->maxWaitNs.load(std::memory_order_relaxed));
+        out += "\n   wait_ns: " + stats->wait->GetSnapshot().ToText();
+        out += "\n   hold_ns: " + stats->hold->GetSnapshot().ToText() + "\n";
+
+        std::vector<const CallSite *> sites;
+        for (const auto &site : stats->sites) {
+            if (site.ready.load(std::memory_order_acquire)) {
+                sites.push_back(&site);
+            }
+        }
+        std::sort(sites.begin(), sites.end(), [](const CallSite *a, const CallSite *b) {
+            return a->waitNs.load(std::memory_order_relaxed) > b->waitNs.load(std::memory_order_relaxed);
+        });
+        for (const CallSite *site : sites) {
+            snprintf(line, sizeof(line), "   %8" PRIu64 " waits ", site->count.load(std::memory_order_relaxed));
+            out += line;
+            AppendDuration(out, site->waitNs.load(std::memory_order_relaxed));
+            out += "  " + DescribeCallSite(*site) + "\n";
+        }
+        uint64_t untracked = stats->untrackedSites.load(std::memory_order_relaxed);
+        if (untracked) {
+            snprintf(line, sizeof(line), "   %8" PRIu64 " waits at other call sites\n", untracked);
+            out += line;
+        }
+    }
+    return out;
+}
+
+void ProfiledMutex::ResetAll()
+{
+    auto &table = GetStatsTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    for (auto &pair : table.byName) {
+        ProfiledMutexStats &stats = *pair.second;
+        stats.acquisitions.store(0, std::memory_order_relaxed);
+        stats.contended.store(0, std::memory_order_relaxed);
+        stats.waitNs.store(0, std::memory_order_relaxed);
+        stats.maxWaitNs.store(0, std::memory_order_relaxed);
+        stats.untrackedSites.store(0, std::memory_order_relaxed);
+        stats.wait->Reset();
+        stats.hold->Reset();
+        for (auto &site : stats.sites) {
+            site.ready.store(false, std::memory_order_relaxed);
+            site.count.store(0, std::memory_order_relaxed);
+            site.waitNs.store(0, std::memory_order_relaxed);
+            site.key.store(0, std::memory_order_release);
+        }
+    }
+}
+
+} // namespace lmshao::lmcore
@@ -0,0 +1,407 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/record_log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "internal_logger.h"
+#include "lmcore/byte_order.h"
+#include "lmcore/crc32.h"
+#include "lmcore/data_buffer.h"
+#include "lmcore/mapped_file.h"
+
+namespace lmshao::lmcore {
+
+namespace {
+
+constexpr size_t kSegmentNameDigits = 20;
+
+std::string SegmentPath(const std::string &dir, uint64_t baseSeq)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%020llu.log", static_cast<unsigned long long>(baseSeq));
+    return dir + "/" + name;
+}
+
+uint32_t RecordCrc(const uint8_t *header, const uint8_t *data, size_t size)
+{
+    CRC32::Context ctx;
+    ctx.Update(header, 4);
+    ctx.Update(data, size);
+    return ctx.Final();
+}
+
+/**
+ * @brief Walk the valid records at the start of a segment image.
+ * @param visit Called with each record; returns false to stop
+ * @return Offset just past the last valid record visited
+ */
+template <typename Fn>
+size_t ScanRecords(const uint8_t *data, size_t size, Fn &&visit)
+{
+    size_t offset = 0;
+    while (size - offset >= RecordLog::kHeaderSize) {
+        const uint8_t *header = data + offset;
+        uint32_t length = ByteOrder::ReadBE32(header);
+        if (length > size - offset - RecordLog::kHeaderSize) {
+            break;
+        }
+        const uint8_t *payload = header + RecordLog::kHeaderSize;
+        if (RecordCrc(header, payload, length) != ByteOrder::ReadBE32(header + 4)) {
+            break;
+        }
+        if (!visit(payload, static_cast<size_t>(length))) {
+            break;
+        }
+        offset += RecordLog::kHeaderSize + length;
+    }
+    return offset;
+}
+
+#ifndef _WIN32
+int SyncData(int fd)
+{
+#if defined(__linux__)
+    return fdatasync(fd);
+#else
+    return fsync(fd);
+#endif
+}
+
+bool Preallocate(int fd, size_t size)
+{
+#if defined(__linux__)
+    if (posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0) {
+        return true;
+    }
+#endif
+    // Not supported by the file system: reserve the size at least
+    return ftruncate(fd, static_cast<off_t>(size)) == 0;
+}
+
+bool WriteAt(int fd, const uint8_t *data, size_t size, uint64_t offset)
+{
+    while (size > 0) {
+        ssize_t n = pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+void SyncDirectory(const std::string &dir)
+{
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+#endif
+
+} // namespace
+
+struct RecordLog::Segment {
+    ~Segment()
+    {
+#ifndef _WIN32
+        if (fd >= 0) {
+            close(fd);
+        }
+#endif
+    }
+
+    int fd = -1;
+    uint64_t baseSeq = 0;
+};
+
+RecordLog::RecordLog(std::string dir, size_t segmentSize)
+    : dir_(std::move(dir)), segmentSize_(std::max(segmentSize, kHeaderSize + 1))
+{
+}
+
+RecordLog::~RecordLog() = default;
+
+std::shared_ptr<RecordLog> RecordLog::Open(const std::string &dir, size_t segmentSize)
+{
+    auto log = std::shared_ptr<RecordLog>(new RecordLog(dir, segmentSize));
+    if (log->OpenImpl() != 0) {
+        return nullptr;
+    }
+    return log;
+}
+
+int64_t RecordLog::Append(const DataBuffer &record, bool sync)
+{
+    return Append(record.Data(), record.Size(), sync);
+}
+
+#ifndef _WIN32
+
+int32_t RecordLog::OpenImpl()
+{
+    if (mkdir(dir_.c_str(), 0755) != 0 && errno != EEXIST) {
+        LMCORE_LOGE("Failed to create log directory %s: %s", dir_.c_str(), strerror(errno));
+        return -1;
+    }
+    DIR *dir = opendir(dir_.c_str());
+    if (!dir) {
+        LMCORE_LOGE("Failed to open log directory %s: %s", dir_.c_str(), strerror(errno));
+        return -1;
+    }
+    while (dirent *entry = readdir(dir)) {
+        const char *name = entry->d_name;
+        if (strlen(name) == kSegmentNameDigits + 4 && strcmp(name + kSegmentNameDigits, ".log") == 0 &&
+            std::all_of(name, name + kSegmentNameDigits, [](char c) { return c >= '0' && c <= '9'; })) {
+            segmentBases_.push_back(strtoull(name, nullptr, 10));
+        }
+    }
+    closedir(dir);
+    std::sort(segmentBases_.begin(), segmentBases_.end());
+
+    if (segmentBases_.empty()) {
+        active_ = CreateSegment(0);
+        if (!active_) {
+            return -1;
+        }
+        segmentBases_.push_back(0);
+        return 0;
+    }
+
+    // Only the last segment can have been torn by a crash
+    uint64_t base = segmentBases_.back();
+    std::string path = SegmentPath(dir_, base);
+    auto segment = std::make_shared<Segment>();
+    segment->baseSeq = base;
+    segment->fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+    struct stat st {};
+    if (segment->fd < 0 || fstat(segment->fd, &st) != 0) {
+        LMCORE_LOGE("Failed to open log segment %s: %s", path.c_str(), strerror(errno));
+        return -1;
+    }
+
+    size_t end = 0;
+    uint64_t count = 0;
+    if (st.st_size > 0) {
+        auto file = MappedFile::Open(path);
+        if (!file) {
+            LMCORE_LOGE("Failed to map log segment %s", path.c_str());
+            return -1;
+        }
+        end = ScanRecords(file->Data(), file->Size(), [&count](const uint8_t *, size_t) {
+            ++count;
+            return true;
+        });
+    }
+    // Cut whatever follows the last good record and zero-fill the rest again, so that stale bytes
+    // can never line up with a later record boundary
+    if (static_cast<size_t>(st.st_size) != end || end < segmentSize_) {
+        if (ftruncate(segment->fd, static_cast<off_t>(end)) != 0 ||
+            !Preallocate(segment->fd, std::max(end, segmentSize_)) || SyncData(segment->fd) != 0) {
+            LMCORE_LOGE("Failed to recover log segment %s: %s", path.c_str(), strerror(errno));
+            return -1;
+        }
+    }
+    active_ = std::move(segment);
+    writeOffset_ = end;
+    nextSeq_ = base + count;
+    return 0;
+}
+
+std::shared_ptr<RecordLog::Segment> RecordLog::CreateSegment(uint64_t baseSeq)
+{
+    std::string path = SegmentPath(dir_, baseSeq);
+    auto segment = std::make_shared<Segment>();
+    segment->baseSeq = baseSeq;
+    segment->fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (segment->fd < 0 || !Preallocate(segment->fd, segmentSize_) || SyncData(segment->fd) != 0) {
+        LMCORE_LOGE("Failed to create log segment %s: %s", path.c_str(), strerror(errno));
+        return nullptr;
+    }
+    SyncDirectory(dir_);
+    return segment;
+}
+
+int32_t RecordLog::Rotate()
+{
+    // Seal the full segment: everything before the active segment is always durable
+    if (SyncData(active_->fd) != 0) {
+        LMCORE_LOGE("Failed to sync log segment: %s", strerror(errno));
+        return -1;
+    }
+    auto segment = CreateSegment(nextSeq_);
+    if (!segment) {
+        return -1;
+    }
+    active_ = std::move(segment);
+    segmentBases_.push_back(nextSeq_);
+    writeOffset_ = 0;
+    return 0;
+}
+
+int64_t RecordLog::Append(const uint8_t *data, size_t size, bool sync)
+{
+    if (size > segmentSize_ - kHeaderSize || size > UINT32_MAX) {
+        LMCORE_LOGE("Record of %zu bytes does not fit a %zu-byte log segment", size, segmentSize_);
+        return -1;
+    }
+    uint8_t header[kHeaderSize];
+    ByteOrder::WriteBE32(header, static_cast<uint32_t>(size));
+    ByteOrder::WriteBE32(header + 4, RecordCrc(header, data, size));
+
+    std::unique_lock<InternalMutex> lock(mutex_);
+    if (writeOffset_ + kHeaderSize + size > segmentSize_ && Rotate() != 0) {
+        return -1;
+    }
+    if (!WriteAt(active_->fd, header, kHeaderSize, writeOffset_) ||
+        !WriteAt(active_->fd, data, size, writeOffset_ + kHeaderSize)) {
+        // Nothing is advanced, so the partial record is overwritten by the next append
+        LMCORE_LOGE("Failed to write log record: %s", strerror(errno));
+        return -1;
+    }
+    writeOffset_ += kHeaderSize + size;
+    appendedBytes_ += kHeaderSize + size;
+    auto seq = static_cast<int64_t>(nextSeq_++);
+    if (sync && WaitDurable(lock, appendedBytes_) != 0) {
+        return -1;
+    }
+    return seq;
+}
+
+int32_t RecordLog::Sync()
+{
+    std::unique_lock<InternalMutex> lock(mutex_);
+    return WaitDurable(lock, appendedBytes_);
+}
+
+int32_t RecordLog::WaitDurable(std::unique_lock<InternalMutex> &lock, uint64_t end)
+{
+    while (syncedBytes_ < end) {
+        if (syncing_) {
+            // A sync is in flight; it may not cover our bytes, so check again when it ends
+            syncCond_.wait(lock);
+            continue;
+        }
+        syncing_ = true;
+        uint64_t target = appendedBytes_;
+        std::shared_ptr<Segment> segment = active_;
+        lock.unlock();
+        int ret = SyncData(segment->fd);
+        lock.lock();
+        syncing_ = false;
+        if (ret == 0) {
+            syncedBytes_ = std::max(syncedBytes_, target);
+        }
+        syncCond_.notify_all();
+        if (ret != 0) {
+            LMCORE_LOGE("Failed to sync log: %s", strerror(errno));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+#else
+
+int32_t RecordLog::OpenImpl()
+{
+    LMCORE_LOGE("RecordLog is not supported on this platform");
+    return -1;
+}
+
+std::shared_ptr<RecordLog::Segment> RecordLog::CreateSegment(uint64_t)
+{
+    return nullptr;
+}
+
+int32_t RecordLog::Rotate()
+{
+    return -1;
+}
+
+int64_t RecordLog::Append(const uint8_t *, size_t, bool)
+{
+    return -1;
+}
+
+int32_t RecordLog::Sync()
+{
+    return -1;
+}
+
+int32_t RecordLog::WaitDurable(std::unique_lock<InternalMutex> &, uint64_t)
+{
+    return -1;
+}
+
+#endif
+
+int32_t RecordLog::Replay(const Visitor &visitor, uint64_t fromSeq) const
+{
+    std::vector<uint64_t> bases;
+    {
+        std::lock_guard<InternalMutex> lock(mutex_);
+        bases = segmentBases_;
+    }
+    for (size_t i = 0; i < bases.size(); ++i) {
+        if (i + 1 < bases.size() && bases[i + 1] <= fromSeq) {
+            continue;
+        }
+        std::string path = SegmentPath(dir_, bases[i]);
+        auto file = MappedFile::Open(path);
+        if (!file) {
+            LMCORE_LOGE("Failed to map log segment %s", path.c_str());
+            return -1;
+        }
+        uint64_t seq = bases[i];
+        bool stopped = false;
+        ScanRecords(file->Data(), file->Size(), [&](const uint8_t *data, size_t size) {
+            if (seq++ >= fromSeq && !visitor(seq - 1, data, size)) {
+                stopped = true;
+                return false;
+            }
+            return true;
+        });
+        if (stopped) {
+            break;
+        }
+    }
+    return 0;
+}
+
+uint64_t RecordLog::GetNextSeq() const
+{
+    std::lock_guard<InternalMutex> lock(mutex_);
+    return nextSeq_;
+}
+
+size_t RecordLog::GetSegmentCount() const
+{
+    std::lock_guard<InternalMutex> lock(mutex_);
+    return segmentBases_.size();
+}
+
+} // namespace lmshao::lmcore
@@ -0,0 +1,118 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/recycling_allocator.h"
+
+#include <cstdint>
+
+namespace lmshao::lmcore::detail {
+
+namespace {
+// Small classes step by 16 bytes up to 256 (control blocks, nodes); medium classes step by 128 bytes
+// up to 2 KiB (coroutine frames) and keep fewer blocks, since each one is bigger
+constexpr size_t kSmallGranularity = 16;
+constexpr size_t kSmallClassCount = 16;
+constexpr size_t kSmallMax = kSmallGranularity * kSmallClassCount;
+constexpr size_t kMediumGranularity = 128;
+constexpr size_t kMaxBytes = 2048;
+constexpr size_t kClassCount = kSmallClassCount + (kMaxBytes - kSmallMax) / kMediumGranularity;
+constexpr uint32_t kSmallBlocksMax = 256;
+constexpr uint32_t kMediumBlocksMax = 64;
+
+struct FreeBlock {
+    FreeBlock *next;
+};
+
+// Set once the calling thread's cache is gone, so frees during thread teardown fall back to the heap
+thread_local bool t_cacheDestroyed = false;
+
+struct ThreadCache {
+    ~ThreadCache()
+    {
+        t_cacheDestroyed = true;
+        for (FreeBlock *head : heads) {
+            while (head) {
+                FreeBlock *next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+    }
+
+    FreeBlock *heads[kClassCount] = {};
+    uint32_t counts[kClassCount] = {};
+};
+
+ThreadCache *GetThreadCache()
+{
+    if (t_cacheDestroyed) {
+        return nullptr;
+    }
+    thread_local ThreadCache cache;
+    return &cache;
+}
+
+inline size_t SizeClass(size_t bytes)
+{
+    if (bytes <= kSmallMax) {
+        return (bytes + kSmallGranularity - 1) / kSmallGranularity - 1;
+    }
+    return kSmallClassCount + (bytes - kSmallMax + kMediumGranularity - 1) / kMediumGranularity - 1;
+}
+
+inline size_t ClassSize(size_t index)
+{
+    if (index < kSmallClassCount) {
+        return (index + 1) * kSmallGranularity;
+    }
+    return kSmallMax + (index - kSmallClassCount + 1) * kMediumGranularity;
+}
+} // namespace
+
+void *RecyclingAllocate(size_t bytes)
+{
+    if (bytes == 0 || bytes > kMaxBytes) {
+        return ::operator new(bytes);
+    }
+
+    size_t index = SizeClass(bytes);
+    ThreadCache *cache = GetThreadCache();
+    if (cache && cache->heads[index]) {
+        FreeBlock *block = cache->heads[index];
+        cache->heads[index] = block->next;
+        --cache->counts[index];
+        return block;
+    }
+    // Allocate the whole class size so the block can serve any request of its class later
+    return ::operator new(ClassSize(index));
+}
+
+void RecyclingDeallocate(void *p, size_t bytes)
+{
+    if (!p) {
+        return;
+    }
+    if (bytes == 0 || bytes > kMaxBytes) {
+        ::operator delete(p);
+        return;
+    }
+
+    size_t index = SizeClass(bytes);
+    ThreadCache *cache = GetThreadCache();
+    uint32_t limit = index < kSmallClassCount ? kSmallBlocksMax : kMediumBlocksMax;
+    if (!cache || cache->counts[index] >= limit) {
+        ::operator delete(p);
+        return;
+    }
+    auto *block = static_cast<FreeBlock *>(p);
+    block->next = cache->heads[index];
+    cache->heads[index] = block;
+    ++cache->counts[index];
+}
+
+} // namespace lmshao::lmcore::detail
@@ -0,0 +1,74 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_SIMD_KERNELS_H
+#define LMSHAO_LMCORE_SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Instruction-set specific kernels. Each lives in its own source file that CMake compiles
+// with the matching target flags (LMCORE_X86_KERNELS / LMCORE_ARM_KERNELS tell which ones
+// were built); callers must only reach them through SelectKernel() after checking CpuFeatures.
+
+namespace lmshao::lmcore::simd {
+
+#if defined(LMCORE_X86_KERNELS)
+/**
+ * @brief CRC32 (IEEE) folding with carry-less multiply. Needs SSE4.1 + PCLMULQDQ.
+ * @param crc Running (pre-inverted) CRC state
+ * @param data Input, len >= 64 and a multiple of 16
+ * @return Updated CRC state
+ */
+uint32_t Crc32FoldPclmul(uint32_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief Hex-encode 16-byte blocks. Needs SSSE3.
+ * @param digits The 16 hex digits to use
+ * @return Number of input bytes consumed (len rounded down to 16)
+ */
+size_t HexEncodeSsse3(const uint8_t *src, size_t len, char *dst, const char *digits);
+
+/**
+ * @brief Base64-encode 12-byte groups. Needs SSSE3.
+ * @return Number of input bytes consumed (a multiple of 12, reads 4 bytes past it)
+ */
+size_t Base64EncodeSsse3(const uint8_t *src, size_t len, char *dst);
+
+/**
+ * @brief Convert ASCII letters to upper or lower case in place, 32 bytes at a time. Needs AVX2.
+ * @return Number of bytes processed (len rounded down to 32)
+ */
+size_t AsciiCaseAvx2(char *data, size_t len, bool upper);
+
+/**
+ * @brief Bitmap of the bytes equal to `value`: bit i of masks[j] is byte 64 * j + i. Needs AVX2.
+ * @return Number of bytes covered (len rounded down to 64)
+ */
+size_t MatchMaskAvx2(const uint8_t *data, size_t len, uint8_t value, uint64_t *masks);
+
+/**
+ * @brief Find the blank line ending a message head, "\n\n" or "\n\r\n", 32 positions at a time. Needs AVX2.
+ * @return Offset of the first match, or the number of leading positions known not to start one
+ *         (the last few positions are always left to the caller)
+ */
+size_t FindBlankLineAvx2(const uint8_t *data, size_t len);
+#endif
+
+#if defined(LMCORE_ARM_KERNELS)
+/**
+ * @brief CRC32 (IEEE) with the ARMv8 CRC32 instructions.
+ * @param crc Running (pre-inverted) CRC state
+ * @return Updated CRC state
+ */
+uint32_t Crc32Armv8(uint32_t crc, const uint8_t *data, size_t len);
+#endif
+
+} // namespace lmshao::lmcore::simd
+
+#endif // LMSHAO_LMCORE_SIMD_KERNELS_H
@@ -12,8 +12,42 @@
 #include <cctype>
 #include <sstream>
 
+#include "lmcore/cpu_features.h"
+#include "simd_kernels.h"
+
 namespace lmshao::lmcore {
 
+namespace {
+
+// Converts a prefix in place, returns the number of bytes processed
+using AsciiCaseKernel = size_t (*)(char *data, size_t len, bool upper);
+
+size_t AsciiCaseNone(char *, size_t, bool)
+{
+    return 0;
+}
+
+void ConvertAsciiCase(char *data, size_t len, bool upper)
+{
+    static const AsciiCaseKernel kernel = SelectKernel<AsciiCaseKernel>(
+        {
+#if defined(LMCORE_X86_KERNELS)
+            {CpuFeatures::kAvx2, simd::AsciiCaseAvx2},
+#endif
+        },
+        AsciiCaseNone);
+
+    char first = upper ? 'a' : 'A';
+    char last = upper ? 'z' : 'Z';
+    for (size_t i = kernel(data, len, upper); i < len; ++i) {
+        if (data[i] >= first && data[i] <= last) {
+            data[i] = static_cast<char>(data[i] ^ 0x20);
+        }
+    }
+}
+
+} // namespace
+
 std::vector<std::string> StringUtils::Split(const std::string &str, char delimiter, bool skip_empty)
 {
     std::vector<std::string> result;
@@ -114,14 +148,18 @@ std::string StringUtils::TrimRight(const std::string &str)
 std::string StringUtils::ToLower(const std::string &str)
 {
     std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (!result.empty()) {
+        ConvertAsciiCase(&result[0], result.size(), false);
+    }
     return result;
 }
 
 std::string StringUtils::ToUpper(const std::string &str)
 {
     std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return std::toupper(c); });
+    if (!result.empty()) {
+        ConvertAsciiCase(&result[0], result.size(), true);
+    }
     return result;
 }
 
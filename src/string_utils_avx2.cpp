@@ -0,0 +1,36 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "simd_kernels.h"
+
+#if defined(LMCORE_X86_KERNELS)
+
+#include <immintrin.h>
+
+namespace lmshao::lmcore::simd {
+
+size_t AsciiCaseAvx2(char *data, size_t len, bool upper)
+{
+    // Signed compares: bytes >= 0x80 are negative and never fall in the letter range
+    const __m256i below = _mm256_set1_epi8(upper ? 'a' - 1 : 'A' - 1);
+    const __m256i above = _mm256_set1_epi8(upper ? 'z' + 1 : 'Z' + 1);
+    const __m256i caseBit = _mm256_set1_epi8(0x20);
+
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        __m256i letters = _mm256_and_si256(_mm256_cmpgt_epi8(v, below), _mm256_cmpgt_epi8(above, v));
+        v = _mm256_xor_si256(v, _mm256_and_si256(letters, caseBit));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + i), v);
+    }
+    return i;
+}
+
+} // namespace lmshao::lmcore::simd
+
+#endif // LMCORE_X86_KERNELS
@@ -10,6 +10,7 @@
 #include "lmcore/task_queue.h"
 
 #include <algorithm>
+#include <utility>
 
 #ifdef _WIN32
 #include <processthreadsapi.h>
@@ -24,6 +25,8 @@
 #endif
 
 #include "internal_logger.h"
+#include "lmcore/metrics.h"
+#include "lmcore/trace.h"
 
 namespace lmshao::lmcore {
 TaskQueue::~TaskQueue()
@@ -33,7 +36,7 @@ TaskQueue::~TaskQueue()
 
 int32_t TaskQueue::Start()
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InternalMutex> lock(mutex_);
     if (thread_ != nullptr) {
         LMCORE_LOGE("Started already, ignore ! [%s]", name_.c_str());
         return 0;
@@ -46,7 +49,7 @@ int32_t TaskQueue::Start()
 
 int32_t TaskQueue::Stop() noexcept
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InternalMutex> lock(mutex_);
     if (isExit_) {
         return 0;
     }
@@ -70,6 +73,7 @@ int32_t TaskQueue::Stop() noexcept
 int32_t TaskQueue::EnqueueTask(const std::shared_ptr<ITaskHandler> &task, bool cancelNotExecuted, uint64_t delayUs)
 {
     constexpr uint64_t MAX_DELAY_US = 10000000ULL; // max delay.
+    LMCORE_TRACE_SCOPE("TaskQueue::EnqueueTask");
 
     if (task == nullptr) {
         LMCORE_LOGE("Enqueue task when taskqueue task is nullptr.[%s]\n", name_.c_str());
@@ -85,7 +89,7 @@ int32_t TaskQueue::EnqueueTask(const std::shared_ptr<ITaskHandler> &task, bool c
         return -1;
     }
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InternalMutex> lock(mutex_);
     if (isExit_) {
         LMCORE_LOGE("Enqueue task when taskqueue is stopped, failed ! [%s]", name_.c_str());
         return -1;
@@ -111,7 +115,16 @@ int32_t TaskQueue::EnqueueTask(const std::shared_ptr<ITaskHandler> &task, bool c
         return (item.executeTimeNs_ > executeTimeNs);
     });
 
-    (void)taskList_.insert(iter, {task, executeTimeNs});
+    uint64_t flowId = LMCORE_TRACE_NEW_FLOW_ID();
+    LMCORE_TRACE_FLOW_BEGIN("TaskQueue::Task", flowId);
+    if (freeList_.empty()) {
+        (void)taskList_.insert(iter, {task, executeTimeNs, flowId});
+    } else {
+        freeList_.front() = {task, executeTimeNs, flowId};
+        taskList_.splice(iter, freeList_, freeList_.begin());
+    }
+    tasksEnqueued_->Increment();
+    queueDepth_->Increment();
 
     cond_.notify_all();
 
@@ -121,14 +134,41 @@ int32_t TaskQueue::EnqueueTask(const std::shared_ptr<ITaskHandler> &task, bool c
 void TaskQueue::CancelNotExecutedTaskLocked()
 {
     while (!taskList_.empty()) {
-        std::shared_ptr<ITaskHandler> task = taskList_.front().task_;
-        taskList_.pop_front();
+        std::shared_ptr<ITaskHandler> task = PopFrontLocked().task_;
+        tasksCancelled_->Increment();
+        queueDepth_->Decrement();
         if (task != nullptr) {
             task->Cancel();
         }
     }
 }
 
+TaskQueue::TaskHandlerItem TaskQueue::PopFrontLocked()
+{
+    constexpr size_t FREE_NODES_MAX = 64;
+    TaskHandlerItem item = std::move(taskList_.front());
+    taskList_.front().task_ = nullptr;
+    if (freeList_.size() < FREE_NODES_MAX) {
+        freeList_.splice(freeList_.begin(), taskList_, taskList_.begin());
+    } else {
+        taskList_.pop_front();
+    }
+    return item;
+}
+
+void TaskQueue::RegisterMetrics()
+{
+    auto &registry = MetricsRegistry::GetInstance();
+    MetricLabels labels{{"queue", name_}};
+    tasksEnqueued_ = &registry.GetCounter("lmcore_taskqueue_tasks_enqueued_total", labels, "Tasks enqueued");
+    tasksExecuted_ = &registry.GetCounter("lmcore_taskqueue_tasks_executed_total", labels, "Tasks executed");
+    tasksCancelled_ = &registry.GetCounter("lmcore_taskqueue_tasks_cancelled_total", labels, "Tasks cancelled");
+    tasksFailed_ = &registry.GetCounter("lmcore_taskqueue_tasks_failed_total", labels, "Tasks that threw");
+    queueDepth_ = &registry.GetGauge("lmcore_taskqueue_queue_depth", labels, "Tasks waiting in the queue");
+    lateness_ = &registry.GetHistogram("lmcore_taskqueue_lateness_ns", labels,
+                                       "Delay between the requested and the actual start time of a task");
+}
+
 void TaskQueue::TaskProcessor()
 {
     LMCORE_LOGD("Enter TaskProcessor [%s], tid_: (%lu)\n", name_.c_str(), static_cast<unsigned long>(tid_));
@@ -157,26 +197,27 @@ void TaskQueue::TaskProcessor()
 #endif
 
     while (true) {
-        std::unique_lock<std::mutex> lock(mutex_);
+        std::unique_lock<InternalMutex> lock(mutex_);
         cond_.wait(lock, [this] { return isExit_ || !taskList_.empty(); });
         if (isExit_) {
             LMCORE_LOGD("Exit TaskProcessor [%s], tid_: (%lu)\n", name_.c_str(), static_cast<unsigned long>(tid_));
             return;
         }
-        TaskHandlerItem item = taskList_.front();
+        uint64_t executeTimeNs = taskList_.front().executeTimeNs_;
         uint64_t curTimeNs = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
-        if (curTimeNs >= item.executeTimeNs_) {
-            taskList_.pop_front();
-        } else {
-            uint64_t diff = item.executeTimeNs_ - curTimeNs;
-            (void)cond_.wait_for(lock, std::chrono::nanoseconds(diff));
+        if (curTimeNs < executeTimeNs) {
+            (void)cond_.wait_for(lock, std::chrono::nanoseconds(executeTimeNs - curTimeNs));
             continue;
         }
+        TaskHandlerItem item = PopFrontLocked();
+        queueDepth_->Decrement();
+        lateness_->Record(curTimeNs - executeTimeNs);
         isTaskExecuting_ = true;
         lock.unlock();
 
         if (item.task_ == nullptr || item.task_->IsCanceled()) {
             LMCORE_LOGE("task is nullptr or task canceled. [%s]", name_.c_str());
+            tasksCancelled_->Increment();
             lock.lock();
             isTaskExecuting_ = false;
             lock.unlock();
@@ -184,10 +225,15 @@ void TaskQueue::TaskProcessor()
         }
 
         try {
+            LMCORE_TRACE_SCOPE("TaskQueue::RunTask");
+            LMCORE_TRACE_FLOW_END("TaskQueue::Task", item.flowId_);
             item.task_->Execute();
+            tasksExecuted_->Increment();
         } catch (const std::exception &e) {
+            tasksFailed_->Increment();
             LMCORE_LOGE("Task execution failed with exception: %s [%s]", e.what(), name_.c_str());
         } catch (...) {
+            tasksFailed_->Increment();
             LMCORE_LOGE("Task execution failed with unknown exception [%s]", name_.c_str());
         }
 
@@ -207,7 +253,7 @@ void TaskQueue::TaskProcessor()
 
 bool TaskQueue::IsTaskExecuting()
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<InternalMutex> lock(mutex_);
     return isTaskExecuting_;
 }
 
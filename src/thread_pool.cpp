@@ -8,6 +8,8 @@
 
 #include "lmcore/thread_pool.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -16,6 +18,8 @@
 #endif
 
 #include "internal_logger.h"
+#include "lmcore/metrics.h"
+#include "lmcore/trace.h"
 
 namespace lmshao::lmcore {
 constexpr size_t POOL_SIZE_MAX = 100;
@@ -33,7 +37,9 @@ ThreadPool::ThreadPool(int preAlloc, int threadsMax, std::string name) : threads
         threadName_ = name;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    RegisterMetrics();
+
+    std::lock_guard<InternalMutex> lock(mutex_);
     for (int i = 0; i < preAlloc; ++i) {
         CreateWorkerThread();
     }
@@ -42,12 +48,24 @@ ThreadPool::ThreadPool(int preAlloc, int threadsMax, std::string name) : threads
 ThreadPool::~ThreadPool()
 {
     Shutdown();
+
+    // Workers are joined, so every item is in one of the lists
+    auto drain = [](TaskList &list) {
+        while (TaskItem *item = list.Pop()) {
+            delete item;
+        }
+    };
+    drain(tasks_);
+    for (auto &pair : serialTasks_) {
+        drain(pair.second);
+    }
+    drain(taskItemPool_);
 }
 
 void ThreadPool::Shutdown()
 {
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
         running_ = false;
         shutdown_ = true;
     }
@@ -58,16 +76,42 @@ void ThreadPool::Shutdown()
             thread->join();
         }
     }
+
+    // Tasks left in the queues are never run; take them and the joined threads out of the gauges
+    std::lock_guard<InternalMutex> lock(mutex_);
+    if (!metricsReleased_) {
+        metricsReleased_ = true;
+        size_t pending = tasks_.size;
+        for (const auto &pair : serialTasks_) {
+            pending += pair.second.size;
+        }
+        queueDepth_->Sub(static_cast<int64_t>(pending));
+        threadCount_->Sub(static_cast<int64_t>(threads_.size()));
+    }
+}
+
+void ThreadPool::RegisterMetrics()
+{
+    auto &registry = MetricsRegistry::GetInstance();
+    MetricLabels labels{{"pool", threadName_}};
+    tasksSubmitted_ = &registry.GetCounter("lmcore_threadpool_tasks_submitted_total", labels, "Tasks accepted");
+    tasksCompleted_ = &registry.GetCounter("lmcore_threadpool_tasks_completed_total", labels, "Tasks completed");
+    tasksRejected_ = &registry.GetCounter("lmcore_threadpool_tasks_rejected_total", labels, "Tasks rejected");
+    tasksFailed_ = &registry.GetCounter("lmcore_threadpool_tasks_failed_total", labels, "Tasks that threw");
+    queueDepth_ = &registry.GetGauge("lmcore_threadpool_queue_depth", labels, "Tasks waiting for a worker");
+    threadCount_ = &registry.GetGauge("lmcore_threadpool_threads", labels, "Worker threads");
+    queueDelay_ = &registry.GetHistogram("lmcore_threadpool_queue_delay_ns", labels,
+                                         "Time from AddTask until a worker starts the task");
 }
 
 void ThreadPool::Worker()
 {
     while (running_) {
-        std::shared_ptr<TaskItem> task;
+        TaskItem *task = nullptr;
         {
-            std::unique_lock<std::mutex> lock(mutex_);
+            std::unique_lock<InternalMutex> lock(mutex_);
             idle_++;
-            signal_.wait(lock, [this] { return !running_ || !tasks_.empty() || HasSerialTask(); });
+            signal_.wait(lock, [this] { return !running_ || !tasks_.Empty() || HasSerialTask(); });
             idle_--;
 
             if (!running_) {
@@ -75,9 +119,8 @@ void ThreadPool::Worker()
             }
 
             // Process normal tasks first
-            if (!tasks_.empty()) {
-                task = std::move(tasks_.front());
-                tasks_.pop();
+            if (!tasks_.Empty()) {
+                task = tasks_.Pop();
             } else {
                 // Process serial tasks
                 task = GetNextSerialTask();
@@ -85,23 +128,32 @@ void ThreadPool::Worker()
         }
 
         if (task) {
-            auto fn = task->fn;
-            if (fn) {
+            LMCORE_TRACE_SCOPE("ThreadPool::RunTask");
+            LMCORE_TRACE_FLOW_END("ThreadPool::Task", task->flowId);
+            queueDepth_->Decrement();
+            queueDelay_->RecordDuration(std::chrono::steady_clock::now() - task->enqueueTime);
+
+            // The item belongs to this worker until released, so run the task in place instead of copying it
+            if (task->fn) {
                 try {
-                    fn();
+                    task->fn();
+                    tasksCompleted_->Increment();
                 } catch (const std::exception &e) {
+                    tasksFailed_->Increment();
                     LMCORE_LOGE("Task execution failed: %s", e.what());
                 } catch (...) {
+                    tasksFailed_->Increment();
                     LMCORE_LOGE("Task execution failed with unknown exception");
                 }
             }
 
             // If it's a serial task, clean up state after completion
             if (!task->tag.empty()) {
-                std::lock_guard<std::mutex> lock(mutex_);
+                std::lock_guard<InternalMutex> lock(mutex_);
                 runningSerialTags_.erase(task->tag);
                 // Add tag back to available queue if there are pending tasks
-                if (serialTasks_.count(task->tag) && !serialTasks_[task->tag].empty()) {
+                auto it = serialTasks_.find(task->tag);
+                if (it != serialTasks_.end() && !it->second.Empty()) {
                     availableSerialTags_.push(task->tag);
                     signal_.notify_one();
                 }
@@ -113,36 +165,45 @@ void ThreadPool::Worker()
     }
 }
 
-void ThreadPool::AddTask(const Task &task, const std::string &serialTag)
+bool ThreadPool::AddTask(const Task &task, const std::string &serialTag)
 {
     if (task == nullptr) {
         LMCORE_LOGE("task is nullptr");
-        return;
+        return false;
     }
 
+    LMCORE_TRACE_SCOPE("ThreadPool::AddTask");
     auto t = AcquireTaskItem();
     t->reset(task, serialTag);
+    t->flowId = LMCORE_TRACE_NEW_FLOW_ID();
+    LMCORE_TRACE_FLOW_BEGIN("ThreadPool::Task", t->flowId);
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<InternalMutex> lock(mutex_);
 
         if (shutdown_) {
+            tasksRejected_->Increment();
             LMCORE_LOGE("ThreadPool is shutting down, task rejected");
-            return;
+            t->clear();
+            ReleaseTaskItemLocked(t);
+            return false;
         }
 
+        tasksSubmitted_->Increment();
+        queueDepth_->Increment();
+
         if (serialTag.empty()) {
             // Normal task
-            tasks_.push(t);
+            tasks_.Push(t);
         } else {
             // Serial task
             if (runningSerialTags_.count(serialTag)) {
                 // A task with the same tag is running, add to waiting queue
-                serialTasks_[serialTag].push(t);
-                return;
+                serialTasks_[serialTag].Push(t);
+                return true;
             } else {
                 // No task with the same tag is running, add to normal queue directly
                 runningSerialTags_.insert(serialTag);
-                tasks_.push(t);
+                tasks_.Push(t);
             }
         }
 
@@ -153,6 +214,67 @@ void ThreadPool::AddTask(const Task &task, const std::string &serialTag)
     }
 
     signal_.notify_one();
+    return true;
+}
+
+void ThreadPool::ParallelFor(size_t begin, size_t end, const std::function<void(size_t)> &fn, size_t grain)
+{
+    if (begin >= end || !fn) {
+        return;
+    }
+    LMCORE_TRACE_SCOPE("ThreadPool::ParallelFor");
+
+    struct State {
+        const std::function<void(size_t)> *fn;
+        size_t begin;
+        size_t end;
+        size_t grain;
+        size_t blocks;
+        std::atomic<size_t> next{0};
+        /// Blocks not finished yet
+        std::atomic<size_t> pending;
+        InternalMutex mutex LMCORE_MUTEX_INIT("ThreadPool::ParallelFor");
+        InternalCondVar done;
+    };
+    auto state = std::make_shared<State>();
+    state->fn = &fn;
+    state->begin = begin;
+    state->end = end;
+    state->grain = std::max<size_t>(grain, 1);
+    state->blocks = (end - begin - 1) / state->grain + 1;
+    state->pending.store(state->blocks, std::memory_order_relaxed);
+
+    // fn is only touched after claiming a block, and the caller waits for every claimed block, so
+    // helpers that start late find nothing left and never see fn dangling
+    auto run = [](State &s) {
+        size_t finished = 0;
+        for (size_t block; (block = s.next.fetch_add(1, std::memory_order_relaxed)) < s.blocks; ++finished) {
+            size_t first = s.begin + block * s.grain;
+            size_t last = std::min(s.end, first + s.grain);
+            for (size_t i = first; i < last; ++i) {
+                try {
+                    (*s.fn)(i);
+                } catch (const std::exception &e) {
+                    LMCORE_LOGE("ParallelFor item %zu failed: %s", i, e.what());
+                } catch (...) {
+                    LMCORE_LOGE("ParallelFor item %zu failed with unknown exception", i);
+                }
+            }
+        }
+        if (finished > 0 && s.pending.fetch_sub(finished, std::memory_order_acq_rel) == finished) {
+            std::lock_guard<InternalMutex> lock(s.mutex);
+            s.done.notify_all();
+        }
+    };
+
+    size_t helpers = shutdown_ ? 0 : std::min(state->blocks - 1, static_cast<size_t>(std::max(threadsMax_, 0)));
+    for (size_t i = 0; i < helpers; ++i) {
+        AddTask([state, run]() { run(*state); });
+    }
+    run(*state);
+
+    std::unique_lock<InternalMutex> lock(state->mutex);
+    state->done.wait(lock, [&state]() { return state->pending.load(std::memory_order_acquire) == 0; });
 }
 
 bool ThreadPool::HasSerialTask() const
@@ -161,21 +283,21 @@ bool ThreadPool::HasSerialTask() const
     return !availableSerialTags_.empty();
 }
 
-std::shared_ptr<ThreadPool::TaskItem> ThreadPool::GetNextSerialTask()
+ThreadPool::TaskItem *ThreadPool::GetNextSerialTask()
 {
     // Use the optimized available tags queue for O(1) lookup
     if (!availableSerialTags_.empty()) {
-        std::string tag = availableSerialTags_.front();
+        std::string tag = std::move(availableSerialTags_.front());
         availableSerialTags_.pop();
 
-        if (serialTasks_.count(tag) && !serialTasks_[tag].empty() && !runningSerialTags_.count(tag)) {
-            auto task = serialTasks_[tag].front();
-            serialTasks_[tag].pop();
+        auto it = serialTasks_.find(tag);
+        if (it != serialTasks_.end() && !it->second.Empty() && !runningSerialTags_.count(tag)) {
+            TaskItem *task = it->second.Pop();
             runningSerialTags_.insert(tag);
 
             // If the queue is empty, clean up the map
-            if (serialTasks_[tag].empty()) {
-                serialTasks_.erase(tag);
+            if (it->second.Empty()) {
+                serialTasks_.erase(it);
             }
 
             return task;
@@ -187,17 +309,17 @@ std::shared_ptr<ThreadPool::TaskItem> ThreadPool::GetNextSerialTask()
 
 size_t ThreadPool::GetQueueSize() const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    size_t total = tasks_.size();
+    std::lock_guard<InternalMutex> lock(mutex_);
+    size_t total = tasks_.size;
     for (const auto &pair : serialTasks_) {
-        total += pair.second.size();
+        total += pair.second.size;
     }
     return total;
 }
 
 size_t ThreadPool::GetThreadCount() const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<InternalMutex> lock(mutex_);
     return threads_.size();
 }
 
@@ -219,24 +341,24 @@ void ThreadPool::CreateWorkerThread()
 
     auto p = std::make_unique<std::thread>(std::move(workerEntry));
     threads_.emplace_back(std::move(p));
+    threadCount_->Increment();
     LMCORE_LOGD("Created new thread, total: %zu/%d", threads_.size(), threadsMax_);
 }
 
-std::shared_ptr<ThreadPool::TaskItem> ThreadPool::AcquireTaskItem()
+ThreadPool::TaskItem *ThreadPool::AcquireTaskItem()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (!taskItemPool_.empty()) {
-        auto item = taskItemPool_.top();
-        taskItemPool_.pop();
-        return item;
+    {
+        std::lock_guard<InternalMutex> lock(mutex_);
+        if (TaskItem *item = taskItemPool_.Pop()) {
+            return item;
+        }
     }
 
     // Create new item if pool is empty
-    return std::make_shared<TaskItem>();
+    return new TaskItem();
 }
 
-void ThreadPool::ReleaseTaskItem(std::shared_ptr<TaskItem> item)
+void ThreadPool::ReleaseTaskItem(TaskItem *item)
 {
     if (!item) {
         return;
@@ -245,11 +367,17 @@ void ThreadPool::ReleaseTaskItem(std::shared_ptr<TaskItem> item)
     // Clear the item for reuse
     item->clear();
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<InternalMutex> lock(mutex_);
+    ReleaseTaskItemLocked(item);
+}
 
+void ThreadPool::ReleaseTaskItemLocked(TaskItem *item)
+{
     // Only return to pool if we haven't exceeded the max size
-    if (taskItemPool_.size() < POOL_SIZE_MAX) {
-        taskItemPool_.push(item);
+    if (taskItemPool_.size < POOL_SIZE_MAX) {
+        taskItemPool_.Push(item);
+    } else {
+        delete item;
     }
 }
-} // namespace lmshao::lmcore
\ No newline at end of file
+} // namespace lmshao::lmcore
@@ -0,0 +1,120 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "thread_records.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace lmshao::lmcore::detail {
+
+namespace {
+struct Registry {
+    std::mutex mutex;
+    uint64_t nextId = 1;
+    std::unordered_set<uint64_t> alive;
+};
+
+Registry &GetRegistry()
+{
+    // Leaked: threads may exit after static destruction
+    static Registry *registry = new Registry();
+    return *registry;
+}
+
+struct Entry {
+    uint64_t domainId;
+    void *domain;
+    void *record;
+    ReleaseRecordFn release;
+};
+
+struct ThreadRecords {
+    std::vector<Entry> entries;
+    ~ThreadRecords();
+};
+
+thread_local ThreadRecords t_records;
+thread_local bool t_recordsDestroyed = false;
+// Last lookup, checked before the table
+thread_local uint64_t t_lastDomain = 0;
+thread_local void *t_lastRecord = nullptr;
+
+ThreadRecords::~ThreadRecords()
+{
+    t_recordsDestroyed = true;
+    t_lastDomain = 0;
+    t_lastRecord = nullptr;
+
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const Entry &entry : entries) {
+        if (registry.alive.count(entry.domainId)) {
+            entry.release(entry.domain, entry.record);
+        }
+    }
+}
+} // namespace
+
+uint64_t RegisterDomain()
+{
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    uint64_t id = registry.nextId++;
+    registry.alive.insert(id);
+    return id;
+}
+
+void UnregisterDomain(uint64_t domainId)
+{
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.alive.erase(domainId);
+}
+
+void *FindThreadRecord(uint64_t domainId)
+{
+    if (t_lastDomain == domainId) {
+        return t_lastRecord;
+    }
+    if (t_recordsDestroyed) {
+        return nullptr;
+    }
+    for (const Entry &entry : t_records.entries) {
+        if (entry.domainId == domainId) {
+            t_lastDomain = domainId;
+            t_lastRecord = entry.record;
+            return entry.record;
+        }
+    }
+    return nullptr;
+}
+
+void AddThreadRecord(uint64_t domainId, void *domain, void *record, ReleaseRecordFn release)
+{
+    t_lastDomain = domainId;
+    t_lastRecord = record;
+    if (t_recordsDestroyed) {
+        return;
+    }
+
+    auto &entries = t_records.entries;
+    {
+        // Drop entries of destroyed domains so short-lived domains don't accumulate
+        Registry &registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [&](const Entry &entry) { return !registry.alive.count(entry.domainId); }),
+                      entries.end());
+    }
+    entries.push_back({domainId, domain, record, release});
+}
+
+} // namespace lmshao::lmcore::detail
@@ -0,0 +1,46 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef LMSHAO_LMCORE_THREAD_RECORDS_H
+#define LMSHAO_LMCORE_THREAD_RECORDS_H
+
+#include <cstdint>
+
+namespace lmshao::lmcore::detail {
+
+// Bookkeeping shared by the memory reclamation domains (EpochDomain, HazardDomain): every thread
+// owns one record per domain, found through a thread-local table and handed back to the domain
+// when the thread exits. Domains are identified by never-reused ids so that a thread exiting
+// after a domain was destroyed does not touch freed memory.
+
+using ReleaseRecordFn = void (*)(void *domain, void *record);
+
+/**
+ * @brief Allocate an id for a new domain and mark it alive.
+ */
+uint64_t RegisterDomain();
+
+/**
+ * @brief Mark a domain dead; exiting threads no longer hand records back to it.
+ */
+void UnregisterDomain(uint64_t domainId);
+
+/**
+ * @brief Get the calling thread's record in a domain, nullptr if it has none yet.
+ */
+void *FindThreadRecord(uint64_t domainId);
+
+/**
+ * @brief Remember the calling thread's record; release(domain, record) runs at thread exit.
+ * @note During thread teardown the record can no longer be tracked and stays owned forever.
+ */
+void AddThreadRecord(uint64_t domainId, void *domain, void *record, ReleaseRecordFn release);
+
+} // namespace lmshao::lmcore::detail
+
+#endif // LMSHAO_LMCORE_THREAD_RECORDS_H
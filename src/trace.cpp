@@ -0,0 +1,314 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/trace.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#endif
+
+#include "internal_logger.h"
+
+namespace lmshao::lmcore {
+
+std::atomic<bool> Tracer::enabled_{false};
+
+namespace {
+
+struct TraceEvent {
+    uint64_t timestampNs;
+    // Duration for complete events, flow id for flow events
+    uint64_t value;
+    const char *name;
+    Tracer::Phase phase;
+};
+
+struct ThreadRing {
+    explicit ThreadRing(size_t capacity) : events(capacity), mask(capacity - 1) {}
+
+    std::vector<TraceEvent> events;
+    size_t mask;
+    // Number of events ever written; only the owning thread stores it
+    std::atomic<uint64_t> head{0};
+    // Events below this index were dropped by Clear(); only touched under g_ringsMutex
+    uint64_t base = 0;
+    uint64_t tid = 0;
+    std::string threadName;
+};
+
+std::mutex g_ringsMutex;
+std::vector<std::shared_ptr<ThreadRing>> g_rings;
+std::atomic<size_t> g_ringCapacity{Tracer::kDefaultRingCapacity};
+std::atomic<uint64_t> g_nextFlowId{1};
+thread_local std::shared_ptr<ThreadRing> t_ring;
+
+uint64_t CurrentThreadId(size_t fallback)
+{
+#ifdef _WIN32
+    (void)fallback;
+    return static_cast<uint64_t>(GetCurrentThreadId());
+#elif defined(__APPLE__)
+    uint64_t tid64 = 0;
+    return pthread_threadid_np(nullptr, &tid64) == 0 ? tid64 : fallback;
+#elif defined(__linux__)
+    (void)fallback;
+    return static_cast<uint64_t>(syscall(SYS_gettid));
+#else
+    return fallback;
+#endif
+}
+
+std::string CurrentThreadName()
+{
+#if !defined(_WIN32)
+    char name[64] = {0};
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0) {
+        return name;
+    }
+#endif
+    return "";
+}
+
+ThreadRing *CreateRing()
+{
+    auto ring = std::make_shared<ThreadRing>(g_ringCapacity.load(std::memory_order_relaxed));
+    std::lock_guard<std::mutex> lock(g_ringsMutex);
+    ring->tid = CurrentThreadId(g_rings.size() + 1);
+    ring->threadName = CurrentThreadName();
+    g_rings.push_back(ring);
+    t_ring = std::move(ring);
+    return t_ring.get();
+}
+
+inline void Append(Tracer::Phase phase, const char *name, uint64_t timestampNs, uint64_t value)
+{
+    ThreadRing *ring = t_ring.get();
+    if (ring == nullptr) {
+        ring = CreateRing();
+    }
+
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    TraceEvent &event = ring->events[head & ring->mask];
+    event.timestampNs = timestampNs;
+    event.value = value;
+    event.name = name;
+    event.phase = phase;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void AppendJsonString(std::string &out, const char *value)
+{
+    out += '"';
+    for (const char *p = value; *p != '\0'; ++p) {
+        char c = *p;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            out += buffer;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+// Chrome timestamps are microseconds; keep nanosecond precision as a fraction
+void AppendMicros(std::string &out, const char *key, uint64_t ns)
+{
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), ",\"%s\":%" PRIu64 ".%03" PRIu64, key, ns / 1000, ns % 1000);
+    out += buffer;
+}
+
+void AppendEvent(std::string &out, const TraceEvent &event, uint64_t pid, uint64_t tid)
+{
+    char buffer[96];
+    out += "{\"name\":";
+    AppendJsonString(out, event.name);
+    snprintf(buffer, sizeof(buffer), ",\"cat\":\"lmcore\",\"ph\":\"%c\",\"pid\":%" PRIu64 ",\"tid\":%" PRIu64,
+             static_cast<char>(event.phase), pid, tid);
+    out += buffer;
+    AppendMicros(out, "ts", event.timestampNs);
+
+    switch (event.phase) {
+        case Tracer::Phase::kComplete:
+            AppendMicros(out, "dur", event.value);
+            break;
+        case Tracer::Phase::kInstant:
+            out += ",\"s\":\"t\"";
+            break;
+        case Tracer::Phase::kFlowEnd:
+            // Bind to the enclosing span instead of the next one
+            out += ",\"bp\":\"e\"";
+            [[fallthrough]];
+        default:
+            snprintf(buffer, sizeof(buffer), ",\"id\":%" PRIu64, event.value);
+            out += buffer;
+            break;
+    }
+    out += "},\n";
+}
+
+} // namespace
+
+void Tracer::Enable(bool enable)
+{
+    enabled_.store(enable, std::memory_order_relaxed);
+}
+
+void Tracer::SetRingCapacity(size_t events)
+{
+    size_t capacity = 16;
+    while (capacity < events) {
+        capacity <<= 1;
+    }
+    g_ringCapacity.store(capacity, std::memory_order_relaxed);
+}
+
+void Tracer::SetThreadName(const std::string &name)
+{
+    ThreadRing *ring = t_ring.get();
+    if (ring == nullptr) {
+        ring = CreateRing();
+    }
+    std::lock_guard<std::mutex> lock(g_ringsMutex);
+    ring->threadName = name;
+}
+
+uint64_t Tracer::NowNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+uint64_t Tracer::NewFlowId()
+{
+    return IsEnabled() ? g_nextFlowId.fetch_add(1, std::memory_order_relaxed) : 0;
+}
+
+void Tracer::Complete(const char *name, uint64_t startNs, uint64_t endNs)
+{
+    if (IsEnabled()) {
+        Append(Phase::kComplete, name, startNs, endNs > startNs ? endNs - startNs : 0);
+    }
+}
+
+void Tracer::Instant(const char *name)
+{
+    if (IsEnabled()) {
+        Append(Phase::kInstant, name, NowNs(), 0);
+    }
+}
+
+void Tracer::Flow(Phase phase, const char *name, uint64_t id)
+{
+    if (id != 0 && IsEnabled()) {
+        Append(phase, name, NowNs(), id);
+    }
+}
+
+std::string Tracer::ExportChromeJson()
+{
+#ifdef _WIN32
+    uint64_t pid = static_cast<uint64_t>(GetCurrentProcessId());
+#else
+    uint64_t pid = static_cast<uint64_t>(::getpid());
+#endif
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    std::vector<TraceEvent> copy;
+    std::lock_guard<std::mutex> lock(g_ringsMutex);
+    for (const auto &ring : g_rings) {
+        char buffer[96];
+        snprintf(buffer, sizeof(buffer),
+                 "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%" PRIu64 ",\"tid\":%" PRIu64 ",\"args\":{\"name\":",
+                 pid, ring->tid);
+        out += buffer;
+        AppendJsonString(out, ring->threadName.c_str());
+        out += "}},\n";
+
+        // The owner may keep writing while we copy: copy the published range, then drop
+        // every slot that could have been overwritten in the meantime.
+        size_t capacity = ring->mask + 1;
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = head > capacity ? head - capacity : 0;
+        if (begin < ring->base) {
+            begin = ring->base;
+        }
+        copy.clear();
+        for (uint64_t i = begin; i < head; ++i) {
+            copy.push_back(ring->events[i & ring->mask]);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = ring->head.load(std::memory_order_relaxed);
+        uint64_t firstValid = after >= capacity ? after - capacity + 1 : 0;
+
+        for (uint64_t i = begin; i < head; ++i) {
+            if (i >= firstValid) {
+                AppendEvent(out, copy[i - begin], pid, ring->tid);
+            }
+        }
+    }
+
+    // Replace the trailing ",\n" of the last entry
+    if (out.size() >= 2 && out[out.size() - 2] == ',') {
+        out.resize(out.size() - 2);
+        out += '\n';
+    }
+    out += "]}\n";
+    return out;
+}
+
+bool Tracer::WriteChromeTrace(const std::string &path)
+{
+    std::string json = ExportChromeJson();
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        LMCORE_LOGE("Failed to open trace file %s", path.c_str());
+        return false;
+    }
+    bool ok = fwrite(json.data(), 1, json.size(), file) == json.size();
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        LMCORE_LOGE("Failed to write trace file %s", path.c_str());
+    }
+    return ok;
+}
+
+void Tracer::Clear()
+{
+    std::lock_guard<std::mutex> lock(g_ringsMutex);
+    std::vector<std::shared_ptr<ThreadRing>> live;
+    for (auto &ring : g_rings) {
+        // Only the registry holds a ring whose thread has exited
+        if (ring.use_count() > 1) {
+            ring->base = ring->head.load(std::memory_order_acquire);
+            live.push_back(std::move(ring));
+        }
+    }
+    g_rings.swap(live);
+}
+
+} // namespace lmshao::lmcore
@@ -0,0 +1,160 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "lmcore/xxhash64.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "lmcore/byte_order.h"
+
+namespace lmshao::lmcore {
+
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t RotateLeft(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t ReadLE64(const uint8_t *p)
+{
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return ByteOrder::IsSystemLittleEndian() ? value : ByteOrder::Swap64(value);
+}
+
+inline uint32_t ReadLE32(const uint8_t *p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return ByteOrder::IsSystemLittleEndian() ? value : ByteOrder::Swap32(value);
+}
+
+inline uint64_t Round(uint64_t acc, uint64_t input)
+{
+    acc += input * kPrime2;
+    acc = RotateLeft(acc, 31);
+    return acc * kPrime1;
+}
+
+inline uint64_t MergeRound(uint64_t acc, uint64_t value)
+{
+    acc ^= Round(0, value);
+    return acc * kPrime1 + kPrime4;
+}
+
+/// Consume as many whole 32-byte stripes as `len` holds; returns the bytes consumed
+inline size_t ConsumeStripes(uint64_t acc[4], const uint8_t *data, size_t len)
+{
+    size_t offset = 0;
+    for (; len - offset >= 32; offset += 32) {
+        acc[0] = Round(acc[0], ReadLE64(data + offset));
+        acc[1] = Round(acc[1], ReadLE64(data + offset + 8));
+        acc[2] = Round(acc[2], ReadLE64(data + offset + 16));
+        acc[3] = Round(acc[3], ReadLE64(data + offset + 24));
+    }
+    return offset;
+}
+
+uint64_t Finish(const uint64_t acc[4], uint64_t seed, uint64_t totalLen, const uint8_t *tail, size_t tailLen)
+{
+    uint64_t h;
+    if (totalLen >= 32) {
+        h = RotateLeft(acc[0], 1) + RotateLeft(acc[1], 7) + RotateLeft(acc[2], 12) + RotateLeft(acc[3], 18);
+        for (int i = 0; i < 4; ++i) {
+            h = MergeRound(h, acc[i]);
+        }
+    } else {
+        h = seed + kPrime5;
+    }
+    h += totalLen;
+
+    for (; tailLen >= 8; tail += 8, tailLen -= 8) {
+        h ^= Round(0, ReadLE64(tail));
+        h = RotateLeft(h, 27) * kPrime1 + kPrime4;
+    }
+    if (tailLen >= 4) {
+        h ^= static_cast<uint64_t>(ReadLE32(tail)) * kPrime1;
+        h = RotateLeft(h, 23) * kPrime2 + kPrime3;
+        tail += 4;
+        tailLen -= 4;
+    }
+    for (; tailLen > 0; ++tail, --tailLen) {
+        h ^= *tail * kPrime5;
+        h = RotateLeft(h, 11) * kPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+} // namespace
+
+uint64_t XXHash64::Calculate(const uint8_t *data, size_t len, uint64_t seed)
+{
+    uint64_t acc[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1};
+    size_t consumed = ConsumeStripes(acc, data, len);
+    return Finish(acc, seed, len, data + consumed, len - consumed);
+}
+
+uint64_t XXHash64::Calculate(const std::string &data, uint64_t seed)
+{
+    return Calculate(reinterpret_cast<const uint8_t *>(data.data()), data.size(), seed);
+}
+
+void XXHash64::Context::Reset(uint64_t seed)
+{
+    acc_[0] = seed + kPrime1 + kPrime2;
+    acc_[1] = seed + kPrime2;
+    acc_[2] = seed;
+    acc_[3] = seed - kPrime1;
+    seed_ = seed;
+    totalLen_ = 0;
+    bufferSize_ = 0;
+}
+
+void XXHash64::Context::Update(const uint8_t *data, size_t len)
+{
+    if (len == 0) {
+        return;
+    }
+    totalLen_ += len;
+    if (bufferSize_ > 0) {
+        size_t take = std::min(len, sizeof(buffer_) - bufferSize_);
+        memcpy(buffer_ + bufferSize_, data, take);
+        bufferSize_ += take;
+        data += take;
+        len -= take;
+        if (bufferSize_ < sizeof(buffer_)) {
+            return;
+        }
+        ConsumeStripes(acc_, buffer_, sizeof(buffer_));
+        bufferSize_ = 0;
+    }
+    size_t consumed = ConsumeStripes(acc_, data, len);
+    bufferSize_ = len - consumed;
+    memcpy(buffer_, data + consumed, bufferSize_);
+}
+
+uint64_t XXHash64::Context::Final() const
+{
+    return Finish(acc_, seed_, totalLen_, buffer_, bufferSize_);
+}
+
+} // namespace lmshao::lmcore
@@ -0,0 +1,211 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef TEST_ALLOC_COUNTER_H
+#define TEST_ALLOC_COUNTER_H
+
+// Counts heap allocations so tests can assert that hot paths stay off the allocator.
+// Include from exactly one translation unit of a test binary: it replaces the global
+// operator new/delete and, on glibc, interposes the malloc family as well, so allocations
+// made inside liblmcore and libstdc++ are seen too.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+#define TEST_ALLOC_COUNTER_MALLOC 1
+#endif
+
+namespace alloc_counter {
+
+// Constant-initialized, so reading them is safe from inside malloc during thread start-up
+static thread_local uint64_t t_count = 0;
+static thread_local uint64_t t_bytes = 0;
+static std::atomic<uint64_t> g_total{0};
+
+inline void Record(size_t bytes)
+{
+    ++t_count;
+    t_bytes += bytes;
+    g_total.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Allocations made since construction, on this thread and process-wide.
+ */
+class AllocScope {
+public:
+    AllocScope() : count_(t_count), bytes_(t_bytes), total_(g_total.load(std::memory_order_relaxed)) {}
+
+    /// @brief Allocations made by the constructing thread.
+    uint64_t Count() const { return t_count - count_; }
+    /// @brief Bytes requested by the constructing thread.
+    uint64_t Bytes() const { return t_bytes - bytes_; }
+    /// @brief Allocations made by all threads.
+    uint64_t TotalCount() const { return g_total.load(std::memory_order_relaxed) - total_; }
+
+private:
+    uint64_t count_;
+    uint64_t bytes_;
+    uint64_t total_;
+};
+
+} // namespace alloc_counter
+
+using alloc_counter::AllocScope;
+
+#if defined(TEST_ALLOC_COUNTER_MALLOC)
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+
+void *malloc(size_t size) noexcept
+{
+    alloc_counter::Record(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) noexcept
+{
+    alloc_counter::Record(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) noexcept
+{
+    alloc_counter::Record(size);
+    return __libc_realloc(ptr, size);
+}
+
+void *memalign(size_t alignment, size_t size) noexcept
+{
+    alloc_counter::Record(size);
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    alloc_counter::Record(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **out, size_t alignment, size_t size) noexcept
+{
+    alloc_counter::Record(size);
+    void *p = __libc_memalign(alignment, size);
+    if (!p) {
+        return 12; // ENOMEM
+    }
+    *out = p;
+    return 0;
+}
+
+void free(void *ptr) noexcept
+{
+    __libc_free(ptr);
+}
+}
+
+// The malloc hooks already count, operator new only has to route through them
+#define TEST_ALLOC_COUNTER_NEW(size) std::malloc(size)
+#define TEST_ALLOC_COUNTER_ALIGNED_NEW(size, align) aligned_alloc(align, ((size) + (align) - 1) / (align) * (align))
+
+#else
+
+#define TEST_ALLOC_COUNTER_NEW(size) (alloc_counter::Record(size), std::malloc(size))
+#define TEST_ALLOC_COUNTER_ALIGNED_NEW(size, align)                                                                   \
+    (alloc_counter::Record(size), aligned_alloc(align, ((size) + (align) - 1) / (align) * (align)))
+
+#endif // TEST_ALLOC_COUNTER_MALLOC
+
+void *operator new(size_t size)
+{
+    void *p = TEST_ALLOC_COUNTER_NEW(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return TEST_ALLOC_COUNTER_NEW(size ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return TEST_ALLOC_COUNTER_NEW(size ? size : 1);
+}
+
+void *operator new(size_t size, std::align_val_t align)
+{
+    void *p = TEST_ALLOC_COUNTER_ALIGNED_NEW(size ? size : 1, static_cast<size_t>(align));
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](size_t size, std::align_val_t align)
+{
+    return operator new(size, align);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+#endif // TEST_ALLOC_COUNTER_H
@@ -79,6 +79,24 @@
         }                                                                                                              \
     } while (0)
 
+// Allocation assertions, available to tests that include alloc_counter.h. Only allocations made
+// by the calling thread while running the statement are counted.
+#define EXPECT_ALLOCS(expected, statement)                                                                             \
+    do {                                                                                                               \
+        AllocScope alloc_scope_;                                                                                       \
+        statement;                                                                                                     \
+        uint64_t alloc_count_ = alloc_scope_.Count();                                                                  \
+        if (alloc_count_ != static_cast<uint64_t>(expected)) {                                                         \
+            std::cerr << "FAIL: " << __FILE__ << ":" << __LINE__ << " - Expected " << (expected)                       \
+                      << " allocation(s) but got " << alloc_count_ << " (" << alloc_scope_.Bytes() << " bytes)"        \
+                      << std::endl;                                                                                    \
+            TestRunner::getInstance().recordFailure();                                                                 \
+            return;                                                                                                    \
+        }                                                                                                              \
+    } while (0)
+
+#define EXPECT_NO_ALLOC(statement) EXPECT_ALLOCS(0, statement)
+
 // Test structure
 struct TestCase {
     std::string suite_name;
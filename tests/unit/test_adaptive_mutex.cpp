@@ -0,0 +1,169 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/adaptive_mutex.h"
+
+using namespace lmshao::lmcore;
+
+TEST(AdaptiveMutexTest, TryLock)
+{
+    AdaptiveMutex mutex;
+    EXPECT_TRUE(mutex.try_lock());
+    EXPECT_FALSE(mutex.try_lock());
+    mutex.unlock();
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(AdaptiveMutexTest, MutualExclusion)
+{
+    AdaptiveMutex mutex;
+    int64_t counter = 0;
+    const int kThreads = 4;
+    const int kIterations = 50000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < kIterations; ++i) {
+                std::lock_guard<AdaptiveMutex> lock(mutex);
+                ++counter;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter, static_cast<int64_t>(kThreads) * kIterations);
+}
+
+TEST(AdaptiveMutexTest, SleepingWaiterIsWoken)
+{
+    AdaptiveMutex mutex;
+    std::atomic<bool> acquired{false};
+
+    mutex.lock();
+    std::thread waiter([&]() {
+        std::lock_guard<AdaptiveMutex> lock(mutex);
+        acquired = true;
+    });
+    // Long enough for the waiter to give up spinning and park
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(acquired.load());
+    mutex.unlock();
+    waiter.join();
+    EXPECT_TRUE(acquired.load());
+}
+
+TEST(AdaptiveCondVarTest, ProducerConsumer)
+{
+    AdaptiveMutex mutex;
+    AdaptiveCondVar notEmpty;
+    std::vector<int> items;
+    const int kItems = 10000;
+    int64_t sum = 0;
+
+    std::thread consumer([&]() {
+        int received = 0;
+        while (received < kItems) {
+            std::unique_lock<AdaptiveMutex> lock(mutex);
+            notEmpty.wait(lock, [&]() { return !items.empty(); });
+            for (int value : items) {
+                sum += value;
+            }
+            received += static_cast<int>(items.size());
+            items.clear();
+        }
+    });
+
+    for (int i = 1; i <= kItems; ++i) {
+        {
+            std::lock_guard<AdaptiveMutex> lock(mutex);
+            items.push_back(i);
+        }
+        notEmpty.notify_one();
+    }
+    consumer.join();
+    EXPECT_EQ(sum, static_cast<int64_t>(kItems) * (kItems + 1) / 2);
+}
+
+TEST(AdaptiveCondVarTest, NotifyAllWakesEveryWaiter)
+{
+    AdaptiveMutex mutex;
+    AdaptiveCondVar cond;
+    bool go = false;
+    int waiting = 0;
+    std::atomic<int> woken{0};
+    const int kThreads = 8;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&]() {
+            std::unique_lock<AdaptiveMutex> lock(mutex);
+            ++waiting;
+            cond.wait(lock, [&]() { return go; });
+            woken.fetch_add(1);
+        });
+    }
+
+    for (;;) {
+        std::lock_guard<AdaptiveMutex> lock(mutex);
+        if (waiting == kThreads) {
+            break;
+        }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    {
+        std::lock_guard<AdaptiveMutex> lock(mutex);
+        go = true;
+    }
+    // Waiters are requeued onto the mutex and must still all get it
+    cond.notify_all();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(woken.load(), kThreads);
+}
+
+TEST(AdaptiveCondVarTest, WaitForTimesOut)
+{
+    AdaptiveMutex mutex;
+    AdaptiveCondVar cond;
+    std::unique_lock<AdaptiveMutex> lock(mutex);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(cond.wait_for(lock, std::chrono::milliseconds(20)) == std::cv_status::timeout);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_GE(elapsed.count(), 20);
+    EXPECT_FALSE(cond.wait_for(lock, std::chrono::milliseconds(5), []() { return false; }));
+    EXPECT_TRUE(cond.wait_for(lock, std::chrono::milliseconds(5), []() { return true; }));
+
+    // Still locked by us after waiting
+    EXPECT_TRUE(lock.owns_lock());
+    std::thread other([&]() { EXPECT_FALSE(mutex.try_lock()); });
+    other.join();
+}
+
+TEST(AdaptiveCondVarTest, NotifyWithoutWaiters)
+{
+    AdaptiveCondVar cond;
+    for (int i = 0; i < 1000; ++i) {
+        cond.notify_one();
+        cond.notify_all();
+    }
+    EXPECT_TRUE(true);
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,201 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../alloc_counter.h"
+#include "../test_framework.h"
+#include "lmcore/data_buffer.h"
+#include "lmcore/logger.h"
+#include "lmcore/mpmc_channel.h"
+#include "lmcore/mpsc_channel.h"
+#include "lmcore/object_pool.h"
+#include "lmcore/recycling_allocator.h"
+#include "lmcore/spmc_channel.h"
+#include "lmcore/spsc_channel.h"
+#include "lmcore/task_queue.h"
+#include "lmcore/thread_pool.h"
+
+using namespace lmshao::lmcore;
+using namespace lmshao::lmcore::sync;
+
+// Steady-state hot paths must not touch the heap once warmed up. Each test runs the operation
+// a few times first so lazily created thread-local caches and registry entries exist.
+
+namespace {
+
+struct AllocTestModuleTag {};
+
+void WaitFor(const std::atomic<int> &counter, int expected)
+{
+    while (counter.load() < expected) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace
+
+TEST(AllocCounterTest, CountsAllocations)
+{
+    EXPECT_NO_ALLOC(int x = 1; (void)x);
+    EXPECT_ALLOCS(1, delete new int(7));
+    EXPECT_ALLOCS(1, std::vector<int> v(100); (void)v);
+
+    AllocScope scope;
+    std::string text(100, 'x');
+    EXPECT_EQ(scope.Count(), 1u);
+    EXPECT_GE(scope.Bytes(), 100u);
+    EXPECT_GE(scope.TotalCount(), 1u);
+}
+
+TEST(AllocCounterTest, RecyclingAllocatorReusesBlocks)
+{
+    RecyclingAllocator<uint64_t> alloc;
+    uint64_t *first = alloc.allocate(4);
+    alloc.deallocate(first, 4);
+
+    uint64_t *second = nullptr;
+    EXPECT_NO_ALLOC(second = alloc.allocate(4));
+    EXPECT_TRUE(first == second);
+    alloc.deallocate(second, 4);
+
+    // Outside the size classes the heap is used
+    EXPECT_ALLOCS(1, uint64_t *big = alloc.allocate(1000); alloc.deallocate(big, 1000));
+}
+
+TEST(AllocCounterTest, ChannelSendRecv)
+{
+    auto spsc = SpscChannel<int>(64);
+    auto mpsc = MpscChannel<int>(64);
+    auto spmc = SpmcChannel<int>(64);
+    auto mpmc = MpmcChannel<int>(64);
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_NO_ALLOC(spsc.first->Send(i); (void)spsc.second->Recv());
+        EXPECT_NO_ALLOC(mpsc.first->Send(i); (void)mpsc.second->Recv());
+        EXPECT_NO_ALLOC(spmc.first->Send(i); (void)spmc.second->Recv());
+        EXPECT_NO_ALLOC(mpmc.first->Send(i); (void)mpmc.second->Recv());
+        EXPECT_NO_ALLOC((void)spsc.first->TrySend(i); (void)spsc.second->TryRecv());
+    }
+}
+
+TEST(AllocCounterTest, DataBufferPoolAlloc)
+{
+    // Warm up the buffer pool and the control-block cache
+    {
+        auto warm = DataBuffer::PoolAlloc(100);
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_NO_ALLOC({
+            auto buffer = DataBuffer::PoolAlloc(100);
+            buffer->Assign("hello", 5);
+        });
+    }
+}
+
+TEST(AllocCounterTest, ObjectPoolAcquire)
+{
+    ObjectPool<std::string> pool(nullptr, [](std::string *s) { s->clear(); }, nullptr, 4, "alloc_test");
+    {
+        auto warm = pool.Acquire();
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_NO_ALLOC({
+            auto obj = pool.Acquire();
+            obj->assign("short");
+        });
+    }
+}
+
+TEST(AllocCounterTest, ThreadPoolAddTask)
+{
+    ThreadPool pool(1, 1, "alloc_test");
+    std::atomic<int> done{0};
+    auto task = [&done]() { done.fetch_add(1); };
+
+    // The first burst fills the task item pool
+    for (int i = 0; i < 50; ++i) {
+        pool.AddTask(task);
+    }
+    WaitFor(done, 50);
+
+    // Worker side included: nothing in the process should allocate while tasks flow through
+    AllocScope scope;
+    for (int i = 0; i < 50; ++i) {
+        pool.AddTask(task);
+    }
+    WaitFor(done, 100);
+    EXPECT_EQ(scope.TotalCount(), 0u);
+
+    pool.Shutdown();
+}
+
+TEST(AllocCounterTest, TaskQueueEnqueue)
+{
+    TaskQueue queue("alloc_test");
+    EXPECT_EQ(queue.Start(), 0);
+
+    std::atomic<int> done{0};
+    auto handler = std::make_shared<TaskHandler<void>>([&done]() { done.fetch_add(1); });
+
+    int expected = 0;
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(queue.EnqueueTask(handler), 0);
+        WaitFor(done, ++expected);
+        while (queue.IsTaskExecuting()) {
+            std::this_thread::yield();
+        }
+    }
+
+    AllocScope scope;
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(queue.EnqueueTask(handler), 0);
+        WaitFor(done, ++expected);
+        while (queue.IsTaskExecuting()) {
+            std::this_thread::yield();
+        }
+    }
+    EXPECT_EQ(scope.TotalCount(), 0u);
+
+    queue.Stop();
+}
+
+TEST(AllocCounterTest, Logging)
+{
+#ifdef _WIN32
+    const char *sink = "NUL";
+#else
+    const char *sink = "/dev/null";
+#endif
+    LoggerRegistry::RegisterModule<AllocTestModuleTag>("AllocTest");
+    auto &logger = LoggerRegistry::GetLogger<AllocTestModuleTag>();
+    logger.SetLevel(LogLevel::kInfo);
+    logger.SetOutput(LogOutput::FILE);
+    logger.SetLogFile(sink);
+
+    // The first record opens the file
+    logger.LogWithModuleTag<AllocTestModuleTag>(LogLevel::kInfo, __FILE__, __LINE__, __FUNCTION__, "warm up %d", 0);
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_NO_ALLOC(logger.LogWithModuleTag<AllocTestModuleTag>(LogLevel::kInfo, __FILE__, __LINE__, __FUNCTION__,
+                                                                    "value %d name %s", i, "abc"));
+        EXPECT_NO_ALLOC(logger.Log(LogLevel::kWarn, __FILE__, __LINE__, __FUNCTION__, "plain %d", i));
+    }
+    // Filtered records are free as well
+    EXPECT_NO_ALLOC(logger.Log(LogLevel::kDebug, __FILE__, __LINE__, __FUNCTION__, "dropped"));
+
+    logger.SetOutput(LogOutput::CONSOLE);
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,110 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <poll.h>
+
+#include <atomic>
+#include <thread>
+
+#include "../test_framework.h"
+#include "lmcore/sync.h"
+
+using namespace lmshao::lmcore::sync;
+
+namespace {
+bool Readable(int fd, int timeoutMs = 0)
+{
+    pollfd pfd{fd, POLLIN, 0};
+    return poll(&pfd, 1, timeoutMs) == 1 && (pfd.revents & POLLIN);
+}
+} // namespace
+
+TEST(ChannelNotifierTest, NotifiesOnlyWhenArmed)
+{
+    ChannelNotifier notifier;
+    EXPECT_TRUE(notifier.GetFd() >= 0);
+    notifier.Notify();
+    EXPECT_FALSE(Readable(notifier.GetFd()));
+
+    notifier.Arm();
+    notifier.Notify();
+    EXPECT_TRUE(Readable(notifier.GetFd()));
+    notifier.Clear();
+    EXPECT_FALSE(Readable(notifier.GetFd()));
+
+    // The first notification disarms
+    notifier.Notify();
+    EXPECT_FALSE(Readable(notifier.GetFd()));
+}
+
+TEST(ChannelNotifierTest, ChannelWithoutNotifier)
+{
+    auto [tx, rx] = SpscChannel<int>(4);
+    EXPECT_TRUE(rx->GetNotifier() == nullptr);
+    EXPECT_FALSE(rx->ArmNotifier());
+    EXPECT_TRUE(tx->TrySend(1));
+}
+
+TEST(ChannelNotifierTest, OneSignalPerBatch)
+{
+    auto [tx, rx] = MpscChannel<int>(64, true);
+    ChannelNotifier *notifier = rx->GetNotifier();
+    EXPECT_TRUE(rx->ArmNotifier());
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(tx->TrySend(i));
+    }
+    EXPECT_TRUE(Readable(notifier->GetFd()));
+    notifier->Clear();
+    // Still disarmed: the rest of the batch wrote nothing
+    EXPECT_FALSE(Readable(notifier->GetFd()));
+
+    // Re-arming with data pending is refused
+    EXPECT_FALSE(rx->ArmNotifier());
+    int count = 0;
+    while (rx->TryRecv()) {
+        ++count;
+    }
+    EXPECT_EQ(count, 10);
+    EXPECT_TRUE(rx->ArmNotifier());
+
+    tx->Close();
+    EXPECT_TRUE(Readable(notifier->GetFd()));
+    notifier->Clear();
+    EXPECT_FALSE(rx->ArmNotifier());
+}
+
+TEST(ChannelNotifierTest, NoLostWakeups)
+{
+    auto [tx, rx] = SpscChannel<int>(128, true);
+    const int kCount = 50000;
+    std::thread producer([&, sender = std::move(tx)]() {
+        for (int i = 0; i < kCount; ++i) {
+            sender->Send(i);
+        }
+    });
+
+    int received = 0;
+    int waits = 0;
+    while (received < kCount) {
+        while (auto value = rx->TryRecv()) {
+            EXPECT_EQ(*value, received);
+            ++received;
+        }
+        if (received < kCount && rx->ArmNotifier()) {
+            // A lost wakeup would make this block until the timeout
+            EXPECT_TRUE(Readable(rx->GetNotifier()->GetFd(), 5000));
+            rx->GetNotifier()->Clear();
+            ++waits;
+        }
+    }
+    producer.join();
+    EXPECT_EQ(received, kCount);
+    EXPECT_TRUE(waits < kCount);
+}
+
+RUN_ALL_TESTS()
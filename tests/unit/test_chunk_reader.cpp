@@ -0,0 +1,160 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lmcore/chunk_reader.h>
+#include <lmcore/data_buffer.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+
+using namespace lmshao::lmcore;
+
+// Source producing `total` bytes of a known pattern, at most `step` bytes per call
+static ChunkReader::Source PatternSource(size_t total, size_t step, std::atomic<size_t> *calls = nullptr)
+{
+    auto offset = std::make_shared<size_t>(0);
+    return [offset, total, step, calls](uint8_t *buffer, size_t size) -> int64_t {
+        if (calls) {
+            calls->fetch_add(1);
+        }
+        size_t n = std::min({size, step, total - *offset});
+        for (size_t i = 0; i < n; ++i) {
+            buffer[i] = static_cast<uint8_t>((*offset + i) * 7);
+        }
+        *offset += n;
+        return static_cast<int64_t>(n);
+    };
+}
+
+TEST(ChunkReader, DeliversFullChunksInOrder)
+{
+    const size_t total = 10000;
+    ChunkReader reader(PatternSource(total, 333), 1024, 3);
+
+    size_t offset = 0;
+    size_t chunks = 0;
+    bool intact = true;
+    while (auto chunk = reader.Next()) {
+        // Every chunk is full except the last
+        intact = intact && (chunk->Size() == 1024 || offset + chunk->Size() == total);
+        for (size_t i = 0; i < chunk->Size(); ++i) {
+            intact = intact && chunk->Data()[i] == static_cast<uint8_t>((offset + i) * 7);
+        }
+        offset += chunk->Size();
+        ++chunks;
+    }
+    EXPECT_TRUE(intact);
+    EXPECT_EQ(total, offset);
+    EXPECT_EQ(10U, chunks);
+    EXPECT_TRUE(reader.IsFinished());
+    EXPECT_FALSE(reader.HasError());
+    EXPECT_EQ(total, reader.GetStats().bytes);
+    EXPECT_TRUE(reader.Next() == nullptr);
+}
+
+TEST(ChunkReader, RecyclesReadAheadChunks)
+{
+    ChunkReader reader(PatternSource(64 * 1024, 64 * 1024), 1024, 2);
+
+    // Holding readAhead chunks stalls the reader until one is released
+    auto first = reader.Next();
+    auto second = reader.Next();
+    EXPECT_TRUE(first != nullptr && second != nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(reader.TryNext() == nullptr);
+    EXPECT_GE(reader.GetStats().readerWaits, 1U);
+
+    const DataBuffer *recycled = first.get();
+    first.reset();
+    auto third = reader.Next();
+    EXPECT_TRUE(third.get() == recycled);
+
+    // Released chunks keep coming back: only two buffers are ever used
+    second.reset();
+    third.reset();
+    size_t chunks = 3;
+    while (auto chunk = reader.Next()) {
+        ++chunks;
+    }
+    EXPECT_EQ(64U, chunks);
+}
+
+TEST(ChunkReader, ReadsAhead)
+{
+    std::atomic<size_t> calls{0};
+    ChunkReader reader(PatternSource(1 << 20, 4096, &calls), 4096, 4);
+    // Without any Next(), the reader fills all four chunks on its own
+    for (int i = 0; i < 200 && calls.load() < 4; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(4U, calls.load());
+    EXPECT_EQ(4U, reader.GetStats().chunks);
+}
+
+TEST(ChunkReader, SourceError)
+{
+    auto calls = std::make_shared<int>(0);
+    ChunkReader reader(
+        [calls](uint8_t *buffer, size_t size) -> int64_t {
+            if ((*calls)++ == 3) {
+                return -1;
+            }
+            memset(buffer, 1, size);
+            return static_cast<int64_t>(size);
+        },
+        100, 2);
+    size_t chunks = 0;
+    while (auto chunk = reader.Next()) {
+        ++chunks;
+    }
+    EXPECT_EQ(3U, chunks);
+    EXPECT_TRUE(reader.HasError());
+}
+
+TEST(ChunkReader, StopWhileStalled)
+{
+    ChunkReader reader(PatternSource(1 << 20, 1 << 20), 1024, 1);
+    auto held = reader.Next();
+    EXPECT_TRUE(held != nullptr);
+    reader.Stop();
+    EXPECT_TRUE(reader.Next() == nullptr);
+    EXPECT_TRUE(reader.IsFinished());
+    // Still valid after the reader stopped; freed on release
+    EXPECT_EQ(1024U, held->Size());
+}
+
+TEST(ChunkReader, OpenFile)
+{
+    const std::string path = "test_chunk_reader.bin";
+    std::string content(5000, '\0');
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i % 251);
+    }
+    std::ofstream(path, std::ios::binary).write(content.data(), content.size());
+
+    EXPECT_TRUE(ChunkReader::OpenFile("no_such_file_12345.bin") == nullptr);
+    auto reader = ChunkReader::OpenFile(path, 2048, 2);
+    EXPECT_TRUE(reader != nullptr);
+    std::string read;
+    while (auto chunk = reader->Next()) {
+        read.append(reinterpret_cast<const char *>(chunk->Data()), chunk->Size());
+    }
+    EXPECT_TRUE(read == content);
+    std::remove(path.c_str());
+}
+
+RUN_ALL_TESTS()
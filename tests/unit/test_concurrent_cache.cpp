@@ -0,0 +1,155 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/concurrent_cache.h"
+#include "lmcore/data_buffer.h"
+#include "lmcore/object_pool.h"
+
+using namespace lmshao::lmcore;
+
+TEST(ConcurrentCacheTest, PutGetErase)
+{
+    ConcurrentCache<std::string, int> cache(100);
+    EXPECT_FALSE(cache.Get("a").has_value());
+    EXPECT_TRUE(cache.Put("a", 1));
+    EXPECT_TRUE(cache.Put("b", 2));
+    EXPECT_EQ(1, *cache.Get("a"));
+    EXPECT_EQ(2, *cache.Get("b"));
+
+    EXPECT_TRUE(cache.Put("a", 10));
+    EXPECT_EQ(10, *cache.Get("a"));
+    EXPECT_EQ(2u, cache.GetSize());
+
+    EXPECT_TRUE(cache.Erase("a"));
+    EXPECT_FALSE(cache.Erase("a"));
+    EXPECT_FALSE(cache.Contains("a"));
+    EXPECT_TRUE(cache.Contains("b"));
+
+    cache.Clear();
+    EXPECT_EQ(0u, cache.GetSize());
+    EXPECT_FALSE(cache.Get("b").has_value());
+}
+
+TEST(ConcurrentCacheTest, ManyKeysWithDeletes)
+{
+    // Exercises table growth and backward-shift deletion
+    ConcurrentCache<int, int> cache(100000, nullptr, 4);
+    for (int i = 0; i < 20000; ++i) {
+        cache.Put(i, i * 3);
+    }
+    for (int i = 0; i < 20000; i += 3) {
+        EXPECT_TRUE(cache.Erase(i));
+    }
+    for (int i = 0; i < 20000; ++i) {
+        auto value = cache.Get(i);
+        if (i % 3 == 0) {
+            EXPECT_FALSE(value.has_value());
+        } else {
+            EXPECT_TRUE(value.has_value());
+            EXPECT_EQ(i * 3, *value);
+        }
+    }
+}
+
+TEST(ConcurrentCacheTest, CapacityEviction)
+{
+    ConcurrentCache<int, int> cache(8, nullptr, 1);
+    for (int i = 0; i < 100; ++i) {
+        cache.Put(i, i);
+        EXPECT_TRUE(cache.GetSize() <= 8u);
+    }
+    EXPECT_EQ(8u, cache.GetSize());
+    EXPECT_TRUE(cache.Contains(99));
+}
+
+TEST(ConcurrentCacheTest, ClockGivesSecondChance)
+{
+    ConcurrentCache<int, int> cache(4, nullptr, 1);
+    for (int i = 0; i < 4; ++i) {
+        cache.Put(i, i);
+    }
+    // A hot key survives a stream of one-off insertions
+    for (int i = 4; i < 40; ++i) {
+        EXPECT_TRUE(cache.Get(0).has_value());
+        cache.Put(i, i);
+    }
+    EXPECT_TRUE(cache.Contains(0));
+}
+
+TEST(ConcurrentCacheTest, WeightedDataBuffers)
+{
+    DataBufferPool pool(1024, 16);
+    using Buffer = std::shared_ptr<DataBuffer>;
+    ConcurrentCache<int, Buffer> cache(
+        4096, [](const int &, const Buffer &buffer) { return buffer->Capacity(); }, 1);
+
+    for (int i = 0; i < 10; ++i) {
+        auto buffer = pool.Acquire(1024);
+        buffer->Assign("x", 1);
+        EXPECT_TRUE(cache.Put(i, buffer));
+        EXPECT_TRUE(cache.GetWeight() <= 4096u);
+    }
+    EXPECT_TRUE(cache.GetSize() < 10u);
+    EXPECT_GT(pool.GetPoolSize(), 0u); // evicted buffers went back to the pool
+
+    auto huge = std::make_shared<DataBuffer>(8192);
+    EXPECT_FALSE(cache.Put(100, huge));
+    EXPECT_FALSE(cache.Contains(100));
+}
+
+TEST(ConcurrentCacheTest, TimeToLive)
+{
+    ConcurrentCache<int, int> cache(100, nullptr, 2, std::chrono::milliseconds(30));
+    cache.Put(1, 1);
+    cache.Put(2, 2, std::chrono::hours(1));
+    EXPECT_TRUE(cache.Get(1).has_value());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(cache.Get(1).has_value());
+    EXPECT_TRUE(cache.Get(2).has_value());
+
+    cache.Put(3, 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(1u, cache.PurgeExpired());
+    EXPECT_EQ(1u, cache.GetSize());
+}
+
+TEST(ConcurrentCacheTest, ConcurrentAccess)
+{
+    ConcurrentCache<int, int> cache(512);
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, &wrong, t]() {
+            for (int i = 0; i < 20000; ++i) {
+                int key = (i * 7 + t) % 1024;
+                if (i % 4 == 0) {
+                    cache.Put(key, key * 2);
+                } else if (auto value = cache.Get(key)) {
+                    if (*value != key * 2) {
+                        wrong.fetch_add(1);
+                    }
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, wrong.load());
+    EXPECT_TRUE(cache.GetSize() <= cache.GetCapacity());
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,268 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "../alloc_counter.h"
+#include "../test_framework.h"
+#include "lmcore/coro.h"
+#include "lmcore/mpsc_channel.h"
+#include "lmcore/spsc_channel.h"
+
+using namespace lmshao::lmcore;
+
+#ifdef LMCORE_HAS_COROUTINES
+
+namespace {
+coro::Task<int> Add(int a, int b)
+{
+    co_return a + b;
+}
+
+coro::Task<int> SumTo(int n)
+{
+    int sum = 0;
+    for (int i = 1; i <= n; ++i) {
+        sum = co_await Add(sum, i);
+    }
+    co_return sum;
+}
+
+coro::Task<int> Fail()
+{
+    throw std::runtime_error("boom");
+    co_return 0;
+}
+
+coro::Task<bool> Catches()
+{
+    try {
+        co_await Fail();
+    } catch (const std::runtime_error &) {
+        co_return true;
+    }
+    co_return false;
+}
+
+coro::Task<std::thread::id> HopToPool(ThreadPool &pool)
+{
+    co_await pool.Schedule();
+    co_return std::this_thread::get_id();
+}
+
+coro::Task<long long> Sleep(AsyncTimer &timer, int ms)
+{
+    auto start = std::chrono::steady_clock::now();
+    co_await timer.SleepFor(std::chrono::milliseconds(ms));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    co_return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+}
+
+template <typename Receiver>
+coro::Task<int> SumChannel(Receiver &rx, ThreadPool &pool)
+{
+    int sum = 0;
+    while (auto value = co_await coro::Recv(rx, pool)) {
+        sum += *value;
+    }
+    co_return sum;
+}
+
+template <typename Sender>
+coro::Task<void> Produce(Sender &tx, ThreadPool &pool, int count)
+{
+    for (int i = 1; i <= count; ++i) {
+        co_await coro::Send(tx, i, pool);
+    }
+    tx.Close();
+}
+
+coro::Task<int> SumPointers(sync::SpscReceiver<std::unique_ptr<int>> &rx, ThreadPool &pool)
+{
+    int sum = 0;
+    while (auto value = co_await coro::Recv(rx, pool)) {
+        sum += **value;
+    }
+    co_return sum;
+}
+
+coro::Task<void> ProducePointers(sync::SpscSender<std::unique_ptr<int>> &tx, ThreadPool &pool, int count)
+{
+    for (int i = 1; i <= count; ++i) {
+        co_await coro::Send(tx, std::make_unique<int>(i), pool);
+    }
+    tx.Close();
+}
+} // namespace
+
+TEST(CoroTest, NestedTasks)
+{
+    EXPECT_EQ(5050, coro::SyncWait(SumTo(100)));
+}
+
+TEST(CoroTest, DeepChainDoesNotOverflow)
+{
+    // Each level completes synchronously. Optimized builds make the symmetric transfer a tail call
+    // and keep the stack flat; -O0 builds don't, so the depth stays within a default 8 MiB stack
+    EXPECT_EQ(50005000LL, static_cast<long long>(coro::SyncWait([]() -> coro::Task<long long> {
+                  long long sum = 0;
+                  for (int i = 1; i <= 10000; ++i) {
+                      sum += co_await Add(0, i);
+                  }
+                  co_return sum;
+              }())));
+}
+
+TEST(CoroTest, ExceptionPropagates)
+{
+    EXPECT_TRUE(coro::SyncWait(Catches()));
+
+    bool thrown = false;
+    try {
+        coro::SyncWait(Fail());
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+}
+
+TEST(CoroTest, AwaitEmptyTaskThrows)
+{
+    bool thrown = false;
+    try {
+        coro::SyncWait(coro::Task<int>{});
+    } catch (const std::logic_error &) {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+}
+
+TEST(CoroTest, FramesAreRecycled)
+{
+    EXPECT_EQ(55, coro::SyncWait(SumTo(10)));
+    EXPECT_NO_ALLOC(coro::SyncWait(SumTo(10)));
+}
+
+TEST(CoroTest, ScheduleOnPool)
+{
+    ThreadPool pool(1, 2, "coro");
+    auto id = coro::SyncWait(HopToPool(pool));
+    EXPECT_NE(std::this_thread::get_id(), id);
+}
+
+TEST(CoroTest, ScheduleOnStoppedPoolResumesInline)
+{
+    ThreadPool pool(1, 1, "coro");
+    pool.Shutdown();
+    EXPECT_EQ(std::this_thread::get_id(), coro::SyncWait(HopToPool(pool)));
+
+    auto [tx, rx] = sync::SpscChannel<int>(4);
+    EXPECT_EQ(0, coro::SyncWait(SumChannel(*rx, pool)));
+}
+
+TEST(CoroTest, SleepFor)
+{
+    AsyncTimer timer;
+    EXPECT_EQ(0, timer.Start());
+    EXPECT_GE(coro::SyncWait(Sleep(timer, 20)), 20);
+    EXPECT_EQ(0, coro::SyncWait(Sleep(timer, 0)));
+    timer.Stop();
+}
+
+TEST(CoroTest, SpawnRunsDetached)
+{
+    ThreadPool pool(1, 2, "coro");
+    std::atomic<int> done{0};
+    for (int i = 0; i < 10; ++i) {
+        coro::Spawn([](ThreadPool &pool, std::atomic<int> &done) -> coro::Task<void> {
+            co_await pool.Schedule();
+            done.fetch_add(1);
+        }(pool, done));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (done.load() < 10 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(10, done.load());
+}
+
+TEST(CoroTest, SpscChannelSendRecv)
+{
+    ThreadPool pool(2, 2, "coro");
+    auto [tx, rx] = sync::SpscChannel<int>(4);
+    coro::Spawn(Produce(*tx, pool, 1000));
+    EXPECT_EQ(500500, coro::SyncWait(SumChannel(*rx, pool)));
+}
+
+TEST(CoroTest, MpscRecvEndsOnClose)
+{
+    ThreadPool pool(1, 2, "coro");
+    auto [tx, rx] = sync::MpscChannel<int>(8);
+    std::thread producer([tx = tx]() {
+        for (int i = 1; i <= 100; ++i) {
+            while (!tx->TrySend(i)) {
+                std::this_thread::yield();
+            }
+        }
+        tx->Close();
+    });
+    EXPECT_EQ(5050, coro::SyncWait(SumChannel(*rx, pool)));
+    producer.join();
+}
+
+TEST(CoroTest, IdleRecvParksOnNotifier)
+{
+    ThreadPool pool(1, 1, "coro");
+    auto [tx, rx] = sync::SpscChannel<int>(4, true);
+    std::atomic<int> sum{-1};
+    coro::Spawn([](sync::SpscReceiver<int> &rx, ThreadPool &pool, std::atomic<int> &sum) -> coro::Task<void> {
+        co_await pool.Schedule();
+        sum = co_await SumChannel(rx, pool);
+    }(*rx, pool, sum));
+
+    // Parked on the notifier, the awaiter leaves the only worker idle
+    std::clock_t cpu = std::clock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_GT(static_cast<std::clock_t>(CLOCKS_PER_SEC / 50), std::clock() - cpu);
+
+    for (int i = 1; i <= 10; ++i) {
+        EXPECT_TRUE(tx->TrySend(i));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    tx->Close();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (sum.load() < 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(55, sum.load());
+}
+
+TEST(CoroTest, SendMovesOnce)
+{
+    ThreadPool pool(2, 2, "coro");
+    auto [tx, rx] = sync::SpscChannel<std::unique_ptr<int>>(1, true);
+    coro::Spawn(ProducePointers(*tx, pool, 200));
+    EXPECT_EQ(20100, coro::SyncWait(SumPointers(*rx, pool)));
+}
+
+#else
+
+TEST(CoroTest, Unavailable)
+{
+    // Built without C++20 coroutine support: coro.h is empty
+    EXPECT_TRUE(true);
+}
+
+#endif
+
+RUN_ALL_TESTS()
@@ -0,0 +1,172 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/base64.h"
+#include "lmcore/cpu_features.h"
+#include "lmcore/crc32.h"
+#include "lmcore/hex.h"
+#include "lmcore/string_utils.h"
+
+using namespace lmshao::lmcore;
+
+// Every dispatched codec is checked against a straightforward reference on inputs long
+// enough to reach the vector loops. ctest also runs this binary with LMCORE_NO_SIMD=1.
+
+namespace {
+
+std::vector<uint8_t> MakeData(size_t len, uint32_t seed)
+{
+    std::vector<uint8_t> data(len);
+    uint32_t x = seed * 2654435761u + 1;
+    for (auto &b : data) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        b = static_cast<uint8_t>(x);
+    }
+    return data;
+}
+
+uint32_t ReferenceCrc32(const std::vector<uint8_t> &data)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint8_t b : data) {
+        crc ^= b;
+        for (int k = 0; k < 8; ++k) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+std::string ReferenceHex(const std::vector<uint8_t> &data, bool uppercase)
+{
+    std::string out;
+    char buffer[3];
+    for (uint8_t b : data) {
+        snprintf(buffer, sizeof(buffer), uppercase ? "%02X" : "%02x", b);
+        out += buffer;
+    }
+    return out;
+}
+
+std::string ReferenceBase64(const std::vector<uint8_t> &data)
+{
+    static const char kChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    size_t bits = 0;
+    uint32_t acc = 0;
+    for (uint8_t b : data) {
+        acc = (acc << 8) | b;
+        bits += 8;
+        while (bits >= 6) {
+            bits -= 6;
+            out += kChars[(acc >> bits) & 0x3f];
+        }
+    }
+    if (bits > 0) {
+        out += kChars[(acc << (6 - bits)) & 0x3f];
+    }
+    while (out.size() % 4 != 0) {
+        out += '=';
+    }
+    return out;
+}
+
+const size_t kLengths[] = {0, 1, 2, 3, 11, 12, 15, 16, 17, 31, 32, 33, 63, 64, 65, 79, 80, 127, 128, 129, 1000, 4099};
+
+} // namespace
+
+TEST(CpuFeaturesTest, Detection)
+{
+    const CpuFeatures &features = CpuFeatures::Get();
+    EXPECT_TRUE(&features == &CpuFeatures::Get());
+    EXPECT_TRUE(features.Has(0));
+    EXPECT_EQ(features.Has(CpuFeatures::kAvx2), (features.Mask() & CpuFeatures::kAvx2) != 0);
+    // AVX2 implies AVX on any sane CPU/OS combination
+    if (features.Has(CpuFeatures::kAvx2)) {
+        EXPECT_TRUE(features.Has(CpuFeatures::kAvx));
+    }
+    EXPECT_EQ(features.Has(CpuFeatures::kAvx2), features.ToString().find("avx2") != std::string::npos);
+}
+
+TEST(CpuFeaturesTest, SelectKernel)
+{
+    using Fn = int (*)();
+    Fn generic = []() { return 0; };
+    Fn special = []() { return 1; };
+
+    EXPECT_EQ(SelectKernel<Fn>({}, generic)(), 0);
+    EXPECT_EQ(SelectKernel<Fn>({{0, special}}, generic)(), 1);
+    EXPECT_EQ(SelectKernel<Fn>({{0, nullptr}}, generic)(), 0);
+
+    // Feature bit 31 is never reported
+    EXPECT_EQ(SelectKernel<Fn>({{1u << 31, special}}, generic)(), 0);
+}
+
+TEST(CpuFeaturesTest, Crc32MatchesReference)
+{
+    for (size_t len : kLengths) {
+        auto data = MakeData(len, static_cast<uint32_t>(len));
+        EXPECT_EQ(CRC32::Calculate(data), ReferenceCrc32(data));
+
+        // Split updates must agree with the one-shot result
+        CRC32::Context ctx;
+        ctx.Update(data.data(), len / 3);
+        ctx.Update(data.data() + len / 3, len - len / 3);
+        EXPECT_EQ(ctx.Final(), ReferenceCrc32(data));
+    }
+}
+
+TEST(CpuFeaturesTest, HexMatchesReference)
+{
+    for (size_t len : kLengths) {
+        auto data = MakeData(len, static_cast<uint32_t>(len) + 7);
+        EXPECT_EQ(Hex::Encode(data), ReferenceHex(data, true));
+        EXPECT_EQ(Hex::Encode(data, false), ReferenceHex(data, false));
+    }
+}
+
+TEST(CpuFeaturesTest, Base64MatchesReference)
+{
+    for (size_t len : kLengths) {
+        auto data = MakeData(len, static_cast<uint32_t>(len) + 13);
+        std::string encoded = Base64::Encode(data);
+        EXPECT_EQ(encoded, ReferenceBase64(data));
+        EXPECT_TRUE(Base64::Decode(encoded) == data);
+    }
+}
+
+TEST(CpuFeaturesTest, CaseConversionMatchesReference)
+{
+    for (size_t len : kLengths) {
+        auto data = MakeData(len, static_cast<uint32_t>(len) + 21);
+        std::string text(data.begin(), data.end());
+        std::string upper = text;
+        std::string lower = text;
+        for (size_t i = 0; i < text.size(); ++i) {
+            char c = text[i];
+            if (c >= 'a' && c <= 'z') {
+                upper[i] = static_cast<char>(c - 'a' + 'A');
+            }
+            if (c >= 'A' && c <= 'Z') {
+                lower[i] = static_cast<char>(c - 'A' + 'a');
+            }
+        }
+        EXPECT_EQ(StringUtils::ToUpper(text), upper);
+        EXPECT_EQ(StringUtils::ToLower(text), lower);
+    }
+}
+
+RUN_ALL_TESTS()
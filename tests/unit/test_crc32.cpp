@@ -8,7 +8,9 @@
 
 #include <lmcore/crc32.h>
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 #include "../test_framework.h"
 
@@ -131,4 +133,28 @@ TEST(CRC32, Large1MB)
     EXPECT_GT(result, 0);
 }
 
+TEST(CRC32, Combine)
+{
+    std::vector<uint8_t> data(100000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    uint32_t whole = CRC32::Calculate(data);
+
+    for (size_t split : {size_t(0), size_t(1), size_t(4096), size_t(65537), data.size()}) {
+        uint32_t crc1 = CRC32::Calculate(data.data(), split);
+        uint32_t crc2 = CRC32::Calculate(data.data() + split, data.size() - split);
+        EXPECT_EQ(whole, CRC32::Combine(crc1, crc2, data.size() - split));
+    }
+
+    // Folding many chunks gives the checksum of the whole
+    uint32_t crc = CRC32::Calculate(data.data(), 0);
+    for (size_t offset = 0; offset < data.size(); offset += 7777) {
+        size_t len = std::min<size_t>(7777, data.size() - offset);
+        crc = CRC32::Combine(crc, CRC32::Calculate(data.data() + offset, len), len);
+    }
+    EXPECT_EQ(whole, crc);
+    EXPECT_EQ(0xCBF43926U, CRC32::Combine(CRC32::Calculate("1234"), CRC32::Calculate("56789"), 5));
+}
+
 RUN_ALL_TESTS()
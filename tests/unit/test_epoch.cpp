@@ -0,0 +1,221 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/epoch.h"
+#include "lmcore/rcu_ptr.h"
+
+using namespace lmshao::lmcore;
+
+namespace {
+std::atomic<int> g_live{0};
+
+struct Tracked {
+    explicit Tracked(int v = 0) : value(v), check(v) { g_live.fetch_add(1); }
+    Tracked(const Tracked &other) : value(other.value), check(other.check) { g_live.fetch_add(1); }
+    ~Tracked()
+    {
+        check = -1;
+        g_live.fetch_sub(1);
+    }
+    int value;
+    int check;
+};
+} // namespace
+
+TEST(EpochTest, ReclaimWaitsForActiveReader)
+{
+    g_live = 0;
+    EpochDomain domain;
+    std::atomic<bool> entered{false};
+    std::atomic<bool> release{false};
+
+    std::thread reader([&]() {
+        EpochGuard guard(domain);
+        entered = true;
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!entered.load()) {
+        std::this_thread::yield();
+    }
+
+    domain.Retire(new Tracked(1));
+    for (int i = 0; i < 10; ++i) {
+        domain.Reclaim();
+    }
+    EXPECT_EQ(g_live.load(), 1);
+    EXPECT_EQ(domain.PendingCount(), 1u);
+
+    release = true;
+    reader.join();
+    domain.Synchronize();
+    EXPECT_EQ(g_live.load(), 0);
+    EXPECT_EQ(domain.PendingCount(), 0u);
+}
+
+TEST(EpochTest, NestedSections)
+{
+    g_live = 0;
+    EpochDomain domain;
+    std::atomic<bool> innerDone{false};
+    std::atomic<bool> release{false};
+
+    std::thread reader([&]() {
+        EpochGuard outer(domain);
+        {
+            EpochGuard inner(domain);
+        }
+        innerDone = true;
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!innerDone.load()) {
+        std::this_thread::yield();
+    }
+
+    // Leaving the inner section must not end the outer one
+    domain.Retire(new Tracked(2));
+    for (int i = 0; i < 10; ++i) {
+        domain.Reclaim();
+    }
+    EXPECT_EQ(g_live.load(), 1);
+
+    release = true;
+    reader.join();
+    domain.Synchronize();
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+TEST(EpochTest, ObjectsOfExitedThreadsAreReclaimed)
+{
+    g_live = 0;
+    EpochDomain domain;
+    std::thread worker([&]() {
+        for (int i = 0; i < 10; ++i) {
+            domain.Retire(new Tracked(i));
+        }
+    });
+    worker.join();
+    EXPECT_EQ(domain.PendingCount(), 10u);
+
+    domain.Synchronize();
+    EXPECT_EQ(g_live.load(), 0);
+    EXPECT_EQ(domain.PendingCount(), 0u);
+}
+
+TEST(EpochTest, DestructorFreesPending)
+{
+    g_live = 0;
+    {
+        EpochDomain domain;
+        EpochGuard guard(domain);
+        domain.Retire(new Tracked(3));
+        EXPECT_EQ(g_live.load(), 1);
+    }
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+TEST(EpochTest, ConcurrentReadersAndWriter)
+{
+    g_live = 0;
+    {
+        EpochDomain domain;
+        std::atomic<Tracked *> shared{new Tracked(0)};
+        std::atomic<bool> stop{false};
+        std::atomic<int> corrupted{0};
+
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 3; ++t) {
+            readers.emplace_back([&]() {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    EpochGuard guard(domain);
+                    Tracked *node = shared.load(std::memory_order_acquire);
+                    if (node->check != node->value) {
+                        corrupted.fetch_add(1);
+                    }
+                }
+            });
+        }
+
+        for (int i = 1; i <= 20000; ++i) {
+            Tracked *old = shared.exchange(new Tracked(i), std::memory_order_acq_rel);
+            domain.Retire(old);
+        }
+        stop = true;
+        for (auto &reader : readers) {
+            reader.join();
+        }
+
+        EXPECT_EQ(corrupted.load(), 0);
+        // Reclamation keeps up instead of letting the limbo list grow without bound
+        EXPECT_TRUE(domain.PendingCount() < 20000u);
+        delete shared.load();
+    }
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+TEST(RcuPtrTest, ReadStoreUpdate)
+{
+    RcuPtr<std::map<std::string, int>> routes(std::make_unique<std::map<std::string, int>>());
+    EXPECT_TRUE(routes.Read()->empty());
+
+    routes.Update([](std::map<std::string, int> &table) { table["a"] = 1; });
+    routes.Update([](std::map<std::string, int> &table) { table["b"] = 2; });
+    {
+        auto snapshot = routes.Read();
+        EXPECT_EQ(snapshot->size(), 2u);
+        EXPECT_EQ(snapshot->at("b"), 2);
+    }
+
+    auto table = std::make_unique<std::map<std::string, int>>();
+    (*table)["c"] = 3;
+    routes.Store(std::move(table));
+    EXPECT_EQ(routes.Load().count("a"), 0u);
+    EXPECT_EQ(routes.Load().at("c"), 3);
+}
+
+TEST(RcuPtrTest, SnapshotOutlivesUpdate)
+{
+    g_live = 0;
+    {
+        EpochDomain domain;
+        RcuPtr<Tracked> config(std::make_unique<Tracked>(1), domain);
+        auto snapshot = config.Read();
+        config.Update([](Tracked &copy) {
+            copy.value = 2;
+            copy.check = 2;
+        });
+        domain.Reclaim();
+        // The old value stays alive while we still read it
+        EXPECT_EQ(snapshot->value, 1);
+        EXPECT_EQ(snapshot->check, 1);
+        EXPECT_EQ(config.Read()->value, 2);
+    }
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+TEST(RcuPtrTest, EmptyPointer)
+{
+    RcuPtr<int> empty;
+    EXPECT_FALSE(static_cast<bool>(empty.Read()));
+    EXPECT_EQ(empty.Load(), 0);
+    empty.Update([](int &value) { value = 7; });
+    EXPECT_EQ(*empty.Read(), 7);
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,222 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/event_loop.h"
+#include "lmcore/sync.h"
+
+using namespace lmshao::lmcore;
+using namespace std::chrono_literals;
+
+TEST(EventLoopTest, PostFromManyThreads)
+{
+    EventLoop loop;
+    const int kThreads = 4;
+    const int kTasks = 2000;
+    int executed = 0; // loop thread only
+    bool wrongThread = false;
+
+    std::thread runner([&]() { EXPECT_EQ(loop.Run(), 0); });
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&]() {
+            for (int i = 0; i < kTasks; ++i) {
+                loop.Post([&]() {
+                    wrongThread |= !loop.IsInLoopThread();
+                    if (++executed == kThreads * kTasks) {
+                        loop.Stop();
+                    }
+                });
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    runner.join();
+    EXPECT_EQ(executed, kThreads * kTasks);
+    EXPECT_FALSE(wrongThread);
+    EXPECT_FALSE(loop.IsRunning());
+}
+
+TEST(EventLoopTest, TimersFireInOrder)
+{
+    EventLoop loop;
+    std::vector<int> order;
+    auto start = EventLoop::Clock::now();
+    loop.RunAt(start + 30ms, [&]() {
+        order.push_back(3);
+        loop.Stop();
+    });
+    loop.RunAfter(10ms, [&]() { order.push_back(1); });
+    loop.RunAt(start + 20ms, [&]() { order.push_back(2); });
+    EventLoop::TimerId cancelled = loop.RunAfter(15ms, [&]() { order.push_back(-1); });
+    loop.CancelTimer(cancelled);
+
+    EXPECT_EQ(loop.Run(), 0);
+    EXPECT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0], 1);
+    EXPECT_EQ(order[1], 2);
+    EXPECT_EQ(order[2], 3);
+    EXPECT_GE(std::chrono::duration_cast<std::chrono::milliseconds>(EventLoop::Clock::now() - start).count(), 30);
+}
+
+TEST(EventLoopTest, RepeatingTimerCancelsItself)
+{
+    EventLoop loop;
+    int ticks = 0;
+    EventLoop::TimerId id = 0;
+    id = loop.RunEvery(2ms, [&]() {
+        if (++ticks == 5) {
+            EXPECT_TRUE(loop.CancelTimer(id));
+            loop.RunAfter(10ms, [&]() { loop.Stop(); });
+        }
+    });
+    EXPECT_TRUE(id != 0);
+    EXPECT_EQ(loop.Run(), 0);
+    EXPECT_EQ(ticks, 5);
+}
+
+TEST(EventLoopTest, FdReadiness)
+{
+    int fds[2];
+    EXPECT_EQ(pipe(fds), 0);
+    EventLoop loop;
+    char received = 0;
+    EXPECT_EQ(loop.AddFd(fds[0], EventLoop::kReadable,
+                         [&](uint32_t events) {
+                             EXPECT_TRUE((events & EventLoop::kReadable) != 0);
+                             EXPECT_EQ(read(fds[0], &received, 1), 1);
+                             EXPECT_EQ(loop.RemoveFd(fds[0]), 0);
+                             loop.Stop();
+                         }),
+              0);
+    EXPECT_EQ(loop.AddFd(fds[0], EventLoop::kReadable, [](uint32_t) {}), -1);
+
+    std::thread writer([&]() {
+        std::this_thread::sleep_for(10ms);
+        EXPECT_EQ(write(fds[1], "x", 1), 1);
+    });
+    EXPECT_EQ(loop.Run(), 0);
+    writer.join();
+    EXPECT_EQ(received, 'x');
+    EXPECT_EQ(loop.GetSourceCount(), 0u);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(EventLoopTest, ChannelReceiver)
+{
+    using namespace lmshao::lmcore::sync;
+    EventLoop loop;
+    auto [tx, rx] = MpscChannel<int>(64);
+    const int kCount = 5000;
+    int64_t sum = 0;
+    int received = 0;
+    loop.AddReceiver(std::move(rx), [&](int value) {
+        sum += value;
+        if (++received == kCount) {
+            loop.Stop();
+        }
+    });
+    EXPECT_EQ(loop.GetSourceCount(), 1u);
+
+    std::thread producer([&, sender = std::move(tx)]() {
+        for (int i = 1; i <= kCount; ++i) {
+            sender->Send(i);
+        }
+    });
+    EXPECT_EQ(loop.Run(), 0);
+    producer.join();
+    EXPECT_EQ(sum, static_cast<int64_t>(kCount) * (kCount + 1) / 2);
+}
+
+TEST(EventLoopTest, ClosedReceiverIsDropped)
+{
+    using namespace lmshao::lmcore::sync;
+    EventLoop loop;
+    auto [tx, rx] = SpscChannel<int>(8);
+    tx->Send(1);
+    tx->Close();
+    int received = 0;
+    loop.AddReceiver(std::move(rx), [&](int) { ++received; });
+    loop.RunAfter(20ms, [&]() { loop.Stop(); });
+    EXPECT_EQ(loop.Run(), 0);
+    EXPECT_EQ(received, 1);
+    EXPECT_EQ(loop.GetSourceCount(), 0u);
+}
+
+TEST(EventLoopTest, NotifiedReceiverWakesLoop)
+{
+    using namespace lmshao::lmcore::sync;
+    EventLoop loop;
+    auto [tx, rx] = SpscChannel<int>(16, true);
+    EXPECT_TRUE(rx->GetNotifier() != nullptr);
+    const int kCount = 3000;
+    int received = 0;
+    int64_t sum = 0;
+    loop.AddReceiver(std::move(rx), [&](int value) {
+        sum += value;
+        ++received;
+    });
+    EXPECT_EQ(loop.GetSourceCount(), 1u);
+
+    std::atomic<bool> dropped{false};
+    std::thread producer([&, sender = std::move(tx)]() {
+        for (int i = 1; i <= kCount; ++i) {
+            sender->Send(i);
+            if (i % 500 == 0) {
+                // Let the loop go idle and arm the notifier again
+                std::this_thread::sleep_for(2ms);
+            }
+        }
+        sender->Close();
+    });
+    // The closed receiver is dropped, then we stop
+    loop.RunEvery(1ms, [&]() {
+        if (loop.GetSourceCount() == 1) {
+            dropped = true;
+            loop.Stop();
+        }
+    });
+    EXPECT_EQ(loop.Run(), 0);
+    producer.join();
+    EXPECT_TRUE(dropped.load());
+    EXPECT_EQ(received, kCount);
+    EXPECT_EQ(sum, static_cast<int64_t>(kCount) * (kCount + 1) / 2);
+}
+
+TEST(EventLoopTest, StopAndRestart)
+{
+    EventLoop loop;
+    std::thread runner([&]() { loop.Run(); });
+    while (!loop.IsRunning()) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(loop.Run(), -1);
+    loop.Stop();
+    runner.join();
+
+    // Cross-thread timers are posted and picked up on the next run
+    std::atomic<bool> fired{false};
+    loop.RunAfter(1ms, [&]() {
+        fired = true;
+        loop.Stop();
+    });
+    EXPECT_EQ(loop.Run(), 0);
+    EXPECT_TRUE(fired.load());
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,200 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lmcore/data_buffer.h>
+#include <lmcore/fast_cdc.h>
+#include <lmcore/mapped_file.h>
+#include <lmcore/thread_pool.h>
+#include <lmcore/xxhash64.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../test_framework.h"
+
+using namespace lmshao::lmcore;
+
+static std::vector<uint8_t> RandomData(size_t size, uint64_t seed)
+{
+    std::vector<uint8_t> data(size);
+    uint64_t state = seed;
+    for (auto &byte : data) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        byte = static_cast<uint8_t>(state >> 24);
+    }
+    return data;
+}
+
+/// Chunks are contiguous, within bounds and correctly fingerprinted
+static bool CheckChunks(const FastCdc &cdc, const std::vector<FastCdc::Chunk> &chunks, const uint8_t *data,
+                        size_t size)
+{
+    uint64_t offset = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const auto &chunk = chunks[i];
+        bool last = i + 1 == chunks.size();
+        if (chunk.offset != offset || chunk.length > cdc.GetMaxSize() || (!last && chunk.length < cdc.GetMinSize()) ||
+            chunk.fingerprint != XXHash64::Calculate(data + chunk.offset, chunk.length)) {
+            return false;
+        }
+        offset += chunk.length;
+    }
+    return offset == size;
+}
+
+static bool SameChunks(const std::vector<FastCdc::Chunk> &a, const std::vector<FastCdc::Chunk> &b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].offset != b[i].offset || a[i].length != b[i].length || a[i].fingerprint != b[i].fingerprint) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(FastCdc, Parameters)
+{
+    FastCdc cdc(1000, 5000, 100);
+    EXPECT_EQ(8192U, cdc.GetAvgSize()); // rounded up to a power of two
+    EXPECT_EQ(1000U, cdc.GetMinSize());
+    EXPECT_EQ(8192U, cdc.GetMaxSize()); // never below the average
+
+    FastCdc defaults;
+    EXPECT_EQ(FastCdc::kDefaultMinSize, defaults.GetMinSize());
+    EXPECT_EQ(FastCdc::kDefaultAvgSize, defaults.GetAvgSize());
+    EXPECT_EQ(FastCdc::kDefaultMaxSize, defaults.GetMaxSize());
+}
+
+TEST(FastCdc, SmallInputs)
+{
+    FastCdc cdc;
+    EXPECT_TRUE(cdc.Split(nullptr, 0).empty());
+
+    auto data = RandomData(100, 1);
+    auto chunks = cdc.Split(data.data(), data.size());
+    EXPECT_EQ(1U, chunks.size());
+    EXPECT_EQ(100U, chunks[0].length);
+    EXPECT_EQ(XXHash64::Calculate(data.data(), data.size()), chunks[0].fingerprint);
+}
+
+TEST(FastCdc, ChunkSizes)
+{
+    FastCdc cdc;
+    auto data = RandomData(4 * 1024 * 1024, 2);
+    auto chunks = cdc.Split(data.data(), data.size());
+    EXPECT_TRUE(CheckChunks(cdc, chunks, data.data(), data.size()));
+
+    // Normalized chunking keeps the average near the target
+    size_t average = data.size() / chunks.size();
+    EXPECT_GT(average, cdc.GetAvgSize() / 2);
+    EXPECT_GT(cdc.GetAvgSize() * 2, average);
+}
+
+TEST(FastCdc, MaxSizeOnUniformData)
+{
+    // Constant bytes never match the mask: every chunk is cut at the maximum
+    FastCdc cdc(1024, 4096, 16384);
+    std::vector<uint8_t> data(100000, 0);
+    auto chunks = cdc.Split(data.data(), data.size());
+    EXPECT_TRUE(CheckChunks(cdc, chunks, data.data(), data.size()));
+    EXPECT_EQ(7U, chunks.size());
+    EXPECT_EQ(16384U, chunks[0].length);
+    EXPECT_EQ(chunks[0].fingerprint, chunks[5].fingerprint);
+}
+
+TEST(FastCdc, BoundariesSurviveInsertion)
+{
+    FastCdc cdc;
+    auto data = RandomData(2 * 1024 * 1024, 3);
+    auto edited = data;
+    edited.insert(edited.begin() + 300000, 77, 0x5A);
+    edited.erase(edited.begin() + 1500000, edited.begin() + 1500100);
+
+    std::set<uint64_t> original;
+    for (const auto &chunk : cdc.Split(data.data(), data.size())) {
+        original.insert(chunk.fingerprint);
+    }
+    auto chunks = cdc.Split(edited.data(), edited.size());
+    size_t shared = 0;
+    for (const auto &chunk : chunks) {
+        shared += original.count(chunk.fingerprint);
+    }
+    // Only the chunks around the two edits change
+    EXPECT_GE(shared + 8, chunks.size());
+}
+
+TEST(FastCdc, StreamMatchesSplit)
+{
+    FastCdc cdc(1024, 4096, 16384);
+    auto data = RandomData(300000, 4);
+    auto expected = cdc.Split(data.data(), data.size());
+
+    bool same = true;
+    for (size_t step : {1000U, 4096U, 16384U, 65536U, 300000U}) {
+        std::vector<FastCdc::Chunk> chunks;
+        bool dataOk = true;
+        FastCdc::Stream stream(cdc, [&](const FastCdc::Chunk &chunk, const uint8_t *chunkData) {
+            dataOk = dataOk && XXHash64::Calculate(chunkData, chunk.length) == chunk.fingerprint;
+            chunks.push_back(chunk);
+        });
+        for (size_t offset = 0; offset < data.size(); offset += step) {
+            DataBuffer piece;
+            piece.Assign(data.data() + offset, std::min(step, data.size() - offset));
+            stream.Update(piece);
+        }
+        same = same && stream.GetOffset() + 16384 > data.size();
+        stream.Finish();
+        same = same && dataOk && SameChunks(expected, chunks) && stream.GetOffset() == 0;
+    }
+    EXPECT_TRUE(same);
+}
+
+TEST(FastCdc, ParallelMatchesSequential)
+{
+    FastCdc cdc;
+    // Three and a half segments, so that every segment edge is resynchronized
+    auto data = RandomData(FastCdc::kSegmentSize * 7 / 2, 5);
+    auto expected = cdc.Split(data.data(), data.size());
+
+    ThreadPool pool(4, 4, "cdc");
+    auto chunks = cdc.Split(data.data(), data.size(), &pool);
+    EXPECT_TRUE(CheckChunks(cdc, chunks, data.data(), data.size()));
+    EXPECT_TRUE(SameChunks(expected, chunks));
+}
+
+TEST(FastCdc, MappedFileOffsets)
+{
+    std::string path = "/tmp/lmcore_test_fast_cdc.bin";
+    auto data = RandomData(200000, 6);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+
+    FastCdc cdc;
+    auto file = MappedFile::Open(path, 65536, 100000);
+    EXPECT_TRUE(file != nullptr);
+    auto chunks = cdc.Split(*file);
+    auto expected = cdc.Split(data.data() + 65536, 100000);
+    EXPECT_EQ(expected.size(), chunks.size());
+    EXPECT_EQ(65536U, chunks[0].offset);
+    EXPECT_EQ(expected.back().offset + 65536, chunks.back().offset);
+    EXPECT_EQ(expected.back().fingerprint, chunks.back().fingerprint);
+    std::remove(path.c_str());
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,162 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../test_framework.h"
+#include "lmcore/flat_hash_map.h"
+
+using namespace lmshao::lmcore;
+
+TEST(FlatHashMapTest, InsertFindErase)
+{
+    FlatHashMap<int, std::string> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.find(1) == map.end());
+
+    EXPECT_TRUE(map.emplace(1, "one").second);
+    EXPECT_FALSE(map.emplace(1, "uno").second);
+    EXPECT_TRUE(map.try_emplace(2, "two").second);
+    map[3] = "three";
+    map.insert_or_assign(2, std::string("deux"));
+
+    EXPECT_EQ(3u, map.size());
+    EXPECT_EQ(std::string("one"), map.find(1)->second);
+    EXPECT_EQ(std::string("deux"), map[2]);
+    EXPECT_TRUE(map.contains(3));
+    EXPECT_EQ(1u, map.count(3));
+
+    EXPECT_EQ(1u, map.erase(2));
+    EXPECT_EQ(0u, map.erase(2));
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(2u, map.size());
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.find(1) == map.end());
+}
+
+TEST(FlatHashMapTest, MatchesUnorderedMap)
+{
+    FlatHashMap<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> reference;
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t key = rng() % 5000;
+        switch (rng() % 3) {
+            case 0:
+                map[key] = i;
+                reference[key] = i;
+                break;
+            case 1:
+                EXPECT_EQ(reference.erase(key), map.erase(key));
+                break;
+            default: {
+                auto it = map.find(key);
+                auto ref = reference.find(key);
+                EXPECT_EQ(ref == reference.end(), it == map.end());
+                if (ref != reference.end()) {
+                    EXPECT_EQ(ref->second, it->second);
+                }
+            }
+        }
+    }
+    EXPECT_EQ(reference.size(), map.size());
+
+    size_t visited = 0;
+    for (const auto &entry : map) {
+        EXPECT_EQ(reference[entry.first], entry.second);
+        ++visited;
+    }
+    EXPECT_EQ(reference.size(), visited);
+}
+
+TEST(FlatHashMapTest, ChurnDoesNotGrow)
+{
+    // Erased slots are reused: a steady insert/erase pattern must not keep growing the table
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < 100; ++i) {
+        map[i] = i;
+    }
+    size_t capacity = map.capacity();
+    for (int i = 100; i < 100000; ++i) {
+        map.erase(i - 100);
+        map[i] = i;
+    }
+    EXPECT_EQ(100u, map.size());
+    EXPECT_TRUE(map.capacity() <= capacity * 2);
+}
+
+TEST(FlatHashMapTest, HeterogeneousStringLookup)
+{
+    FlatHashMap<std::string, int> map{{"alpha", 1}, {"beta", 2}};
+    std::string_view key = "alpha";
+    EXPECT_EQ(1, map.find(key)->second);
+    EXPECT_TRUE(map.contains("beta"));
+    EXPECT_FALSE(map.contains(std::string_view("gamma")));
+    EXPECT_EQ(1u, map.erase(std::string_view("beta")));
+    EXPECT_EQ(1u, map.size());
+}
+
+TEST(FlatHashMapTest, MoveOnlyValuesAndRehash)
+{
+    FlatHashMap<std::string, std::unique_ptr<int>> map;
+    for (int i = 0; i < 1000; ++i) {
+        map.try_emplace("key" + std::to_string(i), std::make_unique<int>(i));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        auto it = map.find("key" + std::to_string(i));
+        EXPECT_TRUE(it != map.end());
+        EXPECT_EQ(i, *it->second);
+    }
+
+    FlatHashMap<std::string, std::unique_ptr<int>> moved(std::move(map));
+    EXPECT_EQ(1000u, moved.size());
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains("key1"));
+}
+
+TEST(FlatHashMapTest, CopyAndEraseWhileIterating)
+{
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = i * i;
+    }
+    FlatHashMap<int, int> copy = map;
+    for (auto it = copy.begin(); it != copy.end();) {
+        it = it->first % 2 ? copy.erase(it) : ++it;
+    }
+    EXPECT_EQ(500u, copy.size());
+    EXPECT_EQ(1000u, map.size());
+    EXPECT_EQ(81, map[9]);
+    EXPECT_FALSE(copy.contains(9));
+}
+
+TEST(FlatHashSetTest, Basic)
+{
+    FlatHashSet<std::string> set{"a", "b"};
+    EXPECT_TRUE(set.insert("c").second);
+    EXPECT_FALSE(set.insert(std::string("a")).second);
+    EXPECT_EQ(3u, set.size());
+    EXPECT_TRUE(set.contains(std::string_view("b")));
+    EXPECT_EQ(1u, set.erase("a"));
+    EXPECT_EQ(0u, set.count("a"));
+
+    size_t visited = 0;
+    for (const auto &value : set) {
+        EXPECT_TRUE(value == "b" || value == "c");
+        ++visited;
+    }
+    EXPECT_EQ(2u, visited);
+}
+
+RUN_ALL_TESTS()
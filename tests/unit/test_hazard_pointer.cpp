@@ -0,0 +1,131 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/hazard_pointer.h"
+
+using namespace lmshao::lmcore;
+
+namespace {
+std::atomic<int> g_live{0};
+
+struct Tracked {
+    explicit Tracked(int v = 0) : value(v), check(v) { g_live.fetch_add(1); }
+    ~Tracked()
+    {
+        check = -1;
+        g_live.fetch_sub(1);
+    }
+    int value;
+    int check;
+};
+} // namespace
+
+TEST(HazardPointerTest, ProtectedObjectIsKept)
+{
+    g_live = 0;
+    HazardDomain domain;
+    std::atomic<Tracked *> shared{new Tracked(1)};
+
+    HazardGuard guard(domain);
+    Tracked *node = guard.Protect(shared);
+    domain.Retire(shared.exchange(new Tracked(2)));
+    domain.Reclaim();
+    EXPECT_EQ(g_live.load(), 2);
+    EXPECT_EQ(node->check, 1);
+
+    guard.Reset();
+    EXPECT_EQ(domain.Reclaim(), 1u);
+    EXPECT_EQ(g_live.load(), 1);
+    delete shared.load();
+}
+
+TEST(HazardPointerTest, ManyGuardsPerThread)
+{
+    g_live = 0;
+    HazardDomain domain;
+    const int kCount = 10;
+    std::vector<std::atomic<Tracked *>> shared(kCount);
+    std::vector<std::unique_ptr<HazardGuard>> guards;
+    for (int i = 0; i < kCount; ++i) {
+        shared[i] = new Tracked(i);
+        guards.push_back(std::make_unique<HazardGuard>(domain));
+        guards.back()->Protect(shared[i]);
+    }
+    for (int i = 0; i < kCount; ++i) {
+        domain.Retire(shared[i].exchange(nullptr));
+    }
+    domain.Reclaim();
+    EXPECT_EQ(g_live.load(), kCount);
+
+    guards.clear();
+    domain.Reclaim();
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+TEST(HazardPointerTest, ObjectsOfExitedThreadsAreReclaimed)
+{
+    g_live = 0;
+    HazardDomain domain;
+    std::thread worker([&]() {
+        for (int i = 0; i < 10; ++i) {
+            domain.Retire(new Tracked(i));
+        }
+    });
+    worker.join();
+    EXPECT_EQ(domain.PendingCount(), 10u);
+    EXPECT_EQ(domain.Reclaim(), 10u);
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+TEST(HazardPointerTest, ConcurrentReadersAndWriter)
+{
+    g_live = 0;
+    {
+        HazardDomain domain;
+        std::atomic<Tracked *> shared{new Tracked(0)};
+        std::atomic<bool> stop{false};
+        std::atomic<int> corrupted{0};
+
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 3; ++t) {
+            readers.emplace_back([&]() {
+                HazardGuard guard(domain);
+                while (!stop.load(std::memory_order_relaxed)) {
+                    Tracked *node = guard.Protect(shared);
+                    if (node->check != node->value) {
+                        corrupted.fetch_add(1);
+                    }
+                    guard.Reset();
+                }
+            });
+        }
+
+        for (int i = 1; i <= 20000; ++i) {
+            domain.Retire(shared.exchange(new Tracked(i), std::memory_order_acq_rel));
+        }
+        stop = true;
+        for (auto &reader : readers) {
+            reader.join();
+        }
+
+        EXPECT_EQ(corrupted.load(), 0);
+        // At most one object per hazard slot can stay pinned after a scan
+        domain.Reclaim();
+        EXPECT_EQ(domain.PendingCount(), 0u);
+        delete shared.load();
+    }
+    EXPECT_EQ(g_live.load(), 0);
+}
+
+RUN_ALL_TESTS()
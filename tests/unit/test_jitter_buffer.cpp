@@ -0,0 +1,174 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/data_buffer.h"
+#include "lmcore/jitter_buffer.h"
+#include "lmcore/object_pool.h"
+
+using namespace lmshao::lmcore;
+using Clock = JitterBuffer::Clock;
+using std::chrono::milliseconds;
+
+namespace {
+// 90 kHz clock: 20 ms per packet
+constexpr uint32_t kTicksPerPacket = 1800;
+
+std::shared_ptr<DataBuffer> Payload(uint16_t seq)
+{
+    auto buffer = std::make_shared<DataBuffer>(2);
+    buffer->Assign(seq);
+    return buffer;
+}
+} // namespace
+
+TEST(JitterBufferTest, ReordersPackets)
+{
+    JitterBuffer jitter(64, 90000, milliseconds(0));
+    Clock::time_point t0 = Clock::now();
+    const uint16_t order[] = {0, 2, 1, 4, 3};
+    for (uint16_t seq : order) {
+        EXPECT_TRUE(jitter.Insert(seq, seq * kTicksPerPacket, Payload(seq), false, t0) ==
+                    JitterBuffer::InsertResult::kInserted);
+    }
+    EXPECT_EQ(5u, jitter.GetSize());
+
+    Clock::time_point late = t0 + milliseconds(1000);
+    for (uint16_t expected = 0; expected < 5; ++expected) {
+        auto packet = jitter.Pop(late);
+        EXPECT_TRUE(packet.has_value());
+        EXPECT_EQ(expected, packet->seq);
+        EXPECT_EQ(expected * kTicksPerPacket, packet->timestamp);
+    }
+    EXPECT_FALSE(jitter.Pop(late).has_value());
+}
+
+TEST(JitterBufferTest, DuplicateAndLate)
+{
+    JitterBuffer jitter(64, 90000, milliseconds(0));
+    Clock::time_point t0 = Clock::now();
+    jitter.Insert(10, 0, Payload(10), false, t0);
+    EXPECT_TRUE(jitter.Insert(10, 0, Payload(10), false, t0) == JitterBuffer::InsertResult::kDuplicate);
+    EXPECT_TRUE(jitter.Pop(t0 + milliseconds(1)).has_value());
+    EXPECT_TRUE(jitter.Insert(10, 0, Payload(10), false, t0) == JitterBuffer::InsertResult::kLate);
+    EXPECT_TRUE(jitter.Insert(9, 0, Payload(9), false, t0) == JitterBuffer::InsertResult::kLate);
+    EXPECT_EQ(1u, jitter.GetStats().duplicates);
+    EXPECT_EQ(2u, jitter.GetStats().late);
+}
+
+TEST(JitterBufferTest, SequenceAndTimestampWraparound)
+{
+    JitterBuffer jitter(64, 90000, milliseconds(0));
+    Clock::time_point t0 = Clock::now();
+    uint32_t ts = 0xFFFFFFFFu - kTicksPerPacket * 2;
+    uint16_t seq = 65533;
+    for (int i = 0; i < 8; ++i) {
+        jitter.Insert(static_cast<uint16_t>(seq + i), ts + i * kTicksPerPacket, Payload(0), false, t0);
+    }
+    for (int i = 0; i < 8; ++i) {
+        auto packet = jitter.Pop(t0 + milliseconds(1000));
+        EXPECT_TRUE(packet.has_value());
+        EXPECT_EQ(static_cast<uint16_t>(seq + i), packet->seq);
+    }
+    EXPECT_EQ(0u, jitter.GetStats().lost);
+}
+
+TEST(JitterBufferTest, PlayoutDeadline)
+{
+    JitterBuffer jitter(64, 90000, milliseconds(50));
+    Clock::time_point t0 = Clock::now();
+    jitter.Insert(0, 0, Payload(0), false, t0);
+    jitter.Insert(1, kTicksPerPacket, Payload(1), false, t0 + milliseconds(20));
+
+    EXPECT_TRUE(*jitter.GetNextPlayoutTime() == t0 + milliseconds(50));
+    EXPECT_FALSE(jitter.Pop(t0 + milliseconds(49)).has_value());
+    EXPECT_EQ(0, jitter.Pop(t0 + milliseconds(50))->seq);
+    // The second packet plays 20 ms of media later
+    EXPECT_FALSE(jitter.Pop(t0 + milliseconds(69)).has_value());
+    EXPECT_EQ(1, jitter.Pop(t0 + milliseconds(70))->seq);
+}
+
+TEST(JitterBufferTest, LossIsSkippedWhenLaterPacketIsDue)
+{
+    JitterBuffer jitter(64, 90000, milliseconds(40));
+    Clock::time_point t0 = Clock::now();
+    jitter.Insert(0, 0, Payload(0), false, t0);
+    jitter.Insert(2, 2 * kTicksPerPacket, Payload(2), false, t0 + milliseconds(40));
+    EXPECT_EQ(0, jitter.Pop(t0 + milliseconds(40))->seq);
+
+    // Packet 1 is missing: nothing plays until packet 2 is due
+    EXPECT_FALSE(jitter.Pop(t0 + milliseconds(79)).has_value());
+    EXPECT_EQ(2, jitter.Pop(t0 + milliseconds(80))->seq);
+    EXPECT_EQ(1u, jitter.GetStats().lost);
+
+    // A retransmission arriving afterwards is late
+    EXPECT_TRUE(jitter.Insert(1, kTicksPerPacket, Payload(1), false, t0 + milliseconds(81)) ==
+                JitterBuffer::InsertResult::kLate);
+}
+
+TEST(JitterBufferTest, NackList)
+{
+    JitterBuffer jitter(64, 90000, milliseconds(100), milliseconds(20));
+    Clock::time_point t0 = Clock::now();
+    jitter.Insert(100, 0, Payload(0), false, t0);
+    jitter.Insert(103, 3 * kTicksPerPacket, Payload(0), false, t0);
+
+    std::vector<uint16_t> nacks;
+    EXPECT_EQ(2u, jitter.GetNackList(nacks, t0));
+    EXPECT_EQ(101, nacks[0]);
+    EXPECT_EQ(102, nacks[1]);
+
+    // Not repeated before the interval, then retried a bounded number of times
+    nacks.clear();
+    EXPECT_EQ(0u, jitter.GetNackList(nacks, t0 + milliseconds(10)));
+    jitter.Insert(101, kTicksPerPacket, Payload(0), false, t0 + milliseconds(15));
+    EXPECT_EQ(1u, jitter.GetNackList(nacks, t0 + milliseconds(20)));
+    EXPECT_EQ(102, nacks[0]);
+    EXPECT_EQ(1u, jitter.GetNackList(nacks, t0 + milliseconds(40)));
+    EXPECT_EQ(0u, jitter.GetNackList(nacks, t0 + milliseconds(60)));
+    EXPECT_EQ(4u, jitter.GetStats().nacks);
+}
+
+TEST(JitterBufferTest, OverflowDropsOldestAndPooledBuffersReturn)
+{
+    DataBufferPool pool(64, 32);
+    {
+        JitterBuffer jitter(8, 90000, milliseconds(1000));
+        Clock::time_point t0 = Clock::now();
+        std::vector<std::shared_ptr<DataBuffer>> buffers;
+        for (int i = 0; i < 12; ++i) {
+            buffers.push_back(pool.Acquire(64));
+        }
+        for (uint16_t seq = 0; seq < 12; ++seq) {
+            jitter.Insert(seq, seq * kTicksPerPacket, std::move(buffers[seq]), false, t0);
+        }
+        EXPECT_EQ(8u, jitter.GetSize());
+        EXPECT_EQ(4u, jitter.GetStats().dropped);
+        EXPECT_EQ(4u, pool.GetPoolSize());
+        EXPECT_EQ(4, jitter.Pop(t0 + milliseconds(5000))->seq);
+
+        // A jump beyond the ring restarts the stream
+        jitter.Insert(30000, 0, pool.Acquire(64), false, t0);
+        EXPECT_EQ(1u, jitter.GetSize());
+        EXPECT_EQ(30000, jitter.Pop(t0 + milliseconds(5000))->seq);
+
+        // So does one backwards, instead of the new stream being late until it catches up
+        EXPECT_TRUE(jitter.Insert(20000, 0, pool.Acquire(64), false, t0) == JitterBuffer::InsertResult::kInserted);
+        EXPECT_TRUE(jitter.Insert(20001, kTicksPerPacket, pool.Acquire(64), false, t0) ==
+                    JitterBuffer::InsertResult::kInserted);
+        EXPECT_EQ(20000, jitter.Pop(t0 + milliseconds(5000))->seq);
+        EXPECT_EQ(0u, jitter.GetStats().late);
+    }
+    EXPECT_EQ(12u, pool.GetPoolSize());
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,163 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/latency_histogram.h"
+
+using namespace lmshao::lmcore;
+
+TEST(LatencyHistogramTest, EmptyHistogram)
+{
+    LatencyHistogram hist;
+    auto snapshot = hist.GetSnapshot();
+    EXPECT_EQ(snapshot.Count(), 0);
+    EXPECT_EQ(snapshot.Min(), 0);
+    EXPECT_EQ(snapshot.Max(), 0);
+    EXPECT_EQ(snapshot.Percentile(99.0), 0);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+    LatencyHistogram hist;
+    for (uint64_t i = 0; i < LatencyHistogram::kSubBucketCount; ++i) {
+        EXPECT_EQ(LatencyHistogram::BucketIndex(i), i);
+        EXPECT_EQ(LatencyHistogram::BucketLowerBound(i), i);
+        EXPECT_EQ(LatencyHistogram::BucketUpperBound(i), i);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketBoundsContainValue)
+{
+    const uint64_t values[] = {32, 33, 63, 64, 65, 1000, 123456, 1ULL << 40, (1ULL << 40) + 12345, UINT64_MAX};
+    for (uint64_t v : values) {
+        size_t index = LatencyHistogram::BucketIndex(v);
+        EXPECT_TRUE(index < LatencyHistogram::kBucketCount);
+        EXPECT_TRUE(LatencyHistogram::BucketLowerBound(index) <= v);
+        EXPECT_TRUE(LatencyHistogram::BucketUpperBound(index) >= v);
+    }
+    EXPECT_EQ(LatencyHistogram::BucketIndex(UINT64_MAX), LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinRelativeError)
+{
+    LatencyHistogram hist;
+    for (uint64_t i = 1; i <= 10000; ++i) {
+        hist.Record(i * 1000);
+    }
+
+    auto snapshot = hist.GetSnapshot();
+    EXPECT_EQ(snapshot.Count(), 10000);
+    EXPECT_EQ(snapshot.Min(), 1000);
+    EXPECT_EQ(snapshot.Max(), 10000000);
+
+    const double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+    for (double p : percentiles) {
+        double expected = p / 100.0 * 10000000.0;
+        double actual = static_cast<double>(snapshot.Percentile(p));
+        double error = (actual - expected) / expected;
+        EXPECT_TRUE(error > -0.04 && error < 0.04);
+    }
+    EXPECT_EQ(snapshot.Percentile(100.0), 10000000);
+    EXPECT_EQ(snapshot.Percentile(0.0), 1000);
+}
+
+TEST(LatencyHistogramTest, RecordDuration)
+{
+    LatencyHistogram hist;
+    hist.RecordDuration(std::chrono::microseconds(5));
+    hist.RecordDuration(std::chrono::nanoseconds(-5));
+    auto snapshot = hist.GetSnapshot();
+    EXPECT_EQ(snapshot.Count(), 2);
+    EXPECT_EQ(snapshot.Min(), 0);
+    EXPECT_EQ(snapshot.Max(), 5000);
+    EXPECT_EQ(snapshot.Sum(), 5000);
+}
+
+TEST(LatencyHistogramTest, MergeAndReset)
+{
+    LatencyHistogram a;
+    LatencyHistogram b(1);
+    a.Record(10, 3);
+    b.Record(1000);
+    b.Record(5);
+
+    a.Merge(b);
+    auto snapshot = a.GetSnapshot();
+    EXPECT_EQ(snapshot.Count(), 5);
+    EXPECT_EQ(snapshot.Sum(), 1035);
+    EXPECT_EQ(snapshot.Min(), 5);
+    EXPECT_EQ(snapshot.Max(), 1000);
+
+    auto other = b.GetSnapshot();
+    other.Merge(snapshot);
+    EXPECT_EQ(other.Count(), 7);
+
+    a.Reset();
+    EXPECT_EQ(a.Count(), 0);
+    EXPECT_EQ(a.GetSnapshot().Max(), 0);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecording)
+{
+    LatencyHistogram hist(4);
+    EXPECT_EQ(hist.ShardCount(), 4);
+
+    const int numThreads = 4;
+    const int perThread = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&hist, t]() {
+            for (int i = 0; i < perThread; ++i) {
+                hist.Record(static_cast<uint64_t>(t * perThread + i));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    auto snapshot = hist.GetSnapshot();
+    EXPECT_EQ(snapshot.Count(), numThreads * perThread);
+    EXPECT_EQ(snapshot.Min(), 0);
+    EXPECT_EQ(snapshot.Max(), numThreads * perThread - 1);
+}
+
+TEST(LatencyHistogramTest, ExportFormats)
+{
+    LatencyHistogram hist;
+    hist.Record(10);
+    hist.Record(20);
+    auto snapshot = hist.GetSnapshot();
+
+    std::string text = snapshot.ToText();
+    EXPECT_TRUE(text.find("count=2") != std::string::npos);
+    EXPECT_TRUE(text.find("max=20") != std::string::npos);
+
+    std::string json = snapshot.ToJson();
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_TRUE(json.find("\"count\":2") != std::string::npos);
+    EXPECT_TRUE(json.find("\"p99\":20") != std::string::npos);
+
+    std::string prom = snapshot.ToPrometheus("rpc_latency_ns", "method=\"get\"");
+    EXPECT_TRUE(prom.find("# TYPE rpc_latency_ns summary\n") == 0);
+    EXPECT_TRUE(prom.find("rpc_latency_ns{method=\"get\",quantile=\"0.5\"} 10\n") != std::string::npos);
+    EXPECT_TRUE(prom.find("rpc_latency_ns_sum{method=\"get\"} 30\n") != std::string::npos);
+    EXPECT_TRUE(prom.find("rpc_latency_ns_count{method=\"get\"} 2\n") != std::string::npos);
+
+    std::string bare = snapshot.ToPrometheus("bare");
+    EXPECT_TRUE(bare.find("bare{quantile=\"0.9\"} 20\n") != std::string::npos);
+    EXPECT_TRUE(bare.find("bare_count 2\n") != std::string::npos);
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,217 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lmcore/line_scanner.h>
+#include <lmcore/mapped_file.h>
+#include <lmcore/thread_pool.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../test_framework.h"
+
+using namespace lmshao::lmcore;
+
+static std::vector<std::string> Lines(std::string_view text, bool csv = false)
+{
+    std::vector<std::string> lines;
+    LineScanner::ForEachLine(text, [&](std::string_view line) { lines.emplace_back(line); }, csv);
+    return lines;
+}
+
+/// Byte-by-byte reference, quote-aware in CSV mode
+static std::vector<std::string> NaiveLines(const std::string &text, bool csv)
+{
+    std::vector<std::string> lines;
+    std::string line;
+    bool inQuotes = false;
+    for (char c : text) {
+        if (csv && c == '"') {
+            inQuotes = !inQuotes;
+        }
+        if (c == '\n' && !inQuotes) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            lines.push_back(line);
+            line.clear();
+        } else {
+            line.push_back(c);
+        }
+    }
+    if (!line.empty()) {
+        if (line.back() == '\r') {
+            line.pop_back();
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+/// CSV with lines of varied length, quoted fields, doubled quotes and quoted newlines
+static std::string MakeCsv(size_t records)
+{
+    std::string text;
+    uint32_t state = 12345;
+    for (size_t i = 0; i < records; ++i) {
+        state = state * 1103515245 + 12345;
+        text += std::to_string(i) + ",";
+        switch ((state >> 16) % 4) {
+            case 0:
+                text += "\"multi\nline, field\"";
+                break;
+            case 1:
+                text += "\"say \"\"hi\"\"\"";
+                break;
+            default:
+                text += std::string((state >> 8) % 150, 'x');
+                break;
+        }
+        text += (state & 1) ? "\r\n" : "\n";
+    }
+    return text;
+}
+
+TEST(LineScanner, BasicLines)
+{
+    auto lines = Lines("a\nbb\r\n\nccc");
+    EXPECT_EQ(4U, lines.size());
+    EXPECT_EQ("a", lines[0]);
+    EXPECT_EQ("bb", lines[1]);
+    EXPECT_EQ("", lines[2]);
+    EXPECT_EQ("ccc", lines[3]);
+
+    EXPECT_EQ(1U, Lines("only\n").size());
+    EXPECT_TRUE(Lines("").empty());
+}
+
+TEST(LineScanner, MatchesNaiveAcrossWindows)
+{
+    // Newlines at every distance from the 64-byte words and 4 KiB windows
+    std::string text;
+    for (size_t i = 0; i < 3000; ++i) {
+        text += std::string(i % 131, static_cast<char>('a' + i % 26));
+        text += (i % 7 == 0) ? "\r\n" : "\n";
+    }
+    text += "tail";
+    EXPECT_TRUE(Lines(text) == NaiveLines(text, false));
+}
+
+TEST(LineScanner, CsvQuotedNewlines)
+{
+    std::string text = "id,note\n1,\"two\nlines\"\n2,plain\n";
+    auto lines = Lines(text, true);
+    EXPECT_EQ(3U, lines.size());
+    EXPECT_EQ("1,\"two\nlines\"", lines[1]);
+    EXPECT_EQ(4U, Lines(text, false).size());
+
+    std::string csv = MakeCsv(5000);
+    EXPECT_TRUE(Lines(csv, true) == NaiveLines(csv, true));
+}
+
+TEST(LineScanner, PartitionSnapsToNewlines)
+{
+    std::string text = MakeCsv(20000);
+    LineScanner::Options options;
+    options.partSize = 10000;
+    auto parts = LineScanner::Partition(text, options);
+    EXPECT_GT(parts.size(), text.size() / options.partSize / 2);
+
+    bool ok = true;
+    size_t offset = 0;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        ok = ok && parts[i].data() == text.data() + offset && !parts[i].empty();
+        ok = ok && (i + 1 == parts.size() || parts[i].back() == '\n');
+        offset += parts[i].size();
+    }
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(text.size(), offset);
+}
+
+TEST(LineScanner, ParallelCsvMatchesSequential)
+{
+    std::string text = MakeCsv(20000);
+    ThreadPool pool(4, 4, "scan");
+    for (bool csv : {false, true}) {
+        LineScanner::Options options;
+        options.csv = csv;
+        options.partSize = 7000;
+
+        std::mutex mutex;
+        std::vector<std::pair<size_t, std::string>> lines;
+        size_t parts = LineScanner::ParallelForEachLine(
+            text, pool,
+            [&](size_t part, std::string_view line) {
+                std::lock_guard<std::mutex> lock(mutex);
+                lines.emplace_back(part, std::string(line));
+            },
+            options);
+        EXPECT_GT(parts, 10U);
+
+        // Lines of a part arrive in order, so a stable sort by part restores the file order
+        std::stable_sort(lines.begin(), lines.end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+        std::vector<std::string> ordered;
+        for (auto &line : lines) {
+            ordered.push_back(std::move(line.second));
+        }
+        EXPECT_TRUE(ordered == NaiveLines(text, csv));
+    }
+}
+
+TEST(LineScanner, SplitFields)
+{
+    std::vector<std::string_view> fields;
+    LineScanner::SplitFields("a,\"b,c\",,\"say \"\"hi\"\"\",", fields);
+    EXPECT_EQ(5U, fields.size());
+    EXPECT_EQ("a", std::string(fields[0]));
+    EXPECT_EQ("b,c", std::string(fields[1]));
+    EXPECT_EQ("", std::string(fields[2]));
+    EXPECT_EQ("say \"\"hi\"\"", std::string(fields[3]));
+    EXPECT_EQ("say \"hi\"", LineScanner::UnescapeField(fields[3]));
+    EXPECT_EQ("", std::string(fields[4]));
+
+    LineScanner::SplitFields("x\ty", fields, '\t');
+    EXPECT_EQ(2U, fields.size());
+    EXPECT_EQ("y", std::string(fields[1]));
+}
+
+TEST(LineScanner, MappedFile)
+{
+    std::string path = "/tmp/lmcore_test_line_scanner.txt";
+    std::string text = MakeCsv(3000);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << text;
+    }
+    auto file = MappedFile::Open(path);
+    EXPECT_TRUE(file != nullptr);
+
+    ThreadPool pool(2, 2, "scan");
+    std::mutex mutex;
+    size_t count = 0;
+    LineScanner::Options options;
+    options.csv = true;
+    options.partSize = 4096;
+    LineScanner::ParallelForEachLine(
+        *file, pool,
+        [&](size_t, std::string_view) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++count;
+        },
+        options);
+    EXPECT_EQ(3000U, count);
+    std::remove(path.c_str());
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,49 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "../test_framework.h"
+#include "lmcore/logger.h"
+
+using namespace lmshao::lmcore;
+
+namespace {
+struct RegistryTestModule {};
+struct UnregisteredModule {};
+} // namespace
+
+TEST(LoggerRegistryTest, PublishedModuleNames)
+{
+    EXPECT_EQ(LoggerRegistry::GetModuleName<UnregisteredModule>(), std::string("Unknown"));
+
+    LoggerRegistry::RegisterModule<RegistryTestModule>("First");
+    EXPECT_EQ(LoggerRegistry::GetModuleName<RegistryTestModule>(), std::string("First"));
+
+    // Readers racing with re-registration always see one complete name
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad{0};
+    std::thread reader([&]() {
+        while (!stop.load()) {
+            std::string name = LoggerRegistry::GetModuleName<RegistryTestModule>();
+            if (name != "First" && name != "Second") {
+                bad.fetch_add(1);
+            }
+        }
+    });
+    for (int i = 0; i < 1000; ++i) {
+        LoggerRegistry::RegisterModule<RegistryTestModule>((i % 2) ? "First" : "Second");
+    }
+    stop = true;
+    reader.join();
+    EXPECT_EQ(bad.load(), 0);
+}
+
+RUN_ALL_TESTS()
@@ -256,4 +256,61 @@ TEST(MappedFile, H264SimulatedData)
     DeleteTestFile(test_file);
 }
 
+TEST(MappedFile, WritableMapping)
+{
+    const std::string test_file = "test_mapped_file_writable.bin";
+    DeleteTestFile(test_file);
+
+    {
+        auto file = MappedFile::OpenWritable(test_file, 100);
+        EXPECT_TRUE(file != nullptr);
+        EXPECT_TRUE(file->IsWritable());
+        EXPECT_EQ(100U, file->Size());
+        EXPECT_EQ(0, file->Data()[99]); // New space is zero-filled
+        std::memcpy(file->MutableData() + 10, "persist", 7);
+        EXPECT_EQ(0, file->Flush(10, 7));
+    }
+
+    auto file = MappedFile::Open(test_file);
+    EXPECT_TRUE(file != nullptr);
+    EXPECT_FALSE(file->IsWritable());
+    EXPECT_TRUE(file->MutableData() == nullptr);
+    EXPECT_EQ(0, std::memcmp(file->Data() + 10, "persist", 7));
+    EXPECT_EQ(-1, file->Flush());
+
+    // An existing file is mapped whole, never shrunk
+    EXPECT_EQ(100U, MappedFile::OpenWritable(test_file, 10)->Size());
+
+    DeleteTestFile(test_file);
+}
+
+TEST(MappedFile, RangedMapping)
+{
+    const std::string test_file = "test_mapped_file_ranged.bin";
+    std::string content(3 * 4096 + 100, '\0');
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i * 13);
+    }
+    CreateTestFile(test_file, content);
+
+    // Unaligned offset in the middle of a page
+    auto file = MappedFile::Open(test_file, 5000, 3000);
+    EXPECT_TRUE(file != nullptr);
+    EXPECT_EQ(3000U, file->Size());
+    EXPECT_EQ(5000U, file->Offset());
+    EXPECT_EQ(content.size(), file->FileSize());
+    EXPECT_EQ(0, std::memcmp(file->Data(), content.data() + 5000, 3000));
+
+    // Clipped at the end of the file
+    auto tail = MappedFile::Open(test_file, content.size() - 10, 4096);
+    EXPECT_TRUE(tail != nullptr);
+    EXPECT_EQ(10U, tail->Size());
+    EXPECT_EQ(0, std::memcmp(tail->Data(), content.data() + content.size() - 10, 10));
+
+    EXPECT_TRUE(MappedFile::Open(test_file, content.size(), 1) == nullptr);
+    EXPECT_EQ(content.size(), MappedFile::Open(test_file)->FileSize());
+
+    DeleteTestFile(test_file);
+}
+
 RUN_ALL_TESTS()
@@ -8,7 +8,9 @@
 
 #include <lmcore/md5.h>
 
+#include <algorithm>
 #include <fstream>
+#include <string>
 
 #include "../test_framework.h"
 
@@ -153,4 +155,23 @@ TEST(MD5, OutputFormat)
     }
 }
 
+TEST(MD5, IncrementalContext)
+{
+    std::string data;
+    for (int i = 0; i < 1000; i++) {
+        data += std::to_string(i);
+    }
+    MD5::Context ctx;
+    for (size_t offset = 0; offset < data.size(); offset += 37) {
+        size_t len = std::min<size_t>(37, data.size() - offset);
+        ctx.Update(reinterpret_cast<const uint8_t *>(data.data()) + offset, len);
+    }
+    EXPECT_EQ(MD5::Calculate(data), ctx.Final());
+    // Final() does not disturb the state
+    EXPECT_EQ(MD5::Calculate(data), ctx.Final());
+
+    ctx.Reset();
+    EXPECT_EQ(std::string("d41d8cd98f00b204e9800998ecf8427e"), ctx.Final());
+}
+
 RUN_ALL_TESTS()
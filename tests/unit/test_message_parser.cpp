@@ -0,0 +1,227 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lmcore/data_buffer.h>
+#include <lmcore/message_parser.h>
+
+#include <string>
+#include <vector>
+
+#include "../alloc_counter.h"
+#include "../test_framework.h"
+
+using namespace lmshao::lmcore;
+
+using Event = MessageParser::Event;
+
+static void Feed(MessageParser &parser, const std::string &data)
+{
+    parser.Feed(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+}
+
+/// Feed `data` in pieces of `step` bytes and record the events, with bodies concatenated
+static std::string Collect(MessageParser &parser, const std::string &data, size_t step)
+{
+    std::string trace;
+    for (size_t offset = 0; offset < data.size(); offset += step) {
+        Feed(parser, data.substr(offset, step));
+        for (Event event = parser.Next(); event != Event::kNeedMore; event = parser.Next()) {
+            if (event == Event::kHead) {
+                trace += "[" + std::string(parser.GetStartLine()) + "]";
+            } else if (event == Event::kBody) {
+                trace += std::string(parser.GetBody());
+            } else if (event == Event::kEnd) {
+                trace += "|";
+            } else if (event == Event::kInterleaved) {
+                trace += "$" + std::to_string(parser.GetChannel()) + ":" + std::string(parser.GetBody()) + "|";
+            } else {
+                return trace + "error: " + parser.GetError();
+            }
+        }
+    }
+    return trace;
+}
+
+TEST(MessageParser, RtspRequest)
+{
+    MessageParser parser;
+    Feed(parser, "OPTIONS rtsp://example.com/live RTSP/1.0\r\nCSeq: 2\r\nUser-Agent:  lmcore \r\n\r\n");
+    EXPECT_TRUE(parser.Next() == Event::kHead);
+    EXPECT_TRUE(parser.IsRequest());
+    EXPECT_EQ("OPTIONS", std::string(parser.GetMethod()));
+    EXPECT_EQ("rtsp://example.com/live", std::string(parser.GetTarget()));
+    EXPECT_EQ("RTSP/1.0", std::string(parser.GetVersion()));
+    EXPECT_EQ(2U, parser.GetHeaders().size());
+    EXPECT_EQ("2", std::string(parser.GetHeader("cseq")));
+    EXPECT_EQ("lmcore", std::string(parser.GetHeader("USER-AGENT")));
+    EXPECT_TRUE(parser.GetHeader("Session").empty());
+    EXPECT_EQ(0, parser.GetContentLength());
+    EXPECT_TRUE(parser.Next() == Event::kEnd);
+    EXPECT_TRUE(parser.Next() == Event::kNeedMore);
+    EXPECT_EQ(0U, parser.GetBufferedSize());
+
+    // Nothing of the message outlives Reset()
+    parser.Reset();
+    EXPECT_TRUE(parser.GetStartLine().empty());
+    EXPECT_TRUE(parser.GetMethod().empty());
+    EXPECT_TRUE(parser.GetHeaders().empty());
+}
+
+TEST(MessageParser, ResponseWithBody)
+{
+    std::string sdp = "v=0\r\no=- 0 0 IN IP4 127.0.0.1\r\ns=live\r\n";
+    std::string message = "RTSP/1.0 200 OK\r\nCSeq: 3\r\nContent-Type: application/sdp\r\nContent-Length: " +
+                          std::to_string(sdp.size()) + "\r\n\r\n" + sdp;
+
+    MessageParser parser;
+    Feed(parser, message);
+    EXPECT_TRUE(parser.Next() == Event::kHead);
+    EXPECT_FALSE(parser.IsRequest());
+    EXPECT_EQ(200, parser.GetStatusCode());
+    EXPECT_EQ("OK", std::string(parser.GetReason()));
+    EXPECT_EQ(static_cast<int64_t>(sdp.size()), parser.GetContentLength());
+    EXPECT_TRUE(parser.Next() == Event::kBody);
+    EXPECT_EQ(sdp, std::string(parser.GetBody()));
+    EXPECT_TRUE(parser.Next() == Event::kEnd);
+
+    // Resumed at every split point
+    std::string expected = "[RTSP/1.0 200 OK]" + sdp + "|";
+    for (size_t step : {1U, 2U, 3U, 7U, 40U}) {
+        MessageParser incremental;
+        EXPECT_EQ(expected, Collect(incremental, message, step));
+    }
+}
+
+TEST(MessageParser, PipelinedAndInterleaved)
+{
+    std::string data = "GET /a HTTP/1.1\r\nHost: x\r\n\r\n"
+                       "\r\n"; // tolerated between messages
+    data += std::string("$\x01\x00\x03rtp", 7);
+    data += "POST /b HTTP/1.1\nContent-Length: 5\n\nhello"
+            "HTTP/1.1 204 No Content\r\n\r\n";
+    std::string expected = "[GET /a HTTP/1.1]|$1:rtp|[POST /b HTTP/1.1]hello|[HTTP/1.1 204 No Content]|";
+    for (size_t step : {1U, 5U, 1000U}) {
+        MessageParser parser;
+        EXPECT_EQ(expected, Collect(parser, data, step));
+    }
+}
+
+TEST(MessageParser, ChunkedBody)
+{
+    std::string data = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+                       "5\r\nhello\r\n"
+                       "7;ext=1\r\n, world\r\n"
+                       "0\r\nTrailer: x\r\n\r\n"
+                       "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+    std::string expected = "[HTTP/1.1 200 OK]hello, world|[HTTP/1.1 200 OK]|";
+    for (size_t step : {1U, 4U, 1000U}) {
+        MessageParser parser;
+        EXPECT_EQ(expected, Collect(parser, data, step));
+    }
+
+    MessageParser parser;
+    Feed(parser, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n");
+    EXPECT_TRUE(parser.Next() == Event::kHead);
+    EXPECT_TRUE(parser.IsChunked());
+    EXPECT_EQ(-1, parser.GetContentLength());
+}
+
+TEST(MessageParser, ResponsesWithoutBody)
+{
+    // Content-Length is what the body would have been; the next message follows right away
+    std::string data = "HTTP/1.1 100 Continue\r\nContent-Length: 4\r\n\r\n"
+                       "HTTP/1.1 204 No Content\r\nContent-Length: 4\r\n\r\n"
+                       "HTTP/1.1 304 Not Modified\r\nTransfer-Encoding: chunked\r\n\r\n"
+                       "HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\nbody";
+    std::string expected = "[HTTP/1.1 100 Continue]|[HTTP/1.1 204 No Content]|[HTTP/1.1 304 Not Modified]|"
+                           "[HTTP/1.1 200 OK]body|";
+    for (size_t step : {1U, 1000U}) {
+        MessageParser parser;
+        EXPECT_EQ(expected, Collect(parser, data, step));
+    }
+
+    // Only the response after ExpectHeadResponse() is bodiless
+    std::string head = "HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\n";
+    MessageParser parser;
+    parser.ExpectHeadResponse();
+    Feed(parser, head);
+    EXPECT_TRUE(parser.Next() == Event::kHead);
+    EXPECT_EQ(0, parser.GetContentLength());
+    EXPECT_TRUE(parser.Next() == Event::kEnd);
+    EXPECT_EQ("[HTTP/1.1 200 OK]body|", Collect(parser, head + "body", 1000));
+}
+
+TEST(MessageParser, LongHeadAcrossWindows)
+{
+    // Long enough for the vectorized search, with the terminator at every alignment
+    for (size_t padding = 0; padding < 40; ++padding) {
+        std::string head = "GET / HTTP/1.1\r\nX-Pad: " + std::string(100 + padding, 'p') + "\r\n\r\n";
+        MessageParser parser;
+        EXPECT_EQ("[GET / HTTP/1.1]|[GET / HTTP/1.1]|", Collect(parser, head + head, 33));
+    }
+}
+
+TEST(MessageParser, Errors)
+{
+    const char *bad[] = {
+        "GARBAGE\r\n\r\n",
+        "GET /\r\n\r\n",
+        "GET / FTP/1.0\r\n\r\n",
+        "HTTP/1.1 2000 OK\r\n\r\n",
+        "GET / HTTP/1.1\r\nNoColon\r\n\r\n",
+        "GET / HTTP/1.1\r\nName : value\r\n\r\n",
+        "GET / HTTP/1.1\r\nA: b\r\n folded\r\n\r\n",
+        "GET / HTTP/1.1\r\nContent-Length: abc\r\n\r\n",
+        "GET / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n",
+        "GET / HTTP/1.1\r\nTransfer-Encoding: gzip\r\n\r\n",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\nxyz\r\n",
+    };
+    bool allFailed = true;
+    for (const char *message : bad) {
+        MessageParser parser;
+        Feed(parser, message);
+        Event event = parser.Next();
+        while (event == Event::kHead || event == Event::kBody) {
+            event = parser.Next();
+        }
+        allFailed = allFailed && event == Event::kError && parser.GetError()[0] != '\0';
+    }
+    EXPECT_TRUE(allFailed);
+
+    MessageParser small(64);
+    Feed(small, "GET / HTTP/1.1\r\nX-Long: " + std::string(100, 'x'));
+    EXPECT_TRUE(small.Next() == Event::kError);
+    EXPECT_TRUE(small.Next() == Event::kError);
+    small.Reset();
+    Feed(small, "GET / HTTP/1.1\r\n\r\n");
+    EXPECT_TRUE(small.Next() == Event::kHead);
+}
+
+TEST(MessageParser, NoAllocationPerMessage)
+{
+    std::string message = "PLAY rtsp://example.com/live RTSP/1.0\r\nCSeq: 4\r\nSession: 12345678\r\n"
+                          "Range: npt=0.000-\r\nContent-Length: 4\r\n\r\nbody";
+    DataBuffer buffer;
+    buffer.Assign(message.data(), message.size());
+
+    MessageParser parser;
+    size_t heads = 0;
+    auto run = [&]() {
+        for (int i = 0; i < 100; ++i) {
+            parser.Feed(buffer);
+            for (Event event = parser.Next(); event != Event::kNeedMore; event = parser.Next()) {
+                heads += event == Event::kHead;
+            }
+        }
+    };
+    run(); // warm up: the buffer and header list reach their size
+    EXPECT_NO_ALLOC(run());
+    EXPECT_EQ(200U, heads);
+}
+
+RUN_ALL_TESTS()
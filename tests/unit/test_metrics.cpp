@@ -0,0 +1,164 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/data_buffer.h"
+#include "lmcore/metrics.h"
+#include "lmcore/object_pool.h"
+#include "lmcore/thread_pool.h"
+
+using namespace lmshao::lmcore;
+
+TEST(MetricsTest, CounterSumsShards)
+{
+    Counter counter;
+    const int numThreads = 4;
+    const int perThread = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&counter]() {
+            for (int i = 0; i < perThread; ++i) {
+                counter.Increment();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter.Value(), numThreads * perThread);
+
+    counter.Increment(5);
+    EXPECT_EQ(counter.Value(), numThreads * perThread + 5);
+    counter.Reset();
+    EXPECT_EQ(counter.Value(), 0);
+    EXPECT_TRUE(CurrentMetricShard() < Counter::kShards);
+}
+
+TEST(MetricsTest, Gauge)
+{
+    Gauge gauge;
+    gauge.Set(10);
+    gauge.Increment();
+    gauge.Sub(3);
+    gauge.Decrement();
+    gauge.Add(-10);
+    EXPECT_EQ(gauge.Value(), -3);
+}
+
+TEST(MetricsTest, SameNameReturnsSameMetric)
+{
+    auto &registry = MetricsRegistry::GetInstance();
+    auto &a = registry.GetCounter("test_same_total", {{"k", "v"}});
+    auto &b = registry.GetCounter("test_same_total", {{"k", "v"}});
+    auto &c = registry.GetCounter("test_same_total", {{"k", "w"}});
+    EXPECT_TRUE(&a == &b);
+    EXPECT_TRUE(&a != &c);
+
+    // Type conflicts hand out a usable but unexported metric
+    auto &gauge = registry.GetGauge("test_same_total");
+    gauge.Set(42);
+    EXPECT_TRUE(registry.ExportText().find("test_same_total 42") == std::string::npos);
+}
+
+TEST(MetricsTest, Exports)
+{
+    auto &registry = MetricsRegistry::GetInstance();
+    registry.GetCounter("test_export_total", {{"method", "GET"}}, "Exported requests").Increment(3);
+    registry.GetGauge("test_export_depth").Set(-2);
+    auto &hist = registry.GetHistogram("test_export_latency_ns", {{"op", "read"}});
+    hist.Record(100);
+    hist.Record(200);
+
+    std::string text = registry.ExportText();
+    EXPECT_TRUE(text.find("test_export_total{method=\"GET\"} 3\n") != std::string::npos);
+    EXPECT_TRUE(text.find("test_export_depth -2\n") != std::string::npos);
+    EXPECT_TRUE(text.find("test_export_latency_ns{op=\"read\"} count=2") != std::string::npos);
+
+    std::string json = registry.ExportJson();
+    EXPECT_EQ(json.front(), '[');
+    EXPECT_EQ(json.back(), ']');
+    EXPECT_TRUE(json.find("{\"name\":\"test_export_total\",\"type\":\"counter\",\"labels\":{\"method\":\"GET\"},"
+                          "\"value\":3}") != std::string::npos);
+    EXPECT_TRUE(json.find("\"type\":\"histogram\",\"labels\":{\"op\":\"read\"},\"value\":{\"count\":2") !=
+                std::string::npos);
+
+    std::string prom = registry.ExportPrometheus();
+    EXPECT_TRUE(prom.find("# HELP test_export_total Exported requests\n# TYPE test_export_total counter\n") !=
+                std::string::npos);
+    EXPECT_TRUE(prom.find("# TYPE test_export_depth gauge\ntest_export_depth -2\n") != std::string::npos);
+    EXPECT_TRUE(prom.find("# TYPE test_export_latency_ns summary\n") != std::string::npos);
+    EXPECT_TRUE(prom.find("test_export_latency_ns_count{op=\"read\"} 2\n") != std::string::npos);
+
+    registry.ResetAll();
+    EXPECT_EQ(registry.GetCounter("test_export_total", {{"method", "GET"}}).Value(), 0);
+    EXPECT_EQ(registry.GetGauge("test_export_depth").Value(), -2);
+    EXPECT_EQ(hist.Count(), 0);
+}
+
+TEST(MetricsTest, LabelEscaping)
+{
+    auto &registry = MetricsRegistry::GetInstance();
+    registry.GetCounter("test_escape_total", {{"path", "a\"b\\c"}}).Increment();
+    std::string prom = registry.ExportPrometheus();
+    EXPECT_TRUE(prom.find("test_escape_total{path=\"a\\\"b\\\\c\"} 1\n") != std::string::npos);
+}
+
+TEST(MetricsTest, ThreadPoolMetrics)
+{
+    auto &registry = MetricsRegistry::GetInstance();
+    std::atomic<int> executed{0};
+    {
+        ThreadPool pool(1, 2, "metrics_pool");
+        for (int i = 0; i < 10; ++i) {
+            pool.AddTask([&executed]() { executed++; });
+        }
+        while (executed.load() < 10) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        pool.Shutdown();
+    }
+    EXPECT_EQ(executed.load(), 10);
+
+    MetricLabels labels = {{"pool", "metrics_pool"}};
+    EXPECT_EQ(registry.GetCounter("lmcore_threadpool_tasks_submitted_total", labels).Value(), 10);
+    EXPECT_EQ(registry.GetCounter("lmcore_threadpool_tasks_completed_total", labels).Value(), 10);
+    EXPECT_EQ(registry.GetGauge("lmcore_threadpool_queue_depth", labels).Value(), 0);
+    EXPECT_EQ(registry.GetGauge("lmcore_threadpool_threads", labels).Value(), 0);
+    EXPECT_EQ(registry.GetHistogram("lmcore_threadpool_queue_delay_ns", labels).Count(), 10);
+}
+
+TEST(MetricsTest, PoolMetrics)
+{
+    auto &registry = MetricsRegistry::GetInstance();
+    ObjectPool<int> pool(nullptr, nullptr, nullptr, 100, "metrics_int_pool");
+    {
+        auto a = pool.Acquire();
+    }
+    auto b = pool.Acquire();
+
+    EXPECT_EQ(registry.GetCounter("lmcore_objectpool_acquire_total", {{"pool", "metrics_int_pool"}, {"result", "miss"}})
+                  .Value(),
+              1);
+    EXPECT_EQ(registry.GetCounter("lmcore_objectpool_acquire_total", {{"pool", "metrics_int_pool"}, {"result", "hit"}})
+                  .Value(),
+              1);
+
+    auto &localAllocs = registry.GetCounter("lmcore_databuffer_pool_alloc_total", {{"source", "local"}});
+    uint64_t before = localAllocs.Value();
+    DataBuffer::PoolAlloc(64).reset();
+    DataBuffer::PoolAlloc(64).reset();
+    EXPECT_GE(localAllocs.Value(), before + 1);
+}
+
+RUN_ALL_TESTS()
@@ -8,6 +8,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -149,4 +150,36 @@ TEST(MpscChannel, SizeAndFull)
     EXPECT_FALSE(rx->IsFull());
 }
 
+TEST(MpscChannel, ConsumerSeesWholeValues)
+{
+    // Heap-allocated strings the consumer would see half-built if it raced the producer's construction
+    constexpr size_t num_producers = 4;
+    constexpr size_t items_per_producer = 2000;
+    const std::string payload(64, 'x');
+    auto [tx, rx] = MpscChannel<std::string>(8);
+
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < num_producers; ++i) {
+        producers.emplace_back([tx = tx, &payload]() {
+            for (size_t j = 0; j < items_per_producer; ++j) {
+                tx->Send(payload);
+            }
+        });
+    }
+
+    size_t received = 0;
+    bool intact = true;
+    while (received < num_producers * items_per_producer) {
+        if (auto val = rx->TryRecv()) {
+            intact = intact && *val == payload;
+            ++received;
+        }
+    }
+    for (auto &t : producers) {
+        t.join();
+    }
+    EXPECT_TRUE(intact);
+    EXPECT_TRUE(rx->IsEmpty());
+}
+
 RUN_ALL_TESTS();
@@ -0,0 +1,167 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lmcore/parallel_ordered_stage.h>
+#include <lmcore/thread_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+
+using namespace lmshao::lmcore;
+
+static void Work(int x)
+{
+    // Uneven work, so items complete out of order
+    std::this_thread::sleep_for(std::chrono::microseconds((x * 53) % 300));
+}
+
+TEST(ParallelOrderedStage, RestoresOrder)
+{
+    std::vector<std::string> out;
+    ParallelOrderedOptions options;
+    options.workers = 4;
+    options.window = 8;
+    ParallelOrderedStage<int, std::string> stage(
+        [](int x) {
+            Work(x);
+            return std::to_string(x);
+        },
+        [&](std::string s) { out.push_back(std::move(s)); }, options);
+    EXPECT_EQ(8U, stage.GetWindow());
+
+    bool bounded = true;
+    for (int i = 0; i < 300; ++i) {
+        EXPECT_TRUE(stage.Submit(i));
+        bounded = bounded && stage.GetInFlight() <= stage.GetWindow();
+    }
+    stage.Flush();
+    EXPECT_TRUE(bounded);
+    EXPECT_EQ(0U, stage.GetInFlight());
+    EXPECT_GT(stage.GetWindowWaits(), 0U);
+
+    bool ordered = out.size() == 300;
+    for (size_t i = 0; ordered && i < out.size(); ++i) {
+        ordered = out[i] == std::to_string(i);
+    }
+    EXPECT_TRUE(ordered);
+
+    stage.Close();
+    EXPECT_TRUE(stage.IsClosed());
+    EXPECT_FALSE(stage.Submit(1));
+}
+
+TEST(ParallelOrderedStage, FilterAndExceptionsDrop)
+{
+    std::vector<int> out;
+    ParallelOrderedOptions options;
+    options.workers = 3;
+    options.window = 4;
+    {
+        ParallelOrderedStage<int, int> stage(
+            [](int x) -> std::optional<int> {
+                Work(x);
+                if (x == 7) {
+                    throw std::runtime_error("bad item");
+                }
+                return x % 3 == 0 ? std::nullopt : std::optional<int>(x);
+            },
+            [&](int x) { out.push_back(x); }, options);
+        for (int i = 0; i < 12; ++i) {
+            stage.Submit(i);
+        }
+    } // the destructor flushes
+    EXPECT_TRUE(out == std::vector<int>({1, 2, 4, 5, 8, 10, 11}));
+}
+
+TEST(ParallelOrderedStage, SlowOutputHoldsSubmitBack)
+{
+    std::atomic<int> done{0};
+    ParallelOrderedOptions options;
+    options.workers = 2;
+    options.window = 3;
+    ParallelOrderedStage<int, int> stage([](int x) { return x; },
+                                         [&](int) {
+                                             std::this_thread::sleep_for(std::chrono::microseconds(300));
+                                             done.fetch_add(1);
+                                         },
+                                         options);
+    int maxAhead = 0;
+    for (int i = 0; i < 50; ++i) {
+        stage.Submit(i);
+        maxAhead = std::max(maxAhead, i + 1 - done.load());
+    }
+    stage.Close();
+    // The ring, plus the item whose output is running
+    EXPECT_GE(4, maxAhead);
+    EXPECT_EQ(50, done.load());
+}
+
+TEST(ParallelOrderedStage, SharedPool)
+{
+    ThreadPool pool(3, 3, "shared");
+    std::vector<int> out;
+    ParallelOrderedOptions options;
+    options.window = 16;
+    {
+        ParallelOrderedStage<int, int> stage(
+            [](int x) {
+                Work(x);
+                return x * x;
+            },
+            [&](int x) { out.push_back(x); }, options, &pool);
+        for (int i = 0; i < 100; ++i) {
+            stage.Submit(i);
+        }
+        stage.Close();
+    }
+    bool ordered = out.size() == 100;
+    for (int i = 0; ordered && i < 100; ++i) {
+        ordered = out[i] == i * i;
+    }
+    EXPECT_TRUE(ordered);
+
+    // Closing the stage leaves the pool running
+    std::atomic<bool> ran{false};
+    pool.AddTask([&]() { ran = true; });
+    for (int i = 0; i < 1000 && !ran; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(ran.load());
+}
+
+TEST(ParallelOrderedStage, RejectedItemsKeepTheRingMoving)
+{
+    ThreadPool pool(2, 2, "stopping");
+    std::vector<int> out;
+    ParallelOrderedOptions options;
+    options.window = 4;
+    ParallelOrderedStage<int, int> stage([](int x) { return x; }, [&](int x) { out.push_back(x); }, options, &pool);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(stage.Submit(i));
+    }
+    stage.Flush();
+
+    // More items than the ring holds, none of which runs
+    pool.Shutdown();
+    for (int i = 3; i < 20; ++i) {
+        EXPECT_FALSE(stage.Submit(i));
+    }
+    stage.Flush();
+    EXPECT_EQ(0U, stage.GetInFlight());
+    EXPECT_TRUE(out == std::vector<int>({0, 1, 2}));
+}
+
+RUN_ALL_TESTS()
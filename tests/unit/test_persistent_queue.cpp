@@ -0,0 +1,228 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lmcore/data_buffer.h>
+#include <lmcore/persistent_queue.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include "../test_framework.h"
+
+using namespace lmshao::lmcore;
+
+static std::string MakeTempDir()
+{
+    char path[] = "/tmp/lmcore_persistent_queue_XXXXXX";
+    return mkdtemp(path) ? path : "";
+}
+
+static size_t CountSegments(const std::string &dir)
+{
+    size_t count = 0;
+    if (DIR *d = opendir(dir.c_str())) {
+        while (dirent *entry = readdir(d)) {
+            count += strstr(entry->d_name, ".seg") != nullptr;
+        }
+        closedir(d);
+    }
+    return count;
+}
+
+static void RemoveDir(const std::string &dir)
+{
+    if (DIR *d = opendir(dir.c_str())) {
+        while (dirent *entry = readdir(d)) {
+            std::string name = entry->d_name;
+            if (name != "." && name != "..") {
+                unlink((dir + "/" + name).c_str());
+            }
+        }
+        closedir(d);
+    }
+    rmdir(dir.c_str());
+}
+
+static int32_t PushString(PersistentQueue &queue, const std::string &s, bool sync = true)
+{
+    return queue.Push(reinterpret_cast<const uint8_t *>(s.data()), s.size(), sync);
+}
+
+static std::string FrontString(PersistentQueue &queue)
+{
+    auto record = queue.Front();
+    return record ? std::string(reinterpret_cast<const char *>(record->data), record->size) : "<empty>";
+}
+
+TEST(PersistentQueue, PushFrontPop)
+{
+    std::string dir = MakeTempDir();
+    auto queue = PersistentQueue::Open(dir, 4096);
+    EXPECT_TRUE(queue != nullptr);
+    EXPECT_TRUE(queue->Empty());
+    EXPECT_FALSE(queue->Front().has_value());
+    EXPECT_EQ(-1, queue->Pop());
+
+    EXPECT_EQ(0, PushString(*queue, "first"));
+    EXPECT_EQ(0, PushString(*queue, "", false));
+    DataBuffer buffer;
+    buffer.Assign("third", 5);
+    EXPECT_EQ(0, queue->Push(buffer));
+    EXPECT_EQ(3U, queue->GetSize());
+
+    EXPECT_EQ(std::string("first"), FrontString(*queue));
+    EXPECT_EQ(0, queue->Pop());
+    EXPECT_EQ(std::string(""), FrontString(*queue));
+    EXPECT_EQ(0, queue->Pop(false));
+    EXPECT_EQ(std::string("third"), FrontString(*queue));
+    EXPECT_EQ(0, queue->Pop());
+    EXPECT_TRUE(queue->Empty());
+    EXPECT_EQ(0U, queue->GetSize());
+
+    std::string huge(4096, 'x');
+    EXPECT_EQ(-1, PushString(*queue, huge));
+    RemoveDir(dir);
+}
+
+TEST(PersistentQueue, SurvivesReopen)
+{
+    std::string dir = MakeTempDir();
+    {
+        auto queue = PersistentQueue::Open(dir, 4096);
+        for (int i = 0; i < 5; ++i) {
+            PushString(*queue, "record" + std::to_string(i));
+        }
+        queue->Pop();
+        // Read but not popped: delivered again after a restart
+        EXPECT_EQ(std::string("record1"), FrontString(*queue));
+    }
+    // The segment size of an existing queue wins
+    auto queue = PersistentQueue::Open(dir, 1 << 20);
+    EXPECT_TRUE(queue != nullptr);
+    EXPECT_EQ(4096U, queue->GetSegmentSize());
+    EXPECT_EQ(4U, queue->GetSize());
+    for (int i = 1; i < 5; ++i) {
+        EXPECT_EQ("record" + std::to_string(i), FrontString(*queue));
+        queue->Pop();
+    }
+    EXPECT_TRUE(queue->Empty());
+    RemoveDir(dir);
+}
+
+TEST(PersistentQueue, SegmentsRollOver)
+{
+    std::string dir = MakeTempDir();
+    auto queue = PersistentQueue::Open(dir, 256);
+    // 108-byte records, padded to 112: two per 256-byte segment, then a roll-over marker
+    std::string payload(100, 'a');
+    for (int i = 0; i < 10; ++i) {
+        payload[0] = static_cast<char>('0' + i);
+        EXPECT_EQ(0, PushString(*queue, payload, false));
+    }
+    EXPECT_EQ(5U, CountSegments(dir));
+
+    for (int i = 0; i < 5; ++i) {
+        auto record = queue->Front();
+        EXPECT_TRUE(record.has_value());
+        EXPECT_EQ(100U, record->size);
+        EXPECT_EQ(static_cast<uint8_t>('0' + i), record->data[0]);
+        EXPECT_EQ(0, queue->Pop());
+    }
+    // Fully consumed segments are deleted
+    EXPECT_EQ(3U, CountSegments(dir));
+    while (queue->Pop() == 0) {
+    }
+    EXPECT_EQ(1U, CountSegments(dir));
+
+    // A consumer that never syncs deletes them too
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(0, PushString(*queue, payload, false));
+    }
+    EXPECT_EQ(6U, CountSegments(dir));
+    while (queue->Pop(false) == 0) {
+    }
+    EXPECT_EQ(1U, CountSegments(dir));
+    RemoveDir(dir);
+}
+
+TEST(PersistentQueue, ProducerConsumerHandoff)
+{
+    std::string dir = MakeTempDir();
+    // Separate instances, as a producer and a consumer process would have
+    auto producer = PersistentQueue::Open(dir, 1024);
+    auto consumer = PersistentQueue::Open(dir, 1024);
+    const int kCount = 2000;
+
+    std::thread thread([&producer]() {
+        for (int i = 0; i < kCount; ++i) {
+            PushString(*producer, std::to_string(i), false);
+        }
+    });
+    int expected = 0;
+    bool ordered = true;
+    while (expected < kCount) {
+        auto record = consumer->Front();
+        if (!record) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::string s(reinterpret_cast<const char *>(record->data), record->size);
+        ordered = ordered && s == std::to_string(expected);
+        consumer->Pop(false);
+        ++expected;
+    }
+    thread.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(consumer->Empty());
+    EXPECT_TRUE(producer->Empty());
+    RemoveDir(dir);
+}
+
+static void OverwriteHeaderWord(const std::string &dir, long offset, uint64_t value)
+{
+    if (FILE *file = fopen((dir + "/header").c_str(), "r+b")) {
+        fseek(file, offset, SEEK_SET);
+        fwrite(&value, sizeof(value), 1, file);
+        fclose(file);
+    }
+}
+
+TEST(PersistentQueue, CountsSurviveCrashAfterCursor)
+{
+    std::string dir = MakeTempDir();
+    {
+        auto queue = PersistentQueue::Open(dir, 4096);
+        EXPECT_EQ(0, PushString(*queue, "a"));
+        EXPECT_EQ(0, PushString(*queue, "b"));
+        EXPECT_EQ(0, PushString(*queue, "c"));
+        EXPECT_EQ(0, queue->Pop());
+    }
+    // A crash after publishing the write cursor but before the count, which is at byte 72
+    OverwriteHeaderWord(dir, 72, 2);
+    {
+        auto queue = PersistentQueue::Open(dir);
+        EXPECT_EQ(2U, queue->GetSize());
+        EXPECT_EQ(0, PushString(*queue, "d"));
+        EXPECT_EQ(0, queue->Pop());
+        EXPECT_EQ(2U, queue->GetSize());
+    }
+    // The same on the consumer side, whose count is at byte 136
+    OverwriteHeaderWord(dir, 136, 1);
+    auto queue = PersistentQueue::Open(dir);
+    EXPECT_EQ(2U, queue->GetSize());
+    EXPECT_EQ(std::string("c"), FrontString(*queue));
+    RemoveDir(dir);
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,246 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lmcore/pipeline.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "../test_framework.h"
+
+using namespace lmshao::lmcore;
+
+TEST(Pipeline, TransformsInOrder)
+{
+    std::vector<std::string> out;
+    auto pipeline = PipelineBuilder<int>("test")
+                        .Stage("double", [](int x) { return x * 2; })
+                        .Stage("format", [](int x) { return "#" + std::to_string(x); })
+                        .Sink("collect", [&](std::string s) { out.push_back(std::move(s)); });
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(pipeline->Push(i));
+    }
+    pipeline->Close();
+    EXPECT_EQ(100U, out.size());
+    EXPECT_EQ("#0", out[0]);
+    EXPECT_EQ("#198", out[99]);
+    EXPECT_FALSE(pipeline->Push(1));
+}
+
+TEST(Pipeline, ParallelStagesKeepOrder)
+{
+    std::vector<int> out;
+    PipelineStageOptions three;
+    three.workers = 3;
+    three.capacity = 4;
+    PipelineStageOptions two;
+    two.workers = 2;
+    auto pipeline = PipelineBuilder<int>("order")
+                        .Stage(
+                            "jitter",
+                            [](int x) {
+                                // Uneven work, so workers finish out of order
+                                std::this_thread::sleep_for(std::chrono::microseconds((x * 37) % 200));
+                                return x;
+                            },
+                            three)
+                        .Stage("plus", [](int x) { return x + 1; }, two)
+                        .Sink("collect", [&](int x) { out.push_back(x); });
+    const int count = 500;
+    for (int i = 0; i < count; ++i) {
+        pipeline->Push(i);
+    }
+    pipeline->Close();
+
+    bool ordered = out.size() == count;
+    for (int i = 0; ordered && i < count; ++i) {
+        ordered = out[i] == i + 1;
+    }
+    EXPECT_TRUE(ordered);
+
+    auto stats = pipeline->GetStats();
+    EXPECT_EQ(3U, stats.size());
+    EXPECT_EQ("jitter", stats[0].name);
+    EXPECT_EQ(3U, stats[0].workers);
+    EXPECT_EQ(static_cast<uint64_t>(count), stats[0].items);
+    EXPECT_EQ(static_cast<uint64_t>(count), stats[1].items);
+    EXPECT_EQ(static_cast<uint64_t>(count), stats[2].latency.Count());
+    EXPECT_GT(stats[0].latency.Max(), 0U);
+    EXPECT_GT(stats[2].itemsPerSecond, 0.0);
+}
+
+TEST(Pipeline, FilterAndExceptionsDrop)
+{
+    std::vector<int> out;
+    PipelineStageOptions two;
+    two.workers = 2;
+    auto pipeline = PipelineBuilder<int>()
+                        .Stage(
+                            "even", [](int x) { return x % 2 == 0 ? std::optional<int>(x) : std::nullopt; }, two)
+                        .Stage("check",
+                               [](int x) {
+                                   if (x == 10) {
+                                       throw std::runtime_error("bad item");
+                                   }
+                                   return x;
+                               })
+                        .Sink("collect", [&](int x) { out.push_back(x); });
+    for (int i = 0; i < 20; ++i) {
+        pipeline->Push(i);
+    }
+    pipeline->Close();
+
+    EXPECT_TRUE(out == std::vector<int>({0, 2, 4, 6, 8, 12, 14, 16, 18}));
+    auto stats = pipeline->GetStats();
+    EXPECT_EQ(20U, stats[0].items);
+    EXPECT_EQ(10U, stats[0].dropped);
+    EXPECT_EQ(10U, stats[1].items);
+    EXPECT_EQ(1U, stats[1].dropped);
+    EXPECT_EQ(9U, stats[2].items);
+}
+
+TEST(Pipeline, BackpressureBoundsInFlight)
+{
+    std::atomic<int> pushed{0};
+    std::atomic<int> done{0};
+    int maxInFlight = 0;
+    PipelineStageOptions small;
+    small.capacity = 2;
+    auto pipeline = PipelineBuilder<int>()
+                        .Stage("pass", [](int x) { return x; }, small)
+                        .Sink(
+                            "slow",
+                            [&](int) {
+                                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                                done.fetch_add(1);
+                            },
+                            small);
+    for (int i = 0; i < 200; ++i) {
+        pipeline->Push(i);
+        pushed.fetch_add(1);
+        maxInFlight = std::max(maxInFlight, pushed.load() - done.load());
+    }
+    pipeline->Close();
+
+    // Two channels of 2, plus one item in each stage function
+    EXPECT_GE(6, maxInFlight);
+    EXPECT_EQ(200, done.load());
+    EXPECT_GT(pipeline->GetStats()[0].outputWaits, 0U);
+}
+
+TEST(Pipeline, WaitStrategies)
+{
+    for (WaitStrategy wait : {WaitStrategy::kSpin, WaitStrategy::kYield, WaitStrategy::kBlock}) {
+        PipelineStageOptions options;
+        options.wait = wait;
+        options.workers = 2;
+        options.capacity = 8;
+        std::atomic<long> sum{0};
+        auto pipeline = PipelineBuilder<int>()
+                            .Stage("square", [](int x) { return static_cast<long>(x) * x; }, options)
+                            .Sink("sum", [&](long x) { sum.fetch_add(x); }, options);
+        for (int i = 1; i <= 100; ++i) {
+            pipeline->Push(i);
+        }
+        pipeline->Close();
+        EXPECT_EQ(338350L, sum.load());
+    }
+}
+
+TEST(Pipeline, OrderedStage)
+{
+    std::vector<int> out;
+    PipelineStageOptions pool;
+    pool.workers = 3;
+    pool.capacity = 8;
+    PipelineStageOptions two;
+    two.workers = 2;
+    auto pipeline = PipelineBuilder<int>("ordered")
+                        .OrderedStage(
+                            "uneven",
+                            [](int x) {
+                                std::this_thread::sleep_for(std::chrono::microseconds((x * 53) % 300));
+                                return x % 5 == 0 ? std::nullopt : std::optional<int>(x);
+                            },
+                            pool)
+                        .Stage("plus", [](int x) { return x + 1; }, two)
+                        .Sink("collect", [&](int x) { out.push_back(x); });
+    for (int i = 0; i < 200; ++i) {
+        pipeline->Push(i);
+    }
+    pipeline->Close();
+
+    std::vector<int> expected;
+    for (int i = 0; i < 200; ++i) {
+        if (i % 5 != 0) {
+            expected.push_back(i + 1);
+        }
+    }
+    EXPECT_TRUE(out == expected);
+    auto stats = pipeline->GetStats();
+    EXPECT_EQ("uneven", stats[0].name);
+    EXPECT_EQ(3U, stats[0].workers);
+    EXPECT_EQ(200U, stats[0].items);
+    EXPECT_EQ(40U, stats[0].dropped);
+    EXPECT_GT(stats[0].windowWaits, 0U);
+    EXPECT_EQ(160U, stats[1].items);
+    EXPECT_EQ(0U, stats[1].windowWaits);
+
+    // Its own pool defaults to one thread per CPU, and keeps an explicit size
+    PipelineStageOptions one;
+    one.workers = 1;
+    auto sized = PipelineBuilder<int>()
+                     .OrderedStage("default", [](int x) { return x; })
+                     .OrderedStage("single", [](int x) { return x; }, one)
+                     .Sink("drop", [](int) {});
+    sized->Close();
+    stats = sized->GetStats();
+    EXPECT_EQ(static_cast<size_t>(std::max(1U, std::thread::hardware_concurrency())), stats[0].workers);
+    EXPECT_EQ(1U, stats[1].workers);
+    EXPECT_EQ(1U, stats[2].workers);
+}
+
+TEST(Pipeline, DestructorDrains)
+{
+    std::atomic<int> count{0};
+    {
+        auto pipeline = PipelineBuilder<int>().Sink("count", [&](int) { count.fetch_add(1); });
+        for (int i = 0; i < 50; ++i) {
+            pipeline->Push(i);
+        }
+    }
+    EXPECT_EQ(50, count.load());
+}
+
+#if defined(__linux__)
+TEST(Pipeline, PinsWorkers)
+{
+    PipelineStageOptions pinned;
+    pinned.cpus = {0};
+    std::atomic<bool> onCpu0{true};
+    auto pipeline =
+        PipelineBuilder<int>().Sink("pinned", [&](int) { onCpu0 = onCpu0 && sched_getcpu() == 0; }, pinned);
+    for (int i = 0; i < 10; ++i) {
+        pipeline->Push(i);
+    }
+    pipeline->Close();
+    EXPECT_TRUE(onCpu0.load());
+}
+#endif
+
+RUN_ALL_TESTS()
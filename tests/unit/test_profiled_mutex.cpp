@@ -0,0 +1,131 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "../test_framework.h"
+#include "lmcore/metrics.h"
+#include "lmcore/profiled_mutex.h"
+#include "lmcore/thread_pool.h"
+
+using namespace lmshao::lmcore;
+
+TEST(ProfiledMutexTest, UncontendedLocking)
+{
+    ProfiledMutex mutex("ProfiledMutexTest.Uncontended");
+    for (int i = 0; i < 100; ++i) {
+        std::lock_guard<ProfiledMutex> lock(mutex);
+    }
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+
+    auto &hold = MetricsRegistry::GetInstance().GetHistogram("lmcore_mutex_hold_ns",
+                                                             {{"mutex", "ProfiledMutexTest.Uncontended"}});
+    EXPECT_EQ(hold.Count(), 101u);
+    auto &contended = MetricsRegistry::GetInstance().GetCounter("lmcore_mutex_contended_total",
+                                                                {{"mutex", "ProfiledMutexTest.Uncontended"}});
+    EXPECT_EQ(contended.Value(), 0u);
+}
+
+TEST(ProfiledMutexTest, RecordsContention)
+{
+    ProfiledMutex mutex("ProfiledMutexTest.Contended");
+    std::atomic<bool> held{false};
+    std::atomic<bool> locking{false};
+
+    std::thread holder([&]() {
+        std::lock_guard<ProfiledMutex> lock(mutex);
+        held = true;
+        // Give the main thread time to get from its flag into lock()
+        while (!locking) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    });
+    while (!held) {
+        std::this_thread::yield();
+    }
+    locking = true;
+    {
+        std::lock_guard<ProfiledMutex> lock(mutex);
+    }
+    holder.join();
+
+    auto &registry = MetricsRegistry::GetInstance();
+    EXPECT_EQ(registry.GetCounter("lmcore_mutex_contended_total", {{"mutex", "ProfiledMutexTest.Contended"}}).Value(),
+              1u);
+    auto snapshot = registry.GetHistogram("lmcore_mutex_wait_ns", {{"mutex", "ProfiledMutexTest.Contended"}})
+                        .GetSnapshot();
+    EXPECT_EQ(snapshot.Count(), 1u);
+
+    // The contended lock ranks above the uncontended one and lists its waiting call site
+    std::string report = ProfiledMutex::Report();
+    size_t contended = report.find("ProfiledMutexTest.Contended");
+    EXPECT_NE(contended, std::string::npos);
+    EXPECT_TRUE(report.find("contended=1 ") != std::string::npos);
+    EXPECT_TRUE(report.find("1 waits", contended) != std::string::npos);
+    size_t uncontended = report.find("ProfiledMutexTest.Uncontended");
+    EXPECT_TRUE(uncontended == std::string::npos || uncontended > contended);
+
+    EXPECT_EQ(ProfiledMutex::Report(0), "Top contended mutexes by total wait time\n");
+}
+
+TEST(ProfiledMutexTest, WorksWithConditionVariableAny)
+{
+    ProfiledMutex mutex("ProfiledMutexTest.CondVar");
+    std::condition_variable_any cond;
+    bool ready = false;
+
+    std::thread producer([&]() {
+        std::lock_guard<ProfiledMutex> lock(mutex);
+        ready = true;
+        cond.notify_one();
+    });
+    {
+        std::unique_lock<ProfiledMutex> lock(mutex);
+        cond.wait(lock, [&]() { return ready; });
+    }
+    producer.join();
+    EXPECT_TRUE(ready);
+}
+
+TEST(ProfiledMutexTest, ResetAll)
+{
+    ProfiledMutex mutex("ProfiledMutexTest.Reset");
+    {
+        std::lock_guard<ProfiledMutex> lock(mutex);
+    }
+    ProfiledMutex::ResetAll();
+    auto &hold = MetricsRegistry::GetInstance().GetHistogram("lmcore_mutex_hold_ns",
+                                                             {{"mutex", "ProfiledMutexTest.Reset"}});
+    EXPECT_EQ(hold.Count(), 0u);
+}
+
+#if defined(LMCORE_MUTEX_PROFILING)
+TEST(ProfiledMutexTest, InternalLocksAreProfiled)
+{
+    std::atomic<int> done{0};
+    {
+        ThreadPool pool(2, 2, "profiled");
+        for (int i = 0; i < 100; ++i) {
+            pool.AddTask([&done]() { done.fetch_add(1); });
+        }
+        while (done.load() < 100) {
+            std::this_thread::yield();
+        }
+    }
+    EXPECT_TRUE(ProfiledMutex::Report(100).find("ThreadPool") != std::string::npos);
+}
+#endif
+
+RUN_ALL_TESTS()
@@ -0,0 +1,204 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lmcore/data_buffer.h>
+#include <lmcore/record_log.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../test_framework.h"
+
+using namespace lmshao::lmcore;
+
+static std::string MakeTempDir()
+{
+    char path[] = "/tmp/lmcore_record_log_XXXXXX";
+    return mkdtemp(path) ? path : "";
+}
+
+static void RemoveDir(const std::string &dir)
+{
+    if (DIR *d = opendir(dir.c_str())) {
+        while (dirent *entry = readdir(d)) {
+            std::string name = entry->d_name;
+            if (name != "." && name != "..") {
+                unlink((dir + "/" + name).c_str());
+            }
+        }
+        closedir(d);
+    }
+    rmdir(dir.c_str());
+}
+
+static std::vector<std::string> ReadAll(const RecordLog &log, uint64_t fromSeq = 0)
+{
+    std::vector<std::string> records;
+    log.Replay(
+        [&records](uint64_t, const uint8_t *data, size_t size) {
+            records.emplace_back(reinterpret_cast<const char *>(data), size);
+            return true;
+        },
+        fromSeq);
+    return records;
+}
+
+static int64_t AppendString(RecordLog &log, const std::string &s, bool sync = true)
+{
+    return log.Append(reinterpret_cast<const uint8_t *>(s.data()), s.size(), sync);
+}
+
+TEST(RecordLog, AppendAndReplay)
+{
+    std::string dir = MakeTempDir();
+    auto log = RecordLog::Open(dir, 4096);
+    EXPECT_TRUE(log != nullptr);
+    EXPECT_EQ(0, AppendString(*log, "alpha"));
+    EXPECT_EQ(1, AppendString(*log, "", false));
+    DataBuffer buffer;
+    buffer.Assign("gamma", 5);
+    EXPECT_EQ(2, log->Append(buffer));
+    EXPECT_EQ(0, log->Sync());
+    EXPECT_EQ(3U, log->GetNextSeq());
+
+    auto records = ReadAll(*log);
+    EXPECT_EQ(3U, records.size());
+    EXPECT_EQ(std::string("alpha"), records[0]);
+    EXPECT_EQ(std::string(""), records[1]);
+    EXPECT_EQ(std::string("gamma"), records[2]);
+
+    records = ReadAll(*log, 2);
+    EXPECT_EQ(1U, records.size());
+    EXPECT_EQ(std::string("gamma"), records[0]);
+
+    // Records that don't fit a segment are refused
+    std::string huge(4096, 'x');
+    EXPECT_EQ(-1, AppendString(*log, huge));
+    RemoveDir(dir);
+}
+
+TEST(RecordLog, ReopenContinuesNumbering)
+{
+    std::string dir = MakeTempDir();
+    {
+        auto log = RecordLog::Open(dir, 4096);
+        for (int i = 0; i < 10; ++i) {
+            AppendString(*log, "record" + std::to_string(i));
+        }
+    }
+    auto log = RecordLog::Open(dir, 4096);
+    EXPECT_TRUE(log != nullptr);
+    EXPECT_EQ(10U, log->GetNextSeq());
+    EXPECT_EQ(10, AppendString(*log, "record10"));
+    auto records = ReadAll(*log);
+    EXPECT_EQ(11U, records.size());
+    EXPECT_EQ(std::string("record10"), records[10]);
+    RemoveDir(dir);
+}
+
+TEST(RecordLog, RotatesSegments)
+{
+    std::string dir = MakeTempDir();
+    {
+        auto log = RecordLog::Open(dir, 256);
+        std::string payload(100, 'a');
+        for (int i = 0; i < 10; ++i) {
+            payload[0] = static_cast<char>('0' + i);
+            EXPECT_EQ(i, AppendString(*log, payload, false));
+        }
+        // Two 108-byte records per 256-byte segment
+        EXPECT_EQ(5U, log->GetSegmentCount());
+    }
+    auto log = RecordLog::Open(dir, 256);
+    EXPECT_EQ(5U, log->GetSegmentCount());
+    EXPECT_EQ(10U, log->GetNextSeq());
+
+    std::vector<uint64_t> seqs;
+    bool intact = true;
+    log->Replay(
+        [&](uint64_t seq, const uint8_t *data, size_t size) {
+            intact = intact && size == 100 && data[0] == static_cast<uint8_t>('0' + seq);
+            seqs.push_back(seq);
+            return seqs.size() < 4;
+        },
+        3);
+    EXPECT_TRUE(intact);
+    EXPECT_EQ(4U, seqs.size());
+    EXPECT_EQ(3U, seqs.front());
+    EXPECT_EQ(6U, seqs.back());
+    RemoveDir(dir);
+}
+
+TEST(RecordLog, RecoveryTruncatesAtBadCrc)
+{
+    std::string dir = MakeTempDir();
+    {
+        auto log = RecordLog::Open(dir, 4096);
+        for (int i = 0; i < 5; ++i) {
+            AppendString(*log, "payload" + std::to_string(i));
+        }
+    }
+    // Each record is 8 + 8 bytes; flip a payload byte of record 3
+    std::string segment = dir + "/00000000000000000000.log";
+    int fd = open(segment.c_str(), O_RDWR);
+    EXPECT_TRUE(fd >= 0);
+    uint8_t byte = 'X';
+    EXPECT_EQ(1, pwrite(fd, &byte, 1, 3 * 16 + 8 + 2));
+    close(fd);
+
+    auto log = RecordLog::Open(dir, 4096);
+    EXPECT_EQ(3U, log->GetNextSeq());
+    EXPECT_EQ(3U, ReadAll(*log).size());
+    EXPECT_EQ(3, AppendString(*log, "replaced"));
+    auto records = ReadAll(*log);
+    EXPECT_EQ(4U, records.size());
+    EXPECT_EQ(std::string("replaced"), records[3]);
+    RemoveDir(dir);
+}
+
+TEST(RecordLog, ConcurrentAppends)
+{
+    std::string dir = MakeTempDir();
+    auto log = RecordLog::Open(dir, 64 * 1024);
+    const int kThreads = 4;
+    const int kPerThread = 50;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&log, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                std::string s = std::to_string(t) + ":" + std::to_string(i);
+                log->Append(reinterpret_cast<const uint8_t *>(s.data()), s.size());
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(static_cast<uint64_t>(kThreads * kPerThread), log->GetNextSeq());
+
+    // Per-thread order is preserved
+    std::vector<int> next(kThreads, 0);
+    bool ordered = true;
+    for (const auto &record : ReadAll(*log)) {
+        int t = std::stoi(record.substr(0, record.find(':')));
+        int i = std::stoi(record.substr(record.find(':') + 1));
+        ordered = ordered && i == next[t]++;
+    }
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(kPerThread, next[0]);
+    RemoveDir(dir);
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,119 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/sync.h"
+
+using namespace lmshao::lmcore::sync;
+
+namespace {
+// Every field holds the same value, so a torn read shows up as a mismatch
+struct Stats {
+    uint64_t a;
+    uint64_t b;
+    uint32_t c;
+    uint8_t d[13];
+};
+
+Stats MakeStats(uint64_t v)
+{
+    Stats stats{};
+    stats.a = v;
+    stats.b = v;
+    stats.c = static_cast<uint32_t>(v);
+    for (auto &byte : stats.d) {
+        byte = static_cast<uint8_t>(v);
+    }
+    return stats;
+}
+
+bool Consistent(const Stats &stats)
+{
+    if (stats.b != stats.a || stats.c != static_cast<uint32_t>(stats.a)) {
+        return false;
+    }
+    for (auto byte : stats.d) {
+        if (byte != static_cast<uint8_t>(stats.a)) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST(SeqLockTest, StoreAndLoad)
+{
+    SeqLock<Stats> lock(MakeStats(1));
+    EXPECT_EQ(lock.Load().a, 1u);
+    EXPECT_EQ(lock.Version(), 1u);
+
+    lock.Store(MakeStats(42));
+    Stats stats = lock.Load();
+    EXPECT_TRUE(Consistent(stats));
+    EXPECT_EQ(stats.a, 42u);
+    EXPECT_EQ(lock.Version(), 2u);
+
+    Stats copy{};
+    EXPECT_TRUE(lock.TryLoad(copy));
+    EXPECT_EQ(copy.b, 42u);
+}
+
+TEST(SeqLockTest, SmallAndPointerValues)
+{
+    int value = 5;
+    SeqLock<int *> pointer(&value);
+    EXPECT_EQ(*pointer.Load(), 5);
+
+    SeqLock<uint8_t> byte;
+    EXPECT_EQ(byte.Load(), 0);
+    byte.Store(200);
+    EXPECT_EQ(byte.Load(), 200);
+}
+
+TEST(SeqLockTest, ReadersNeverSeeTornValues)
+{
+    SeqLock<Stats> lock(MakeStats(0));
+    std::atomic<bool> stop{false};
+    std::atomic<int> torn{0};
+    std::atomic<int> backwards{0};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&]() {
+            uint64_t last = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                Stats stats = lock.Load();
+                if (!Consistent(stats)) {
+                    torn.fetch_add(1);
+                }
+                if (stats.a < last) {
+                    backwards.fetch_add(1);
+                }
+                last = stats.a;
+            }
+        });
+    }
+
+    for (uint64_t i = 1; i <= 200000; ++i) {
+        lock.Store(MakeStats(i));
+    }
+    stop = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(backwards.load(), 0);
+    EXPECT_EQ(lock.Load().a, 200000u);
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,101 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/singleton.h"
+
+using namespace lmshao::lmcore;
+
+namespace {
+std::atomic<int> g_created{0};
+std::atomic<int> g_destroyed{0};
+
+class Service : public ManagedSingleton<Service> {
+    friend class ManagedSingleton<Service>;
+
+public:
+    ~Service() override { g_destroyed.fetch_add(1); }
+    int Value() const { return 42; }
+
+private:
+    Service() { g_created.fetch_add(1); }
+};
+
+class Counter : public Singleton<Counter> {
+    friend class Singleton<Counter>;
+
+public:
+    int next = 0;
+
+private:
+    Counter() = default;
+};
+
+} // namespace
+
+TEST(SingletonTest, MeyersSingleton)
+{
+    Counter::GetInstance().next = 5;
+    EXPECT_EQ(Counter::GetInstance().next, 5);
+    EXPECT_TRUE(&Counter::GetInstance() == &Counter::GetInstance());
+}
+
+TEST(ManagedSingletonTest, BorrowAndShare)
+{
+    Service *borrowed = Service::Borrow();
+    auto shared = Service::GetInstance();
+    EXPECT_TRUE(borrowed == shared.get());
+    EXPECT_EQ(borrowed->Value(), 42);
+    EXPECT_EQ(g_created.load(), 1);
+
+    // Shared owners keep the instance alive after DestroyInstance
+    Service::DestroyInstance();
+    EXPECT_EQ(g_destroyed.load(), 0);
+    shared.reset();
+    EXPECT_EQ(g_destroyed.load(), 1);
+
+    // Recreated on next use
+    EXPECT_TRUE(Service::Borrow() != nullptr);
+    EXPECT_EQ(g_created.load(), 2);
+    Service::DestroyInstance();
+    EXPECT_EQ(g_destroyed.load(), 2);
+}
+
+TEST(ManagedSingletonTest, ConcurrentFirstUseCreatesOnce)
+{
+    Service::DestroyInstance();
+    int createdBefore = g_created.load();
+    std::atomic<bool> go{false};
+    std::vector<Service *> seen(8, nullptr);
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            seen[t] = (t % 2) ? Service::Borrow() : Service::GetInstance().get();
+        });
+    }
+    go = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(g_created.load(), createdBefore + 1);
+    for (Service *service : seen) {
+        EXPECT_TRUE(service == seen[0]);
+    }
+    Service::DestroyInstance();
+}
+
+RUN_ALL_TESTS()
@@ -356,4 +356,32 @@ TEST(ThreadPoolTest, StressTest)
 }
 
 // Run all tests
+TEST(ThreadPoolTest, ParallelFor)
+{
+    ThreadPool pool(2, 4, "pfor");
+    std::vector<std::atomic<int>> hits(1000);
+    pool.ParallelFor(0, hits.size(), [&hits](size_t i) { hits[i].fetch_add(1); });
+    bool once = true;
+    for (auto &hit : hits) {
+        once = once && hit.load() == 1;
+    }
+    EXPECT_TRUE(once);
+
+    // Grain and an offset range
+    std::atomic<size_t> sum{0};
+    pool.ParallelFor(10, 110, [&sum](size_t i) { sum += i; }, 16);
+    EXPECT_EQ(5950U, sum.load());
+
+    // Nested from a task: the caller works too, so it can't deadlock
+    std::atomic<int> inner{0};
+    pool.ParallelFor(0, 4, [&pool, &inner](size_t) { pool.ParallelFor(0, 10, [&inner](size_t) { ++inner; }); });
+    EXPECT_EQ(40, inner.load());
+
+    // Still runs everything on the caller after shutdown
+    pool.Shutdown();
+    std::atomic<int> count{0};
+    pool.ParallelFor(0, 5, [&count](size_t) { ++count; });
+    EXPECT_EQ(5, count.load());
+}
+
 RUN_ALL_TESTS()
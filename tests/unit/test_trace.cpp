@@ -0,0 +1,148 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "../test_framework.h"
+#include "lmcore/thread_pool.h"
+#include "lmcore/trace.h"
+
+using namespace lmshao::lmcore;
+
+namespace {
+
+size_t CountOccurrences(const std::string &text, const std::string &pattern)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(TraceTest, DisabledRecordsNothing)
+{
+    Tracer::Clear();
+    Tracer::Disable();
+    {
+        TraceScope scope("disabled_scope");
+    }
+    Tracer::Instant("disabled_instant");
+    EXPECT_EQ(Tracer::NewFlowId(), 0);
+    EXPECT_TRUE(Tracer::ExportChromeJson().find("disabled_") == std::string::npos);
+}
+
+TEST(TraceTest, ScopeAndInstant)
+{
+    Tracer::Clear();
+    Tracer::Enable();
+    {
+        TraceScope outer("outer_scope");
+        TraceScope inner("inner \"quoted\"");
+        Tracer::Instant("marker");
+    }
+    Tracer::Disable();
+
+    std::string json = Tracer::ExportChromeJson();
+    EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0);
+    EXPECT_TRUE(json.find("\"name\":\"outer_scope\",\"cat\":\"lmcore\",\"ph\":\"X\"") != std::string::npos);
+    EXPECT_TRUE(json.find("\"name\":\"inner \\\"quoted\\\"\"") != std::string::npos);
+    EXPECT_TRUE(json.find("\"name\":\"marker\",\"cat\":\"lmcore\",\"ph\":\"i\"") != std::string::npos);
+    EXPECT_TRUE(json.find("\"dur\":") != std::string::npos);
+    EXPECT_TRUE(json.find("\"ph\":\"M\"") != std::string::npos);
+    EXPECT_TRUE(json.find(",\n]}") == std::string::npos);
+
+    Tracer::Clear();
+    EXPECT_TRUE(Tracer::ExportChromeJson().find("outer_scope") == std::string::npos);
+}
+
+TEST(TraceTest, RingOverwritesOldest)
+{
+    Tracer::Clear();
+    Tracer::SetRingCapacity(16);
+    Tracer::Enable();
+    std::thread worker([]() {
+        Tracer::SetThreadName("ring_worker");
+        for (int i = 0; i < 100; ++i) {
+            Tracer::Instant("ring_event");
+        }
+    });
+    worker.join();
+    Tracer::Disable();
+    Tracer::SetRingCapacity(Tracer::kDefaultRingCapacity);
+
+    std::string json = Tracer::ExportChromeJson();
+    // The slot the owner could be writing next is never exported
+    EXPECT_EQ(CountOccurrences(json, "\"ring_event\""), 15);
+    EXPECT_TRUE(json.find("\"args\":{\"name\":\"ring_worker\"}") != std::string::npos);
+
+    // Rings of exited threads are released by Clear()
+    Tracer::Clear();
+    EXPECT_TRUE(Tracer::ExportChromeJson().find("ring_worker") == std::string::npos);
+}
+
+#if !defined(LMCORE_TRACE_DISABLED)
+TEST(TraceTest, ThreadPoolFlows)
+{
+    Tracer::Clear();
+    Tracer::Enable();
+    std::atomic<int> executed{0};
+    {
+        ThreadPool pool(1, 1, "trace_pool");
+        for (int i = 0; i < 3; ++i) {
+            pool.AddTask([&executed]() {
+                LMCORE_TRACE_SCOPE("user_task");
+                executed++;
+            });
+        }
+        while (executed.load() < 3) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    Tracer::Disable();
+
+    std::string json = Tracer::ExportChromeJson();
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"ThreadPool::AddTask\""), 3);
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"user_task\""), 3);
+    EXPECT_EQ(CountOccurrences(json, "\"ph\":\"s\""), 3);
+    EXPECT_EQ(CountOccurrences(json, "\"ph\":\"f\""), 3);
+    EXPECT_TRUE(json.find("\"bp\":\"e\"") != std::string::npos);
+    EXPECT_TRUE(json.find("trace_pool-0") != std::string::npos);
+}
+#endif
+
+TEST(TraceTest, WriteChromeTrace)
+{
+    Tracer::Clear();
+    Tracer::Enable();
+    {
+        TraceScope scope("file_scope");
+    }
+    Tracer::Disable();
+
+    std::string path = "/tmp/lmcore_test_trace.json";
+    EXPECT_TRUE(Tracer::WriteChromeTrace(path));
+    FILE *file = fopen(path.c_str(), "rb");
+    EXPECT_TRUE(file != nullptr);
+    if (file) {
+        char buffer[4096];
+        size_t len = fread(buffer, 1, sizeof(buffer), file);
+        fclose(file);
+        EXPECT_TRUE(std::string(buffer, len).find("file_scope") != std::string::npos);
+    }
+    std::remove(path.c_str());
+    EXPECT_FALSE(Tracer::WriteChromeTrace("/nonexistent_dir/trace.json"));
+}
+
+RUN_ALL_TESTS()
@@ -0,0 +1,104 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../test_framework.h"
+#include "lmcore/sync.h"
+
+using namespace lmshao::lmcore::sync;
+
+TEST(TripleBufferTest, InitialValue)
+{
+    TripleBuffer<std::string> buffer("initial");
+    EXPECT_FALSE(buffer.HasNew());
+    EXPECT_FALSE(buffer.Update());
+    EXPECT_EQ(buffer.ReadBuffer(), std::string("initial"));
+}
+
+TEST(TripleBufferTest, LatestValueWins)
+{
+    TripleBuffer<int> buffer;
+    buffer.Write(1);
+    buffer.Write(2);
+    buffer.Write(3);
+    EXPECT_TRUE(buffer.HasNew());
+    EXPECT_EQ(buffer.Read(), 3);
+    EXPECT_FALSE(buffer.HasNew());
+    // Nothing new: the read buffer keeps its value
+    EXPECT_FALSE(buffer.Update());
+    EXPECT_EQ(buffer.ReadBuffer(), 3);
+}
+
+TEST(TripleBufferTest, ReadBufferStableUntilUpdate)
+{
+    TripleBuffer<std::vector<int>> buffer;
+    buffer.WriteBuffer().assign(4, 7);
+    buffer.Publish();
+    EXPECT_TRUE(buffer.Update());
+    const std::vector<int> &frame = buffer.ReadBuffer();
+
+    // The writer keeps going without touching the reader's slot
+    for (int i = 0; i < 5; ++i) {
+        buffer.WriteBuffer().assign(4, i);
+        buffer.Publish();
+    }
+    EXPECT_EQ(frame.size(), 4u);
+    EXPECT_EQ(frame[0], 7);
+    EXPECT_EQ(buffer.Read()[0], 4);
+}
+
+TEST(TripleBufferTest, ConcurrentWriterAndReader)
+{
+    struct Frame {
+        int id = 0;
+        int payload[64] = {};
+    };
+    TripleBuffer<Frame> buffer;
+    const int kFrames = 100000;
+    std::atomic<int> torn{0};
+    std::atomic<int> backwards{0};
+
+    std::thread reader([&]() {
+        int last = 0;
+        while (last < kFrames) {
+            if (!buffer.Update()) {
+                std::this_thread::yield();
+                continue;
+            }
+            const Frame &frame = buffer.ReadBuffer();
+            for (int value : frame.payload) {
+                if (value != frame.id) {
+                    torn.fetch_add(1);
+                    break;
+                }
+            }
+            if (frame.id <= last) {
+                backwards.fetch_add(1);
+            }
+            last = frame.id;
+        }
+    });
+
+    for (int i = 1; i <= kFrames; ++i) {
+        Frame &frame = buffer.WriteBuffer();
+        frame.id = i;
+        for (int &value : frame.payload) {
+            value = i;
+        }
+        buffer.Publish();
+    }
+    reader.join();
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(backwards.load(), 0);
+}
+
+RUN_ALL_TESTS()
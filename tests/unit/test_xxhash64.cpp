@@ -0,0 +1,60 @@
+/**
+ * @author SHAO Liming <lmshao@163.com>
+ * @copyright Copyright (c) 2026 SHAO Liming
+ * @license MIT
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lmcore/xxhash64.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "../test_framework.h"
+
+using namespace lmshao::lmcore;
+
+TEST(XXHash64, ReferenceVectors)
+{
+    EXPECT_EQ(0xEF46DB3751D8E999ULL, XXHash64::Calculate(nullptr, 0));
+    EXPECT_EQ(0x44BC2CF5AD770999ULL, XXHash64::Calculate("abc"));
+    // Longer than one 32-byte stripe
+    EXPECT_EQ(0xFBCEA83C8A378BF1ULL, XXHash64::Calculate("Nobody inspects the spammish repetition"));
+}
+
+TEST(XXHash64, Seed)
+{
+    EXPECT_EQ(0xBEA9CA8199328908ULL, XXHash64::Calculate("abc", 1));
+    EXPECT_NE(XXHash64::Calculate("abc", 0), XXHash64::Calculate("abc", 1));
+}
+
+TEST(XXHash64, IncrementalMatchesOneShot)
+{
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+    uint64_t expected = XXHash64::Calculate(data.data(), data.size());
+    EXPECT_EQ(0x25275608A9CFC168ULL, expected);
+
+    // Every split size exercises a different mix of buffered and direct stripes
+    bool same = true;
+    for (size_t step = 1; step <= 70; ++step) {
+        XXHash64::Context ctx;
+        for (size_t offset = 0; offset < data.size(); offset += step) {
+            ctx.Update(data.data() + offset, std::min(step, data.size() - offset));
+        }
+        same = same && ctx.Final() == expected;
+    }
+    EXPECT_TRUE(same);
+
+    XXHash64::Context ctx(1);
+    ctx.Update(reinterpret_cast<const uint8_t *>("abc"), 3);
+    EXPECT_EQ(XXHash64::Calculate("abc", 1), ctx.Final());
+    ctx.Reset();
+    EXPECT_EQ(0xEF46DB3751D8E999ULL, ctx.Final());
+}
+
+RUN_ALL_TESTS()